@@ -0,0 +1,5 @@
+// This file is generated by Simplicity Studio.  Please do not edit manually.
+//
+//
+
+// Templates from the callbacks info files
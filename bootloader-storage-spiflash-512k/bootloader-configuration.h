@@ -0,0 +1,194 @@
+// This file is generated by Simplicity Studio.  Please do not edit manually.
+//
+//
+
+// Enclosing macro to prevent multiple inclusion
+#ifndef __BOOTLOADER_CONFIG__
+#define __BOOTLOADER_CONFIG__
+
+
+
+
+// Top level macros
+#define EMBER_AF_DEVICE_NAME "bootloader-storage-spiflash-512k"
+
+
+// Generated plugin macros
+
+// Use this macro to check if Bootloader Core plugin is included
+#define EMBER_AF_PLUGIN_CORE
+// User options for plugin Bootloader Core
+#define BTL_UPGRADE_LOCATION_BASE 32768
+
+// Use this macro to check if Cyclic Redundancy Check plugin is included
+#define EMBER_AF_PLUGIN_CRC
+
+// Use this macro to check if Crypto plugin is included
+#define EMBER_AF_PLUGIN_CRYPTO
+
+// Use this macro to check if EMLIB plugin is included
+#define EMBER_AF_PLUGIN_EMLIB
+
+// Use this macro to check if mbed TLS plugin is included
+#define EMBER_AF_PLUGIN_MBEDTLS
+
+// Use this macro to check if Image Parser plugin is included
+#define EMBER_AF_PLUGIN_PARSER
+
+// Use this macro to check if SPI Driver plugin is included
+#define EMBER_AF_PLUGIN_SPI_DRIVER
+
+// Use this macro to check if SPI Flash Storage plugin is included
+#define EMBER_AF_PLUGIN_SPIFLASH
+
+// Use this macro to check if Common Storage plugin is included
+#define EMBER_AF_PLUGIN_STORAGE_COMMON
+// User options for plugin Common Storage
+#define BTL_STORAGE_BASE_ADDRESS 0
+
+// Use this macro to check if Token Management plugin is included
+#define EMBER_AF_PLUGIN_TOKEN_MANAGEMENT
+
+
+// Generated API headers
+
+
+// Custom macros
+#ifdef BTL_APP_SPACE_SIZE
+#undef BTL_APP_SPACE_SIZE
+#endif
+#define BTL_APP_SPACE_SIZE (FLASH_SIZE - BTL_APPLICATION_BASE)
+
+#ifdef BOOTLOADER_SUPPORT_STORAGE
+#undef BOOTLOADER_SUPPORT_STORAGE
+#endif
+#define BOOTLOADER_SUPPORT_STORAGE 1
+
+#ifdef EMBER_AF_RADIO
+#undef EMBER_AF_RADIO
+#endif
+#define EMBER_AF_RADIO EFR32
+
+#ifdef EMBER_AF_RADIO_FULL
+#undef EMBER_AF_RADIO_FULL
+#endif
+#define EMBER_AF_RADIO_FULL BGM13S22F512GA
+
+#ifdef EMBER_AF_RADIO_FAMILY
+#undef EMBER_AF_RADIO_FAMILY
+#endif
+#define EMBER_AF_RADIO_FAMILY B
+
+#ifdef EMBER_AF_RADIO_SERIES
+#undef EMBER_AF_RADIO_SERIES
+#endif
+#define EMBER_AF_RADIO_SERIES 1
+
+#ifdef EMBER_AF_RADIO_DEVICE_CONFIGURATION
+#undef EMBER_AF_RADIO_DEVICE_CONFIGURATION
+#endif
+#define EMBER_AF_RADIO_DEVICE_CONFIGURATION 3
+
+#ifdef EMBER_AF_RADIO_PERFORMANCE
+#undef EMBER_AF_RADIO_PERFORMANCE
+#endif
+#define EMBER_AF_RADIO_PERFORMANCE P
+
+#ifdef EMBER_AF_RADIO_RADIO
+#undef EMBER_AF_RADIO_RADIO
+#endif
+#define EMBER_AF_RADIO_RADIO 632
+
+#ifdef EMBER_AF_RADIO_FLASH
+#undef EMBER_AF_RADIO_FLASH
+#endif
+#define EMBER_AF_RADIO_FLASH 512K
+
+#ifdef EMBER_AF_RADIO_TEMP
+#undef EMBER_AF_RADIO_TEMP
+#endif
+#define EMBER_AF_RADIO_TEMP G
+
+#ifdef EMBER_AF_RADIO_PACKAGE
+#undef EMBER_AF_RADIO_PACKAGE
+#endif
+#define EMBER_AF_RADIO_PACKAGE M
+
+#ifdef EMBER_AF_RADIO_PINS
+#undef EMBER_AF_RADIO_PINS
+#endif
+#define EMBER_AF_RADIO_PINS 51
+
+#ifdef EMBER_AF_RADIO_MODULE
+#undef EMBER_AF_RADIO_MODULE
+#endif
+#define EMBER_AF_RADIO_MODULE BGM13S22F512GA
+
+#ifdef EMBER_AF_MCU
+#undef EMBER_AF_MCU
+#endif
+#define EMBER_AF_MCU EFR32
+
+#ifdef EMBER_AF_MCU_FULL
+#undef EMBER_AF_MCU_FULL
+#endif
+#define EMBER_AF_MCU_FULL BGM13S22F512GA
+
+#ifdef EMBER_AF_MCU_FAMILY
+#undef EMBER_AF_MCU_FAMILY
+#endif
+#define EMBER_AF_MCU_FAMILY B
+
+#ifdef EMBER_AF_MCU_SERIES
+#undef EMBER_AF_MCU_SERIES
+#endif
+#define EMBER_AF_MCU_SERIES 1
+
+#ifdef EMBER_AF_MCU_DEVICE_CONFIGURATION
+#undef EMBER_AF_MCU_DEVICE_CONFIGURATION
+#endif
+#define EMBER_AF_MCU_DEVICE_CONFIGURATION 3
+
+#ifdef EMBER_AF_MCU_PERFORMANCE
+#undef EMBER_AF_MCU_PERFORMANCE
+#endif
+#define EMBER_AF_MCU_PERFORMANCE P
+
+#ifdef EMBER_AF_MCU_RADIO
+#undef EMBER_AF_MCU_RADIO
+#endif
+#define EMBER_AF_MCU_RADIO 632
+
+#ifdef EMBER_AF_MCU_FLASH
+#undef EMBER_AF_MCU_FLASH
+#endif
+#define EMBER_AF_MCU_FLASH 512K
+
+#ifdef EMBER_AF_MCU_TEMP
+#undef EMBER_AF_MCU_TEMP
+#endif
+#define EMBER_AF_MCU_TEMP G
+
+#ifdef EMBER_AF_MCU_PACKAGE
+#undef EMBER_AF_MCU_PACKAGE
+#endif
+#define EMBER_AF_MCU_PACKAGE M
+
+#ifdef EMBER_AF_MCU_PINS
+#undef EMBER_AF_MCU_PINS
+#endif
+#define EMBER_AF_MCU_PINS 51
+
+#ifdef EMBER_AF_MCU_MODULE
+#undef EMBER_AF_MCU_MODULE
+#endif
+#define EMBER_AF_MCU_MODULE BGM13S22F512GA
+
+#ifdef EMBER_AF_BOARD_TYPE
+#undef EMBER_AF_BOARD_TYPE
+#endif
+#define EMBER_AF_BOARD_TYPE BRD4305C
+
+
+
+#endif // __BOOTLOADER_CONFIG__
@@ -28,11 +28,18 @@
 
 /* BG stack headers */
 #include "bg_types.h"
+#include "gatt_db.h"
 #include "native_gecko.h"
 #include "infrastructure.h"
 
 /* application specific headers*/
+#include "app.h"
+#include "app_hw.h"
 #include "app_ui.h"
+#include "app_timer.h"
+#include "app_work.h"
+#include "app_storage.h"
+#include "batt.h"
 #include "beacon.h"
 
 /* Own header */
@@ -53,49 +60,313 @@
 ***************************************************************************************************/
 
 /* Text definitions */
-#define ADV_HTMKYFOB_ADV_TEXT        "\nH T M / K E Y F O B\n\nM O D E\n"
+#define ADV_HTMKYFOB_ADV_TEXT        "\nH T M / B E A C O N\n\nS E N S O R\n"
+
+/** Convert milliseconds to advertising interval units of 0.625 ms. */
+#define ADV_MS_TO_INTERVAL(ms)       ((uint32_t)(ms) * 8 / 5)
+
+/* Interval profiles */
+#define ADV_PROFILE_FAST             0
+#define ADV_PROFILE_SLOW             1
+#define ADV_PROFILE_COUNT            2
+
+/* Advertising configuration flags, see le_gap_set_advertise_configuration */
+/** Use legacy advertising PDUs. */
+#define ADV_CONFIG_LEGACY            0x01
+/** Include the TX power in extended advertising PDUs. */
+#define ADV_CONFIG_TX_POWER          0x08
+
+/* AD types of the sensor data */
+#define ADV_TYPE_SERVICE_DATA_16     0x16
+#define ADV_TYPE_COMPLETE_NAME       0x09
+/** Temperature characteristic, sint16 in 0.01 degrees Celsius. */
+#define ADV_UUID_TEMPERATURE         0x2A6E
+/** Temperature characteristic value when the temperature is not known. */
+#define ADV_TEMPERATURE_UNKNOWN      0x8000
+/** Longest device name carried by the sensor data. */
+#define ADV_SENSOR_NAME_MAX          29
+
+/***************************************************************************************************
+   Local Type Definitions
+***************************************************************************************************/
+
+/** Advertising interval, in units of 0.625 ms. */
+typedef struct {
+  uint16_t intervalMin; /**< Minimum advertising interval. */
+  uint16_t intervalMax; /**< Maximum advertising interval. */
+} advInterval_t;
+
+/** Advertising set configuration. */
+typedef struct {
+  uint8_t discover;                              /**< Discoverable mode. */
+  uint8_t connect;                               /**< Connectable mode. */
+  uint8_t secondaryPhy;                          /**< Secondary PHY of extended advertising. */
+  uint32_t setConfig;                            /**< Configuration flags to set. */
+  uint32_t clearConfig;                          /**< Configuration flags to clear. */
+  advInterval_t intervals[ADV_PROFILE_COUNT];    /**< Intervals of the fast and slow profiles. */
+} advSet_t;
 
 /***************************************************************************************************
    Local Variables
  **************************************************************************************************/
 
-static bool advConnectableMode = true;
+/** The advertising sets. The Beacon interval stays at the 100 ms that receivers expect while the
+ *  fast profile runs, the connectable set bursts faster to shorten the time to connect. */
+static const advSet_t advSets[ADV_SET_COUNT] = {
+  [ADV_SET_HTM] = {
+    le_gap_general_discoverable, le_gap_connectable_scannable, le_gap_phy_1m, 0, 0,
+    { { ADV_MS_TO_INTERVAL(30), ADV_MS_TO_INTERVAL(60) },
+      { ADV_MS_TO_INTERVAL(760), ADV_MS_TO_INTERVAL(850) } }
+  },
+  [ADV_SET_BEACON] = {
+    le_gap_user_data, le_gap_non_connectable, le_gap_phy_1m, 0, 0,
+    { { ADV_MS_TO_INTERVAL(100), ADV_MS_TO_INTERVAL(100) },
+      { ADV_MS_TO_INTERVAL(1000), ADV_MS_TO_INTERVAL(1000) } }
+  },
+  [ADV_SET_SENSOR] = {
+    le_gap_user_data, le_gap_non_connectable, le_gap_phy_2m, ADV_CONFIG_TX_POWER, ADV_CONFIG_LEGACY,
+    { { ADV_MS_TO_INTERVAL(100), ADV_MS_TO_INTERVAL(120) },
+      { ADV_MS_TO_INTERVAL(1000), ADV_MS_TO_INTERVAL(1100) } }
+  }
+};
+
+/** Sensor data of the extended advertising set. The name is last and only its used length is
+ *  advertised. */
+static struct {
+  uint8_t tempLen;                        /* Length of the Temperature Service Data field. */
+  uint8_t tempType;                       /* Type of the Service Data field. */
+  uint8_t tempUuid[2];                    /* Temperature characteristic UUID. */
+  uint8_t temp[2];                        /* Temperature in 0.01 degrees Celsius. */
+  uint8_t nameLen;                        /* Length of the Complete Local Name field. */
+  uint8_t nameType;                       /* Type of the Complete Local Name field. */
+  uint8_t name[ADV_SENSOR_NAME_MAX];      /* Device name. */
+}
+advSensorData = {
+  5, ADV_TYPE_SERVICE_DATA_16,
+  { UINT16_TO_BYTES(ADV_UUID_TEMPERATURE) },
+  { UINT16_TO_BYTES(ADV_TEMPERATURE_UNKNOWN) },
+  1, ADV_TYPE_COMPLETE_NAME,
+  { 0 }
+};
+
+/** Advertised length of advSensorData. */
+static uint8_t advSensorDataLen = 0;
+
+/** Sets configured and payloads loaded. */
+static bool advConfigured = false;
+
+/** Bit mask of the sets that are advertising. */
+static uint8_t advRunning = 0;
 
-static bool advIsConnected = false;
+/** Interval profile of each set. */
+static uint8_t advProfile[ADV_SET_COUNT];
+
+static appTimer_t advProfileTimer; /* Ends the fast profile */
+static appTimer_t advSensorTimer; /* Sensor data update */
+static appWork_t advSensorWork; /* Deferred sensor read */
+static uint8_t advSensorLogCount = 0; /* Sensor updates since the last log record */
+
+/***************************************************************************************************
+   Static Function Declarations
+ **************************************************************************************************/
+static void advConfigure(void);
+static void advStartSet(uint8_t set, uint8_t profile);
+static void advProfileTimerCback(void *arg);
+static void advSensorTimerCback(void *arg);
+static void advSensorWorkCback(void *arg);
 
 /***************************************************************************************************
    Function Definitions
  **************************************************************************************************/
 void advSetup(void)
 {
-  if (advConnectableMode == true) {
-    /* set server advertising data and start advertising */
-    appUiWriteString(ADV_HTMKYFOB_ADV_TEXT);
-    /* start advertising */
-    gecko_cmd_le_gap_start_advertising(0, le_gap_general_discoverable, le_gap_connectable_scannable);
-  } else {
-    bcnSetupAdvBeaconing();
+  uint8_t set;
+
+  if (!advConfigured) {
+    advConfigure();
   }
-  appUiLedOff();
 
-  advIsConnected = false;
+  appUiWriteString(ADV_HTMKYFOB_ADV_TEXT);
+
+  /* Start the sets that are not advertising, the others keep their profile */
+  for (set = 0; set < ADV_SET_COUNT; set++) {
+    if (!(advRunning & (1 << set))) {
+      advStartSet(set, ADV_PROFILE_FAST);
+    }
+  }
+  appTimerStart(&advProfileTimer, ADV_FAST_DURATION_MS, 0, false, advProfileTimerCback, NULL);
+
+  appUiLedOff();
 }
 
-void advSwitchAdvMessage(void)
+void advStartBurst(void)
 {
-  if (!advIsConnected) {
-    /* switch mode from beaconing to connectable adv. and vica versa */
-    advConnectableMode = (advConnectableMode == true) ? false : true;
+  uint8_t set;
 
-    /* stop advertisement*/
-    gecko_cmd_le_gap_stop_advertising(0);
+  for (set = 0; set < ADV_SET_COUNT; set++) {
+    if ((advRunning & (1 << set)) && (advProfile[set] != ADV_PROFILE_FAST)) {
+      advStartSet(set, ADV_PROFILE_FAST);
+    }
+  }
+  if (advRunning) {
+    appTimerStart(&advProfileTimer, ADV_FAST_DURATION_MS, 0, false, advProfileTimerCback, NULL);
   }
-  advSetup();
 }
 
 void advConnectionStarted(void)
 {
-  advIsConnected = true;
+  /* The stack stops the connectable set when a connection is opened on it */
+  advRunning &= ~(1 << ADV_SET_HTM);
+}
+
+void advSetSensorData(int32_t temperature, uint32_t humidity, uint8_t battery)
+{
+  int16_t value = (int16_t)(temperature / 10);
+  const uint8_t *pData;
+  uint8_t len;
+
+  advSensorData.temp[0] = UINT16_TO_BYTE0(value);
+  advSensorData.temp[1] = UINT16_TO_BYTE1(value);
+
+  /* The advertising data can be replaced while the set is advertising */
+  if (advConfigured) {
+    gecko_cmd_le_gap_bt5_set_adv_data(ADV_SET_SENSOR, 0, advSensorDataLen, (uint8_t *)&advSensorData);
+  }
+
+  /* The Beacon carries the readings in broadcast mode */
+  if (bcnUpdateSensorData(temperature, humidity, battery) && advConfigured) {
+    pData = bcnGetAdvData(&len);
+    gecko_cmd_le_gap_bt5_set_adv_data(ADV_SET_BEACON, 0, len, pData);
+  }
+}
+
+/***************************************************************************************************
+   Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Configure the advertising sets and load their payloads.
+ **************************************************************************************************/
+static void advConfigure(void)
+{
+  struct gecko_msg_gatt_server_read_attribute_value_rsp_t *pName;
+  const uint8_t *pData;
+  uint8_t len;
+  uint8_t set;
+
+  for (set = 0; set < ADV_SET_COUNT; set++) {
+    if (advSets[set].setConfig) {
+      gecko_cmd_le_gap_set_advertise_configuration(set, advSets[set].setConfig);
+    }
+    if (advSets[set].clearConfig) {
+      gecko_cmd_le_gap_clear_advertise_configuration(set, advSets[set].clearConfig);
+    }
+    if (advSets[set].clearConfig & ADV_CONFIG_LEGACY) {
+      gecko_cmd_le_gap_set_advertise_phy(set, le_gap_phy_1m, advSets[set].secondaryPhy);
+    }
+  }
+
+  /* The Beacon payload only changes with the readings in broadcast mode */
+  bcnInit();
+  pData = bcnGetAdvData(&len);
+  gecko_cmd_le_gap_bt5_set_adv_data(ADV_SET_BEACON, 0, len, pData);
+
+  /* Extended advertising has room for the device name next to the sensor data */
+  pName = gecko_cmd_gatt_server_read_attribute_value(gattdb_device_name, 0);
+  len = (pName->result == 0) ? MIN(pName->value.len, ADV_SENSOR_NAME_MAX) : 0;
+  memcpy(advSensorData.name, pName->value.data, len);
+  advSensorData.nameLen = len + 1;
+  advSensorDataLen = sizeof(advSensorData) - ADV_SENSOR_NAME_MAX + len;
+  gecko_cmd_le_gap_bt5_set_adv_data(ADV_SET_SENSOR, 0, advSensorDataLen, (uint8_t *)&advSensorData);
+
+  advConfigured = true;
+
+  /* Take the first reading now, then periodically */
+  appWorkPost(&advSensorWork, APP_WORK_PRIO_LOW, advSensorWorkCback, NULL);
+  appTimerStart(&advSensorTimer, ADV_SENSOR_PERIOD_MS, ADV_SENSOR_PERIOD_MS / 10, true,
+                advSensorTimerCback, NULL);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Start an advertising set with an interval profile, stopping it first if it is running.
+ *  \details  The timing of a set only takes effect when advertising is enabled, so a profile change
+ *  needs a restart. Payload updates do not.
+ *  \param[in]  set  Advertising set handle.
+ *  \param[in]  profile  Interval profile.
+ **************************************************************************************************/
+static void advStartSet(uint8_t set, uint8_t profile)
+{
+  const advInterval_t *pInterval = &advSets[set].intervals[profile];
+  uint16_t result;
+
+  if (advRunning & (1 << set)) {
+    gecko_cmd_le_gap_stop_advertising(set);
+    advRunning &= ~(1 << set);
+  }
+
+  gecko_cmd_le_gap_set_advertise_timing(set, pInterval->intervalMin, pInterval->intervalMax, 0, 0);
+  result = gecko_cmd_le_gap_start_advertising(set, advSets[set].discover, advSets[set].connect)->result;
+  if (result != 0) {
+    /* The connectable set is refused while all connections are in use */
+    printLog("advertising set %d not started: 0x%4.4x\r\n", set, result);
+    return;
+  }
+
+  advRunning |= (1 << set);
+  advProfile[set] = profile;
+}
+
+/***********************************************************************************************//**
+ *  \brief  End of the fast profile, the running sets drop to the slow profile.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void advProfileTimerCback(void *arg)
+{
+  uint8_t set;
+
+  (void)arg;
+
+  for (set = 0; set < ADV_SET_COUNT; set++) {
+    if ((advRunning & (1 << set)) && (advProfile[set] != ADV_PROFILE_SLOW)) {
+      advStartSet(set, ADV_PROFILE_SLOW);
+    }
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Sensor data update timer callback.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void advSensorTimerCback(void *arg)
+{
+  (void)arg;
+  /* The sensor read blocks on I2C, so it is run from the work queue */
+  appWorkPost(&advSensorWork, APP_WORK_PRIO_LOW, advSensorWorkCback, NULL);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Sensor read work item.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void advSensorWorkCback(void *arg)
+{
+  appStorageLogRecord_t record;
+  int32_t temperature;
+  uint32_t humidity;
+
+  (void)arg;
+
+  if (appHwReadRhTm(&humidity, &temperature) == 0) {
+    advSetSensorData(temperature, humidity, battGetLevel());
+
+    if (++advSensorLogCount >= ADV_SENSOR_LOG_DIVIDER) {
+      advSensorLogCount = 0;
+      record.temperature = temperature;
+      record.humidity = (uint16_t)(humidity / 10);
+      record.battery = battGetLevel();
+      appStorageLogAppend(&record);
+    }
+  }
 }
 
 /** @} (end addtogroup adv) */
@@ -18,6 +18,8 @@
 #ifndef APP_ADV_H
 #define APP_ADV_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -46,26 +48,68 @@ extern "C" {
 #define ADV_UUID_LEN      5
 #define ADV_TX_POWER_LEN  2
 
+/* Advertising set handles, all sets advertise at the same time */
+/** Connectable HTM advertising, advertising data generated by the stack. */
+#define ADV_SET_HTM       0
+/** Non-connectable Beacon, legacy PDUs. */
+#define ADV_SET_BEACON    1
+/** Non-connectable extended advertising carrying the sensor data. */
+#define ADV_SET_SENSOR    2
+/** Number of advertising sets, also the number of advertisers configured in the stack. */
+#define ADV_SET_COUNT     3
+
+/** Time in ms the sets advertise with the fast interval profile after boot, after a connection
+ *  has closed or after a button press, before they drop to the slow profile. */
+#ifndef ADV_FAST_DURATION_MS
+#define ADV_FAST_DURATION_MS      30000
+#endif
+
+/** Sensor data update period in ms. */
+#ifndef ADV_SENSOR_PERIOD_MS
+#define ADV_SENSOR_PERIOD_MS      10000
+#endif
+
+/** Every this many sensor updates a record is appended to the measurement log. */
+#ifndef ADV_SENSOR_LOG_DIVIDER
+#define ADV_SENSOR_LOG_DIVIDER    6
+#endif
+
 /***************************************************************************************************
    Public Function Declarations
 ***************************************************************************************************/
 
 /***********************************************************************************************//**
  *  \brief  Setup advertising.
+ *  \details  Configures the advertising sets and loads their payloads the first time, then starts
+ *  every set that is not advertising with the fast interval profile. Sets that are still
+ *  advertising, typically the non-connectable ones while a connection was open, are left running.
  **************************************************************************************************/
 void advSetup(void);
 
-/**********************************************************************************************//**
-*  \brief  Stop advertising current message and prepare for advertising a different message.
-**************************************************************************************************/
-void advSwitchAdvMessage(void);
+/***********************************************************************************************//**
+ *  \brief  Restart the fast interval profile on all advertising sets.
+ **************************************************************************************************/
+void advStartBurst(void);
 
 /***********************************************************************************************//**
- *  \brief  Indicate that connection has started.
+ *  \brief  Indicate that connection has started. The stack has stopped the connectable set.
  **************************************************************************************************/
 void advConnectionStarted(void);
 
+/***********************************************************************************************//**
+ *  \brief  Update the sensor readings carried by the sensor and Beacon advertising sets.
+ *  \details  The payloads are rewritten in place, the sets keep advertising.
+ *  \param[in]  temperature  Temperature in milli-degrees Celsius.
+ *  \param[in]  humidity  Relative humidity in milli-percent.
+ *  \param[in]  battery  Battery level in %.
+ **************************************************************************************************/
+void advSetSensorData(int32_t temperature, uint32_t humidity, uint8_t battery);
+
 /** @} (end addtogroup adv) */
 /** @} (end addtogroup Advertisement) */
 
+#ifdef __cplusplus
+};
+#endif
+
 #endif /* APP_ADV_H */
@@ -45,6 +45,17 @@
 #include "batt.h"
 #include "btl_interface.h"
 #include "btl_interface_storage.h"
+#include "app_flash.h"
+#include "app_storage.h"
+#include "app_slots.h"
+#include "app_work.h"
+#include "app_idle.h"
+#include "app_boot.h"
+#include "app_sensor.h"
+#include "gatt_map.h"
+#include "cts.h"
+#include "hr.h"
+#include "app_security.h"
 
 /* Own header */
 #include "app.h"
@@ -53,13 +64,29 @@ void bootMessage(struct gecko_msg_system_boot_evt_t *bootevt);
 
 extern erase_slot_if_needed();
 extern int32_t get_slot_info();
+extern int32_t get_download_slot_info();
 extern bool get_ota_image_finished(void);
 extern uint8 get_ota_in_progress(void);
+extern bool ota_flash_begin(void);
+extern bool ota_storage_begin(uint32_t *address);
+extern bool ota_slots_external(void);
 // tmp?
 uint32 ota_image_position = 0;
 uint8 ota_in_progress = 0;
 uint8 ota_image_finished = 0;
 uint16 ota_time_elapsed = 0;
+static bool ota_direct_flash = false; /* image is burst programmed by app_flash.c */
+static bool ota_external_flash = false; /* image is programmed into the MX25 by app_storage.c */
+static bool ota_write_failed = false; /* part of the image was not stored */
+static uint32_t ota_slot_address = 0; /* MX25 address of the download slot */
+extern int32_t ota_slot; /* download slot, APP_SLOTS_NONE while the image is on trial */
+static bool storage_ok = false; /* MX25 answered at boot */
+static appTimer_t health_timer; /* confirms an image on trial once it has proven healthy */
+static appTimer_t ota_timer; /* 1 second tick, used for performance statistics during OTA file upload */
+#if APP_BOOT_FAST_START
+static appWork_t boot_work; /* runs the boot work deferred until advertising has started */
+static uint8_t boot_work_step = 0;
+#endif
 
 /***********************************************************************************************//**
  * @addtogroup Application
@@ -74,26 +101,41 @@ uint16 ota_time_elapsed = 0;
 /***************************************************************************************************
  * Local Macros and Definitions
  **************************************************************************************************/
-#define STRLENGHT (40U)
+/* Time from boot an image on trial must run without problems before it is confirmed, it must be
+ * well inside APP_SLOTS_CONFIRM_TIMEOUT_MS */
+#ifndef APP_HEALTH_CHECK_MS
+#define APP_HEALTH_CHECK_MS (10000U)
+#endif
+
+/* ATT application error returned when an update is refused */
+#define APP_ATT_ERR_OTA_REFUSED (0x80U)
+/* ATT application error returned when the image could not be stored, the upload must restart */
+#define APP_ATT_ERR_OTA_WRITE_FAILED (0x81U)
+/* ATT application error returned while the bootloader is not initialized yet, the peer can retry */
+#define APP_ATT_ERR_OTA_NOT_READY (0x82U)
 /***************************************************************************************************
  * Local Variables
  **************************************************************************************************/
 static uint8_t activeConnectionId = 0xFF; 	/* Connection Handle ID */
-static char passString[STRLENGHT];
-
-//static uint8_t bonded = 0;
 static uint8_t ledState = 0;
-static uint8_t heart_rate_measurement = 0x7f;
 
 /***************************************************************************************************
  * Static Function Declarations
  **************************************************************************************************/
    #ifndef FEATURE_IOEXPANDER
-/* Periodically called Display Polarity Inverter Function for the LCD.
+/* Timer of the periodically called Display Polarity Inverter Function for the LCD.
    Toggles the the EXTCOMIN signal of the Sharp memory LCD panel, which prevents building up a DC
    bias according to the LCD's datasheet */
-static void (*dispPolarityInvert)(void *);
+static appTimer_t dispPolInvTimer;
   #endif /* FEATURE_IOEXPANDER */
+static void healthCheck(void *arg);
+static void otaTimerTick(void *arg);
+static bool otaFlashIdle(void);
+static void otaAbort(void);
+static void bootSlotCheck(void);
+#if APP_BOOT_FAST_START
+static void bootDeferredWork(void *arg);
+#endif
 
 /***************************************************************************************************
  * Function Definitions
@@ -138,6 +180,8 @@ void appInit(void)
 
   /* Initialize services */
   htmInit();
+  battInit();
+  iaInit();
 }
 
 /***********************************************************************************************//**
@@ -154,26 +198,25 @@ void appHandleEvents(struct gecko_cmd_packet *evt)
     case gecko_evt_system_boot_id:
 
       if (gecko_evt_system_boot_id == BGLIB_MSG_ID(evt->header)) { // GN:
+      appBootMark(APP_BOOT_EVENT);
 
 	    	  /* 1 second soft timer, used for performance statistics during OTA file upload */
-      gecko_cmd_hardware_set_soft_timer(TIMER_MS_2_TIMERTICK(1000), OTA_TIMER, 0);
+      appTimerStart(&ota_timer, 1000, 0, true, otaTimerTick, NULL);
 
 //                printLog("\r\nBoot! ........ \r\n");
                 bootMessage(&(evt->data.evt_system_boot));
 
-    	        /* bootloader init must be called before calling other bootloader_xxx API calls */
-    	        bootloader_init();
-
-    	        /* read slot information from bootloader */
-    	        if(get_slot_info() == BOOTLOADER_OK)
-    	        {
-    	        	/* the download area is erased here (if needed), prior to any connections are opened */
-    	        	erase_slot_if_needed();
-    	        }
-    	        else
-    	        {
-    	        	printf("Check that you have installed correct type of Gecko bootloader!\r\n");
-    	        }
+      /* Security manager and bonding table, once per boot */
+      appSecurityInit();
+
+#if APP_SENSOR_BENCH
+                appSensorBench();
+#endif
+
+#if !APP_BOOT_FAST_START
+    	        /* the download area is checked before advertising, with fast start it is done after */
+    	        bootSlotCheck();
+#endif
       }
 //fall-thru ...
     case gecko_evt_le_connection_closed_id:
@@ -184,25 +227,59 @@ void appHandleEvents(struct gecko_cmd_packet *evt)
         /* Store the connection ID */
         activeConnectionId = 0xFF; /* delete the connection ID */
 
+        /* Drop a time synchronization still running on the connection */
+        ctsClientEvent(evt);
+
+        /* Drop what the services keep per connection */
+        htmConnectionClosed(evt->data.evt_le_connection_closed.connection);
+        hrConnectionClosed(evt->data.evt_le_connection_closed.connection);
+        appSecurityConnectionClosed(evt->data.evt_le_connection_closed.connection);
+
+        /* An upload cut short by the disconnect is dropped, the peer starts over */
+        if (ota_in_progress) {
+          otaAbort();
+        }
+
         if (ota_image_finished) {
-   		  printf("Installing new image\r\n"); flushLog(); // uart_flush();
-  	      bootloader_setImageToBootload(0);
+          int32_t installStatus;
+
+          ota_image_finished = 0;
+          printf("Installing new image\r\n"); syncLog(); // uart_flush();
+          /* downloaded image first, the confirmed image as fallback */
+          installStatus = appSlotsInstall();
+          if (installStatus == BOOTLOADER_OK) {
 #if 1 // GN: stop here if you don't want to install! (e.g. just perf. testing the transfer time)
-  	      bootloader_rebootAndInstall();
+            bootloader_rebootAndInstall();
 #endif
-  	    }
+          } else {
+            /* Rebooting would only restart the running image, keep serving until the peer retries */
+            printf("install failed, error 0x%lx\r\n", (unsigned long)installStatus); flushLog();
+          }
+        }
       }
       /* Restart advertising after client has disconnected ?????  */
-///*
-// *  GN: set sm mode ...
-            gecko_cmd_sm_configure(0x00, sm_io_capability_displayyesno);
-            gecko_cmd_sm_set_bondable_mode(1);
- //*/
       /* Initialize app */
       appInit(); /* App initialization */
       htmInit(); /* Health thermometer initialization */
       advSetup(); /* Advertisement initialization */
 
+      if (gecko_evt_le_connection_closed_id == BGLIB_MSG_ID(evt->header)) {
+        /* End the alert of the peer, or raise one if the link was lost. This comes after appInit(),
+         * which redraws the display. */
+        iaConnectionClosed(evt->data.evt_le_connection_closed.connection,
+                           evt->data.evt_le_connection_closed.reason);
+      }
+
+      if (gecko_evt_system_boot_id == BGLIB_MSG_ID(evt->header)) {
+        appBootMark(APP_BOOT_ADVERTISING);
+#if APP_BOOT_FAST_START
+        /* Display init and the slot scan run from the work queue now that advertising is up */
+        appWorkPost(&boot_work, APP_WORK_PRIO_LOW, bootDeferredWork, NULL);
+#else
+        appBootComplete();
+#endif
+      }
+
       /* Enter to DFU OTA mode if needed */
       if (boot_to_dfu) {
         gecko_cmd_system_reset(2);
@@ -220,89 +297,45 @@ void appHandleEvents(struct gecko_cmd_packet *evt)
 
       /* Call advertisement.c connection started callback */
       advConnectionStarted();
-      break;
-
-    /* Value of attribute changed from the local database by remote GATT client */
-    case gecko_evt_gatt_server_attribute_value_id:
-
-      printLog("_evt_gatt_server_attribute_value_id (attribute_value.attribute == %d) \r\n", evt->data.evt_gatt_server_attribute_value.attribute); flushLog();
 
-      switch (evt->data.evt_gatt_server_attribute_value.attribute){
+      /* A bonded peer is encrypted with its stored key before anything else */
+      appSecurityConnectionOpened(evt->data.evt_le_connection_opened.connection,
+                                  evt->data.evt_le_connection_opened.bonding);
 
-        /* Check if changed characteristic is the Immediate Alert level */
-        case gattdb_alert_level:
-          /* Write the Immediate Alert level value */
-          iaImmediateAlertWrite(&evt->data.evt_gatt_server_attribute_value.value);
-          break;
+      /* Read the time from the peer if the clock needs it */
+      ctsConnectionOpened(evt->data.evt_le_connection_opened.connection);
 
-        default:
-          printLog("unhandled: _evt_gatt_server_attribute_value_id (%d == %d) \r\n",
-            evt->data.evt_gatt_server_attribute_value.attribute, evt->data.evt_gatt_server_attribute_value.value.data[0]); flushLog();
-          break;
-      }
+      /* A peer is back, the link loss alert has done its job */
+      iaConnectionOpened(evt->data.evt_le_connection_opened.connection);
       break;
 
-    /* Indicates the changed value of CCC or received characteristic confirmation */
+    /* GATT server events, routed by attribute handle to the handlers bound in gatt_handlers.txt */
+    case gecko_evt_gatt_server_attribute_value_id:
     case gecko_evt_gatt_server_characteristic_status_id:
-      switch (evt->data.evt_gatt_server_attribute_value.attribute) 
-      {
-        case gattdb_temperature_measurement:
-          /* Check if changed client char config is for the temperature measurement */
-          if (evt->data.evt_gatt_server_characteristic_status.status_flags == 0x01) {
-            /* Call HTM temperature characteristic status changed callback */
-            htmTemperatureCharStatusChange(
-              evt->data.evt_gatt_server_characteristic_status.connection,
-              evt->data.evt_gatt_server_characteristic_status.client_config_flags);
-          }
-          break;
-
-        case gattdb_battery_level:
-// char-write-cmd 0x3b 0100 ... enable notification   t_server_characteristic_status.client_config_flags == 1
-          printLog("gattdb_battery_level: evt->data.evt_gatt_server_characteristic_status.client_config_flags (%d) \r\n", evt->data.evt_gatt_server_characteristic_status.client_config_flags); flushLog();
-
-          battCharStatusChange(evt->data.evt_gatt_server_characteristic_status.connection,
-              evt->data.evt_gatt_server_characteristic_status.client_config_flags);
-          break;
-
-//        case gattdb_characteristic_presentation_format: // GN: nfi
-
-        case gattdb_service_changed_char:
-          printLog("gattdb_service_changed_char ?????????????? (pairing??? )  \r\n");flushLog();
-          break;
-
-        case gattdb_device_name:
-          printLog("_evt_gatt_server_characteristic_status_id -> gattdb_device_name \r\n");flushLog();
-          break;
-
-        case gattdb_heart_rate_measurement:
-            heart_rate_measurement += 1;
-            printLog("_evt_gatt_server_characteristic_status_id -> _heart_rate_measurement (%d) ... characteristic_status.status_flags== [%d]\r\n", heart_rate_measurement, evt->data.evt_gatt_server_characteristic_status.status_flags); flushLog();
-            gecko_cmd_gatt_server_send_characteristic_notification( conGetConnectionId(), gattdb_heart_rate_measurement, sizeof(heart_rate_measurement), &heart_rate_measurement);
-            break;
-
-        default:
-          printLog("unhandled  _gatt_server_attribute_value.attribute ) ... evt->data.evt_gatt_server_attribute_value.attribute %d \r\n", evt->data.evt_gatt_server_attribute_value.attribute);
-//            printLog("evt->data.evt_gatt_server_characteristic_status.characteristic (%d) \r\n", evt->data.evt_gatt_server_characteristic_status.characteristic);
-//            printLog("evt->data.evt_gatt_server_characteristic_status.client_config_flags (%d) \r\n", evt->data.evt_gatt_server_characteristic_status.client_config_flags);
-//            printLog("evt->data.evt_gatt_server_characteristic_status.status_flags (%d) \r\n", evt->data.evt_gatt_server_characteristic_status.status_flags);
-          flushLog();
-          break;
+    case gecko_evt_gatt_server_user_read_request_id:
+    case gecko_evt_gatt_server_user_write_request_id:
+      if (!gattMapDispatch(evt)) {
+        printLog("unhandled GATT server event '%08x' \r\n", BGLIB_MSG_ID(evt->header)); flushLog();
       }
+      break;
 
+    /* GATT client events, only the Current Time synchronization uses the client */
+    case gecko_evt_gatt_service_id:
+    case gecko_evt_gatt_characteristic_id:
+    case gecko_evt_gatt_characteristic_value_id:
+    case gecko_evt_gatt_procedure_completed_id:
+      if (!ctsClientEvent(evt)) {
+        printLog("unhandled GATT client event '%08x' \r\n", BGLIB_MSG_ID(evt->header)); flushLog();
+      }
       break;
 
-    case gecko_evt_gatt_server_user_read_request_id:
-    	/*
-    	 * When reading a user characteristic longer than MTU, multiple gatt_server_user_read_request events will be generated on the server side, each
-    	 * containing the offset from the beginning of the characteristic. The application code must use the offset parameter to send the correct chunk of data.
-    	 */
-      switch (evt->data.evt_gatt_server_user_read_request.characteristic){
-        case gattdb_battery_level:
-          battRead();
-          break;
-        default:
-          printLog("gecko_evt_gatt_server_user_read_request_id, ...: (%d) \r\n", evt->data.evt_gatt_server_user_read_request.characteristic); flushLog();
-          break;
+    /* Security manager events, passkeys and bonding results */
+    case gecko_evt_sm_passkey_display_id:
+    case gecko_evt_sm_confirm_passkey_id:
+    case gecko_evt_sm_bonded_id:
+    case gecko_evt_sm_bonding_failed_id:
+      if (!appSecurityEvent(evt)) {
+        printLog("unhandled SM event '%08x' \r\n", BGLIB_MSG_ID(evt->header)); flushLog();
       }
       break;
 
@@ -317,113 +350,15 @@ void appHandleEvents(struct gecko_cmd_packet *evt)
 #endif
       /* Check which software timer handle is in question */
       switch (evt->data.evt_hardware_soft_timer.handle) {
-        case OTA_TIMER: /* performance statistics during OTA file upload  */
-    		  ota_time_elapsed++;
-  // 	    		  print_progress();
+        case APP_TIMER_HANDLE: /* Application timers (UI, OTA, temperature, display) */
+          appTimerProcess();
           break;
-        case UI_TIMER: /* App UI Timer (LEDs, Buttons) */
-          appUiTick();
-          break;
-        case ADV_TIMER: /* Advertisement Timer */
-          advSetup();
-          break;
-        case TEMP_TIMER: /* Temperature measurement timer */
-          /* Make a temperature measurement */
-          htmTemperatureMeasure();
-          break;
-        #ifndef FEATURE_IOEXPANDER
-        case DISP_POL_INV_TIMER:
-          /*Toggle the the EXTCOMIN signal, which prevents building up a DC bias  within the
-           * Sharp memory LCD panel */
-          dispPolarityInvert(0);
-          break;
-        #endif /* FEATURE_IOEXPANDER */
         default:
         	printf("unhandled\r\n");
           break;
       }
       break;
 
-    /* User write request event. Checks if the user-type OTA Control Characteristic was written.
-     * If written, boots the device into Device Firmware Upgrade (DFU) mode. */
-    case gecko_evt_gatt_server_user_write_request_id:
-#if 0 // GN: this is for boot to DFU 
-      /* Handle OTA */
-      if (evt->data.evt_gatt_server_user_write_request.characteristic == gattdb_ota_control) {
-        /* Set flag to enter to OTA mode */
-        boot_to_dfu = 1;
-        /* Send response to Write Request */
-        gecko_cmd_gatt_server_send_user_write_response(
-          evt->data.evt_gatt_server_user_write_request.connection,
-          gattdb_ota_control,
-          bg_err_success);
-
-        /* Close connection to enter to DFU OTA mode */
-        gecko_cmd_le_connection_close(evt->data.evt_gatt_server_user_write_request.connection);
-      }
-#endif
-      switch(evt->data.evt_gatt_server_user_write_request.characteristic){
-
-      case gattdb_ota_control:
-          printf("characteristic == gattdb_ota_control ...... value.data[0] %d \r\n", evt->data.evt_gatt_server_user_write_request.value.data[0]);
-		  switch(evt->data.evt_gatt_server_user_write_request.value.data[0])
-		  {
-		  case 0://Erase and use slot 0
-			  // NOTE: download are is NOT erased here, because the long blocking delay would result in supervision timeout
-			  //bootloader_eraseStorageSlot(0);
-			  ota_image_position=0;
-			  ota_in_progress=1;
-			  break;
-		  case 3://END OTA process
-			  //wait for connection close and then reboot
-			  ota_in_progress=0;
-			  ota_image_finished=1;
-			  printf("upload finished. received file size %u bytes\r\n", ota_image_position); flushLog(); // uart_flush();
-			  break;
-		  default:
-			  break;
-		  }
-  	      gecko_cmd_gatt_server_send_user_write_response(
-	  	    		evt->data.evt_gatt_server_user_write_request.connection, gattdb_ota_control,0);
-		  break;
-
-      case gattdb_ota_data:
-    	if(ota_in_progress)
-		{
-			  bootloader_writeStorage(0,//use slot 0
-					  ota_image_position,
-					  evt->data.evt_gatt_server_user_write_request.value.data,
-					  evt->data.evt_gatt_server_user_write_request.value.len);
-			  ota_image_position+=evt->data.evt_gatt_server_user_write_request.value.len;
-		}
-// GN: I can uncheck write /w/ response .... !!!
-///*
-  	    gecko_cmd_gatt_server_send_user_write_response(
-  	    		evt->data.evt_gatt_server_user_write_request.connection, gattdb_ota_data,0);
-//*/
-//printLog("GN: received %d\r\n", evt->data.evt_gatt_server_user_write_request.value.len);
-  	    break;
-
-      case gattdb_battery_level:
-        battSet(evt->data.evt_gatt_server_attribute_value.value.data[0]); // gecko_cmd_gatt_server_send_characteristic_notification() ... needs notifications enabled?
-
-        /* Send response to Write Request */
-        gecko_cmd_gatt_server_send_user_write_response(
-            evt->data.evt_gatt_server_user_write_request.connection, gattdb_battery_level, bg_err_success);
-
-        printLog("_evt_gatt_server_user_write_request_id: characteristic '%d' = (%d) \r\n",
-        		evt->data.evt_gatt_server_user_write_request.characteristic,
-				evt->data.evt_gatt_server_attribute_value.value.data[0]); flushLog();
-        break;
-
-      default:
-        printLog("Unhandled evt->data.evt_gatt_server_user_write_request.characteristic [_evt_gatt_server_user_write_request_id]: characteristic '%d' = (%d) \r\n",
-    	  evt->data.evt_gatt_server_user_write_request.characteristic, evt->data.evt_gatt_server_attribute_value.value.data[0]); flushLog();
-        break;
-      }
-
-      break; // _user_write_request_id
-
     case gecko_evt_le_connection_parameters_id:
     {
         struct gecko_msg_le_connection_parameters_evt_t* data = &evt->data.evt_le_connection_parameters;
@@ -434,6 +369,9 @@ void appHandleEvents(struct gecko_cmd_packet *evt)
         printLog("(gecko_evt_le_connection_parameters_id) parameters security_mode: %lu \r\n", data->security_mode);
         printLog("(gecko_evt_le_connection_parameters_id) parameters txsize: %lu \r\n", data->txsize);
         flushLog();
+
+        /* A time read refused for lack of security is retried once the link is encrypted */
+        ctsSecurityChanged(data->connection, data->security_mode);
         break;
     }
     case gecko_evt_le_connection_phy_status_id:
@@ -444,11 +382,14 @@ void appHandleEvents(struct gecko_cmd_packet *evt)
     {
     	struct gecko_msg_gatt_mtu_exchanged_evt_t* data = &evt->data.evt_gatt_mtu_exchanged;
     	printLog("(gecko_evt_gatt_mtu_exchanged_id) mtu: %u \r\n", data->mtu); flushLog();
+    	/* Heart rate measurements carry as many RR-Intervals as the MTU allows */
+    	hrMtuExchanged(data->connection, data->mtu);
     	break;
     }
 
+    /* Deferred work (sensor reads, boot steps) */
     case gecko_evt_system_external_signal_id:
-    	printLog("(_evt_system_external_signal_id) xxxx: %u \r\n", 0 ); flushLog();
+    	appWorkProcess(evt->data.evt_system_external_signal.extsignals);
     	break;
 
     case gecko_rsp_le_connection_set_parameters_id:
@@ -478,14 +419,246 @@ int rtcIntCallbackRegister(void (*pFunction)(void*),
 {
   #ifndef FEATURE_IOEXPANDER
 
-  dispPolarityInvert =  pFunction;
-  /* Start timer with required frequency */
-  gecko_cmd_hardware_set_soft_timer(TIMER_MS_2_TIMERTICK(1000 / frequency), DISP_POL_INV_TIMER, false);
+  /* Start timer with required frequency. The panel only needs the polarity toggled every so
+   * often, so the timer may run up to half a period late to share a wakeup with other timers. */
+  appTimerStart(&dispPolInvTimer, 1000 / frequency, 500 / frequency, true, pFunction, argument);
 
   #endif /* FEATURE_IOEXPANDER */
 
   return 0;
 }
 
+/***********************************************************************************************//**
+ * \brief  OTA Control write handler, bound in gatt_handlers.txt.
+ * @param[in] pEvt  User write request.
+ **************************************************************************************************/
+void appOtaControlWrite(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt)
+{
+  uint8_t att_err = 0;
+
+  printf("characteristic == gattdb_ota_control ...... value.data[0] %d \r\n", pEvt->value.data[0]);
+
+  /* With fast start bootSlotCheck() runs from the work queue after advertising has started, the
+   * download slot and the bootloader interface are not set up until it is done */
+  if (appBootDeferring()) {
+    printf("boot not complete, update refused\r\n");
+    gecko_cmd_gatt_server_send_user_write_response(pEvt->connection, gattdb_ota_control,
+                                                   APP_ATT_ERR_OTA_NOT_READY);
+    return;
+  }
+
+  switch (pEvt->value.data[0]) {
+    case 0: /* Erase and use the download slot */
+      /* NOTE: download area is NOT erased here, because the long blocking delay would result in
+       * supervision timeout */
+      if (ota_slot == APP_SLOTS_NONE) {
+        /* both slots are needed until the image on trial has been confirmed */
+        printf("image on trial, update refused\r\n");
+        att_err = APP_ATT_ERR_OTA_REFUSED;
+        break;
+      }
+      ota_image_position = 0;
+      ota_in_progress = 1;
+      ota_write_failed = false;
+      ota_direct_flash = ota_flash_begin();
+      ota_external_flash = !ota_direct_flash && ota_storage_begin(&ota_slot_address);
+      if (ota_direct_flash) {
+        appIdleUnregister(otaFlashIdle);
+        appIdleRegister(otaFlashIdle);
+      }
+      break;
+
+    case 3: /* END OTA process */
+      /* wait for connection close and then reboot */
+      ota_in_progress = 0;
+      printf("upload finished. received file size %u bytes\r\n", ota_image_position); flushLog();
+      if (ota_direct_flash) {
+        const appFlashStats_t *stats;
+
+        appIdleUnregister(otaFlashIdle);
+        if (appFlashFlush() != 0) {
+          ota_write_failed = true;
+        }
+        stats = appFlashGetStats();
+        printf("flash: %u pages, %u erased, %u errors, page us min/max/avg %u/%u/%u\r\n",
+               stats->pages, stats->erases, stats->errors, stats->minPageUs, stats->maxPageUs,
+               stats->pages ? (stats->totalUs / stats->pages) : 0); flushLog();
+        ota_direct_flash = false;
+      }
+      if (ota_external_flash) {
+        /* the bootloader reads the image with its own driver, the last page must be programmed */
+        if (appStorageSync() != 0) {
+          ota_write_failed = true;
+        }
+        ota_external_flash = false;
+      }
+      if (ota_write_failed) {
+        /* an incomplete image is not installed */
+        printf("upload failed, image incomplete\r\n"); flushLog();
+        att_err = APP_ATT_ERR_OTA_WRITE_FAILED;
+      } else {
+        ota_image_finished = 1;
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  gecko_cmd_gatt_server_send_user_write_response(pEvt->connection, gattdb_ota_control, att_err);
+}
+
+/***********************************************************************************************//**
+ * \brief  OTA Data write handler, bound in gatt_handlers.txt.
+ * @param[in] pEvt  User write request.
+ **************************************************************************************************/
+void appOtaDataWrite(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt)
+{
+  uint8_t att_err = 0;
+  int32_t err;
+
+  if (ota_in_progress) {
+    if (ota_write_failed) {
+      /* the image has a gap, nothing more is stored until the upload is restarted */
+      err = -1;
+    } else if (ota_direct_flash) {
+      err = appFlashWrite(ota_image_position, pEvt->value.data, pEvt->value.len);
+    } else if (ota_external_flash) {
+      err = appStorageWrite(ota_slot_address + ota_image_position, pEvt->value.data,
+                            pEvt->value.len);
+    } else {
+      err = bootloader_writeStorage(ota_slot, /* use the download slot */
+                                    ota_image_position,
+                                    (uint8_t *)pEvt->value.data,
+                                    pEvt->value.len);
+    }
+
+    /* all three return 0 on success */
+    if (err) {
+      if (!ota_write_failed) {
+        printf("image write failed at %u\r\n", ota_image_position); flushLog();
+      }
+      ota_write_failed = true;
+      att_err = APP_ATT_ERR_OTA_WRITE_FAILED;
+    } else {
+      ota_image_position += pEvt->value.len;
+    }
+  }
+
+  /* a completed page is committed by otaFlashIdle() once the stack has no events pending */
+  gecko_cmd_gatt_server_send_user_write_response(pEvt->connection, gattdb_ota_data, att_err);
+}
+
+/***********************************************************************************************//**
+ *  \brief  OTA statistics timer callback.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void otaTimerTick(void *arg)
+{
+  (void)arg;
+  ota_time_elapsed++;
+}
+
+/***********************************************************************************************//**
+ *  \brief  OTA idle hook, commits a completed page.
+ *  \details  Programming a page stalls the CPU for several milliseconds, so it is done when the
+ *  stack has no events pending rather than between them.
+ *  \return  false, app_flash.c keeps at most one page waiting
+ **************************************************************************************************/
+static bool otaFlashIdle(void)
+{
+  if (ota_direct_flash && (appFlashPoll() != 0)) {
+    ota_write_failed = true;
+  }
+  return false;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Drop an upload that will not be completed, so the next one starts from a clean state.
+ **************************************************************************************************/
+static void otaAbort(void)
+{
+  printf("upload aborted at %u bytes\r\n", ota_image_position);
+  if (ota_direct_flash) {
+    appIdleUnregister(otaFlashIdle);
+    appFlashAbort();
+  }
+  ota_direct_flash = false;
+  ota_external_flash = false;
+  ota_in_progress = 0;
+}
+
+/***********************************************************************************************//**
+ * \brief  Initialize the bootloader interface and erase the download area if it is not empty.
+ **************************************************************************************************/
+static void bootSlotCheck(void)
+{
+  /* bootloader init must be called before calling other bootloader_xxx API calls */
+  bootloader_init();
+
+  /* read slot information from bootloader */
+  if (get_slot_info() == BOOTLOADER_OK) {
+    appBootMark(APP_BOOT_BOOTLOADER);
+    storage_ok = appStorageInit();
+    /* the download area is erased here (if needed), prior to any connections are opened */
+    erase_slot_if_needed();
+    appBootMark(APP_BOOT_SLOT_SCAN);
+  } else {
+    printf("Check that you have installed correct type of Gecko bootloader!\r\n");
+  }
+
+  if (appSlotsGetState() == APP_SLOTS_TRIAL) {
+    appTimerStart(&health_timer, APP_HEALTH_CHECK_MS, 0, false, healthCheck, NULL);
+  }
+}
+
+/***********************************************************************************************//**
+ * \brief  Confirm an image on trial. By now it has booted, advertised and run its timers for
+ * APP_HEALTH_CHECK_MS without a reset, and it must still reach the storage holding the slots.
+ * \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void healthCheck(void *arg)
+{
+  uint32_t address;
+
+  (void)arg;
+
+  if (!storage_ok && ota_slots_external()) {
+    printf("external flash not responding, image not healthy\r\n");
+    appSlotsRollback();
+    return;
+  }
+
+  if (appSlotsConfirm() && (get_download_slot_info() == BOOTLOADER_OK)
+      && ota_storage_begin(&address)) {
+    /* the fallback slot is free now, the MX25 is erased in the background */
+    erase_slot_if_needed();
+  }
+}
+
+#if APP_BOOT_FAST_START
+/***********************************************************************************************//**
+ * \brief  Boot work deferred until advertising has started, one step per work item so the stack
+ * events queued in between are handled.
+ * \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void bootDeferredWork(void *arg)
+{
+  (void)arg;
+
+  switch (boot_work_step++) {
+    case 0:
+      appUiDisplayInit();
+      appWorkPost(&boot_work, APP_WORK_PRIO_LOW, bootDeferredWork, NULL);
+      break;
+
+    default:
+      bootSlotCheck();
+      appBootComplete();
+      break;
+  }
+}
+#endif
+
 /** @} (end addtogroup app) */
 /** @} (end addtogroup Application) */
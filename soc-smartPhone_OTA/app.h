@@ -52,13 +52,18 @@ extern "C" {
 #include <stdio.h>
 #endif
 
+/* The console (app_console.c) sends the log in the background and keeps the device out of EM2
+ * until it is out, so flushLog() does not need to wait. syncLog() waits for the output to
+ * complete, for use before a reset. */
 #if DEBUG_LEVEL
 #define initLog()     RETARGET_SerialInit()
-#define flushLog()    RETARGET_SerialFlush()
+#define flushLog()
+#define syncLog()     RETARGET_SerialFlush()
 #define printLog(...) printf(__VA_ARGS__)
 #else
 #define initLog()
 #define flushLog()
+#define syncLog()
 #define printLog(...)
 #endif
 
@@ -0,0 +1,154 @@
+/***************************************************************************//**
+ * @file
+ * @brief Boot profiler
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#include "native_gecko.h"
+
+/* em library */
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_rtcc.h"
+
+/* application specific headers */
+#include "app.h"
+
+/* Own header */
+#include "app_boot.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_boot
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+/** Boot record. */
+static appBootRecord_t appBootRecord;
+/** CPU cycle counter and core clock at the phases stamped before the RTCC was started. */
+static uint32_t appBootCycles[APP_BOOT_CLOCKS];
+static uint32_t appBootCoreClock[APP_BOOT_CLOCKS];
+/** RTCC has been started. */
+static bool appBootRtccRunning = false;
+/** Deferred boot work is done. */
+static bool appBootDone = false;
+
+/** Phase names for the boot report. */
+static const char * const appBootPhaseNames[APP_BOOT_PHASE_COUNT] = {
+  "main", "mcu", "board", "clocks", "app", "log", "stack", "boot event",
+  "bootloader", "slot scan", "display", "advertising", "done"
+};
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+void appBootStart(void)
+{
+  memset(&appBootRecord, 0, sizeof(appBootRecord));
+  appBootRecord.fastStart = APP_BOOT_FAST_START;
+
+  /* Cycle counter times the phases until the RTCC is running */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  appBootMark(APP_BOOT_MAIN);
+}
+
+void appBootMark(appBootPhase_t phase)
+{
+  if (appBootRecord.marked & (1UL << phase)) {
+    return;
+  }
+  appBootRecord.marked |= (1UL << phase);
+
+  if (appBootRtccRunning) {
+    appBootRecord.ticks[phase] = (int32_t)RTCC_CounterGet();
+  } else if (phase < APP_BOOT_CLOCKS) {
+    appBootCycles[phase] = DWT->CYCCNT;
+    appBootCoreClock[phase] = SystemCoreClockGet();
+  }
+}
+
+void appBootClockStarted(void)
+{
+  uint32_t cycles = DWT->CYCCNT;
+  uint32_t rtcc = RTCC_CounterGet();
+  int32_t ticks;
+  int32_t phase;
+
+  appBootRtccRunning = true;
+  appBootRecord.tickFreq = CMU_ClockFreqGet(cmuClock_RTCC);
+
+  /* Walk back from now. Each interval is converted at the core clock that was running at its
+   * start, the clock switch to the HFXO makes this approximate for the interval it falls into. */
+  ticks = (int32_t)rtcc;
+  for (phase = APP_BOOT_CLOCKS - 1; phase >= 0; phase--) {
+    if (!(appBootRecord.marked & (1UL << phase))) {
+      continue;
+    }
+    ticks -= (int32_t)(((uint64_t)(cycles - appBootCycles[phase]) * appBootRecord.tickFreq)
+                       / appBootCoreClock[phase]);
+    appBootRecord.ticks[phase] = ticks;
+    cycles = appBootCycles[phase];
+  }
+
+  appBootMark(APP_BOOT_CLOCKS);
+}
+
+bool appBootDeferring(void)
+{
+  return APP_BOOT_FAST_START && !appBootDone;
+}
+
+void appBootComplete(void)
+{
+  uint32_t phase;
+  int32_t us;
+
+  appBootDone = true;
+  appBootMark(APP_BOOT_DONE);
+
+  printLog("boot record (%s start), us from main:\r\n", appBootRecord.fastStart ? "fast" : "normal");
+  for (phase = 0; phase < APP_BOOT_PHASE_COUNT; phase++) {
+    if (appBootRecord.marked & (1UL << phase)) {
+      us = (int32_t)(((int64_t)(appBootRecord.ticks[phase] - appBootRecord.ticks[APP_BOOT_MAIN])
+                      * 1000000) / appBootRecord.tickFreq);
+      printLog("  %-12s %8ld\r\n", appBootPhaseNames[phase], (long)us);
+    }
+  }
+}
+
+const appBootRecord_t *appBootGetRecord(void)
+{
+  return &appBootRecord;
+}
+
+/** @} (end addtogroup app_boot) */
+/** @} (end addtogroup Application) */
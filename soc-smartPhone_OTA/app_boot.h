@@ -0,0 +1,130 @@
+/***************************************************************************//**
+ * @file
+ * @brief Boot profiler header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_BOOT_H
+#define APP_BOOT_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup app_boot Boot Profiler
+ * \brief Boot phase timestamps and the fast start sequence.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_boot
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Fast start. The HFXO and LFXO start up while the board is initialized, and the slot scan and
+ *  the display initialization are run from the work queue after advertising has started. */
+#ifndef APP_BOOT_FAST_START
+#define APP_BOOT_FAST_START           1
+#endif
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Boot phases, each is stamped when it has completed. */
+typedef enum {
+  APP_BOOT_MAIN = 0,        /**< main() entered. */
+  APP_BOOT_MCU,             /**< initMcu() done, with fast start the oscillators are still starting. */
+  APP_BOOT_BOARD,           /**< initBoard() done, LEDs and buttons follow before the clocks. */
+  APP_BOOT_CLOCKS,          /**< HFXO selected, LFXO running and RTCC started. */
+  APP_BOOT_APP,             /**< initApp() done. */
+  APP_BOOT_LOG,             /**< Log console initialized. */
+  APP_BOOT_STACK,           /**< gecko_init() done. */
+  APP_BOOT_EVENT,           /**< System boot event received. */
+  APP_BOOT_BOOTLOADER,      /**< bootloader_init() and the slot information read. */
+  APP_BOOT_SLOT_SCAN,       /**< Download slot checked and erased if needed. */
+  APP_BOOT_DISPLAY,         /**< Display initialized. */
+  APP_BOOT_ADVERTISING,     /**< Advertising started. */
+  APP_BOOT_DONE,            /**< All deferred boot work done. */
+  APP_BOOT_PHASE_COUNT
+} appBootPhase_t;
+
+/** Boot record. */
+typedef struct {
+  int32_t ticks[APP_BOOT_PHASE_COUNT];  /**< RTCC counter at the end of each phase. Phases before
+                                             the RTCC was started are derived from the CPU cycle
+                                             counter and are negative. */
+  uint32_t marked;                      /**< Bit mask of the phases that have been stamped. */
+  uint32_t tickFreq;                    /**< RTCC tick frequency in Hz. */
+  bool fastStart;                       /**< Boot used the fast start sequence. */
+} appBootRecord_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Start the profiler. To be called first thing in main().
+ **************************************************************************************************/
+void appBootStart(void);
+
+/***********************************************************************************************//**
+ *  \brief  Stamp the end of a boot phase. A phase is only stamped the first time.
+ *  \param[in]  phase  Phase.
+ **************************************************************************************************/
+void appBootMark(appBootPhase_t phase);
+
+/***********************************************************************************************//**
+ *  \brief  The RTCC has been started. Converts the earlier stamps to RTCC ticks and stamps
+ *  APP_BOOT_CLOCKS.
+ **************************************************************************************************/
+void appBootClockStarted(void);
+
+/***********************************************************************************************//**
+ *  \brief  Check whether non-critical boot work is still deferred.
+ *  \return  true until the deferred boot work is done when fast start is used
+ **************************************************************************************************/
+bool appBootDeferring(void);
+
+/***********************************************************************************************//**
+ *  \brief  All deferred boot work is done. Stamps APP_BOOT_DONE and prints the boot record.
+ **************************************************************************************************/
+void appBootComplete(void);
+
+/***********************************************************************************************//**
+ *  \brief  Get the boot record.
+ *  \return  Pointer to the boot record.
+ **************************************************************************************************/
+const appBootRecord_t *appBootGetRecord(void);
+
+/** @} (end addtogroup app_boot) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_BOOT_H */
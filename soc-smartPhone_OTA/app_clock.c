@@ -0,0 +1,237 @@
+/***************************************************************************//**
+ * @file
+ * @brief Calendar clock
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* em library */
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_rtcc.h"
+
+/* application specific headers */
+#include "app_timer.h"
+
+/* Own header */
+#include "app_clock.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_clock
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+
+/** Clock read period of the wrap timer in ms, well inside the 36 hour RTCC wrap. */
+#define APP_CLOCK_KEEPALIVE_MS        (3600UL * 1000UL)
+
+#define APP_CLOCK_SECONDS_PER_DAY     86400UL
+
+/** Days from 0000-03-01 to 1970-01-01 in the proleptic Gregorian calendar. */
+#define APP_CLOCK_EPOCH_DAYS          719468UL
+/** Days in a 400 year cycle. */
+#define APP_CLOCK_DAYS_PER_ERA        146097UL
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+/** RTCC frequency in Hz. */
+static uint32_t appClockFreq = 32768;
+/** RTCC count the clock was last brought up to date at. */
+static uint32_t appClockRtccRef = 0;
+/** Clock at appClockRtccRef, whole seconds and RTCC ticks into the second. */
+static uint32_t appClockSeconds = 0;
+static uint32_t appClockTicks = 0;
+/** Rate trim in ppb and the part of a tick carried over between updates, in ppb ticks. */
+static int32_t appClockTrimPpb = 0;
+static int32_t appClockTrimRem = 0;
+/** Uncorrected RTCC ticks since the clock was last set. */
+static uint64_t appClockRawSinceSet = 0;
+/** Clock has been set. */
+static bool appClockValid = false;
+/** Keeps the clock continuous across RTCC wraps. */
+static appTimer_t appClockTimer;
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+
+static void appClockUpdate(void);
+static void appClockKeepAlive(void *arg);
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+
+void appClockInit(void)
+{
+  appClockFreq = CMU_ClockFreqGet(cmuClock_RTCC);
+  appClockRtccRef = RTCC_CounterGet();
+  appClockSeconds = 0;
+  appClockTicks = 0;
+  appClockValid = false;
+}
+
+void appClockStart(void)
+{
+  appTimerStart(&appClockTimer, APP_CLOCK_KEEPALIVE_MS, APP_CLOCK_KEEPALIVE_MS / 2, true,
+                appClockKeepAlive, NULL);
+}
+
+uint32_t appClockGet(uint8_t *fractions256)
+{
+  appClockUpdate();
+
+  if (fractions256) {
+    *fractions256 = (uint8_t)(((uint64_t)appClockTicks << 8) / appClockFreq);
+  }
+  return appClockSeconds;
+}
+
+void appClockSet(uint32_t time, uint8_t fractions256)
+{
+  uint32_t ticks = (uint32_t)(((uint64_t)fractions256 * appClockFreq) >> 8);
+  int64_t error;
+  int64_t trim;
+
+  appClockUpdate();
+
+  /* The error against the new setting accumulated over the raw ticks since the last one, it is
+   * taken as drift of the LFXO if it is small enough */
+  if (appClockValid && (appClockRawSinceSet >= (uint64_t)APP_CLOCK_TRIM_MIN_S * appClockFreq)) {
+    error = ((int64_t)time - appClockSeconds) * appClockFreq + ((int64_t)ticks - appClockTicks);
+    trim = appClockTrimPpb + (error * 1000000000) / (int64_t)appClockRawSinceSet;
+    if ((trim >= -APP_CLOCK_TRIM_MAX_PPM * 1000L) && (trim <= APP_CLOCK_TRIM_MAX_PPM * 1000L)) {
+      appClockTrimPpb = (int32_t)trim;
+    }
+  }
+
+  appClockSeconds = time;
+  appClockTicks = ticks;
+  appClockTrimRem = 0;
+  appClockRawSinceSet = 0;
+  appClockValid = true;
+}
+
+bool appClockIsSet(void)
+{
+  return appClockValid;
+}
+
+void appClockToDateTime(uint32_t time, appClockDateTime_t *dateTime)
+{
+  uint32_t days = time / APP_CLOCK_SECONDS_PER_DAY;
+  uint32_t secs = time % APP_CLOCK_SECONDS_PER_DAY;
+  uint32_t z = days + APP_CLOCK_EPOCH_DAYS;
+  uint32_t era = z / APP_CLOCK_DAYS_PER_ERA;
+  uint32_t doe = z - era * APP_CLOCK_DAYS_PER_ERA;
+  uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  uint32_t mp = (5 * doy + 2) / 153;
+  uint32_t month = (mp < 10) ? (mp + 3) : (mp - 9);
+
+  /* days counted from March, so that the leap day is the last day of the year */
+  dateTime->year = (uint16_t)(yoe + era * 400 + (month <= 2));
+  dateTime->month = (uint8_t)month;
+  dateTime->day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+  dateTime->hours = (uint8_t)(secs / 3600);
+  dateTime->minutes = (uint8_t)((secs / 60) % 60);
+  dateTime->seconds = (uint8_t)(secs % 60);
+  /* 1970-01-01 was a Thursday */
+  dateTime->weekday = (uint8_t)((days + 3) % 7 + 1);
+}
+
+bool appClockFromDateTime(const appClockDateTime_t *dateTime, uint32_t *time)
+{
+  static const uint8_t monthDays[12] = { 31, 29, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+  uint32_t year = dateTime->year;
+  uint32_t month = dateTime->month;
+  uint32_t era;
+  uint32_t yoe;
+  uint32_t doy;
+  uint32_t doe;
+
+  if ((year < 1970) || (year > 2105) || (month < 1) || (month > 12) || (dateTime->day < 1)
+      || (dateTime->day > monthDays[month - 1]) || (dateTime->hours > 23)
+      || (dateTime->minutes > 59) || (dateTime->seconds > 59)) {
+    return false;
+  }
+  if ((month == 2) && (dateTime->day == 29)
+      && ((year % 4) || (!(year % 100) && (year % 400)))) {
+    return false;
+  }
+
+  year -= (month <= 2);
+  era = year / 400;
+  yoe = year - era * 400;
+  doy = (153 * ((month > 2) ? (month - 3) : (month + 9)) + 2) / 5 + dateTime->day - 1;
+  doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+  *time = (era * APP_CLOCK_DAYS_PER_ERA + doe - APP_CLOCK_EPOCH_DAYS) * APP_CLOCK_SECONDS_PER_DAY
+          + dateTime->hours * 3600UL + dateTime->minutes * 60UL + dateTime->seconds;
+  return true;
+}
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Bring the clock up to the current RTCC count, applying the rate trim.
+ *  \details  The counter delta is taken modulo 2^32, so the clock must be updated at least once per
+ *  RTCC wrap.
+ **************************************************************************************************/
+static void appClockUpdate(void)
+{
+  uint32_t raw = RTCC_CounterGet() - appClockRtccRef;
+  int64_t adjust;
+  uint64_t ticks;
+
+  appClockRtccRef += raw;
+  appClockRawSinceSet += raw;
+
+  /* the trim is applied in whole ticks, the remainder is carried so it does not drift itself */
+  adjust = (int64_t)raw * appClockTrimPpb + appClockTrimRem;
+  appClockTrimRem = (int32_t)(adjust % 1000000000);
+
+  ticks = (uint64_t)((int64_t)appClockTicks + raw + adjust / 1000000000);
+  appClockSeconds += (uint32_t)(ticks / appClockFreq);
+  appClockTicks = (uint32_t)(ticks % appClockFreq);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Wrap timer callback.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void appClockKeepAlive(void *arg)
+{
+  (void)arg;
+  appClockUpdate();
+}
+
+/** @} (end addtogroup app_clock) */
+/** @} (end addtogroup Application) */
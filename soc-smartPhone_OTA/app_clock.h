@@ -0,0 +1,135 @@
+/***************************************************************************//**
+ * @file
+ * @brief Calendar clock header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_CLOCK_H
+#define APP_CLOCK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup app_clock Calendar Clock
+ * \brief Wall clock time derived from the free running RTCC.
+ *
+ * The time is kept as a base time and the RTCC count it was taken at. Reading the clock converts
+ * the counter delta since then, nothing runs per tick. The clock counts seconds since 1970-01-01
+ * in the local time the peer set it to, as the Current Time Service defines it. Until it is set
+ * it counts from 0 at boot.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_clock
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Shortest time between two settings in seconds for the second one to trim the clock rate. */
+#ifndef APP_CLOCK_TRIM_MIN_S
+#define APP_CLOCK_TRIM_MIN_S          3600
+#endif
+
+/** Largest rate trim in ppm, a larger error is taken as a time change rather than drift. */
+#ifndef APP_CLOCK_TRIM_MAX_PPM
+#define APP_CLOCK_TRIM_MAX_PPM        200
+#endif
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Date and time, the Date Time characteristic fields plus the day of week. */
+typedef struct {
+  uint16_t year;    /**< Year, 1970 to 2105. */
+  uint8_t month;    /**< Month, 1 to 12. */
+  uint8_t day;      /**< Day of month, 1 to 31. */
+  uint8_t hours;    /**< Hours, 0 to 23. */
+  uint8_t minutes;  /**< Minutes, 0 to 59. */
+  uint8_t seconds;  /**< Seconds, 0 to 59. */
+  uint8_t weekday;  /**< Day of week, 1 is Monday and 7 is Sunday. */
+} appClockDateTime_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Start the clock at 0, called from initMcu() once the RTCC runs.
+ **************************************************************************************************/
+void appClockInit(void);
+
+/***********************************************************************************************//**
+ *  \brief  Start the timer that keeps the clock continuous across RTCC wraps.
+ *  \details  The RTCC count wraps every 36 hours, the clock has to be read more often than that.
+ **************************************************************************************************/
+void appClockStart(void);
+
+/***********************************************************************************************//**
+ *  \brief  Read the clock.
+ *  \param[out]  fractions256  Fraction of the second in 1/256 s, may be NULL.
+ *  \return  Seconds since 1970-01-01, or since boot if the clock has not been set.
+ **************************************************************************************************/
+uint32_t appClockGet(uint8_t *fractions256);
+
+/***********************************************************************************************//**
+ *  \brief  Set the clock. A setting long enough after the previous one also trims the clock rate
+ *  by the drift between them.
+ *  \param[in]  time  Seconds since 1970-01-01.
+ *  \param[in]  fractions256  Fraction of the second in 1/256 s.
+ **************************************************************************************************/
+void appClockSet(uint32_t time, uint8_t fractions256);
+
+/***********************************************************************************************//**
+ *  \brief  Check whether the clock has been set.
+ *  \return  true if the clock shows calendar time
+ **************************************************************************************************/
+bool appClockIsSet(void);
+
+/***********************************************************************************************//**
+ *  \brief  Convert seconds since 1970-01-01 to a date and time.
+ *  \param[in]  time  Seconds since 1970-01-01.
+ *  \param[out]  dateTime  Date and time.
+ **************************************************************************************************/
+void appClockToDateTime(uint32_t time, appClockDateTime_t *dateTime);
+
+/***********************************************************************************************//**
+ *  \brief  Convert a date and time to seconds since 1970-01-01. The day of week is ignored.
+ *  \param[in]  dateTime  Date and time.
+ *  \param[out]  time  Seconds since 1970-01-01.
+ *  \return  false if a field is out of range
+ **************************************************************************************************/
+bool appClockFromDateTime(const appClockDateTime_t *dateTime, uint32_t *time);
+
+/** @} (end addtogroup app_clock) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_CLOCK_H */
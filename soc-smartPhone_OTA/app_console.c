@@ -0,0 +1,484 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application console
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* The console replaces retargetserial.c, which is excluded from the build. It implements the same
+ * RETARGET_xxx interface, so printf() and the log macros in app.h are unchanged. Transmit data is
+ * queued in a ring that the LDMA drains to the USART. Receive data is written by the LDMA into a
+ * ring made of two linked descriptors that reload each other, so reception never stops for the CPU
+ * and is not lost while the flash is being programmed. */
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/* em library */
+#include "em_device.h"
+#include "em_bus.h"
+#include "em_cmu.h"
+#include "em_core.h"
+#include "em_gpio.h"
+#include "em_usart.h"
+
+/* emdrv */
+#include "sleep.h"
+
+/* kit drivers */
+#include "retargetserial.h"
+#include "retargetserialhalconfig.h"
+
+/* application specific headers */
+#include "app_work.h"
+
+/* Own header */
+#include "app_console.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_console
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+
+#if !defined(RETARGET_USART)
+#error "The LDMA console supports USART ports only"
+#endif
+
+#if (RETARGET_UART_INDEX == 0)
+#define APP_CONSOLE_REQSEL_TX         (LDMA_CH_REQSEL_SOURCESEL_USART0 | LDMA_CH_REQSEL_SIGSEL_USART0TXBL)
+#define APP_CONSOLE_REQSEL_RX         (LDMA_CH_REQSEL_SOURCESEL_USART0 | LDMA_CH_REQSEL_SIGSEL_USART0RXDATAV)
+#elif (RETARGET_UART_INDEX == 1)
+#define APP_CONSOLE_REQSEL_TX         (LDMA_CH_REQSEL_SOURCESEL_USART1 | LDMA_CH_REQSEL_SIGSEL_USART1TXBL)
+#define APP_CONSOLE_REQSEL_RX         (LDMA_CH_REQSEL_SOURCESEL_USART1 | LDMA_CH_REQSEL_SIGSEL_USART1RXDATAV)
+#else
+#error "No LDMA request defined for the console USART"
+#endif
+
+#define APP_CONSOLE_TX_MASK           (1UL << APP_CONSOLE_TX_DMA_CH)
+#define APP_CONSOLE_RX_MASK           (1UL << APP_CONSOLE_RX_DMA_CH)
+#define APP_CONSOLE_RX_HALF           (APP_CONSOLE_RX_BUF_SIZE / 2)
+/** Longest single LDMA transfer. */
+#define APP_CONSOLE_DMA_MAX_XFER      ((_LDMA_CH_CTRL_XFERCNT_MASK >> _LDMA_CH_CTRL_XFERCNT_SHIFT) + 1)
+
+/** Byte wide transfer, one byte per request. */
+#define APP_CONSOLE_DMA_CTRL          (LDMA_CH_CTRL_STRUCTTYPE_TRANSFER \
+                                       | LDMA_CH_CTRL_BLOCKSIZE_UNIT1   \
+                                       | LDMA_CH_CTRL_DONEIFSEN         \
+                                       | LDMA_CH_CTRL_REQMODE_BLOCK     \
+                                       | LDMA_CH_CTRL_SIZE_BYTE)
+#define APP_CONSOLE_DMA_XFERCNT(n)    ((((uint32_t)(n)) - 1) << _LDMA_CH_CTRL_XFERCNT_SHIFT)
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+/** Transmit ring. Head is written by the application, tail is advanced when a transfer is done. */
+static uint8_t appConsoleTxBuf[APP_CONSOLE_TX_BUF_SIZE];
+static volatile uint32_t appConsoleTxHead = 0;
+static volatile uint32_t appConsoleTxTail = 0;
+/** Length of the transfer in progress, 0 if the channel is idle. */
+static volatile uint32_t appConsoleTxLen = 0;
+
+/** Receive ring and its two linked descriptors. */
+static uint8_t appConsoleRxBuf[APP_CONSOLE_RX_BUF_SIZE];
+static DMA_DESCRIPTOR_TypeDef appConsoleRxDesc[2];
+/** Number of receive halves completed by the LDMA. */
+static volatile uint32_t appConsoleRxHalves = 0;
+/** Total number of bytes consumed from the receive ring. */
+static uint32_t appConsoleRxTail = 0;
+
+static appConsoleRxCback_t appConsoleRxCback = NULL;
+static appWork_t appConsoleRxWork;
+
+static bool appConsoleLfToCrLf = false;
+static bool appConsoleInitialized = false;
+static appConsoleStats_t appConsoleStats;
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+static void appConsoleTxStart(void);
+static void appConsoleTxDone(void);
+static void appConsoleTxPut(uint8_t c);
+static uint32_t appConsoleRxWritten(void);
+static void appConsoleRxIdleWork(void *arg);
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+void appConsoleSetRxCback(appConsoleRxCback_t cback)
+{
+  appConsoleRxCback = cback;
+}
+
+uint32_t appConsoleRxAvailable(void)
+{
+  uint32_t available;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  available = appConsoleRxWritten() - appConsoleRxTail;
+  CORE_EXIT_ATOMIC();
+
+  return available;
+}
+
+const appConsoleStats_t *appConsoleGetStats(void)
+{
+  return &appConsoleStats;
+}
+
+/***************************************************************************************************
+ * Retarget Interface
+ **************************************************************************************************/
+void RETARGET_SerialInit(void)
+{
+  USART_TypeDef *usart = RETARGET_UART;
+  USART_InitAsync_TypeDef init = USART_INITASYNC_DEFAULT;
+  LDMA_CH_TypeDef *rxCh = &LDMA->CH[APP_CONSOLE_RX_DMA_CH];
+  uint8_t i;
+
+  /* Enable peripheral clocks */
+  CMU_ClockEnable(cmuClock_HFPER, true);
+  CMU_ClockEnable(cmuClock_GPIO, true);
+  CMU_ClockEnable(cmuClock_LDMA, true);
+  CMU_ClockEnable(RETARGET_CLK, true);
+
+  /* To avoid false start, configure output as high */
+  GPIO_PinModeSet(RETARGET_TXPORT, RETARGET_TXPIN, gpioModePushPull, 1);
+  GPIO_PinModeSet(RETARGET_RXPORT, RETARGET_RXPIN, gpioModeInputPull, 1);
+
+  /* Enable DK RS232/UART switch */
+  RETARGET_PERIPHERAL_ENABLE();
+
+  /* Configure USART for basic async operation */
+  init.enable = usartDisable;
+  USART_InitAsync(usart, &init);
+
+  usart->ROUTEPEN = USART_ROUTEPEN_RXPEN | USART_ROUTEPEN_TXPEN;
+  usart->ROUTELOC0 = (usart->ROUTELOC0
+                      & ~(_USART_ROUTELOC0_TXLOC_MASK
+                          | _USART_ROUTELOC0_RXLOC_MASK) )
+                     | (RETARGET_TX_LOCATION << _USART_ROUTELOC0_TXLOC_SHIFT)
+                     | (RETARGET_RX_LOCATION << _USART_ROUTELOC0_RXLOC_SHIFT);
+
+  /* The timer starts when a frame ends and stops when the next one starts, so the compare fires
+   * once the line has been idle for APP_CONSOLE_RX_IDLE_BITS bit periods */
+  usart->TIMECMP1 = (APP_CONSOLE_RX_IDLE_BITS << _USART_TIMECMP1_TCMPVAL_SHIFT)
+                    | USART_TIMECMP1_TSTART_RXEOF
+                    | USART_TIMECMP1_TSTOP_RXACT;
+  USART_IntClear(usart, USART_IF_TCMP1);
+  USART_IntEnable(usart, USART_IF_TCMP1);
+  NVIC_ClearPendingIRQ(RETARGET_IRQn);
+  NVIC_EnableIRQ(RETARGET_IRQn);
+
+  /* Receive descriptors, each fills one half of the ring and then loads the other one */
+  for (i = 0; i < 2; i++) {
+    appConsoleRxDesc[i].CTRL = APP_CONSOLE_DMA_CTRL
+                               | APP_CONSOLE_DMA_XFERCNT(APP_CONSOLE_RX_HALF)
+                               | LDMA_CH_CTRL_SRCINC_NONE
+                               | LDMA_CH_CTRL_DSTINC_ONE;
+    appConsoleRxDesc[i].SRC = (void *)&usart->RXDATA;
+    appConsoleRxDesc[i].DST = &appConsoleRxBuf[i * APP_CONSOLE_RX_HALF];
+    appConsoleRxDesc[i].LINK = (void *)(((uint32_t)&appConsoleRxDesc[i ^ 1] & _LDMA_CH_LINK_LINKADDR_MASK)
+                                        | LDMA_CH_LINK_LINK);
+  }
+
+  LDMA->IFC = APP_CONSOLE_TX_MASK | APP_CONSOLE_RX_MASK;
+  LDMA->IEN |= APP_CONSOLE_TX_MASK | APP_CONSOLE_RX_MASK;
+  NVIC_ClearPendingIRQ(LDMA_IRQn);
+  NVIC_EnableIRQ(LDMA_IRQn);
+
+  LDMA->CH[APP_CONSOLE_TX_DMA_CH].REQSEL = APP_CONSOLE_REQSEL_TX;
+  LDMA->CH[APP_CONSOLE_TX_DMA_CH].CFG = 0;
+  LDMA->CH[APP_CONSOLE_TX_DMA_CH].LOOP = 0;
+
+  rxCh->REQSEL = APP_CONSOLE_REQSEL_RX;
+  rxCh->CFG = 0;
+  rxCh->LOOP = 0;
+  rxCh->LINK = (uint32_t)&appConsoleRxDesc[0] & _LDMA_CH_LINK_LINKADDR_MASK;
+  /* Loading the link enables the channel. CHEN is read/write, a plain write would disable the
+   * channels of the other LDMA users. */
+  LDMA->LINKLOAD = APP_CONSOLE_RX_MASK;
+
+  /* Finally enable it */
+  USART_Enable(usart, usartEnable);
+
+#if !defined(__CROSSWORKS_ARM) && defined(__GNUC__)
+  setvbuf(stdout, NULL, _IONBF, 0);   /*Set unbuffered mode for stdout (newlib)*/
+#endif
+
+  appConsoleInitialized = true;
+}
+
+void RETARGET_SerialCrLf(int on)
+{
+  appConsoleLfToCrLf = (on != 0);
+}
+
+int RETARGET_ReadChar(void)
+{
+  int c = -1;
+  uint32_t written;
+  CORE_DECLARE_IRQ_STATE;
+
+  if (appConsoleInitialized == false) {
+    RETARGET_SerialInit();
+  }
+
+  CORE_ENTER_ATOMIC();
+  written = appConsoleRxWritten();
+
+  /* The LDMA has lapped the reader, skip to the oldest half that is still intact */
+  if ((written - appConsoleRxTail) > APP_CONSOLE_RX_BUF_SIZE) {
+    appConsoleStats.rxOverruns += written - APP_CONSOLE_RX_HALF - appConsoleRxTail;
+    appConsoleRxTail = written - APP_CONSOLE_RX_HALF;
+  }
+
+  if (written != appConsoleRxTail) {
+    c = appConsoleRxBuf[appConsoleRxTail % APP_CONSOLE_RX_BUF_SIZE];
+    appConsoleRxTail++;
+    appConsoleStats.rxBytes++;
+  }
+  CORE_EXIT_ATOMIC();
+
+  return c;
+}
+
+int RETARGET_WriteChar(char c)
+{
+  if (appConsoleInitialized == false) {
+    RETARGET_SerialInit();
+  }
+
+  /* Add CR or LF to CRLF if enabled */
+  if (appConsoleLfToCrLf && (c == '\n')) {
+    appConsoleTxPut('\r');
+  }
+  appConsoleTxPut(c);
+
+  return c;
+}
+
+bool RETARGET_SerialEnableFlowControl(void)
+{
+#if defined(_USART_ROUTEPEN_CTSPEN_MASK) \
+  && defined(RETARGET_CTSPORT)           \
+  && defined(RETARGET_RTSPORT)
+  GPIO_PinModeSet(RETARGET_CTSPORT, RETARGET_CTSPIN, gpioModeInputPull, 0);
+  GPIO_PinModeSet(RETARGET_RTSPORT, RETARGET_RTSPIN, gpioModePushPull, 0);
+  RETARGET_UART->ROUTELOC1 = (RETARGET_CTS_LOCATION << _USART_ROUTELOC1_CTSLOC_SHIFT)
+                             | (RETARGET_RTS_LOCATION << _USART_ROUTELOC1_RTSLOC_SHIFT);
+  RETARGET_UART->ROUTEPEN |= (USART_ROUTEPEN_CTSPEN | USART_ROUTEPEN_RTSPEN);
+  RETARGET_UART->CTRLX    |= USART_CTRLX_CTSEN;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void RETARGET_SerialFlush(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if (appConsoleInitialized == false) {
+    return;
+  }
+
+  /* Poll the transfers to completion, this also works with interrupts masked */
+  while (appConsoleTxHead != appConsoleTxTail) {
+    CORE_ENTER_ATOMIC();
+    if (LDMA->IF & APP_CONSOLE_TX_MASK) {
+      appConsoleTxDone();
+    }
+    CORE_EXIT_ATOMIC();
+  }
+
+  while (!(RETARGET_UART->STATUS & USART_STATUS_TXC)) ;
+}
+
+/***************************************************************************************************
+ * Interrupt Handlers
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  LDMA interrupt, transfer done on the console channels.
+ **************************************************************************************************/
+void LDMA_IRQHandler(void)
+{
+  uint32_t pending = LDMA->IF & LDMA->IEN;
+
+  if (pending & APP_CONSOLE_RX_MASK) {
+    LDMA->IFC = APP_CONSOLE_RX_MASK;
+    appConsoleRxHalves++;
+  }
+  if (pending & APP_CONSOLE_TX_MASK) {
+    appConsoleTxDone();
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  USART receive interrupt, receive line idle.
+ **************************************************************************************************/
+void RETARGET_IRQ_NAME(void)
+{
+  if (RETARGET_UART->IF & USART_IF_TCMP1) {
+    USART_IntClear(RETARGET_UART, USART_IF_TCMP1);
+    appConsoleStats.rxIdles++;
+    if (appConsoleRxCback) {
+      appWorkPost(&appConsoleRxWork, APP_WORK_PRIO_NORMAL, appConsoleRxIdleWork, NULL);
+    }
+  }
+}
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Start a transfer of the queued data, if the channel is idle. Called with interrupts
+ *  masked.
+ *  \details  A transfer covers the contiguous part of the ring up to its end, the rest goes in the
+ *  next transfer. EM2 is blocked while a transfer is in progress, since the USART stops there.
+ **************************************************************************************************/
+static void appConsoleTxStart(void)
+{
+  LDMA_CH_TypeDef *ch = &LDMA->CH[APP_CONSOLE_TX_DMA_CH];
+  uint32_t tail = appConsoleTxTail % APP_CONSOLE_TX_BUF_SIZE;
+  uint32_t len = appConsoleTxHead - appConsoleTxTail;
+
+  if (appConsoleTxLen || (0 == len)) {
+    return;
+  }
+
+  if (len > (APP_CONSOLE_TX_BUF_SIZE - tail)) {
+    len = APP_CONSOLE_TX_BUF_SIZE - tail;
+  }
+  if (len > APP_CONSOLE_DMA_MAX_XFER) {
+    len = APP_CONSOLE_DMA_MAX_XFER;
+  }
+
+  ch->CTRL = APP_CONSOLE_DMA_CTRL
+             | APP_CONSOLE_DMA_XFERCNT(len)
+             | LDMA_CH_CTRL_SRCINC_ONE
+             | LDMA_CH_CTRL_DSTINC_NONE;
+  ch->SRC = (uint32_t)&appConsoleTxBuf[tail];
+  ch->DST = (uint32_t)&RETARGET_UART->TXDATA;
+  ch->LINK = 0;
+
+  appConsoleTxLen = len;
+  SLEEP_SleepBlockBegin(sleepEM2);
+  BUS_RegMaskedSet(&LDMA->CHEN, APP_CONSOLE_TX_MASK);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Retire the completed transfer and start the next one. Called with interrupts masked.
+ **************************************************************************************************/
+static void appConsoleTxDone(void)
+{
+  LDMA->IFC = APP_CONSOLE_TX_MASK;
+
+  if (appConsoleTxLen) {
+    appConsoleTxTail += appConsoleTxLen;
+    appConsoleTxLen = 0;
+    SLEEP_SleepBlockEnd(sleepEM2);
+  }
+  appConsoleTxStart();
+}
+
+/***********************************************************************************************//**
+ *  \brief  Queue one byte for transmission.
+ *  \details  If the ring is full the caller waits for the running transfer. The done flag is
+ *  polled, so this also works from interrupt context or with interrupts masked.
+ *  \param[in]  c  Byte to send.
+ **************************************************************************************************/
+static void appConsoleTxPut(uint8_t c)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if ((appConsoleTxHead - appConsoleTxTail) == APP_CONSOLE_TX_BUF_SIZE) {
+    appConsoleStats.txStalls++;
+    while ((appConsoleTxHead - appConsoleTxTail) == APP_CONSOLE_TX_BUF_SIZE) {
+      if (LDMA->IF & APP_CONSOLE_TX_MASK) {
+        appConsoleTxDone();
+      }
+    }
+  }
+
+  appConsoleTxBuf[appConsoleTxHead % APP_CONSOLE_TX_BUF_SIZE] = c;
+  appConsoleTxHead++;
+  appConsoleStats.txBytes++;
+
+  appConsoleTxStart();
+  CORE_EXIT_ATOMIC();
+}
+
+/***********************************************************************************************//**
+ *  \brief  Total number of bytes the LDMA has written to the receive ring. Called with interrupts
+ *  masked.
+ *  \return  Byte count.
+ **************************************************************************************************/
+static uint32_t appConsoleRxWritten(void)
+{
+  uint32_t halves = appConsoleRxHalves;
+  uint32_t pending;
+  uint32_t dst;
+  uint32_t offset;
+
+  /* The LDMA keeps running with interrupts masked. A half that completes between reading the
+   * flag and the address would make the count one half short, so both are read until the flag is
+   * the same before and after the address. */
+  do {
+    pending = LDMA->IF & APP_CONSOLE_RX_MASK;
+    dst = LDMA->CH[APP_CONSOLE_RX_DMA_CH].DST;
+  } while (pending != (LDMA->IF & APP_CONSOLE_RX_MASK));
+
+  /* A half may have completed without the interrupt having been served yet */
+  if (pending) {
+    halves++;
+  }
+
+  /* Offset into the active half. At the end of a half the address is one past it, which wraps to
+   * the start of the next half, matching the count above. */
+  offset = (dst - (uint32_t)appConsoleRxBuf) % APP_CONSOLE_RX_HALF;
+
+  return (halves * APP_CONSOLE_RX_HALF) + offset;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Receive idle work item, runs the application callback.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void appConsoleRxIdleWork(void *arg)
+{
+  (void)arg;
+  if (appConsoleRxCback) {
+    appConsoleRxCback();
+  }
+}
+
+/** @} (end addtogroup app_console) */
+/** @} (end addtogroup Application) */
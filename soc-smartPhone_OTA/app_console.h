@@ -0,0 +1,110 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application console header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_CONSOLE_H
+#define APP_CONSOLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup app_console Application Console
+ * \brief LDMA driven serial console behind the retarget (printf) interface.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_console
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Size of the transmit ring, power of two. */
+#ifndef APP_CONSOLE_TX_BUF_SIZE
+#define APP_CONSOLE_TX_BUF_SIZE       512
+#endif
+
+/** Size of the receive ring, power of two. It is filled by the LDMA as two halves. */
+#ifndef APP_CONSOLE_RX_BUF_SIZE
+#define APP_CONSOLE_RX_BUF_SIZE       128
+#endif
+
+/* The LDMA channels APP_CONSOLE_TX_DMA_CH and APP_CONSOLE_RX_DMA_CH are allocated with all other
+ * channels in hal-config-app-common.h. */
+
+/** Receive line idle time, in bit periods, after which the idle callback is run. */
+#ifndef APP_CONSOLE_RX_IDLE_BITS
+#define APP_CONSOLE_RX_IDLE_BITS      20
+#endif
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Receive idle callback, run from the work queue. */
+typedef void (*appConsoleRxCback_t)(void);
+
+/** Console statistics. */
+typedef struct {
+  uint32_t txBytes;       /**< Number of bytes queued for transmission. */
+  uint32_t txStalls;      /**< Number of writes that had to wait for room in the transmit ring. */
+  uint32_t rxBytes;       /**< Number of bytes read. */
+  uint32_t rxOverruns;    /**< Number of bytes lost because the receive ring was not read in time. */
+  uint32_t rxIdles;       /**< Number of receive idle line events. */
+} appConsoleStats_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Set the callback run when the receive line goes idle after data.
+ *  \param[in]  cback  Callback, or NULL.
+ **************************************************************************************************/
+void appConsoleSetRxCback(appConsoleRxCback_t cback);
+
+/***********************************************************************************************//**
+ *  \brief  Number of received bytes waiting to be read.
+ *  \return  Byte count.
+ **************************************************************************************************/
+uint32_t appConsoleRxAvailable(void);
+
+/***********************************************************************************************//**
+ *  \brief  Get the console statistics.
+ *  \return  Pointer to the statistics.
+ **************************************************************************************************/
+const appConsoleStats_t *appConsoleGetStats(void);
+
+/** @} (end addtogroup app_console) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_CONSOLE_H */
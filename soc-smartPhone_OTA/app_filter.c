@@ -0,0 +1,92 @@
+/***************************************************************************//**
+ * @file
+ * @brief Decimating filter
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* Own header */
+#include "app_filter.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_filter
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+
+void appFilterCicInit(appFilterCic_t *filter, uint8_t ratio)
+{
+  uint8_t log2Ratio = 0;
+
+  memset(filter, 0, sizeof(*filter));
+
+  if (ratio > APP_FILTER_CIC_MAX_RATIO) {
+    ratio = APP_FILTER_CIC_MAX_RATIO;
+  }
+  while ((2U << log2Ratio) <= ratio) {
+    log2Ratio++;
+  }
+
+  filter->ratio = (uint8_t)(1U << log2Ratio);
+  filter->shift = (uint8_t)(log2Ratio * APP_FILTER_CIC_ORDER);
+  filter->warmup = APP_FILTER_CIC_ORDER;
+}
+
+bool appFilterCicPut(appFilterCic_t *filter, int32_t sample, int32_t *output)
+{
+  uint32_t acc = (uint32_t)sample;
+  uint32_t delayed;
+  uint8_t i;
+
+  /* integrators run at the input rate */
+  for (i = 0; i < APP_FILTER_CIC_ORDER; i++) {
+    filter->integ[i] += acc;
+    acc = filter->integ[i];
+  }
+
+  if (++filter->count < filter->ratio) {
+    return false;
+  }
+  filter->count = 0;
+
+  /* combs run at the output rate, the differences are exact in spite of the integrator wrap */
+  for (i = 0; i < APP_FILTER_CIC_ORDER; i++) {
+    delayed = filter->comb[i];
+    filter->comb[i] = acc;
+    acc -= delayed;
+  }
+
+  if (filter->warmup) {
+    filter->warmup--;
+    return false;
+  }
+
+  *output = (int32_t)acc >> filter->shift;
+  return true;
+}
+
+/** @} (end addtogroup app_filter) */
+/** @} (end addtogroup Application) */
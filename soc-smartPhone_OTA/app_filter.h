@@ -0,0 +1,102 @@
+/***************************************************************************//**
+ * @file
+ * @brief Decimating filter header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_FILTER_H
+#define APP_FILTER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup app_filter Decimating Filter
+ * \brief Integer CIC decimator for sensor sample streams.
+ *
+ * A cascaded integrator-comb filter averages APP_FILTER_CIC_ORDER times over the decimation
+ * ratio and outputs one sample per ratio input samples. It needs one add per stage per input and
+ * one subtract per stage per output, no multiplies and no coefficient tables. The integrators
+ * wrap modulo 2^32, the combs undo the wrap as long as the gain, ratio^order, times the input
+ * range fits in 32 bits.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_filter
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Number of integrator and comb stages. */
+#define APP_FILTER_CIC_ORDER          2
+
+/** Largest decimation ratio. */
+#define APP_FILTER_CIC_MAX_RATIO      128
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** CIC decimator state. */
+typedef struct {
+  uint32_t integ[APP_FILTER_CIC_ORDER]; /**< Integrator sums, wrapping. */
+  uint32_t comb[APP_FILTER_CIC_ORDER];  /**< Comb delay elements. */
+  uint8_t ratio;                        /**< Decimation ratio, a power of 2. */
+  uint8_t shift;                        /**< Gain of ratio^order as a shift. */
+  uint8_t count;                        /**< Input samples since the last output. */
+  uint8_t warmup;                       /**< Outputs still to drop while the combs fill. */
+} appFilterCic_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Reset a CIC decimator.
+ *  \param[out]  filter  Decimator.
+ *  \param[in]  ratio  Decimation ratio, a power of 2 up to APP_FILTER_CIC_MAX_RATIO.
+ **************************************************************************************************/
+void appFilterCicInit(appFilterCic_t *filter, uint8_t ratio);
+
+/***********************************************************************************************//**
+ *  \brief  Feed one sample to a CIC decimator.
+ *  \details  The first APP_FILTER_CIC_ORDER outputs after a reset are dropped, they would be
+ *  pulled towards 0 by the empty filter.
+ *  \param[in,out]  filter  Decimator.
+ *  \param[in]  sample  Input sample.
+ *  \param[out]  output  Filtered sample at the decimated rate.
+ *  \return  true if output was written
+ **************************************************************************************************/
+bool appFilterCicPut(appFilterCic_t *filter, int32_t sample, int32_t *output);
+
+/** @} (end addtogroup app_filter) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_FILTER_H */
@@ -0,0 +1,339 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application flash programmer
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* em library */
+#include "em_device.h"
+#include "em_msc.h"
+#include "em_ramfunc.h"
+
+/* Own header */
+#include "app_flash.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_flash
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+
+/** Number of 32-bit words in a flash page. */
+#define APP_FLASH_PAGE_WORDS          (FLASH_PAGE_SIZE / sizeof(uint32_t))
+/** Marks a page buffer that holds no data. */
+#define APP_FLASH_NO_PAGE             0xFFFFFFFFUL
+/** Value of an erased flash word. */
+#define APP_FLASH_ERASED_WORD         0xFFFFFFFFUL
+
+/***************************************************************************************************
+ * Local Type Definitions
+ **************************************************************************************************/
+
+/** Page buffer. Only the words in [firstWord, endWord) have been written by the caller, the rest
+ *  are kept at the erased value. */
+typedef struct {
+  uint32_t data[APP_FLASH_PAGE_WORDS];  /**< Page contents. */
+  uint32_t address;                     /**< Flash address of the page. */
+  uint16_t firstWord;                   /**< First word written. */
+  uint16_t endWord;                     /**< One past the last word written. */
+  bool queued;                          /**< Page is full and waiting to be committed. */
+} appFlashPage_t;
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+/** Double buffered page storage. */
+static appFlashPage_t appFlashPages[2];
+/** Index of the page buffer currently being filled. */
+static uint8_t appFlashFill = 0;
+/** Open region. */
+static uint32_t appFlashBase = 0;
+static uint32_t appFlashLength = 0;
+/** Programming statistics. */
+static appFlashStats_t appFlashStats;
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+static void appFlashPageOpen(appFlashPage_t *page, uint32_t address);
+static int32_t appFlashQueue(void);
+static int32_t appFlashCommit(appFlashPage_t *page);
+static bool appFlashIsBlank(const uint32_t *address, uint32_t numWords);
+SL_RAMFUNC_DECLARATOR static MSC_Status_TypeDef appFlashProgram(uint32_t *address,
+                                                                const uint32_t *data,
+                                                                uint32_t numWords);
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+bool appFlashBegin(uint32_t baseAddress, uint32_t length)
+{
+  if ((baseAddress & (FLASH_PAGE_SIZE - 1)) || (baseAddress + length > FLASH_BASE + FLASH_SIZE)) {
+    appFlashLength = 0;
+    return false;
+  }
+
+  appFlashBase = baseAddress;
+  appFlashLength = length;
+  appFlashFill = 0;
+  appFlashPages[0].address = APP_FLASH_NO_PAGE;
+  appFlashPages[0].queued = false;
+  appFlashPages[1].address = APP_FLASH_NO_PAGE;
+  appFlashPages[1].queued = false;
+
+  memset(&appFlashStats, 0, sizeof(appFlashStats));
+  appFlashStats.minPageUs = UINT32_MAX;
+
+  /* Cycle counter is used for timing the page commits */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  MSC_Init();
+
+  return true;
+}
+
+int32_t appFlashWrite(uint32_t offset, const uint8_t *data, uint32_t len)
+{
+  int32_t status = mscReturnOk;
+
+  if ((offset + len) > appFlashLength) {
+    return mscReturnInvalidAddr;
+  }
+
+  while (len && (mscReturnOk == status)) {
+    uint32_t address = appFlashBase + offset;
+    uint32_t pageAddress = address & ~(FLASH_PAGE_SIZE - 1);
+    uint32_t pageOffset = address - pageAddress;
+    uint32_t chunk = FLASH_PAGE_SIZE - pageOffset;
+    appFlashPage_t *page = &appFlashPages[appFlashFill];
+
+    if (chunk > len) {
+      chunk = len;
+    }
+
+    /* Data for a different page, hand over the current one and start filling the other buffer */
+    if (page->address != pageAddress) {
+      if (page->address != APP_FLASH_NO_PAGE) {
+        status = appFlashQueue();
+        page = &appFlashPages[appFlashFill];
+      }
+      appFlashPageOpen(page, pageAddress);
+    }
+
+    memcpy((uint8_t *)page->data + pageOffset, data, chunk);
+    if (page->firstWord > (pageOffset / sizeof(uint32_t))) {
+      page->firstWord = pageOffset / sizeof(uint32_t);
+    }
+    if (page->endWord < ((pageOffset + chunk + 3) / sizeof(uint32_t))) {
+      page->endWord = (pageOffset + chunk + 3) / sizeof(uint32_t);
+    }
+
+    /* Page complete */
+    if ((pageOffset + chunk) == FLASH_PAGE_SIZE && (mscReturnOk == status)) {
+      status = appFlashQueue();
+    }
+
+    offset += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+
+  return status;
+}
+
+int32_t appFlashPoll(void)
+{
+  appFlashPage_t *page = &appFlashPages[appFlashFill ^ 1];
+
+  if (page->queued) {
+    return appFlashCommit(page);
+  }
+  return mscReturnOk;
+}
+
+int32_t appFlashFlush(void)
+{
+  int32_t status = appFlashPoll();
+  appFlashPage_t *page = &appFlashPages[appFlashFill];
+
+  if ((mscReturnOk == status) && (page->address != APP_FLASH_NO_PAGE)) {
+    status = appFlashCommit(page);
+  }
+
+  MSC_Deinit();
+
+  return status;
+}
+
+void appFlashAbort(void)
+{
+  appFlashPages[0].address = APP_FLASH_NO_PAGE;
+  appFlashPages[0].queued = false;
+  appFlashPages[1].address = APP_FLASH_NO_PAGE;
+  appFlashPages[1].queued = false;
+  appFlashLength = 0;
+
+  MSC_Deinit();
+}
+
+const appFlashStats_t *appFlashGetStats(void)
+{
+  return &appFlashStats;
+}
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Prepare an empty page buffer for the given flash page.
+ *  \param[in]  page  Page buffer.
+ *  \param[in]  address  Flash address of the page.
+ **************************************************************************************************/
+static void appFlashPageOpen(appFlashPage_t *page, uint32_t address)
+{
+  memset(page->data, 0xFF, sizeof(page->data));
+  page->address = address;
+  page->firstWord = APP_FLASH_PAGE_WORDS;
+  page->endWord = 0;
+  page->queued = false;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Queue the page being filled and switch to the other buffer.
+ *  \details  If the other buffer has not been committed yet it is committed now, so at most one
+ *  page is ever waiting.
+ *  \return  0 on success, otherwise a MSC_Status_TypeDef error code
+ **************************************************************************************************/
+static int32_t appFlashQueue(void)
+{
+  int32_t status = mscReturnOk;
+
+  appFlashPages[appFlashFill].queued = true;
+  appFlashFill ^= 1;
+
+  if (appFlashPages[appFlashFill].queued) {
+    status = appFlashCommit(&appFlashPages[appFlashFill]);
+  }
+
+  return status;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Program a page buffer to flash, erasing the page first if the target words are not blank.
+ *  \param[in]  page  Page buffer.
+ *  \return  0 on success, otherwise a MSC_Status_TypeDef error code
+ **************************************************************************************************/
+static int32_t appFlashCommit(appFlashPage_t *page)
+{
+  MSC_Status_TypeDef status = mscReturnOk;
+  uint32_t *dst = (uint32_t *)page->address + page->firstWord;
+  uint32_t numWords = page->endWord - page->firstWord;
+  uint32_t start = DWT->CYCCNT;
+  uint32_t us;
+
+  if (numWords && !appFlashIsBlank(dst, numWords)) {
+    status = MSC_ErasePage((uint32_t *)page->address);
+    appFlashStats.erases++;
+  }
+  if (numWords && (mscReturnOk == status)) {
+    status = appFlashProgram(dst, &page->data[page->firstWord], numWords);
+  }
+
+  us = (DWT->CYCCNT - start) / (SystemCoreClockGet() / 1000000);
+
+  if (mscReturnOk == status) {
+    appFlashStats.pages++;
+    appFlashStats.bytes += numWords * sizeof(uint32_t);
+  } else {
+    appFlashStats.errors++;
+  }
+  appFlashStats.lastPageUs = us;
+  appFlashStats.totalUs += us;
+  if (us < appFlashStats.minPageUs) {
+    appFlashStats.minPageUs = us;
+  }
+  if (us > appFlashStats.maxPageUs) {
+    appFlashStats.maxPageUs = us;
+  }
+
+  page->address = APP_FLASH_NO_PAGE;
+  page->queued = false;
+
+  return status;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Check that a flash range is erased.
+ *  \param[in]  address  Start of the range.
+ *  \param[in]  numWords  Length of the range in words.
+ *  \return  true if every word is erased
+ **************************************************************************************************/
+static bool appFlashIsBlank(const uint32_t *address, uint32_t numWords)
+{
+  while (numWords--) {
+    if (*address++ != APP_FLASH_ERASED_WORD) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Program a range within one page as a series of fast write bursts.
+ *  \details  Runs from RAM so instruction fetches do not stall on the flash being programmed.
+ *  MSC_WriteWordFast() masks interrupts while it loads a burst, so the range is split into
+ *  APP_FLASH_BURST_WORDS chunks to give pending interrupts a chance to run in between.
+ *  \param[in]  address  Destination, word aligned.
+ *  \param[in]  data  Source words.
+ *  \param[in]  numWords  Number of words to program.
+ *  \return  Status of the last write.
+ **************************************************************************************************/
+SL_RAMFUNC_DEFINITION_BEGIN
+static MSC_Status_TypeDef appFlashProgram(uint32_t *address,
+                                          const uint32_t *data,
+                                          uint32_t numWords)
+{
+  MSC_Status_TypeDef status = mscReturnOk;
+
+  while (numWords && (mscReturnOk == status)) {
+    uint32_t burst = (numWords > APP_FLASH_BURST_WORDS) ? APP_FLASH_BURST_WORDS : numWords;
+
+    status = MSC_WriteWordFast(address, data, burst * sizeof(uint32_t));
+    address += burst;
+    data += burst;
+    numWords -= burst;
+  }
+
+  return status;
+}
+SL_RAMFUNC_DEFINITION_END
+
+/** @} (end addtogroup app_flash) */
+/** @} (end addtogroup Application) */
@@ -0,0 +1,123 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application flash programmer header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_FLASH_H
+#define APP_FLASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup app_flash Application Flash Programmer
+ * \brief Page buffered, burst mode programming of the internal flash.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_flash
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Number of words loaded into the MSC per burst. Interrupts are masked for the duration of one
+ *  burst, so this bounds the latency the radio sees while a page is being programmed. */
+#ifndef APP_FLASH_BURST_WORDS
+#define APP_FLASH_BURST_WORDS         32
+#endif
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Programming statistics. Times are in microseconds. */
+typedef struct {
+  uint32_t pages;         /**< Number of pages committed. */
+  uint32_t bytes;         /**< Number of bytes programmed. */
+  uint32_t erases;        /**< Number of pages that had to be erased before programming. */
+  uint32_t errors;        /**< Number of failed erase or write operations. */
+  uint32_t lastPageUs;    /**< Program time of the most recently committed page. */
+  uint32_t minPageUs;     /**< Shortest page program time. */
+  uint32_t maxPageUs;     /**< Longest page program time. */
+  uint32_t totalUs;       /**< Accumulated program time. */
+} appFlashStats_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Open a flash region for sequential programming and reset the statistics.
+ *  \param[in]  baseAddress  Start of the region, must be page aligned.
+ *  \param[in]  length  Size of the region in bytes.
+ *  \return  true if the region is valid internal flash, false otherwise
+ **************************************************************************************************/
+bool appFlashBegin(uint32_t baseAddress, uint32_t length);
+
+/***********************************************************************************************//**
+ *  \brief  Buffer data for programming.
+ *  \details  Data is collected in one of two page buffers. When a buffer fills it is queued for
+ *  programming and further data goes to the other buffer. A queued page is committed by
+ *  appFlashPoll(), or here if both buffers are full.
+ *  \param[in]  offset  Offset from the region base address.
+ *  \param[in]  data  Data to be written.
+ *  \param[in]  len  Length of data in bytes.
+ *  \return  0 on success, otherwise a MSC_Status_TypeDef error code
+ **************************************************************************************************/
+int32_t appFlashWrite(uint32_t offset, const uint8_t *data, uint32_t len);
+
+/***********************************************************************************************//**
+ *  \brief  Commit a queued page, if any.
+ *  \return  0 on success, otherwise a MSC_Status_TypeDef error code
+ **************************************************************************************************/
+int32_t appFlashPoll(void);
+
+/***********************************************************************************************//**
+ *  \brief  Commit all queued and partially filled pages.
+ *  \return  0 on success, otherwise a MSC_Status_TypeDef error code
+ **************************************************************************************************/
+int32_t appFlashFlush(void);
+
+/***********************************************************************************************//**
+ *  \brief  Drop the buffered pages and close the region, for an image that will not be completed.
+ **************************************************************************************************/
+void appFlashAbort(void);
+
+/***********************************************************************************************//**
+ *  \brief  Get the programming statistics collected since appFlashBegin().
+ *  \return  Pointer to the statistics.
+ **************************************************************************************************/
+const appFlashStats_t *appFlashGetStats(void);
+
+/** @} (end addtogroup app_flash) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_FLASH_H */
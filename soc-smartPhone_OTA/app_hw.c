@@ -17,7 +17,7 @@
 
 /* BG stack headers */
 #include "bg_types.h"
-#include "native_gecko.h" // GN: undefined reference to `gecko_cmd_sm_passkey_confirm'
+#include "native_gecko.h"
 
 /* STK header files. */
 #if defined(HAL_CONFIG)
@@ -40,6 +40,9 @@
 /* application specific headers */
 #include "advertisement.h"
 #include "app_ui.h"
+#include "app_sensor.h"
+#include "ia.h"
+#include "app_security.h"
 
 /* Own headers*/
 #include "app_hw.h"
@@ -69,6 +72,15 @@
 
 /** Status flag of the Temperature Sensor. */
 static bool si7013_status = false;
+/* A no-hold conversion is in progress, the sensor NACKs other commands until it is fetched */
+static bool appHwRhTmConverting = false;
+/* Latest result of the no-hold conversions, handed out while they own the sensor */
+static bool appHwRhTmValid = false;
+static uint32_t appHwRhTmRh;
+static int32_t appHwRhTmTemp;
+
+/** Calibration of the Temperature Sensor. */
+static const appSensorCal_t appHwTempCal = { APP_HW_TEMP_CAL_GAIN, APP_HW_TEMP_CAL_OFFSET };
 
 /** I2C init structure. */
 
@@ -94,7 +106,57 @@ void appHwInit(void)
 int32_t appHwReadTm(int32_t* tempData)
 {
   uint32_t rhData = 0;
-  return Si7013_MeasureRHAndTemp(I2C0, SI7021_ADDR, &rhData, tempData);
+  return appHwReadRhTm(&rhData, tempData);
+}
+
+int32_t appHwReadRhTm(uint32_t* rhData, int32_t* tempData)
+{
+  int32_t ret;
+
+  /* The sensor belongs to the running no-hold conversions, a read gets their latest result */
+  if (appHwRhTmConverting) {
+    if (!appHwRhTmValid) {
+      return -1;
+    }
+    *rhData = appHwRhTmRh;
+    *tempData = appHwRhTmTemp;
+    return 0;
+  }
+
+  ret = Si7013_MeasureRHAndTemp(I2C0, SI7021_ADDR, rhData, tempData);
+
+  if (ret == 0) {
+    *tempData = appSensorCalApply(&appHwTempCal, *tempData);
+  }
+  return ret;
+}
+
+int32_t appHwStartRhTm(void)
+{
+  int32_t ret = Si7013_StartNoHoldMeasureRHAndTemp(I2C0, SI7021_ADDR);
+
+  appHwRhTmConverting = (ret == 0);
+  return ret;
+}
+
+int32_t appHwFetchRhTm(uint32_t* rhData, int32_t* tempData)
+{
+  int32_t ret = Si7013_ReadNoHoldRHAndTemp(I2C0, SI7021_ADDR, rhData, tempData);
+
+  appHwRhTmConverting = false;
+  if (ret == 0) {
+    *tempData = appSensorCalApply(&appHwTempCal, *tempData);
+    appHwRhTmRh = *rhData;
+    appHwRhTmTemp = *tempData;
+    appHwRhTmValid = true;
+  }
+  return ret;
+}
+
+void appHwStopRhTm(void)
+{
+  appHwRhTmConverting = false;
+  appHwRhTmValid = false;
 }
 
 bool appHwInitTempSens(void)
@@ -114,8 +176,17 @@ bool appHwInitTempSens(void)
  **************************************************************************************************/
 static void appBtnCback(AppUiBtnEvt_t btn)
 {
+  /* While a passkey comparison is shown the buttons answer it */
+  if (appSecurityButton(btn)) {
+    return;
+  }
+
   if (APP_UI_BTN_0_SHORT == btn) {
-    advSwitchAdvMessage();
+    /* A press silences an alert, otherwise all advertising sets run at once and it brings them
+     * back to the fast profile */
+    if (!iaAlertSilence()) {
+      advStartBurst();
+    }
   }
 
   if (APP_UI_BTN_0_LONG == btn)
@@ -124,13 +195,6 @@ static void appBtnCback(AppUiBtnEvt_t btn)
 //    hidSendKeyboardText();
   }
 
-  if (APP_UI_BTN_1_SHORT == btn)
-  {
-  printLog("PB1 pressed (SHORT)\r\n");flushLog();
-    /* Confirm passkey */
-    gecko_cmd_sm_passkey_confirm(conGetConnectionId(), 1);
-  }
-
   if (APP_UI_BTN_1_LONG == btn)
   {
     /* Send the HID key presses */
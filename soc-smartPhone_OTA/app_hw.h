@@ -39,6 +39,22 @@ extern "C" {
  * @{
  **************************************************************************************************/
 
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Temperature calibration of the Si7013, gain as a Q16 scale factor and offset in milli-degrees
+ *  Celsius, see appSensorCalApply(). */
+#ifndef APP_HW_TEMP_CAL_GAIN
+#define APP_HW_TEMP_CAL_GAIN            65536L
+#endif
+#ifndef APP_HW_TEMP_CAL_OFFSET
+#define APP_HW_TEMP_CAL_OFFSET          0
+#endif
+
+/** Longest Si7013 relative humidity and temperature conversion in ms, 12 ms RH and 10.8 ms T. */
+#define APP_HW_RH_TM_CONV_MS            23
+
 /***************************************************************************************************
  * Data Types
  **************************************************************************************************/
@@ -59,6 +75,38 @@ void appHwInit(void);
  **************************************************************************************************/
 int32_t appHwReadTm(int32_t* tempData);
 
+/***********************************************************************************************//**
+ *  \brief  Perform a relative humidity and temperature measurement.
+ *  \param[out]  rhData  Relative humidity in milli-percent.
+ *  \param[out]  tempData  Temperature in milli-degrees Celsius.
+ *  \return  0 if the read was successful, otherwise -1
+ **************************************************************************************************/
+int32_t appHwReadRhTm(uint32_t* rhData, int32_t* tempData);
+
+/***********************************************************************************************//**
+ *  \brief  Start a relative humidity and temperature conversion without holding the bus.
+ *  \details  The result is fetched with appHwFetchRhTm() once APP_HW_RH_TM_CONV_MS have passed.
+ *  Until then appHwReadTm() and appHwReadRhTm() do not use the bus, they return the result of the
+ *  latest fetched conversion.
+ *  \return  0 if the conversion was started, otherwise non-zero
+ **************************************************************************************************/
+int32_t appHwStartRhTm(void);
+
+/***********************************************************************************************//**
+ *  \brief  Fetch the result of the conversion started by appHwStartRhTm().
+ *  \param[out]  rhData  Relative humidity in milli-percent.
+ *  \param[out]  tempData  Temperature in milli-degrees Celsius.
+ *  \return  0 if the read was successful, otherwise -1
+ **************************************************************************************************/
+int32_t appHwFetchRhTm(uint32_t* rhData, int32_t* tempData);
+
+/***********************************************************************************************//**
+ *  \brief  End a series of no-hold conversions and give the sensor back to appHwReadRhTm().
+ *  \details  A conversion still running is not fetched, a read within APP_HW_RH_TM_CONV_MS is
+ *  NACKed by the sensor and fails.
+ **************************************************************************************************/
+void appHwStopRhTm(void);
+
 /***********************************************************************************************//**
  *  \brief  Initialise temperature measurement.
  *  \return  true if a Si7013 is detected, false otherwise
@@ -0,0 +1,139 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application idle loop
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#include "native_gecko.h"
+
+/* em library */
+#include "em_device.h"
+#include "em_core.h"
+
+/* Own header */
+#include "app_idle.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_idle
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+/** Registered hooks. */
+static appIdleHook_t appIdleHooks[APP_IDLE_MAX_HOOKS];
+/** Hook the next pass starts with, so a busy hook cannot starve the ones after it. */
+static uint8_t appIdleNext = 0;
+/** Statistics. */
+static appIdleStats_t appIdleStats;
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+bool appIdleRegister(appIdleHook_t hook)
+{
+  uint8_t i;
+
+  for (i = 0; i < APP_IDLE_MAX_HOOKS; i++) {
+    if (NULL == appIdleHooks[i]) {
+      appIdleHooks[i] = hook;
+      return true;
+    }
+  }
+  return false;
+}
+
+void appIdleUnregister(appIdleHook_t hook)
+{
+  uint8_t i;
+
+  for (i = 0; i < APP_IDLE_MAX_HOOKS; i++) {
+    if (hook == appIdleHooks[i]) {
+      appIdleHooks[i] = NULL;
+    }
+  }
+}
+
+void appIdleRun(void)
+{
+  uint32_t budget = (SystemCoreClockGet() / 1000000) * APP_IDLE_BUDGET_US;
+  uint32_t start = DWT->CYCCNT;
+  uint32_t elapsed = 0;
+  bool pending = true;
+  uint32_t sleepMs;
+  CORE_DECLARE_IRQ_STATE;
+
+  appIdleStats.passes++;
+
+  /* Run the hooks in rounds until none has work left or the budget is used up. The hooks are
+   * timed with the cycle counter that appWorkInit() enables. */
+  while (pending && (elapsed < budget)) {
+    uint8_t n;
+
+    pending = false;
+    for (n = 0; n < APP_IDLE_MAX_HOOKS; n++) {
+      appIdleHook_t hook = appIdleHooks[appIdleNext];
+
+      appIdleNext = (appIdleNext + 1) % APP_IDLE_MAX_HOOKS;
+      if (hook) {
+        pending |= hook();
+        appIdleStats.hookRuns++;
+      }
+    }
+    elapsed = DWT->CYCCNT - start;
+  }
+
+  appIdleStats.hookCycles += elapsed;
+  if (elapsed > budget) {
+    appIdleStats.overruns++;
+  }
+
+  /* Go back to the stack, there is background work left */
+  if (pending) {
+    appIdleStats.blocked++;
+    return;
+  }
+
+  /* Interrupts are masked between the poll and the sleep, so an event that arrives in between is
+   * not lost: the pending interrupt wakes the core up right away. */
+  CORE_ENTER_ATOMIC();
+  sleepMs = gecko_can_sleep_ms();
+  if (sleepMs) {
+    appIdleStats.sleepMs += gecko_sleep_for_ms(sleepMs);
+    appIdleStats.sleeps++;
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+const appIdleStats_t *appIdleGetStats(void)
+{
+  return &appIdleStats;
+}
+
+/** @} (end addtogroup app_idle) */
+/** @} (end addtogroup Application) */
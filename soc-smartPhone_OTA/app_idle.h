@@ -0,0 +1,112 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application idle loop header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_IDLE_H
+#define APP_IDLE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup app_idle Application Idle Loop
+ * \brief Background work and sleep when the stack has no events pending.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_idle
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Maximum number of idle hooks. */
+#ifndef APP_IDLE_MAX_HOOKS
+#define APP_IDLE_MAX_HOOKS            4
+#endif
+
+/** Time budget for running the idle hooks before the stack is polled again, in microseconds. */
+#ifndef APP_IDLE_BUDGET_US
+#define APP_IDLE_BUDGET_US            1000
+#endif
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Idle hook. Does a bounded step of background work.
+ *  \return  true if there is more work, which keeps the device from sleeping */
+typedef bool (*appIdleHook_t)(void);
+
+/** Idle loop statistics. */
+typedef struct {
+  uint32_t passes;          /**< Number of times the loop found no stack event. */
+  uint32_t hookRuns;        /**< Number of idle hook calls. */
+  uint32_t hookCycles;      /**< CPU cycles spent in idle hooks. */
+  uint32_t overruns;        /**< Number of passes that went over the hook budget. */
+  uint32_t sleeps;          /**< Number of times the device went to sleep. */
+  uint32_t sleepMs;         /**< Total time slept in milliseconds. */
+  uint32_t blocked;         /**< Number of passes the device stayed awake for pending work. */
+} appIdleStats_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Register an idle hook.
+ *  \param[in]  hook  Hook function.
+ *  \return  false if the registry is full
+ **************************************************************************************************/
+bool appIdleRegister(appIdleHook_t hook);
+
+/***********************************************************************************************//**
+ *  \brief  Remove an idle hook.
+ *  \param[in]  hook  Hook function.
+ **************************************************************************************************/
+void appIdleUnregister(appIdleHook_t hook);
+
+/***********************************************************************************************//**
+ *  \brief  Run the idle hooks and sleep if nothing is pending. To be called from the main loop when
+ *  gecko_peek_event() returns no event.
+ **************************************************************************************************/
+void appIdleRun(void);
+
+/***********************************************************************************************//**
+ *  \brief  Get the idle loop statistics.
+ *  \return  Pointer to the statistics.
+ **************************************************************************************************/
+const appIdleStats_t *appIdleGetStats(void);
+
+/** @} (end addtogroup app_idle) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_IDLE_H */
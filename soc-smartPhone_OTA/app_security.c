@@ -0,0 +1,248 @@
+/***************************************************************************//**
+ * @file
+ * @brief Security manager
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#include "native_gecko.h"
+
+/* application specific headers */
+#include "app.h"
+#include "app_ui.h"
+
+/* Own header */
+#include "app_security.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_security
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+/* Text definitions*/
+#define APP_SECURITY_PASSKEY_TEXT     "\nPasskey:\n\n%06lu\n"
+#define APP_SECURITY_CONFIRM_TEXT     "\nConfirm passkey:\n\n%06lu\n\nPB1 yes  PB0 no\n"
+#define APP_SECURITY_BONDED_TEXT      "\nPaired\n"
+#define APP_SECURITY_FAILED_TEXT      "\nPairing failed\n"
+#define APP_SECURITY_REPAIR_TEXT      "\nBonded peer has\nno key. Pair again?\n\nPB1 yes  PB0 no\n"
+#define APP_SECURITY_TEXT_SIZE        48
+
+/** Bonding policy of sm_store_bonding_configuration, replace the bonding used longest ago. */
+#define APP_SECURITY_POLICY_LRU       2
+
+/** Connections the pairing state is kept for, handles run from 1. */
+#define APP_SECURITY_CONNECTIONS      4
+
+#define APP_SECURITY_NO_CONNECTION    0xFF
+#define APP_SECURITY_NO_BONDING       0xFF
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+/** Bonding handle each connection was opened with, APP_SECURITY_NO_BONDING if none. */
+static uint8_t appSecurityBonding[APP_SECURITY_CONNECTIONS];
+/** Connection whose passkey comparison or re-pairing question waits for a button press. */
+static uint8_t appSecurityConfirmConnection = APP_SECURITY_NO_CONNECTION;
+/** Bonding the re-pairing question is about, APP_SECURITY_NO_BONDING for a passkey comparison. */
+static uint8_t appSecurityRepairBonding = APP_SECURITY_NO_BONDING;
+/** Display text, the display keeps the pointer until the next write. */
+static char appSecurityText[APP_SECURITY_TEXT_SIZE];
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+static void appSecurityShowPasskey(const char *format, uint32_t passkey);
+static void appSecurityBondingFailed(uint8_t connection, uint16_t reason);
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+void appSecurityInit(void)
+{
+  uint8_t i;
+
+  for (i = 0; i < APP_SECURITY_CONNECTIONS; i++) {
+    appSecurityBonding[i] = APP_SECURITY_NO_BONDING;
+  }
+  appSecurityConfirmConnection = APP_SECURITY_NO_CONNECTION;
+  appSecurityRepairBonding = APP_SECURITY_NO_BONDING;
+
+  gecko_cmd_sm_configure(APP_SECURITY_SM_FLAGS, APP_SECURITY_IO_CAPABILITY);
+  if (gecko_cmd_sm_store_bonding_configuration(APP_SECURITY_MAX_BONDINGS,
+                                               APP_SECURITY_POLICY_LRU)->result) {
+    printLog("bonding configuration refused\r\n");
+  }
+  gecko_cmd_sm_set_bondable_mode(1);
+}
+
+void appSecurityConnectionOpened(uint8_t connection, uint8_t bonding)
+{
+  if ((connection >= 1) && (connection <= APP_SECURITY_CONNECTIONS)) {
+    appSecurityBonding[connection - 1] = bonding;
+  }
+
+  /* The stored key encrypts the link at once, without pairing */
+  if (bonding != APP_SECURITY_NO_BONDING) {
+    if (gecko_cmd_sm_increase_security(connection)->result) {
+      printLog("encryption of bonding %u failed to start\r\n", bonding);
+    }
+  }
+}
+
+void appSecurityConnectionClosed(uint8_t connection)
+{
+  if ((connection >= 1) && (connection <= APP_SECURITY_CONNECTIONS)) {
+    appSecurityBonding[connection - 1] = APP_SECURITY_NO_BONDING;
+  }
+  if (appSecurityConfirmConnection == connection) {
+    appSecurityConfirmConnection = APP_SECURITY_NO_CONNECTION;
+    appSecurityRepairBonding = APP_SECURITY_NO_BONDING;
+  }
+}
+
+bool appSecurityEvent(struct gecko_cmd_packet *evt)
+{
+  switch (BGLIB_MSG_ID(evt->header)) {
+    case gecko_evt_sm_passkey_display_id:
+      /* The peer enters the passkey */
+      appSecurityShowPasskey(APP_SECURITY_PASSKEY_TEXT, evt->data.evt_sm_passkey_display.passkey);
+      return true;
+
+    case gecko_evt_sm_confirm_passkey_id:
+      /* Numeric comparison, the user answers with the buttons */
+      appSecurityConfirmConnection = evt->data.evt_sm_confirm_passkey.connection;
+      appSecurityRepairBonding = APP_SECURITY_NO_BONDING;
+      appSecurityShowPasskey(APP_SECURITY_CONFIRM_TEXT, evt->data.evt_sm_confirm_passkey.passkey);
+      return true;
+
+    case gecko_evt_sm_bonded_id:
+      if (appSecurityConfirmConnection == evt->data.evt_sm_bonded.connection) {
+        appSecurityConfirmConnection = APP_SECURITY_NO_CONNECTION;
+        appSecurityRepairBonding = APP_SECURITY_NO_BONDING;
+      }
+      if ((evt->data.evt_sm_bonded.connection >= 1)
+          && (evt->data.evt_sm_bonded.connection <= APP_SECURITY_CONNECTIONS)) {
+        appSecurityBonding[evt->data.evt_sm_bonded.connection - 1] = evt->data.evt_sm_bonded.bonding;
+      }
+      printLog("bonded, handle %u\r\n", evt->data.evt_sm_bonded.bonding);
+      appUiWriteString(APP_SECURITY_BONDED_TEXT);
+      return true;
+
+    case gecko_evt_sm_bonding_failed_id:
+      appSecurityBondingFailed(evt->data.evt_sm_bonding_failed.connection,
+                               evt->data.evt_sm_bonding_failed.reason);
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+bool appSecurityButton(AppUiBtnEvt_t btn)
+{
+  uint8_t connection = appSecurityConfirmConnection;
+
+  if (connection == APP_SECURITY_NO_CONNECTION) {
+    return false;
+  }
+
+  if ((APP_UI_BTN_1_SHORT != btn) && (APP_UI_BTN_0_SHORT != btn)) {
+    return false;
+  }
+
+  if (appSecurityRepairBonding == APP_SECURITY_NO_BONDING) {
+    gecko_cmd_sm_passkey_confirm(connection, (APP_UI_BTN_1_SHORT == btn) ? 1 : 0);
+  } else if (APP_UI_BTN_1_SHORT == btn) {
+    /* The user replaces the bonding, the peer pairs from scratch */
+    printLog("bonding %u deleted by the user\r\n", appSecurityRepairBonding);
+    gecko_cmd_sm_delete_bonding(appSecurityRepairBonding);
+    gecko_cmd_sm_increase_security(connection);
+  } else {
+    /* The bonding is kept and the peer that could not prove it is dropped */
+    gecko_cmd_le_connection_close(connection);
+  }
+
+  appSecurityConfirmConnection = APP_SECURITY_NO_CONNECTION;
+  appSecurityRepairBonding = APP_SECURITY_NO_BONDING;
+  return true;
+}
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Show a passkey on the display.
+ *  \param[in]  format  Text with one %06lu for the passkey.
+ *  \param[in]  passkey  Passkey, 0 to 999999.
+ **************************************************************************************************/
+static void appSecurityShowPasskey(const char *format, uint32_t passkey)
+{
+  printLog("passkey %06lu\r\n", (unsigned long)passkey);
+  snprintf(appSecurityText, sizeof(appSecurityText), format, (unsigned long)passkey);
+  appUiWriteString(appSecurityText);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Pairing or encryption failed.
+ *  \details  A peer that has lost the key of its bonding cannot encrypt with it any more. Neither
+ *  can a device that only spoofs the address of a bonded peer, so the bonding is not deleted on the
+ *  failure alone: the user is asked whether the peer should pair again.
+ *  \param[in]  connection  Connection handle.
+ *  \param[in]  reason  Failure reason.
+ **************************************************************************************************/
+static void appSecurityBondingFailed(uint8_t connection, uint16_t reason)
+{
+  uint8_t bonding = APP_SECURITY_NO_BONDING;
+
+  printLog("bonding failed, reason 0x%04x\r\n", reason);
+
+  if (appSecurityConfirmConnection == connection) {
+    appSecurityConfirmConnection = APP_SECURITY_NO_CONNECTION;
+    appSecurityRepairBonding = APP_SECURITY_NO_BONDING;
+  }
+  if ((connection >= 1) && (connection <= APP_SECURITY_CONNECTIONS)) {
+    bonding = appSecurityBonding[connection - 1];
+    appSecurityBonding[connection - 1] = APP_SECURITY_NO_BONDING;
+  }
+
+  /* Clearing the handle first asks only once per connection */
+  if ((bonding != APP_SECURITY_NO_BONDING)
+      && ((reason == bg_err_bt_pin_or_key_missing) || (reason == bg_err_bt_authentication_failure))) {
+    appSecurityConfirmConnection = connection;
+    appSecurityRepairBonding = bonding;
+    appUiWriteString(APP_SECURITY_REPAIR_TEXT);
+    return;
+  }
+
+  appUiWriteString(APP_SECURITY_FAILED_TEXT);
+}
+
+/** @} (end addtogroup app_security) */
+/** @} (end addtogroup Application) */
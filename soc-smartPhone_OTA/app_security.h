@@ -0,0 +1,119 @@
+/***************************************************************************//**
+ * @file
+ * @brief Security manager header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_SECURITY_H
+#define APP_SECURITY_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "app_ui.h"
+
+/***********************************************************************************************//**
+ * \defgroup app_security Security Manager
+ * \brief Pairing, bonding and link encryption.
+ *
+ * The stack keeps the bonding keys in persistent storage, up to APP_SECURITY_MAX_BONDINGS of
+ * them. When the table is full a new bonding replaces the one used longest ago. A bonded peer that
+ * connects again is encrypted with its stored key right away, it does not have to pair or wait for
+ * an insufficient authentication error first.
+ *
+ * A peer whose stored key fails may have lost its key, or may only be spoofing a bonded address.
+ * Bondings are therefore never deleted without the user: the display asks whether the peer should
+ * pair again. PB1 deletes the bonding and pairs, PB0 keeps the bonding and closes the connection.
+ *
+ * Passkeys are shown on the display. A passkey to compare is accepted with a short press of
+ * PB1 and rejected with a short press of PB0.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_security
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Security manager flags of sm_configure, 0 allows bonding without MITM protection. */
+#ifndef APP_SECURITY_SM_FLAGS
+#define APP_SECURITY_SM_FLAGS         0x00
+#endif
+
+/** I/O capabilities, the display shows passkeys and the buttons answer yes or no. */
+#ifndef APP_SECURITY_IO_CAPABILITY
+#define APP_SECURITY_IO_CAPABILITY    sm_io_capability_displayyesno
+#endif
+
+/** Bondings kept, 1 to 32. */
+#ifndef APP_SECURITY_MAX_BONDINGS
+#define APP_SECURITY_MAX_BONDINGS     8
+#endif
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Configure the security manager and the bonding table, called once on the boot event.
+ **************************************************************************************************/
+void appSecurityInit(void);
+
+/***********************************************************************************************//**
+ *  \brief  Encrypt the link of a bonded peer.
+ *  \param[in]  connection  Connection handle.
+ *  \param[in]  bonding  Bonding handle from the connection opened event, 0xFF if not bonded.
+ **************************************************************************************************/
+void appSecurityConnectionOpened(uint8_t connection, uint8_t bonding);
+
+/***********************************************************************************************//**
+ *  \brief  Drop the pairing state of a closed connection.
+ *  \param[in]  connection  Connection handle.
+ **************************************************************************************************/
+void appSecurityConnectionClosed(uint8_t connection);
+
+/***********************************************************************************************//**
+ *  \brief  Handle security manager events.
+ *  \param[in]  evt  Stack event.
+ *  \return  true if the event was a security manager event
+ **************************************************************************************************/
+bool appSecurityEvent(struct gecko_cmd_packet *evt);
+
+/***********************************************************************************************//**
+ *  \brief  Answer a passkey comparison or a re-pairing question with a button press.
+ *  \param[in]  btn  Button press.
+ *  \return  true if the press answered a question
+ **************************************************************************************************/
+bool appSecurityButton(AppUiBtnEvt_t btn);
+
+/** @} (end addtogroup app_security) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_SECURITY_H */
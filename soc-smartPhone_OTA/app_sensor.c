@@ -0,0 +1,325 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fixed-point sensor value processing
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#if APP_SENSOR_BENCH
+#include <stdio.h>
+#include "em_device.h"
+#include "native_gecko.h"
+#include "infrastructure.h"
+#include "app.h"
+#endif
+
+/* Own header */
+#include "app_sensor.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_sensor
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+
+/** 9/5, the Fahrenheit degree per Celsius degree, in Q30 so it stays exact to the milli-degree
+ *  over the whole sensor range. */
+#define APP_SENSOR_F_PER_C_Q          30
+#define APP_SENSOR_F_PER_C            ((int32_t)(((9LL << APP_SENSOR_F_PER_C_Q) + 2) / 5))
+/** 32 degrees Fahrenheit in milli-degrees. */
+#define APP_SENSOR_F_OFFSET           32000
+
+/** Digits of a 32 bit magnitude, the last 3 are the milli-unit decimals. */
+#define APP_SENSOR_DIGITS             10
+#define APP_SENSOR_DECIMALS           3
+
+#if APP_SENSOR_BENCH
+/** Number of conversions timed per variant. */
+#define APP_SENSOR_BENCH_RUNS         64
+#endif
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+/** Powers of 10 for the digit extraction, most significant first. */
+static const uint32_t appSensorPowers[APP_SENSOR_DIGITS] = {
+  1000000000UL, 100000000UL, 10000000UL, 1000000UL, 100000UL,
+  10000UL, 1000UL, 100UL, 10UL, 1UL
+};
+
+/** Half of the last printed digit in milli-units, by number of decimals. */
+static const uint16_t appSensorHalves[APP_SENSOR_DECIMALS + 1] = { 500, 50, 5, 0 };
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+
+static uint32_t appSensorEncode(int32_t mantissa, int8_t exponent, uint8_t mantBits,
+                                uint8_t expBits);
+static void appSensorStatsScan(appSensorStats_t *stats);
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+
+int32_t appSensorCToF(int32_t milliC)
+{
+  return (int32_t)(((int64_t)milliC * APP_SENSOR_F_PER_C + (1LL << (APP_SENSOR_F_PER_C_Q - 1)))
+                   >> APP_SENSOR_F_PER_C_Q) + APP_SENSOR_F_OFFSET;
+}
+
+int32_t appSensorCalApply(const appSensorCal_t *cal, int32_t raw)
+{
+  return (int32_t)(((int64_t)raw * cal->gain + APP_SENSOR_Q_ONE / 2) >> APP_SENSOR_Q)
+         + cal->offset;
+}
+
+uint32_t appSensorFloat(int32_t mantissa, int8_t exponent)
+{
+  return appSensorEncode(mantissa, exponent, 24, 8);
+}
+
+uint16_t appSensorSfloat(int32_t mantissa, int8_t exponent)
+{
+  return (uint16_t)appSensorEncode(mantissa, exponent, 12, 4);
+}
+
+uint8_t appSensorFormat(char *buf, int32_t milli, uint8_t width, uint8_t decimals)
+{
+  char digits[APP_SENSOR_DIGITS];
+  uint32_t mag = (milli < 0) ? (0UL - (uint32_t)milli) : (uint32_t)milli;
+  bool negative = false;
+  uint8_t first = 0;
+  uint8_t intLen;
+  uint8_t len = 0;
+  uint8_t last;
+  uint8_t i;
+
+  if (decimals > APP_SENSOR_DECIMALS) {
+    decimals = APP_SENSOR_DECIMALS;
+  }
+  if (width > APP_SENSOR_FORMAT_MAX - APP_SENSOR_DECIMALS - 2) {
+    width = APP_SENSOR_FORMAT_MAX - APP_SENSOR_DECIMALS - 2;
+  }
+
+  /* round to the printed digits, then subtract each power of 10 as often as it goes */
+  mag += appSensorHalves[decimals];
+  for (i = 0; i < APP_SENSOR_DIGITS; i++) {
+    digits[i] = '0';
+    while (mag >= appSensorPowers[i]) {
+      mag -= appSensorPowers[i];
+      digits[i]++;
+    }
+  }
+
+  /* a value that rounds to 0 has no sign */
+  last = APP_SENSOR_DIGITS - APP_SENSOR_DECIMALS + decimals;
+  if (milli < 0) {
+    for (i = 0; i < last; i++) {
+      if (digits[i] != '0') {
+        negative = true;
+        break;
+      }
+    }
+  }
+
+  while ((first < APP_SENSOR_DIGITS - APP_SENSOR_DECIMALS - 1) && (digits[first] == '0')) {
+    first++;
+  }
+  intLen = (uint8_t)(APP_SENSOR_DIGITS - APP_SENSOR_DECIMALS - first + negative);
+
+  while (intLen + len < width) {
+    buf[len++] = ' ';
+  }
+  if (negative) {
+    buf[len++] = '-';
+  }
+  for (i = first; i < APP_SENSOR_DIGITS - APP_SENSOR_DECIMALS; i++) {
+    buf[len++] = digits[i];
+  }
+  if (decimals) {
+    buf[len++] = '.';
+    for (; i < last; i++) {
+      buf[len++] = digits[i];
+    }
+  }
+  buf[len] = '\0';
+
+  return len;
+}
+
+void appSensorStatsInit(appSensorStats_t *stats)
+{
+  memset(stats, 0, sizeof(*stats));
+}
+
+void appSensorStatsPut(appSensorStats_t *stats, int32_t sample)
+{
+  int32_t old = stats->samples[stats->next];
+  bool full = (stats->count == APP_SENSOR_STATS_WINDOW);
+
+  stats->samples[stats->next] = sample;
+  stats->next = (uint16_t)((stats->next + 1) % APP_SENSOR_STATS_WINDOW);
+  stats->sum += sample;
+
+  if (!full) {
+    if (!stats->count || (sample < stats->min)) {
+      stats->min = sample;
+    }
+    if (!stats->count || (sample > stats->max)) {
+      stats->max = sample;
+    }
+    stats->count++;
+    return;
+  }
+
+  stats->sum -= old;
+  /* the window only needs a scan when the sample that left it was the minimum or maximum */
+  if (((old == stats->min) && (sample > old)) || ((old == stats->max) && (sample < old))) {
+    appSensorStatsScan(stats);
+  } else {
+    if (sample < stats->min) {
+      stats->min = sample;
+    }
+    if (sample > stats->max) {
+      stats->max = sample;
+    }
+  }
+}
+
+int32_t appSensorStatsMean(const appSensorStats_t *stats)
+{
+  if (!stats->count) {
+    return 0;
+  }
+  return (int32_t)(stats->sum / stats->count);
+}
+
+#if APP_SENSOR_BENCH
+void appSensorBench(void)
+{
+  char text[40];
+  volatile uint32_t sink = 0;
+  uint32_t oldCycles = 0;
+  uint32_t newCycles = 0;
+  uint32_t start;
+  int32_t tempData;
+  int32_t tempDataF;
+  uint8_t len;
+  int i;
+
+  for (i = 0; i < APP_SENSOR_BENCH_RUNS; i++) {
+    tempData = 15000 + i * 397;
+
+    /* the conversions htm.c made before this module */
+    start = DWT->CYCCNT;
+    tempDataF = (tempData * 18 + 320000l) / 10l;
+    snprintf(text, sizeof(text), "\nTemperature:\n%3d.%1d C / %3d.%1d F\n",
+             (uint8_t)(tempData / 1000), (uint8_t)((tempData / 100) % 10),
+             (uint8_t)(tempDataF / 1000), (uint8_t)((tempDataF / 100) % 10));
+    sink += FLT_TO_UINT32(tempData, -3);
+    oldCycles += DWT->CYCCNT - start;
+
+    start = DWT->CYCCNT;
+    tempDataF = appSensorCToF(tempData);
+    len = appSensorFormat(text, tempData, 3, 1);
+    appSensorFormat(&text[len], tempDataF, 3, 1);
+    sink += appSensorFloat(tempData, -3);
+    newCycles += DWT->CYCCNT - start;
+  }
+
+  printLog("sensor conversions: %lu cycles before, %lu cycles now\r\n",
+           (unsigned long)(oldCycles / APP_SENSOR_BENCH_RUNS),
+           (unsigned long)(newCycles / APP_SENSOR_BENCH_RUNS));
+  (void)sink;
+}
+#endif
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Encode an IEEE-11073 FLOAT or SFLOAT.
+ *  \param[in]  mantissa  Mantissa.
+ *  \param[in]  exponent  Base 10 exponent.
+ *  \param[in]  mantBits  Mantissa field width.
+ *  \param[in]  expBits  Exponent field width.
+ *  \return  Encoded value.
+ **************************************************************************************************/
+static uint32_t appSensorEncode(int32_t mantissa, int8_t exponent, uint8_t mantBits,
+                                uint8_t expBits)
+{
+  /* the top 3 positive and bottom 2 negative mantissas are reserved for special values */
+  int32_t mantMax = (int32_t)(1UL << (mantBits - 1)) - 3;
+  int32_t expMax = (int32_t)(1UL << (expBits - 1)) - 1;
+  int32_t exp = exponent;
+  int32_t rem;
+
+  /* drop digits, rounded half away from 0, until the mantissa and exponent fit */
+  while ((mantissa > mantMax) || (mantissa < -mantMax) || (exp < -expMax - 1)) {
+    rem = mantissa % 10;
+    mantissa /= 10;
+    mantissa += (rem >= 5) - (rem <= -5);
+    exp++;
+  }
+
+  if (mantissa == 0) {
+    /* 0 is 0 at any exponent */
+    exp = 0;
+  } else if (exp > expMax) {
+    /* +INFINITY and -INFINITY are the mantissas just outside of the range */
+    mantissa = (mantissa >= 0) ? (mantMax + 1) : -(mantMax + 1);
+    exp = 0;
+  }
+
+  return ((uint32_t)mantissa & ((1UL << mantBits) - 1))
+         | (((uint32_t)exp & ((1UL << expBits) - 1)) << mantBits);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Find the minimum and maximum of a full window.
+ *  \param[in,out]  stats  Statistics.
+ **************************************************************************************************/
+static void appSensorStatsScan(appSensorStats_t *stats)
+{
+  uint16_t i;
+
+  stats->min = stats->samples[0];
+  stats->max = stats->samples[0];
+  for (i = 1; i < APP_SENSOR_STATS_WINDOW; i++) {
+    if (stats->samples[i] < stats->min) {
+      stats->min = stats->samples[i];
+    }
+    if (stats->samples[i] > stats->max) {
+      stats->max = stats->samples[i];
+    }
+  }
+}
+
+/** @} (end addtogroup app_sensor) */
+/** @} (end addtogroup Application) */
@@ -0,0 +1,185 @@
+/***************************************************************************//**
+ * @file
+ * @brief Fixed-point sensor value processing header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_SENSOR_H
+#define APP_SENSOR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup app_sensor Sensor Values
+ * \brief Fixed-point conversion, calibration, encoding and formatting of sensor values.
+ *
+ * Values are integers in milli-units, as the sensor drivers return them. Scale factors are Q16
+ * fractions, so a conversion is one multiply and one shift and no division. Nothing uses floating
+ * point or the printf family.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_sensor
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Fraction bits of a scale factor. */
+#define APP_SENSOR_Q                  16
+/** Scale factor of 1. */
+#define APP_SENSOR_Q_ONE              (1L << APP_SENSOR_Q)
+/** Scale factor num/den, rounded, for use in constant expressions. */
+#define APP_SENSOR_Q_RATIO(num, den)  ((int32_t)((((int64_t)(num) << APP_SENSOR_Q) + (den) / 2) / (den)))
+
+/** IEEE-11073 32-bit FLOAT special values. */
+#define APP_SENSOR_FLOAT_NAN          0x007FFFFFUL
+#define APP_SENSOR_FLOAT_POS_INF      0x007FFFFEUL
+#define APP_SENSOR_FLOAT_NEG_INF      0x00800002UL
+
+/** IEEE-11073 16-bit SFLOAT special values. */
+#define APP_SENSOR_SFLOAT_NAN         0x07FF
+#define APP_SENSOR_SFLOAT_POS_INF     0x07FE
+#define APP_SENSOR_SFLOAT_NEG_INF     0x0802
+
+/** Longest string appSensorFormat() writes, including the terminator. */
+#define APP_SENSOR_FORMAT_MAX         16
+
+/** Number of samples the moving statistics are taken over. */
+#ifndef APP_SENSOR_STATS_WINDOW
+#define APP_SENSOR_STATS_WINDOW       16
+#endif
+
+/** Time the conversions against the code they replaced and print the cycle counts at boot. */
+#ifndef APP_SENSOR_BENCH
+#define APP_SENSOR_BENCH              0
+#endif
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Linear calibration, corrected = raw * gain + offset. */
+typedef struct {
+  int32_t gain;     /**< Gain as a Q16 scale factor, APP_SENSOR_Q_ONE for none. */
+  int32_t offset;   /**< Offset in milli-units. */
+} appSensorCal_t;
+
+/** Moving statistics over the last APP_SENSOR_STATS_WINDOW samples. */
+typedef struct {
+  int32_t samples[APP_SENSOR_STATS_WINDOW]; /**< Sample window. */
+  int64_t sum;      /**< Sum of the window. */
+  int32_t min;      /**< Smallest sample in the window. */
+  int32_t max;      /**< Largest sample in the window. */
+  uint16_t count;   /**< Samples in the window. */
+  uint16_t next;    /**< Window position of the next sample. */
+} appSensorStats_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Convert a temperature from Celsius to Fahrenheit.
+ *  \param[in]  milliC  Temperature in milli-degrees Celsius.
+ *  \return  Temperature in milli-degrees Fahrenheit, rounded.
+ **************************************************************************************************/
+int32_t appSensorCToF(int32_t milliC);
+
+/***********************************************************************************************//**
+ *  \brief  Apply a linear calibration.
+ *  \param[in]  cal  Calibration.
+ *  \param[in]  raw  Raw value in milli-units.
+ *  \return  Corrected value in milli-units, rounded.
+ **************************************************************************************************/
+int32_t appSensorCalApply(const appSensorCal_t *cal, int32_t raw);
+
+/***********************************************************************************************//**
+ *  \brief  Encode a value as an IEEE-11073 32-bit FLOAT.
+ *  \details  A mantissa outside of the 24 bit range loses digits, rounded, and the exponent grows
+ *  to match. A value too large to encode gives +INFINITY or -INFINITY.
+ *  \param[in]  mantissa  Mantissa.
+ *  \param[in]  exponent  Base 10 exponent.
+ *  \return  FLOAT value, mantissa in the low 24 bits and exponent in the high 8 bits.
+ **************************************************************************************************/
+uint32_t appSensorFloat(int32_t mantissa, int8_t exponent);
+
+/***********************************************************************************************//**
+ *  \brief  Encode a value as an IEEE-11073 16-bit SFLOAT, see appSensorFloat().
+ *  \param[in]  mantissa  Mantissa.
+ *  \param[in]  exponent  Base 10 exponent.
+ *  \return  SFLOAT value, mantissa in the low 12 bits and exponent in the high 4 bits.
+ **************************************************************************************************/
+uint16_t appSensorSfloat(int32_t mantissa, int8_t exponent);
+
+/***********************************************************************************************//**
+ *  \brief  Format a milli-unit value with a fixed number of decimals.
+ *  \details  The value is rounded to the decimals. The sign and integer part are right aligned in
+ *  width characters, a wider integer part takes the room it needs. Digits are taken from a table
+ *  of powers of 10, without division.
+ *  \param[out]  buf  String, at least APP_SENSOR_FORMAT_MAX characters.
+ *  \param[in]  milli  Value in milli-units.
+ *  \param[in]  width  Minimum width of the sign and integer part.
+ *  \param[in]  decimals  Number of decimals, 0 to 3.
+ *  \return  Length of the string without the terminator.
+ **************************************************************************************************/
+uint8_t appSensorFormat(char *buf, int32_t milli, uint8_t width, uint8_t decimals);
+
+/***********************************************************************************************//**
+ *  \brief  Empty moving statistics.
+ *  \param[out]  stats  Statistics.
+ **************************************************************************************************/
+void appSensorStatsInit(appSensorStats_t *stats);
+
+/***********************************************************************************************//**
+ *  \brief  Add a sample to moving statistics, the oldest sample leaves a full window.
+ *  \param[in,out]  stats  Statistics.
+ *  \param[in]  sample  Sample.
+ **************************************************************************************************/
+void appSensorStatsPut(appSensorStats_t *stats, int32_t sample);
+
+/***********************************************************************************************//**
+ *  \brief  Get the mean of the samples in the window.
+ *  \param[in]  stats  Statistics.
+ *  \return  Mean, rounded towards 0, or 0 for an empty window.
+ **************************************************************************************************/
+int32_t appSensorStatsMean(const appSensorStats_t *stats);
+
+#if APP_SENSOR_BENCH
+/***********************************************************************************************//**
+ *  \brief  Print the cycle counts of the conversions and of the code they replaced.
+ **************************************************************************************************/
+void appSensorBench(void);
+#endif
+
+/** @} (end addtogroup app_sensor) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_SENSOR_H */
@@ -0,0 +1,370 @@
+/***************************************************************************//**
+ * @file
+ * @brief A/B image slots
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#include "native_gecko.h"
+
+/* em library */
+#include "em_device.h"
+#include "em_cmu.h"
+
+/* bootloader interface */
+#include "btl_interface.h"
+#include "btl_interface_storage.h"
+#include "application_properties.h"
+
+/* application specific headers */
+#include "app.h"
+#include "app_timer.h"
+
+/* Own header */
+#include "app_slots.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_slots
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+
+/** Watchdog feed period in ms, well inside the watchdog period. */
+#define APP_SLOTS_WDOG_FEED_MS        1000
+
+/** Slot state as stored in the PS key. */
+typedef struct {
+  uint8_t state;          /**< appSlotsState_t. */
+  int8_t confirmedSlot;   /**< Slot holding a copy of the confirmed image, or APP_SLOTS_NONE. */
+  int8_t trialSlot;       /**< Slot of the image set to install or on trial, or APP_SLOTS_NONE. */
+  uint8_t attempts;       /**< Boots of the image on trial. */
+  uint32_t trialVersion;  /**< Application version of the image on trial. */
+} appSlotsRecord_t;
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+/** Application properties of the running image, from application_properties.c. */
+extern const ApplicationProperties_t applicationProperties;
+
+/** Slot state. */
+static appSlotsRecord_t appSlotsRecord;
+/** Number of bootloader storage slots. */
+static uint32_t appSlotsNumSlots = 0;
+/** Confirmation deadline of an image on trial. */
+static appTimer_t appSlotsTimer;
+/** Watchdog feed while on trial. */
+static appTimer_t appSlotsWdogTimer;
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+
+static void appSlotsLoad(void);
+static void appSlotsSave(void);
+static bool appSlotsImageVersion(int32_t slot, uint32_t *version);
+static void appSlotsTimeout(void *arg);
+static void appSlotsWdogStart(void);
+static void appSlotsWdogStop(void);
+static void appSlotsWdogFeed(void *arg);
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+
+void appSlotsInit(uint32_t numSlots)
+{
+  uint32_t version = applicationProperties.app.version;
+  uint32_t trialVersion;
+
+  appSlotsNumSlots = numSlots;
+  appSlotsLoad();
+
+  /* with a single slot the download overwrites the copy of the running image */
+  if (appSlotsNumSlots < 2) {
+    appSlotsRecord.confirmedSlot = APP_SLOTS_NONE;
+  }
+
+  switch (appSlotsRecord.state) {
+    case APP_SLOTS_PENDING:
+      /* the bootloader installs the first image in the list that verifies, find out which runs */
+      if (appSlotsImageVersion(appSlotsRecord.trialSlot, &trialVersion)
+          && (trialVersion == version)) {
+        printLog("image version %lu on trial, confirm within %u s\r\n",
+                 (unsigned long)version, APP_SLOTS_CONFIRM_TIMEOUT_MS / 1000);
+        appSlotsRecord.state = APP_SLOTS_TRIAL;
+        appSlotsRecord.trialVersion = version;
+        appSlotsRecord.attempts = 1;
+      } else {
+        printLog("update not installed, running image version %lu\r\n", (unsigned long)version);
+        appSlotsRecord.state = APP_SLOTS_IDLE;
+        appSlotsRecord.trialSlot = APP_SLOTS_NONE;
+      }
+      appSlotsSave();
+      break;
+
+    case APP_SLOTS_TRIAL:
+      if (appSlotsRecord.trialVersion != version) {
+        /* the rollback has been installed */
+        printLog("rolled back to image version %lu\r\n", (unsigned long)version);
+        appSlotsRecord.state = APP_SLOTS_IDLE;
+        appSlotsRecord.trialSlot = APP_SLOTS_NONE;
+        appSlotsSave();
+        break;
+      }
+      appSlotsRecord.attempts++;
+      printLog("image on trial, boot %u of %u\r\n", appSlotsRecord.attempts, APP_SLOTS_MAX_ATTEMPTS);
+      if (appSlotsRecord.attempts > APP_SLOTS_MAX_ATTEMPTS + 1) {
+        /* the bootloader did not install the fallback, keep the image rather than reboot forever */
+        printLog("rollback not installed\r\n");
+        appSlotsRecord.confirmedSlot = APP_SLOTS_NONE;
+      }
+      appSlotsSave();
+      if (appSlotsRecord.attempts > APP_SLOTS_MAX_ATTEMPTS) {
+        appSlotsRollback();
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  if (appSlotsRecord.state == APP_SLOTS_TRIAL) {
+    appTimerStart(&appSlotsTimer, APP_SLOTS_CONFIRM_TIMEOUT_MS, 0, false, appSlotsTimeout, NULL);
+    appSlotsWdogStart();
+  }
+}
+
+appSlotsState_t appSlotsGetState(void)
+{
+  return (appSlotsState_t)appSlotsRecord.state;
+}
+
+int32_t appSlotsDownloadSlot(void)
+{
+  /* both slots are in use until the image on trial is confirmed or rolled back, a single slot
+   * is not written over an install either */
+  if (appSlotsRecord.state != APP_SLOTS_IDLE) {
+    return APP_SLOTS_NONE;
+  }
+  if ((appSlotsNumSlots < 2) || (appSlotsRecord.confirmedSlot == APP_SLOTS_NONE)) {
+    return 0;
+  }
+  return (appSlotsRecord.confirmedSlot + 1) % (int32_t)appSlotsNumSlots;
+}
+
+int32_t appSlotsInstall(void)
+{
+  int32_t slots[2];
+  size_t count = 0;
+  uint32_t version;
+  int32_t err;
+
+  slots[count++] = appSlotsDownloadSlot();
+  if (slots[0] == APP_SLOTS_NONE) {
+    return BOOTLOADER_ERROR_STORAGE_INVALID_SLOT;
+  }
+
+  /* an image is told apart from the confirmed one by its version */
+  if (appSlotsImageVersion(slots[0], &version)
+      && (version == applicationProperties.app.version)) {
+    printLog("image version %lu unchanged, installing without trial\r\n", (unsigned long)version);
+    appSlotsRecord.confirmedSlot = APP_SLOTS_NONE;
+    appSlotsSave();
+    return bootloader_setImageToBootload(slots[0]);
+  }
+
+  if (appSlotsRecord.confirmedSlot != APP_SLOTS_NONE) {
+    slots[count++] = appSlotsRecord.confirmedSlot;
+  }
+  err = bootloader_setImagesToBootload(slots, count);
+  if (err != BOOTLOADER_OK) {
+    return err;
+  }
+
+  appSlotsRecord.state = APP_SLOTS_PENDING;
+  appSlotsRecord.trialSlot = (int8_t)slots[0];
+  appSlotsRecord.attempts = 0;
+  appSlotsSave();
+
+  return BOOTLOADER_OK;
+}
+
+bool appSlotsConfirm(void)
+{
+  if (appSlotsRecord.state != APP_SLOTS_TRIAL) {
+    return false;
+  }
+
+  appTimerStop(&appSlotsTimer);
+  appSlotsWdogStop();
+
+  appSlotsRecord.state = APP_SLOTS_IDLE;
+  appSlotsRecord.confirmedSlot = (appSlotsNumSlots < 2) ? APP_SLOTS_NONE : appSlotsRecord.trialSlot;
+  appSlotsRecord.trialSlot = APP_SLOTS_NONE;
+  appSlotsRecord.attempts = 0;
+  appSlotsSave();
+
+  printLog("image version %lu confirmed\r\n", (unsigned long)applicationProperties.app.version);
+  return true;
+}
+
+void appSlotsRollback(void)
+{
+  int32_t slot = appSlotsRecord.confirmedSlot;
+
+  if ((slot == APP_SLOTS_NONE) || (bootloader_setImageToBootload(slot) != BOOTLOADER_OK)) {
+    /* nothing to go back to, keep the image that is running */
+    printLog("no confirmed image to roll back to\r\n");
+    appTimerStop(&appSlotsTimer);
+    appSlotsWdogStop();
+    appSlotsRecord.state = APP_SLOTS_IDLE;
+    appSlotsRecord.trialSlot = APP_SLOTS_NONE;
+    appSlotsSave();
+    return;
+  }
+
+  /* the state stays on trial, the next boot tells the rollback from the image by its version and
+   * a reset before the install rolls back again */
+  printLog("rolling back to slot %ld\r\n", (long)slot); syncLog();
+  bootloader_rebootAndInstall();
+}
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Load the slot state from its PS key, an empty or foreign key gives the idle state.
+ **************************************************************************************************/
+static void appSlotsLoad(void)
+{
+  struct gecko_msg_flash_ps_load_rsp_t *rsp = gecko_cmd_flash_ps_load(APP_SLOTS_PS_KEY);
+
+  if ((rsp->result == bg_err_success) && (rsp->value.len == sizeof(appSlotsRecord))) {
+    memcpy(&appSlotsRecord, rsp->value.data, sizeof(appSlotsRecord));
+  } else {
+    memset(&appSlotsRecord, 0, sizeof(appSlotsRecord));
+    appSlotsRecord.state = APP_SLOTS_IDLE;
+    appSlotsRecord.confirmedSlot = APP_SLOTS_NONE;
+    appSlotsRecord.trialSlot = APP_SLOTS_NONE;
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Store the slot state in its PS key.
+ **************************************************************************************************/
+static void appSlotsSave(void)
+{
+  uint16_t result;
+
+  result = gecko_cmd_flash_ps_save(APP_SLOTS_PS_KEY, sizeof(appSlotsRecord),
+                                   (const uint8_t *)&appSlotsRecord)->result;
+  if (result != bg_err_success) {
+    printLog("slot state not saved, error 0x%4.4x\r\n", result);
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Verify the image in a slot and read its application version.
+ *  \param[in]  slot  Slot number.
+ *  \param[out]  version  Application version.
+ *  \return  true if the image verifies, false otherwise
+ **************************************************************************************************/
+static bool appSlotsImageVersion(int32_t slot, uint32_t *version)
+{
+  ApplicationData_t appInfo;
+  uint32_t bootloaderVersion;
+
+  if ((slot == APP_SLOTS_NONE)
+      || (bootloader_verifyImage((uint32_t)slot, NULL) != BOOTLOADER_OK)
+      || (bootloader_getImageInfo((uint32_t)slot, &appInfo, &bootloaderVersion) != BOOTLOADER_OK)) {
+    return false;
+  }
+  *version = appInfo.version;
+  return true;
+}
+
+/***********************************************************************************************//**
+ *  \brief  The image on trial has not confirmed itself in time.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void appSlotsTimeout(void *arg)
+{
+  (void)arg;
+
+  printLog("image not confirmed within %u s\r\n", APP_SLOTS_CONFIRM_TIMEOUT_MS / 1000);
+  appSlotsRollback();
+}
+
+/***********************************************************************************************//**
+ *  \brief  Start the watchdog on the ULFRCO. It runs in EM2 and EM3, so a hang in any energy mode
+ *  resets the image on trial and counts as a failed boot.
+ **************************************************************************************************/
+static void appSlotsWdogStart(void)
+{
+  CMU_ClockEnable(cmuClock_HFLE, true);
+
+  while (WDOG0->SYNCBUSY & WDOG_SYNCBUSY_CTRL) ;
+  WDOG0->CTRL = WDOG_CTRL_CLKSEL_ULFRCO
+                | ((uint32_t)APP_SLOTS_WDOG_PERSEL << _WDOG_CTRL_PERSEL_SHIFT)
+                | WDOG_CTRL_EM2RUN
+                | WDOG_CTRL_EM3RUN
+                | WDOG_CTRL_EN;
+
+  appTimerStart(&appSlotsWdogTimer, APP_SLOTS_WDOG_FEED_MS, APP_SLOTS_WDOG_FEED_MS / 2, true,
+                appSlotsWdogFeed, NULL);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Stop the watchdog.
+ **************************************************************************************************/
+static void appSlotsWdogStop(void)
+{
+  appTimerStop(&appSlotsWdogTimer);
+
+  while (WDOG0->SYNCBUSY & WDOG_SYNCBUSY_CTRL) ;
+  WDOG0->CTRL &= ~WDOG_CTRL_EN;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Clear the watchdog. A clear still being synchronized to the ULFRCO is not repeated.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void appSlotsWdogFeed(void *arg)
+{
+  (void)arg;
+
+  if (!(WDOG0->SYNCBUSY & WDOG_SYNCBUSY_CMD)) {
+    WDOG0->CMD = WDOG_CMD_CLEAR;
+  }
+}
+
+/** @} (end addtogroup app_slots) */
+/** @} (end addtogroup Application) */
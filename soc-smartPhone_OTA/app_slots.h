@@ -0,0 +1,141 @@
+/***************************************************************************//**
+ * @file
+ * @brief A/B image slots header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_SLOTS_H
+#define APP_SLOTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup app_slots A/B Image Slots
+ * \brief Download slot selection, boot confirmation and rollback of OTA images.
+ *
+ * The bootloader keeps two storage slots. One holds the image that is running and has been
+ * confirmed, the other receives the next download. An installed image runs on trial: it must call
+ * appSlotsConfirm() within APP_SLOTS_CONFIRM_TIMEOUT_MS of boot, and a watchdog resets it if it
+ * hangs. If it is not confirmed, or it resets APP_SLOTS_MAX_ATTEMPTS times before being confirmed,
+ * the confirmed image is installed again with bootloader_setImagesToBootload().
+ *
+ * A confirmed copy exists once an image has been installed through OTA and confirmed. An image
+ * flashed by cable has no copy in storage, the first trial after it cannot be rolled back. With a
+ * single slot, as in the internal flash bootloader configuration, there is never a copy.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_slots
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** PS key of the slot state, in the user range 0x4000 to 0x407F. */
+#ifndef APP_SLOTS_PS_KEY
+#define APP_SLOTS_PS_KEY              0x4000
+#endif
+
+/** Time from boot in ms for an image on trial to confirm itself. */
+#ifndef APP_SLOTS_CONFIRM_TIMEOUT_MS
+#define APP_SLOTS_CONFIRM_TIMEOUT_MS  60000
+#endif
+
+/** Boots an image on trial gets to confirm itself, resets in between count as failed boots. */
+#ifndef APP_SLOTS_MAX_ATTEMPTS
+#define APP_SLOTS_MAX_ATTEMPTS        3
+#endif
+
+/** Watchdog period while on trial, 2^(PERSEL + 3) + 1 ULFRCO cycles. 10 is about 8 s. */
+#ifndef APP_SLOTS_WDOG_PERSEL
+#define APP_SLOTS_WDOG_PERSEL         10
+#endif
+
+/** Slot number for no slot. */
+#define APP_SLOTS_NONE                (-1)
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Slot state. */
+typedef enum {
+  APP_SLOTS_IDLE = 0,     /**< Running image is confirmed. */
+  APP_SLOTS_PENDING,      /**< Image downloaded and set to install, reboot follows. */
+  APP_SLOTS_TRIAL         /**< Installed image is running and has not been confirmed yet. */
+} appSlotsState_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Load the slot state and start a trial if an image has just been installed.
+ *  \details  Called after bootloader_init(). Rolls back, and does not return, if the image on trial
+ *  has used up its boot attempts.
+ *  \param[in]  numSlots  Number of bootloader storage slots.
+ **************************************************************************************************/
+void appSlotsInit(uint32_t numSlots);
+
+/***********************************************************************************************//**
+ *  \brief  Get the slot state.
+ *  \return  Slot state.
+ **************************************************************************************************/
+appSlotsState_t appSlotsGetState(void);
+
+/***********************************************************************************************//**
+ *  \brief  Get the slot for the next download.
+ *  \return  Slot number, APP_SLOTS_NONE while an image is on trial.
+ **************************************************************************************************/
+int32_t appSlotsDownloadSlot(void);
+
+/***********************************************************************************************//**
+ *  \brief  Set the downloaded image to be installed, with the confirmed image as fallback.
+ *  \details  The bootloader installs the first image in the list that verifies, a download that is
+ *  corrupt falls back to the confirmed image without running.
+ *  \return  0 on success, otherwise a bootloader error code
+ **************************************************************************************************/
+int32_t appSlotsInstall(void);
+
+/***********************************************************************************************//**
+ *  \brief  Mark the running image healthy. It becomes the fallback for the next download.
+ *  \return  true if an image on trial was confirmed, false if there was nothing to confirm
+ **************************************************************************************************/
+bool appSlotsConfirm(void);
+
+/***********************************************************************************************//**
+ *  \brief  Install the confirmed image and reboot. Returns only if there is none.
+ **************************************************************************************************/
+void appSlotsRollback(void);
+
+/** @} (end addtogroup app_slots) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_SLOTS_H */
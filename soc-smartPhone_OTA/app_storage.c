@@ -0,0 +1,581 @@
+/***************************************************************************//**
+ * @file
+ * @brief External flash storage
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#include "native_gecko.h"
+#include "infrastructure.h"
+
+/* em library */
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_rtcc.h"
+
+/* drivers */
+#include "mx25flash_spi.h"
+
+/* application specific headers */
+#include "app.h"
+#include "app_timer.h"
+#include "app_clock.h"
+
+/* Own header */
+#include "app_storage.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_storage
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+
+/** Log geometry. */
+#define APP_STORAGE_LOG_SECTORS       (APP_STORAGE_LOG_SIZE / Sector_Offset)
+#define APP_STORAGE_LOG_PER_SECTOR    (Sector_Offset / sizeof(appStorageLogRecord_t))
+#define APP_STORAGE_LOG_RECORDS       (APP_STORAGE_LOG_SECTORS * APP_STORAGE_LOG_PER_SECTOR)
+#define APP_STORAGE_LOG_RECORD_ADDRESS(pos) \
+  (APP_STORAGE_LOG_ADDRESS + (pos) * sizeof(appStorageLogRecord_t))
+
+/** Sequence number of an erased record. */
+#define APP_STORAGE_ERASED_SEQ        0xFFFFFFFFUL
+/** Seed of the record check byte, an erased record does not check. */
+#define APP_STORAGE_CHECK_SEED        0xA5
+
+/** Longest time the flash can stay busy, a 64 kB block erase. */
+#define APP_STORAGE_READY_TIMEOUT_MS  4000
+
+#if (APP_STORAGE_LOG_ADDRESS + APP_STORAGE_LOG_SIZE) > FlashSize
+#error "APP_STORAGE slots and log do not fit the MX25"
+#endif
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+/** MX25 driver has been initialized. */
+static bool appStorageStarted = false;
+/** Flash is out of deep power-down. */
+static bool appStorageAwake = false;
+/** Puts the flash back into deep power-down. */
+static appTimer_t appStorageIdleTimer;
+
+/** Background erase, the range still to be erased and the completion callback. */
+static bool appStorageErasing = false;
+static uint32_t appStorageEraseAddress = 0;
+static uint32_t appStorageEraseEnd = 0;
+static appStorageCback_t appStorageEraseCback = NULL;
+static appTimer_t appStorageEraseTimer;
+
+/** Flash identified and the log scanned. */
+static bool appStorageLogReady = false;
+/** Log position of the next record to be written. */
+static uint32_t appStorageLogHead = 0;
+/** Sequence numbers of the next record and of the oldest record. */
+static uint32_t appStorageLogNextSeq = 0;
+static uint32_t appStorageLogFirstSeq = 0;
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+
+static void appStorageWake(void);
+static void appStorageSleep(void *arg);
+static int32_t appStorageWaitReady(void);
+static int32_t appStorageEraseNext(void);
+static void appStorageEraseStep(void);
+static void appStorageEraseFinish(void);
+static int32_t appStorageEraseWait(uint32_t address, uint32_t len);
+static void appStorageEraseTick(void *arg);
+static void appStorageLogEraseAhead(uint32_t pos);
+static uint32_t appStorageLogSeqAt(uint32_t pos);
+static uint8_t appStorageLogCheck(const appStorageLogRecord_t *record);
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+bool appStorageInit(void)
+{
+  uint32_t id = 0;
+  uint32_t sector;
+  uint32_t seq;
+  uint32_t headSeq = 0;
+  uint32_t headSector = 0;
+  uint32_t lo;
+  uint32_t hi;
+  uint32_t mid;
+  bool used = false;
+
+  appStorageWake();
+
+  MX25_RDID(&id);
+  if (id != FlashID) {
+    printLog("MX25: unexpected ID %06lx\r\n", (unsigned long)id);
+    return false;
+  }
+
+  /* The head sector holds the newest record, the log is empty if no sector has been written */
+  for (sector = 0; sector < APP_STORAGE_LOG_SECTORS; sector++) {
+    seq = appStorageLogSeqAt(sector * APP_STORAGE_LOG_PER_SECTOR);
+    if (seq == APP_STORAGE_ERASED_SEQ) {
+      continue;
+    }
+    if (!used || (seq > headSeq)) {
+      headSeq = seq;
+      headSector = sector;
+    }
+    if (!used || (seq < appStorageLogFirstSeq)) {
+      appStorageLogFirstSeq = seq;
+    }
+    used = true;
+  }
+
+  if (used) {
+    /* Records are written in order, find the first erased one in the head sector */
+    lo = 1;
+    hi = APP_STORAGE_LOG_PER_SECTOR;
+    while (lo < hi) {
+      mid = (lo + hi) / 2;
+      if (appStorageLogSeqAt(headSector * APP_STORAGE_LOG_PER_SECTOR + mid) == APP_STORAGE_ERASED_SEQ) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    appStorageLogHead = (headSector * APP_STORAGE_LOG_PER_SECTOR + lo) % APP_STORAGE_LOG_RECORDS;
+    appStorageLogNextSeq = headSeq + lo;
+  }
+
+  appStorageLogReady = true;
+
+  printLog("MX25: %u slots of %lu bytes, log %lu records\r\n", APP_STORAGE_SLOT_COUNT,
+           (unsigned long)APP_STORAGE_SLOT_SIZE, (unsigned long)appStorageLogCount());
+  return true;
+}
+
+int32_t appStorageRead(uint32_t address, uint8_t *data, uint32_t len)
+{
+  int32_t err;
+
+  if ((address + len) > FlashSize) {
+    return FlashAddressInvalid;
+  }
+
+  appStorageWake();
+  err = appStorageEraseWait(address, len);
+  if (err != FlashOperationSuccess) {
+    return err;
+  }
+
+  return MX25_FASTREAD(address, data, len);
+}
+
+int32_t appStorageWrite(uint32_t address, const uint8_t *data, uint32_t len)
+{
+  uint32_t chunk;
+  int32_t err;
+
+  if ((address + len) > FlashSize) {
+    return FlashAddressInvalid;
+  }
+
+  appStorageWake();
+  err = appStorageEraseWait(address, len);
+  if (err != FlashOperationSuccess) {
+    return err;
+  }
+
+  /* A page program wraps within the page, so the data is split at page boundaries. Each page
+   * is programmed while the next one is sent, the last one while the caller goes on. */
+  while (len) {
+    chunk = MIN(len, Page_Offset - (address % Page_Offset));
+    err = appStorageWaitReady();
+    if (err == FlashOperationSuccess) {
+      err = MX25_PP(address, (uint8_t *)data, chunk);
+    }
+    if (err != FlashOperationSuccess) {
+      return err;
+    }
+    address += chunk;
+    data += chunk;
+    len -= chunk;
+  }
+
+  return FlashOperationSuccess;
+}
+
+int32_t appStorageErase(uint32_t address, uint32_t len)
+{
+  uint32_t end = address + len;
+  int32_t err;
+
+  if ((address % Sector_Offset) || (end > FlashSize)) {
+    return FlashAddressInvalid;
+  }
+
+  appStorageWake();
+  appStorageEraseFinish();
+
+  appStorageEraseAddress = address;
+  appStorageEraseEnd = end;
+  while (appStorageEraseAddress < appStorageEraseEnd) {
+    err = appStorageEraseNext();
+    if (err != FlashOperationSuccess) {
+      return err;
+    }
+  }
+
+  return appStorageWaitReady();
+}
+
+int32_t appStorageEraseStart(uint32_t address, uint32_t len, appStorageCback_t cback)
+{
+  uint32_t end = address + len;
+
+  if ((address % Sector_Offset) || (end > FlashSize)) {
+    return FlashAddressInvalid;
+  }
+
+  appStorageWake();
+  appStorageEraseFinish();
+
+  appStorageEraseAddress = address;
+  appStorageEraseEnd = end;
+  appStorageEraseCback = cback;
+  appStorageErasing = true;
+
+  appTimerStart(&appStorageEraseTimer, APP_STORAGE_POLL_MS, APP_STORAGE_POLL_MS / 2, true,
+                appStorageEraseTick, NULL);
+
+  return FlashOperationSuccess;
+}
+
+int32_t appStorageSync(void)
+{
+  appStorageWake();
+  return appStorageWaitReady();
+}
+
+bool appStorageInSlots(uint32_t address, uint32_t len)
+{
+  return (address >= APP_STORAGE_SLOT_ADDRESS(0)) && ((address + len) <= APP_STORAGE_LOG_ADDRESS);
+}
+
+int32_t appStorageLogAppend(appStorageLogRecord_t *record)
+{
+  uint32_t pos = appStorageLogHead;
+  int32_t err;
+
+  if (!appStorageLogReady) {
+    return FlashAddressInvalid;
+  }
+
+  /* Entering a sector that was not erased ahead, after a reset or a failed erase */
+  if (!(pos % APP_STORAGE_LOG_PER_SECTOR)
+      && (appStorageLogSeqAt(pos) != APP_STORAGE_ERASED_SEQ)) {
+    appStorageLogEraseAhead(pos);
+    err = appStorageWaitReady();
+    if (err != FlashOperationSuccess) {
+      return err;
+    }
+  }
+
+  record->seq = appStorageLogNextSeq;
+  record->timestamp = appClockGet(NULL);
+  record->check = appStorageLogCheck(record);
+
+  err = appStorageWrite(APP_STORAGE_LOG_RECORD_ADDRESS(pos), (const uint8_t *)record,
+                        sizeof(*record));
+  if (err != FlashOperationSuccess) {
+    return err;
+  }
+
+  appStorageLogHead = (pos + 1) % APP_STORAGE_LOG_RECORDS;
+  appStorageLogNextSeq++;
+
+  /* Sector full, erase the next one now so that the next append does not wait for it */
+  if (!(appStorageLogHead % APP_STORAGE_LOG_PER_SECTOR)) {
+    appStorageLogEraseAhead(appStorageLogHead);
+  }
+
+  return FlashOperationSuccess;
+}
+
+int32_t appStorageLogRead(uint32_t index, appStorageLogRecord_t *record)
+{
+  uint32_t pos;
+  int32_t err;
+
+  if (index >= appStorageLogCount()) {
+    return FlashAddressInvalid;
+  }
+
+  /* Sequence numbers are consecutive around the ring, the record is counted back from the head */
+  pos = (appStorageLogHead + APP_STORAGE_LOG_RECORDS - (appStorageLogCount() - index))
+        % APP_STORAGE_LOG_RECORDS;
+
+  err = appStorageRead(APP_STORAGE_LOG_RECORD_ADDRESS(pos), (uint8_t *)record, sizeof(*record));
+  if (err != FlashOperationSuccess) {
+    return err;
+  }
+
+  if ((record->seq != appStorageLogFirstSeq + index)
+      || (record->check != appStorageLogCheck(record))) {
+    return FlashAddressInvalid;
+  }
+
+  return FlashOperationSuccess;
+}
+
+uint32_t appStorageLogCount(void)
+{
+  return appStorageLogNextSeq - appStorageLogFirstSeq;
+}
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Bring the flash out of deep power-down and restart the idle timer.
+ *  \details  The driver is set up on first use. Afterwards only the USART clock is gated while the
+ *  flash sleeps, the pins and the USART configuration are kept.
+ **************************************************************************************************/
+static void appStorageWake(void)
+{
+  if (!appStorageStarted) {
+    MX25_init();
+    /* Program and erase return once issued, completion is waited for by appStorageWaitReady() */
+    MX25_SetAsyncIO(true);
+    appStorageStarted = true;
+  } else if (!appStorageAwake) {
+    CMU_ClockEnable(MX25_USART_CLK, true);
+  }
+
+  if (!appStorageAwake) {
+    /* initBoard() left the flash in deep power-down */
+    MX25_RDP();
+    appStorageAwake = true;
+  }
+
+  appTimerStart(&appStorageIdleTimer, APP_STORAGE_IDLE_MS, APP_STORAGE_IDLE_MS, false,
+                appStorageSleep, NULL);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Idle timer callback, puts the flash into deep power-down.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void appStorageSleep(void *arg)
+{
+  (void)arg;
+
+  /* Deep power-down is not accepted while a program or erase is in progress */
+  if (appStorageErasing || MX25_IsBusy()) {
+    appTimerStart(&appStorageIdleTimer, APP_STORAGE_IDLE_MS, APP_STORAGE_IDLE_MS, false,
+                  appStorageSleep, NULL);
+    return;
+  }
+
+  MX25_DP();
+  CMU_ClockEnable(MX25_USART_CLK, false);
+  appStorageAwake = false;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Wait for a program or erase to complete.
+ *  \details  The status register is read once per RTCC tick rather than back to back, so the bus
+ *  and the flash are mostly idle while a page is programmed.
+ *  \return  0 when the flash is ready, FlashTimeOut otherwise
+ **************************************************************************************************/
+static int32_t appStorageWaitReady(void)
+{
+  uint32_t start = RTCC_CounterGet();
+  uint32_t limit = APP_STORAGE_READY_TIMEOUT_MS * (CMU_ClockFreqGet(cmuClock_RTCC) / 1000);
+  uint32_t tick;
+
+  while (MX25_IsBusy()) {
+    tick = RTCC_CounterGet();
+    if ((tick - start) > limit) {
+      return FlashTimeOut;
+    }
+    while (RTCC_CounterGet() == tick) {
+    }
+  }
+
+  return FlashOperationSuccess;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Issue the erase of the next block or sector of the erase range.
+ *  \return  0 on success, otherwise a ReturnMsg error code
+ **************************************************************************************************/
+static int32_t appStorageEraseNext(void)
+{
+  uint32_t address = appStorageEraseAddress;
+  int32_t err;
+
+  err = appStorageWaitReady();
+  if (err != FlashOperationSuccess) {
+    return err;
+  }
+
+  if (!(address % Block_Offset) && ((appStorageEraseEnd - address) >= Block_Offset)) {
+    appStorageEraseAddress += Block_Offset;
+    return MX25_BE(address);
+  }
+
+  appStorageEraseAddress += Sector_Offset;
+  return MX25_SE(address);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Issue the next erase of the background range, or complete the background erase.
+ **************************************************************************************************/
+static void appStorageEraseStep(void)
+{
+  appStorageCback_t cback = appStorageEraseCback;
+  int32_t err;
+
+  if (appStorageEraseAddress < appStorageEraseEnd) {
+    err = appStorageEraseNext();
+    if (err == FlashOperationSuccess) {
+      return;
+    }
+  } else {
+    err = appStorageWaitReady();
+  }
+
+  appStorageErasing = false;
+  appStorageEraseCback = NULL;
+  appTimerStop(&appStorageEraseTimer);
+  if (cback) {
+    cback(err);
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Complete a background erase before the flash is accessed.
+ **************************************************************************************************/
+static void appStorageEraseFinish(void)
+{
+  while (appStorageErasing) {
+    appStorageEraseStep();
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Make a range ready for access while a background erase may be running.
+ *  \details  The part of the erase range below the access is erased first, the flash cannot be
+ *  accessed during an erase either way. An access outside of the range still to be erased only waits
+ *  for the block or sector being erased, the background erase then goes on.
+ *  \param[in]  address  Start of the access.
+ *  \param[in]  len  Length of the access in bytes.
+ *  \return  0 when the flash is ready, otherwise a ReturnMsg error code
+ **************************************************************************************************/
+static int32_t appStorageEraseWait(uint32_t address, uint32_t len)
+{
+  while (appStorageErasing && ((address + len) > appStorageEraseAddress)
+         && (address < appStorageEraseEnd)) {
+    appStorageEraseStep();
+  }
+
+  return appStorageWaitReady();
+}
+
+/***********************************************************************************************//**
+ *  \brief  Background erase timer callback, moves on once the flash is ready.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void appStorageEraseTick(void *arg)
+{
+  (void)arg;
+
+  if (!MX25_IsBusy()) {
+    appStorageEraseStep();
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Issue the erase of a log sector, dropping its records.
+ *  \param[in]  pos  Log position of the first record of the sector.
+ **************************************************************************************************/
+static void appStorageLogEraseAhead(uint32_t pos)
+{
+  if (appStorageLogSeqAt(pos) != APP_STORAGE_ERASED_SEQ) {
+    if ((appStorageWaitReady() != FlashOperationSuccess)
+        || (MX25_SE(APP_STORAGE_LOG_RECORD_ADDRESS(pos)) != FlashOperationSuccess)) {
+      return;
+    }
+  }
+
+  if ((appStorageLogNextSeq - appStorageLogFirstSeq)
+      > (APP_STORAGE_LOG_RECORDS - APP_STORAGE_LOG_PER_SECTOR)) {
+    appStorageLogFirstSeq = appStorageLogNextSeq
+                            - (APP_STORAGE_LOG_RECORDS - APP_STORAGE_LOG_PER_SECTOR);
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Read the sequence number of a log record.
+ *  \param[in]  pos  Log position.
+ *  \return  Sequence number, APP_STORAGE_ERASED_SEQ for an erased record or on a read error.
+ **************************************************************************************************/
+static uint32_t appStorageLogSeqAt(uint32_t pos)
+{
+  uint32_t seq;
+
+  if (appStorageRead(APP_STORAGE_LOG_RECORD_ADDRESS(pos), (uint8_t *)&seq, sizeof(seq))
+      != FlashOperationSuccess) {
+    return APP_STORAGE_ERASED_SEQ;
+  }
+
+  return seq;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Compute the check byte of a log record.
+ *  \param[in]  record  Record.
+ *  \return  XOR of all bytes but the check byte, seeded so that an erased record does not check.
+ **************************************************************************************************/
+static uint8_t appStorageLogCheck(const appStorageLogRecord_t *record)
+{
+  const uint8_t *p = (const uint8_t *)record;
+  uint8_t check = APP_STORAGE_CHECK_SEED;
+  uint32_t i;
+
+  for (i = 0; i < offsetof(appStorageLogRecord_t, check); i++) {
+    check ^= p[i];
+  }
+
+  return check;
+}
+
+/** @} (end addtogroup app_storage) */
+/** @} (end addtogroup Application) */
@@ -0,0 +1,193 @@
+/***************************************************************************//**
+ * @file
+ * @brief External flash storage header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_STORAGE_H
+#define APP_STORAGE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup app_storage External Flash Storage
+ * \brief OTA slots and a measurement log on the MX25 serial flash.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_storage
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Layout of the 1 MB MX25R8035F: the bootload info of the Gecko bootloader in the first 8 kB,
+ *  two OTA slots after it and the measurement log in the rest.
+ *
+ *  The slots must match those of the bootloader, bootloader-storage-spiflash-512k in this
+ *  repository, whose bootloader-slot-configuration.h has BTL_PLUGIN_STORAGE_NUM_SLOTS (2) so that
+ *  app_slots.c can keep the confirmed image while the next one is downloaded. ota.c takes the slot
+ *  addresses from the bootloader and refuses a slot that reaches into the log. */
+#ifndef APP_STORAGE_INFO_SIZE
+#define APP_STORAGE_INFO_SIZE         0x2000UL
+#endif
+#ifndef APP_STORAGE_SLOT_COUNT
+#define APP_STORAGE_SLOT_COUNT        2
+#endif
+#ifndef APP_STORAGE_SLOT_SIZE
+#define APP_STORAGE_SLOT_SIZE         0x70000UL
+#endif
+#define APP_STORAGE_SLOT_ADDRESS(slot) \
+  (APP_STORAGE_INFO_SIZE + (uint32_t)(slot) * APP_STORAGE_SLOT_SIZE)
+
+/** Measurement log, a ring of 4 kB sectors after the slots. */
+#define APP_STORAGE_LOG_ADDRESS       (APP_STORAGE_INFO_SIZE + APP_STORAGE_SLOT_COUNT * APP_STORAGE_SLOT_SIZE)
+#ifndef APP_STORAGE_LOG_SIZE
+#define APP_STORAGE_LOG_SIZE          0x1E000UL
+#endif
+
+/** The flash is put back into deep power-down when it has not been accessed for this long. */
+#ifndef APP_STORAGE_IDLE_MS
+#define APP_STORAGE_IDLE_MS           100
+#endif
+
+/** Status poll period of a background erase in ms. */
+#ifndef APP_STORAGE_POLL_MS
+#define APP_STORAGE_POLL_MS           10
+#endif
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Completion callback, called with 0 on success or a ReturnMsg error code. */
+typedef void (*appStorageCback_t)(int32_t err);
+
+/** Measurement log record, 16 bytes so that a record never straddles a page. */
+typedef struct {
+  uint32_t seq;           /**< Record sequence number, filled in by appStorageLogAppend(). */
+  uint32_t timestamp;     /**< Clock seconds, see appClockGet(), filled in by appStorageLogAppend(). */
+  int32_t temperature;    /**< Temperature in millidegrees Celsius. */
+  uint16_t humidity;      /**< Relative humidity in 0.01 %. */
+  uint8_t battery;        /**< Battery level in %. */
+  uint8_t check;          /**< Check byte, catches records torn by a reset. */
+} appStorageLogRecord_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Identify the flash and find the end of the measurement log.
+ *  \return  true if the MX25 answered with the expected ID, false otherwise
+ **************************************************************************************************/
+bool appStorageInit(void);
+
+/***********************************************************************************************//**
+ *  \brief  Read from the flash with fast read.
+ *  \param[in]  address  Flash address.
+ *  \param[out]  data  Buffer for the data.
+ *  \param[in]  len  Length of data in bytes.
+ *  \return  0 on success, otherwise a ReturnMsg error code
+ **************************************************************************************************/
+int32_t appStorageRead(uint32_t address, uint8_t *data, uint32_t len);
+
+/***********************************************************************************************//**
+ *  \brief  Program erased flash. The data is split at page boundaries.
+ *  \details  Returns once the last page program has been issued, it completes in the background.
+ *  \param[in]  address  Flash address.
+ *  \param[in]  data  Data to be written.
+ *  \param[in]  len  Length of data in bytes.
+ *  \return  0 on success, otherwise a ReturnMsg error code
+ **************************************************************************************************/
+int32_t appStorageWrite(uint32_t address, const uint8_t *data, uint32_t len);
+
+/***********************************************************************************************//**
+ *  \brief  Erase a sector aligned range, in 64 kB blocks where aligned and 4 kB sectors otherwise.
+ *  \details  Blocks for up to seconds, not to be called while a connection is open.
+ *  \param[in]  address  Start of the range, must be sector aligned.
+ *  \param[in]  len  Length of the range in bytes, rounded up to whole sectors.
+ *  \return  0 on success, otherwise a ReturnMsg error code
+ **************************************************************************************************/
+int32_t appStorageErase(uint32_t address, uint32_t len);
+
+/***********************************************************************************************//**
+ *  \brief  Erase a sector aligned range in the background.
+ *  \details  One block or sector is erased at a time. A timer polls the flash status and issues
+ *  the next erase, the stack runs in between. An access to a part of the range that has not been
+ *  erased yet first erases up to it, any other access waits only for the block or sector being
+ *  erased. Another erase first completes this one.
+ *  \param[in]  address  Start of the range, must be sector aligned.
+ *  \param[in]  len  Length of the range in bytes, rounded up to whole sectors.
+ *  \param[in]  cback  Called when the erase has completed or failed, may be NULL.
+ *  \return  0 if the erase was started, otherwise a ReturnMsg error code
+ **************************************************************************************************/
+int32_t appStorageEraseStart(uint32_t address, uint32_t len, appStorageCback_t cback);
+
+/***********************************************************************************************//**
+ *  \brief  Wait for the program or erase operation in progress to complete.
+ *  \details  A background erase goes on with the rest of its range afterwards.
+ *  \return  0 on success, otherwise a ReturnMsg error code
+ **************************************************************************************************/
+int32_t appStorageSync(void);
+
+/***********************************************************************************************//**
+ *  \brief  Check whether a range lies within one of the OTA slots.
+ *  \param[in]  address  Start of the range.
+ *  \param[in]  len  Length of the range in bytes.
+ *  \return  true if the range touches neither the bootload info nor the log
+ **************************************************************************************************/
+bool appStorageInSlots(uint32_t address, uint32_t len);
+
+/***********************************************************************************************//**
+ *  \brief  Append a record to the measurement log. The oldest sector is erased when the log wraps.
+ *  \param[in,out]  record  Record, the sequence number, timestamp and check byte are filled in.
+ *  \return  0 on success, otherwise a ReturnMsg error code
+ **************************************************************************************************/
+int32_t appStorageLogAppend(appStorageLogRecord_t *record);
+
+/***********************************************************************************************//**
+ *  \brief  Read a record from the measurement log.
+ *  \param[in]  index  Record index, 0 is the oldest record.
+ *  \param[out]  record  Record.
+ *  \return  0 on success, FlashAddressInvalid if there is no such record or it is corrupt
+ **************************************************************************************************/
+int32_t appStorageLogRead(uint32_t index, appStorageLogRecord_t *record);
+
+/***********************************************************************************************//**
+ *  \brief  Get the number of records in the measurement log.
+ *  \return  Number of records.
+ **************************************************************************************************/
+uint32_t appStorageLogCount(void);
+
+/** @} (end addtogroup app_storage) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_STORAGE_H */
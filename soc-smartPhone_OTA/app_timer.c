@@ -0,0 +1,509 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application timers
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#include "native_gecko.h"
+
+/* em library */
+#include "em_device.h"
+#include "em_rtcc.h"
+
+/* Own header */
+#include "app_timer.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+   Local Macros and Definitions
+ **************************************************************************************************/
+
+/* The timers are kept on a hierarchical timing wheel. Level 0 has one slot per wheel tick, each
+ * higher level has slots that are APP_TIMER_SLOTS times longer. A timer is queued on the lowest
+ * level that covers its deadline and is moved down a level (cascaded) when the wheel reaches the
+ * start of its slot. Only the nearest occupied slot is armed on the stack timer, so the number of
+ * wakeups does not depend on the number of timers. */
+
+/** Wheel tick in RTCC ticks, as a power of two. 32 ticks of the 32768 Hz RTCC is about 1 ms. */
+#define APP_TIMER_TICK_SHIFT          5
+/** Number of bits of the wheel time covered by one level. */
+#define APP_TIMER_LEVEL_BITS          5
+/** Number of slots per level. */
+#define APP_TIMER_SLOTS               (1UL << APP_TIMER_LEVEL_BITS)
+#define APP_TIMER_SLOT_MASK           (APP_TIMER_SLOTS - 1)
+/** Number of levels. Five levels of 32 slots cover 2^25 wheel ticks, about 9 hours. */
+#define APP_TIMER_LEVELS              5
+/** Longest delay that can be queued, longer timers are re-queued when they get there. */
+#define APP_TIMER_MAX_DELTA           ((1UL << (APP_TIMER_LEVEL_BITS * APP_TIMER_LEVELS)) - 1)
+/** Slot of a wheel time on a level. */
+#define APP_TIMER_SLOT(time, level)   (((time) >> (APP_TIMER_LEVEL_BITS * (level))) & APP_TIMER_SLOT_MASK)
+
+/** Convert msec to wheel ticks. */
+#define APP_TIMER_MS_2_WHEELTICK(ms)  ((uint32_t)(((uint64_t)(ms) * TIMER_CLK_FREQ / 1000) \
+                                                  >> APP_TIMER_TICK_SHIFT))
+
+/***************************************************************************************************
+   Local Variables
+ **************************************************************************************************/
+
+/** Timer lists, one per slot. */
+static appTimer_t *appTimerWheel[APP_TIMER_LEVELS][APP_TIMER_SLOTS];
+/** Occupied slots, one bit per slot. */
+static uint32_t appTimerOccupied[APP_TIMER_LEVELS];
+/** Last wheel tick that has been processed. */
+static uint32_t appTimerClock;
+/** Current wheel time, and the RTCC count it was last updated at. */
+static uint32_t appTimerTime;
+static uint32_t appTimerRtccRef;
+/** Wheel tick the stack timer is armed for. */
+static uint32_t appTimerArmedAt;
+static bool appTimerArmed = false;
+
+/***************************************************************************************************
+   Static Function Declarations
+ **************************************************************************************************/
+static uint32_t appTimerNow(void);
+static bool appTimerFirstSlot(uint8_t level, uint32_t base, uint32_t *tick, uint32_t *slot);
+static bool appTimerNext(uint32_t *next);
+static bool appTimerDue(uint32_t *due);
+static void appTimerSync(uint32_t now);
+static void appTimerLink(appTimer_t *timer, uint32_t base);
+static void appTimerUnlink(appTimer_t *timer);
+static void appTimerAdvance(uint32_t tick);
+static void appTimerCoalesce(uint32_t now);
+static void appTimerExpire(appTimer_t *list, uint32_t now);
+static void appTimerArm(uint32_t now);
+
+/***************************************************************************************************
+   Public Function Definitions
+ **************************************************************************************************/
+void appTimerInit(void)
+{
+  appTimerRtccRef = RTCC_CounterGet();
+  appTimerTime = 0;
+  appTimerClock = 0;
+  appTimerArmed = false;
+}
+
+void appTimerStart(appTimer_t *timer,
+                   uint32_t timeoutMs,
+                   uint32_t slackMs,
+                   bool periodic,
+                   appTimerCback_t cback,
+                   void *arg)
+{
+  uint32_t now = appTimerNow();
+
+  appTimerUnlink(timer);
+  appTimerSync(now);
+
+  timer->period = periodic ? APP_TIMER_MS_2_WHEELTICK(timeoutMs) : 0;
+  timer->slack = APP_TIMER_MS_2_WHEELTICK(slackMs);
+  timer->expiry = now + APP_TIMER_MS_2_WHEELTICK(timeoutMs);
+  timer->deadline = timer->expiry + timer->slack;
+  timer->cback = cback;
+  timer->arg = arg;
+
+  appTimerLink(timer, appTimerClock + 1);
+
+  /* Only an earlier deadline needs the stack timer to be moved */
+  if (!appTimerArmed || ((int32_t)(timer->deadline - appTimerArmedAt) < 0)) {
+    appTimerArm(now);
+  }
+}
+
+void appTimerStop(appTimer_t *timer)
+{
+  /* The stack timer is left armed, an early wakeup costs less than a stack command here */
+  appTimerUnlink(timer);
+}
+
+bool appTimerIsRunning(const appTimer_t *timer)
+{
+  return (timer->pprev != NULL);
+}
+
+void appTimerProcess(void)
+{
+  uint32_t now = appTimerNow();
+  uint32_t next;
+
+  appTimerArmed = false;
+
+  while (appTimerNext(&next) && ((int32_t)(next - now) <= 0)) {
+    appTimerAdvance(next);
+  }
+  appTimerSync(now);
+  appTimerCoalesce(now);
+  appTimerArm(now);
+}
+
+/***************************************************************************************************
+   Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Get the current wheel time.
+ *  \details  The wheel time is derived from the free running RTCC but kept in its own counter, so
+ *  it stays continuous when the RTCC count wraps.
+ *  \return  Wheel time in wheel ticks.
+ **************************************************************************************************/
+static uint32_t appTimerNow(void)
+{
+  uint32_t elapsed = RTCC_CounterGet() - appTimerRtccRef;
+
+  appTimerRtccRef += elapsed & ~((1UL << APP_TIMER_TICK_SHIFT) - 1);
+  appTimerTime += elapsed >> APP_TIMER_TICK_SHIFT;
+
+  return appTimerTime;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Find the first occupied slot of a level at or after a wheel tick.
+ *  \param[in]  level  Wheel level.
+ *  \param[in]  base  First wheel tick that has not been processed yet.
+ *  \param[out]  tick  Wheel tick the slot starts at.
+ *  \param[out]  slot  Slot index.
+ *  \return  false if the level is empty
+ **************************************************************************************************/
+static bool appTimerFirstSlot(uint8_t level, uint32_t base, uint32_t *tick, uint32_t *slot)
+{
+  uint32_t occupied = appTimerOccupied[level];
+  uint8_t shift = APP_TIMER_LEVEL_BITS * level;
+  uint32_t block;
+  uint32_t index;
+
+  if (0 == occupied) {
+    return false;
+  }
+
+  /* First slot boundary at or after base, then the first occupied slot from there */
+  block = (base >> shift) + ((base & ((1UL << shift) - 1)) ? 1 : 0);
+  index = block & APP_TIMER_SLOT_MASK;
+  occupied = (occupied >> index) | (occupied << ((APP_TIMER_SLOTS - index) & APP_TIMER_SLOT_MASK));
+  block += __CLZ(__RBIT(occupied));
+
+  *tick = block << shift;
+  *slot = block & APP_TIMER_SLOT_MASK;
+  return true;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Find the next wheel tick at which a slot has to be expired or cascaded.
+ *  \param[out]  next  Wheel tick of the next event.
+ *  \return  false if no timer is running
+ **************************************************************************************************/
+static bool appTimerNext(uint32_t *next)
+{
+  uint32_t base = appTimerClock + 1;
+  bool found = false;
+  uint8_t level;
+
+  for (level = 0; level < APP_TIMER_LEVELS; level++) {
+    uint32_t tick;
+    uint32_t slot;
+
+    if (appTimerFirstSlot(level, base, &tick, &slot)
+        && (!found || ((tick - base) < (*next - base)))) {
+      *next = tick;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Find the earliest deadline of the running timers.
+ *  \details  Only the first occupied slot of each level can hold it. Cascading a slot does not need
+ *  a wakeup of its own, appTimerProcess() catches up on the cascades when the deadline is reached.
+ *  Timers queued at APP_TIMER_MAX_DELTA are due at the end of their slot, to be re-queued.
+ *  \param[out]  due  Wheel tick of the earliest deadline.
+ *  \return  false if no timer is running
+ **************************************************************************************************/
+static bool appTimerDue(uint32_t *due)
+{
+  uint32_t base = appTimerClock + 1;
+  bool found = false;
+  uint8_t level;
+
+  for (level = 0; level < APP_TIMER_LEVELS; level++) {
+    const appTimer_t *timer;
+    uint32_t tick;
+    uint32_t slot;
+    uint32_t when;
+
+    if (!appTimerFirstSlot(level, base, &tick, &slot)) {
+      continue;
+    }
+
+    when = tick + ((1UL << (APP_TIMER_LEVEL_BITS * level)) - 1);
+    for (timer = appTimerWheel[level][slot]; timer; timer = timer->next) {
+      if ((int32_t)(timer->deadline - when) < 0) {
+        when = timer->deadline;
+      }
+    }
+    if ((int32_t)(when - tick) < 0) {
+      when = tick;
+    }
+
+    if (!found || ((when - base) < (*due - base))) {
+      *due = when;
+      found = true;
+    }
+  }
+
+  return found;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Move the wheel up to the current time without crossing any queued event.
+ *  \details  Nothing is queued between the processed tick and the next event, so the wheel can
+ *  skip ahead. This keeps new timers on the lowest possible level.
+ *  \param[in]  now  Current wheel time.
+ **************************************************************************************************/
+static void appTimerSync(uint32_t now)
+{
+  uint32_t next;
+  uint32_t target = now;
+
+  if (appTimerNext(&next) && ((int32_t)(next - 1 - now) < 0)) {
+    target = next - 1;
+  }
+  if ((int32_t)(target - appTimerClock) > 0) {
+    appTimerClock = target;
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Queue a timer on the wheel by its deadline.
+ *  \param[in]  timer  Timer to queue.
+ *  \param[in]  base  First wheel tick that has not been processed yet.
+ **************************************************************************************************/
+static void appTimerLink(appTimer_t *timer, uint32_t base)
+{
+  uint32_t when = timer->deadline;
+  uint32_t delta = when - base;
+  uint8_t level = 0;
+  appTimer_t **head;
+
+  if ((int32_t)delta < 0) {
+    when = base;
+    delta = 0;
+  } else if (delta > APP_TIMER_MAX_DELTA) {
+    when = base + APP_TIMER_MAX_DELTA;
+    delta = APP_TIMER_MAX_DELTA;
+  }
+
+  while ((level < (APP_TIMER_LEVELS - 1)) && (delta >> (APP_TIMER_LEVEL_BITS * (level + 1)))) {
+    level++;
+  }
+
+  timer->level = level;
+  timer->slot = APP_TIMER_SLOT(when, level);
+  head = &appTimerWheel[level][timer->slot];
+
+  timer->next = *head;
+  if (timer->next) {
+    timer->next->pprev = &timer->next;
+  }
+  timer->pprev = head;
+  *head = timer;
+
+  appTimerOccupied[level] |= (1UL << timer->slot);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Remove a timer from the wheel.
+ *  \param[in]  timer  Timer to remove.
+ **************************************************************************************************/
+static void appTimerUnlink(appTimer_t *timer)
+{
+  if (NULL == timer->pprev) {
+    return;
+  }
+
+  *timer->pprev = timer->next;
+  if (timer->next) {
+    timer->next->pprev = timer->pprev;
+  }
+  timer->pprev = NULL;
+  timer->next = NULL;
+
+  if (NULL == appTimerWheel[timer->level][timer->slot]) {
+    appTimerOccupied[timer->level] &= ~(1UL << timer->slot);
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Process one wheel tick: cascade the higher levels that start a new slot at this tick,
+ *  then expire the level 0 slot.
+ *  \param[in]  tick  Wheel tick to process.
+ **************************************************************************************************/
+static void appTimerAdvance(uint32_t tick)
+{
+  appTimer_t *list;
+  uint8_t level;
+
+  for (level = APP_TIMER_LEVELS - 1; level > 0; level--) {
+    uint32_t slot = APP_TIMER_SLOT(tick, level);
+
+    if (tick & ((1UL << (APP_TIMER_LEVEL_BITS * level)) - 1)) {
+      continue;
+    }
+
+    list = appTimerWheel[level][slot];
+    appTimerWheel[level][slot] = NULL;
+    appTimerOccupied[level] &= ~(1UL << slot);
+
+    while (list) {
+      appTimer_t *timer = list;
+      list = timer->next;
+      appTimerLink(timer, tick);
+    }
+  }
+
+  list = appTimerWheel[0][APP_TIMER_SLOT(tick, 0)];
+  appTimerWheel[0][APP_TIMER_SLOT(tick, 0)] = NULL;
+  appTimerOccupied[0] &= ~(1UL << APP_TIMER_SLOT(tick, 0));
+  appTimerClock = tick;
+
+  appTimerExpire(list, tick);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Expire the timers that have reached their earliest expiry time.
+ *  \details  The stack timer is armed for the nearest deadline, so when it fires other timers may
+ *  already be inside their slack window. Running them now saves a wakeup later on. A timer with a
+ *  long slack can still be queued on a higher level, so all levels are scanned.
+ *  \param[in]  now  Current wheel time.
+ **************************************************************************************************/
+static void appTimerCoalesce(uint32_t now)
+{
+  appTimer_t *due = NULL;
+  uint8_t level;
+
+  for (level = 0; level < APP_TIMER_LEVELS; level++) {
+    uint32_t occupied = appTimerOccupied[level];
+
+    while (occupied) {
+      uint32_t slot = __CLZ(__RBIT(occupied));
+      appTimer_t *timer = appTimerWheel[level][slot];
+
+      occupied &= ~(1UL << slot);
+
+      while (timer) {
+        appTimer_t *next = timer->next;
+
+        if ((int32_t)(timer->expiry - now) <= 0) {
+          appTimerUnlink(timer);
+          timer->next = due;
+          if (due) {
+            due->pprev = &timer->next;
+          }
+          due = timer;
+        }
+        timer = next;
+      }
+    }
+  }
+
+  appTimerExpire(due, now);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Reload periodic timers and call the callbacks of a list of expired timers.
+ *  \details  The list is detached from the wheel but stays linked through pprev, so callbacks can
+ *  start and stop any timer, including the ones that are still waiting on the list.
+ *  \param[in]  list  Expired timers.
+ *  \param[in]  now  Current wheel time.
+ **************************************************************************************************/
+static void appTimerExpire(appTimer_t *list, uint32_t now)
+{
+  appTimer_t *pending = list;
+
+  if (pending) {
+    pending->pprev = &pending;
+  }
+
+  while (pending) {
+    appTimer_t *timer = pending;
+
+    appTimerUnlink(timer);
+
+    if (timer->period) {
+      timer->expiry += timer->period;
+      if ((int32_t)(timer->expiry - now) <= 0) {
+        /* Missed one or more periods, restart from now */
+        timer->expiry = now + timer->period;
+      }
+      timer->deadline = timer->expiry + timer->slack;
+      appTimerLink(timer, appTimerClock + 1);
+    }
+
+    if (timer->cback) {
+      timer->cback(timer->arg);
+    }
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Arm the stack timer for the earliest deadline.
+ *  \param[in]  now  Current wheel time.
+ **************************************************************************************************/
+static void appTimerArm(uint32_t now)
+{
+  uint32_t next;
+  int32_t delta;
+
+  if (!appTimerDue(&next)) {
+    if (appTimerArmed) {
+      gecko_cmd_hardware_set_soft_timer(TIMER_STOP, APP_TIMER_HANDLE, true);
+      appTimerArmed = false;
+    }
+    return;
+  }
+
+  if (appTimerArmed && (next == appTimerArmedAt)) {
+    return;
+  }
+
+  delta = (int32_t)(next - now);
+  if (delta < 1) {
+    delta = 1;
+  }
+
+  gecko_cmd_hardware_set_soft_timer((uint32_t)delta << APP_TIMER_TICK_SHIFT, APP_TIMER_HANDLE, true);
+  appTimerArmedAt = next;
+  appTimerArmed = true;
+}
+
+/** @} (end addtogroup app) */
+/** @} (end addtogroup Application) */
@@ -22,6 +22,9 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+#include <stdbool.h>
+
 /***********************************************************************************************//**
  * @addtogroup Application
  * @{
@@ -43,29 +46,85 @@ extern "C" {
 /** Stop timer. */
 #define TIMER_STOP 0
 
-/** Application timer enumeration. */
-typedef enum {
-  /** Application UI timer.
-   *  This is an auto-reload timer used for timing LED and Button events. */
-  UI_TIMER = 0,
-  /** OTA timer.
-   *  This is a timer for logging performance statistics during OTA file upload . */
-  OTA_TIMER,
-  /** Advertisement timer.
-   *  This is a single-shot timer used to wait some time with advertisement stopped until changes
-   *  are registered in stack and we can advertise again with a different user defined advertising
-   *  message. */
-  ADV_TIMER,
-  /** Temperature measurement timer.
-   *  This is an auto-reload timer used for timing temperature measurements. */
-  TEMP_TIMER,
-  /** Display Polarity Inversion Timer
-  * Timer for toggling the the EXTCOMIN signal, which prevents building up a DC bias
-     within the Sharp memory LCD panel */
-  DISP_POL_INV_TIMER
+/** Handle of the stack soft timer all application timers are multiplexed on. */
+#define APP_TIMER_HANDLE 0
+
+/***************************************************************************************************
+   Data Types
+***************************************************************************************************/
+
+/** Application timer callback. */
+typedef void (*appTimerCback_t)(void *arg);
+
+/** Application timer.
+ *  Timers are allocated by the user, typically as static variables in the module that owns them,
+ *  and must not be modified directly. The fields are private to app_timer.c. */
+typedef struct appTimer {
+  struct appTimer *next;    /**< Next timer in the same wheel slot. */
+  struct appTimer **pprev;  /**< Link pointing to this timer, NULL if the timer is not running. */
+  uint32_t expiry;          /**< Earliest expiry time in wheel ticks. */
+  uint32_t deadline;        /**< Latest expiry time in wheel ticks (expiry + slack). */
+  uint32_t period;          /**< Reload period in wheel ticks, 0 for one-shot timers. */
+  uint32_t slack;           /**< Slack window in wheel ticks. */
+  appTimerCback_t cback;    /**< Callback function. */
+  void *arg;                /**< Callback argument. */
+  uint8_t level;            /**< Wheel level the timer is queued on. */
+  uint8_t slot;             /**< Wheel slot the timer is queued on. */
 } appTimer_t;
 
+/***************************************************************************************************
+   Public Function Declarations
+***************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Initialise the timer wheel. Must be called before any timer is started.
+ **************************************************************************************************/
+void appTimerInit(void);
+
+/***********************************************************************************************//**
+ *  \brief  Start or restart a timer.
+ *  \details  The callback is called from the stack event handler no earlier than timeoutMs and no
+ *  later than timeoutMs + slackMs after this call. A non-zero slack lets the timer expire together
+ *  with other timers and saves wakeups. Periodic timers are reloaded from their previous expiry
+ *  time, so they do not drift.
+ *  \param[in]  timer  Timer to start.
+ *  \param[in]  timeoutMs  Timeout in milliseconds, also the period of periodic timers.
+ *  \param[in]  slackMs  Allowed delay in milliseconds.
+ *  \param[in]  periodic  true for a periodic timer, false for a one-shot timer.
+ *  \param[in]  cback  Function to call on expiry.
+ *  \param[in]  arg  Argument passed to the callback.
+ **************************************************************************************************/
+void appTimerStart(appTimer_t *timer,
+                   uint32_t timeoutMs,
+                   uint32_t slackMs,
+                   bool periodic,
+                   appTimerCback_t cback,
+                   void *arg);
+
+/***********************************************************************************************//**
+ *  \brief  Stop a timer. Stopping a timer that is not running has no effect.
+ *  \param[in]  timer  Timer to stop.
+ **************************************************************************************************/
+void appTimerStop(appTimer_t *timer);
+
+/***********************************************************************************************//**
+ *  \brief  Check whether a timer is running.
+ *  \param[in]  timer  Timer to check.
+ *  \return  true if the timer is running
+ **************************************************************************************************/
+bool appTimerIsRunning(const appTimer_t *timer);
+
+/***********************************************************************************************//**
+ *  \brief  Expire due timers and re-arm the stack timer.
+ *  \details  Call on gecko_evt_hardware_soft_timer_id with handle APP_TIMER_HANDLE.
+ **************************************************************************************************/
+void appTimerProcess(void);
+
 /** @} (end addtogroup app) */
 /** @} (end addtogroup Application) */
 
+#ifdef __cplusplus
+};
+#endif
+
 #endif /* APP_TIMER_H */
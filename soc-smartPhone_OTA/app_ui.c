@@ -17,6 +17,7 @@
 
 /* standard headers */
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdio.h>
 
 /* Include feature header */
@@ -50,6 +51,7 @@
 
 /* application specific header files*/
 #include "app_timer.h"
+#include "app_boot.h"
 
 /* Own header */
 #include "app_ui.h"
@@ -74,6 +76,16 @@
                                       "Blue Gecko #00000 \n\n"
  #define APP_HEADER_SIZE              (sizeof(APP_HEADER_DEFAULT))
 
+/** Output level that lights an LED. On boards with LEDs and buttons on the same pins the LEDs are
+ *  active low, otherwise they follow the board's BSP_LED_POLARITY. */
+#if defined(FEATURE_LED_BUTTON_ON_SAME_PIN)
+#define APP_UI_LED_ON_LEVEL           0
+#elif defined(BSP_LED_POLARITY)
+#define APP_UI_LED_ON_LEVEL           BSP_LED_POLARITY
+#else
+#define APP_UI_LED_ON_LEVEL           1
+#endif
+
 /** UI Timer periodical call frequency in ms. */
 #define APP_UITIMER_PERIOD            100
 #define APP_RC_DISCHARGE_PERIOD       2
@@ -119,36 +131,24 @@ static struct {
 #ifdef FEATURE_LCD_SUPPORT
 /** Character array to hold the string to be printed on the graphical display. */
 static char appUiHeaderString[APP_HEADER_SIZE];
+/* Display has been initialized */
+static bool appUiDisplayReady = false;
 #endif /* FEATURE_LCD_SUPPORT */
 
 /** Off LED sequence and request. */
 static struct appUiLedStates appUiLedSeqOff[] = { { 0, 0 } };
 static struct appUiLedSeqReq appUiLedSeqOffReq = { appUiLedSeqOff, COUNTOF(appUiLedSeqOff) };
 
-/** Low alert LED sequence and request. */
-static struct appUiLedStates appUiLedSeqLowAlert[] = { { 1, 0 }, { 1, 0 },
-                                                       { 1, 0 }, { 1, 0 },
-                                                       { 1, 0 }, { 1, 0 },
-                                                       { 1, 0 }, { 1, 0 },
-                                                       { 0, 1 }, { 0, 1 },
-                                                       { 0, 1 }, { 0, 1 },
-                                                       { 0, 1 }, { 0, 1 },
-                                                       { 0, 1 }, { 0, 1 } };
-static struct appUiLedSeqReq appUiLedSeqLowAlertReq =
-{ appUiLedSeqLowAlert, COUNTOF(appUiLedSeqLowAlert) };
-
-/** High alert LED sequence and request. */
-static struct appUiLedStates appUiLedSeqHighAlert[] = { { 1, 0 }, { 1, 0 },
-                                                        { 0, 1 }, { 0, 1 } };
-static struct appUiLedSeqReq appUiLedSeqHighAlertReq =
-{ appUiLedSeqHighAlert, COUNTOF(appUiLedSeqHighAlert) };
-
 /** Request a sequence for driving the LEDs. */
 static struct appUiLedSeqReq *appUiLedSeqReq = NULL;
 
+/** UI Timer. */
+static appTimer_t appUiTimer;
+
 /***************************************************************************************************
    Static Function Declarations
  **************************************************************************************************/
+static void appUiTimerCback(void *arg);
 static void appUiLedTimerCback(void);
 static uint8_t appUiPushButtonsGet(uint8_t button);
 static void appUiButtonTimerCallback(void);
@@ -174,34 +174,52 @@ void appUiLedOff(void)
   appUiLedSeqReq = &appUiLedSeqOffReq;
 }
 
-void appUiLedLowAlert(void)
+void appUiLedDark(void)
 {
-  appUiLedSeqReq = &appUiLedSeqLowAlertReq;
+  if (APP_UI_LED_ON_LEVEL) {
+    GPIO_PinOutClear(BSP_LED0_PORT, BSP_LED0_PIN);
+    GPIO_PinOutClear(BSP_LED1_PORT, BSP_LED1_PIN);
+  } else {
+    GPIO_PinOutSet(BSP_LED0_PORT, BSP_LED0_PIN);
+    GPIO_PinOutSet(BSP_LED1_PORT, BSP_LED1_PIN);
+  }
 }
 
-void appUiLedHighAlert(void)
+bool appUiLedActiveLow(void)
 {
-  appUiLedSeqReq = &appUiLedSeqHighAlertReq;
+  return (APP_UI_LED_ON_LEVEL == 0);
 }
 
 void appUiInit(uint16_t devId)
 {
 #ifdef FEATURE_LED_BUTTON_ON_SAME_PIN
-  gecko_cmd_hardware_set_soft_timer(TIMER_MS_2_TIMERTICK(APP_UITIMER_PERIOD - APP_RC_DISCHARGE_PERIOD), UI_TIMER, false);
+  appTimerStart(&appUiTimer, APP_UITIMER_PERIOD - APP_RC_DISCHARGE_PERIOD, 0, false, appUiTimerCback, NULL);
 #else /* !BRD4300A */
   /* Initialise LEDs */
 printf("appUIInit\r\n");
   /* Initialize buttons */
   /* Start repeating (auto-load) timer */
-  gecko_cmd_hardware_set_soft_timer(TIMER_MS_2_TIMERTICK(APP_UITIMER_PERIOD), UI_TIMER, false);
+  appTimerStart(&appUiTimer, APP_UITIMER_PERIOD, 0, true, appUiTimerCback, NULL);
 #endif /* BRD4300A */
 
 #ifdef FEATURE_LCD_SUPPORT
   /* Initialize graphics */
   /* Create the device name string based on the device ID */
   snprintf(appUiHeaderString, APP_HEADER_SIZE, APP_HEADER, devId);
+  /* With fast start the display is initialized after advertising has started */
+  if (!appBootDeferring()) {
+    appUiDisplayInit();
+  }
+#endif /* BRD4301A */
+}
+
+void appUiDisplayInit(void)
+{
+#ifdef FEATURE_LCD_SUPPORT
   graphInit(appUiHeaderString);
+  appUiDisplayReady = true;
 #endif /* BRD4301A */
+  appBootMark(APP_BOOT_DISPLAY);
 }
 
 #ifdef FEATURE_LED_BUTTON_ON_SAME_PIN
@@ -218,7 +236,7 @@ void appUiTick(void)
     /* Initialize buttons */
     appUiButtonInit();
     /* Start a timer measuring a small time period, during which capacitors on GPIO ports can discharge */
-    gecko_cmd_hardware_set_soft_timer(TIMER_MS_2_TIMERTICK(APP_RC_DISCHARGE_PERIOD), UI_TIMER, false);
+    appTimerStart(&appUiTimer, APP_RC_DISCHARGE_PERIOD, 0, false, appUiTimerCback, NULL);
     appUiRcDischargeDone = true; /* Indicate discharge has been done */
   } else {
     /* Read button state*/
@@ -229,7 +247,7 @@ void appUiTick(void)
     appUiLedTimerCback();
 
     /* Restart timer */
-    gecko_cmd_hardware_set_soft_timer(TIMER_MS_2_TIMERTICK(APP_UITIMER_PERIOD - APP_RC_DISCHARGE_PERIOD), UI_TIMER, false);
+    appTimerStart(&appUiTimer, APP_UITIMER_PERIOD - APP_RC_DISCHARGE_PERIOD, 0, false, appUiTimerCback, NULL);
 
     /* Discharge needs to be done before next button read */
     appUiRcDischargeDone = false;
@@ -246,7 +264,10 @@ void appUiTick(void)
 void appUiWriteString(char *string)
 {
 #ifdef FEATURE_LCD_SUPPORT
-  graphWriteString(string);
+  /* Writes before the deferred display initialization are dropped */
+  if (appUiDisplayReady) {
+    graphWriteString(string);
+  }
 #endif /* BRD4301A */
 }
 
@@ -254,6 +275,16 @@ void appUiWriteString(char *string)
    Static Function Definitions
  **************************************************************************************************/
 
+/***********************************************************************************************//**
+ *  \brief  UI timer callback.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void appUiTimerCback(void *arg)
+{
+  (void)arg;
+  appUiTick();
+}
+
 /***********************************************************************************************//**
  *  \brief  Timer callback for driving the LEDs on the DK based on the requested sequence.
  **************************************************************************************************/
@@ -393,7 +424,7 @@ static void appUiLedsInit(void)
   GPIO_PinModeSet(BSP_LED1_PORT, BSP_LED1_PIN, gpioModePushPull, 1);
 }
 
-/* Output = 0 -> LED is on, Output = 1 -> LED is off */
+/* Output = 0 -> LED is on, Output = 1 -> LED is off, APP_UI_LED_ON_LEVEL is 0 on these boards */
 static void BSP_LedSet(uint8_t AppUiLedId)
 {
   switch (AppUiLedId) {
@@ -410,7 +441,7 @@ static void BSP_LedSet(uint8_t AppUiLedId)
   }
 }
 
-/* Output = 0 -> LED is on, Output = 1 -> LED is off */
+/* Output = 0 -> LED is on, Output = 1 -> LED is off, APP_UI_LED_ON_LEVEL is 0 on these boards */
 static void BSP_LedClear(uint8_t AppUiLedId)
 {
   switch (AppUiLedId) {
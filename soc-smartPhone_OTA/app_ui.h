@@ -99,14 +99,16 @@ void appUiBtnRegister(appUiBtnCback_t cback);
 void appUiLedOff(void);
 
 /***********************************************************************************************//**
- *  \brief  Switch on LEDs with low blinking frequency.
+ *  \brief  Drive both LED pins to their off level at once, for modules that take the pins over
+ *  from the LED sequences and hand them back.
  **************************************************************************************************/
-void appUiLedLowAlert(void);
+void appUiLedDark(void);
 
 /***********************************************************************************************//**
- *  \brief  Switch on LEDs with high blinking frequency.
+ *  \brief  LED polarity of the board.
+ *  \return  true if a low output lights an LED
  **************************************************************************************************/
-void appUiLedHighAlert(void);
+bool appUiLedActiveLow(void);
 
 /***********************************************************************************************//**
  *  \brief  Initialize buttons, graphics on the LCD and start repeating timer.
@@ -114,6 +116,12 @@ void appUiLedHighAlert(void);
  **************************************************************************************************/
 void appUiInit(uint16 devId);
 
+/***********************************************************************************************//**
+ *  \brief  Initialize graphics on the LCD. Called by appUiInit(), or after advertising has
+ *  started when the boot uses fast start.
+ **************************************************************************************************/
+void appUiDisplayInit(void);
+
 /***********************************************************************************************//**
  *  \brief  Periodic call for User Interface specific functions.
  **************************************************************************************************/
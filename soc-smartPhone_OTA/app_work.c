@@ -0,0 +1,244 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application deferred work queue
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#include "native_gecko.h"
+
+/* em library */
+#include "em_device.h"
+#include "em_core.h"
+
+/* Own header */
+#include "app_work.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_work
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+/** FIFO of queued items per priority. */
+static appWork_t *appWorkHead[APP_WORK_PRIO_COUNT];
+static appWork_t *appWorkTail[APP_WORK_PRIO_COUNT];
+/** The external signal has been raised and not handled yet. */
+static volatile bool appWorkSignalled = false;
+/** Slice budget in CPU cycles. */
+static uint32_t appWorkBudget;
+/** Statistics. */
+static appWorkStats_t appWorkStats;
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+static appWork_t *appWorkTake(void);
+static void appWorkSignal(void);
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+void appWorkInit(void)
+{
+  memset(&appWorkStats, 0, sizeof(appWorkStats));
+  appWorkBudget = (SystemCoreClockGet() / 1000000) * APP_WORK_SLICE_US;
+
+  /* Cycle counter is used for the slice budget */
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+bool appWorkPost(appWork_t *work, appWorkPrio_t prio, appWorkCback_t cback, void *arg)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if (work->queued) {
+    CORE_EXIT_ATOMIC();
+    return false;
+  }
+
+  work->cback = cback;
+  work->arg = arg;
+  work->prio = prio;
+  work->next = NULL;
+  work->queued = true;
+
+  if (appWorkTail[prio]) {
+    appWorkTail[prio]->next = work;
+  } else {
+    appWorkHead[prio] = work;
+  }
+  appWorkTail[prio] = work;
+  appWorkStats.posted++;
+
+  appWorkSignal();
+  CORE_EXIT_ATOMIC();
+
+  return true;
+}
+
+bool appWorkCancel(appWork_t *work)
+{
+  appWork_t *prev = NULL;
+  appWork_t *item;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if (!work->queued) {
+    CORE_EXIT_ATOMIC();
+    return false;
+  }
+
+  for (item = appWorkHead[work->prio]; item != work; item = item->next) {
+    prev = item;
+  }
+  if (prev) {
+    prev->next = work->next;
+  } else {
+    appWorkHead[work->prio] = work->next;
+  }
+  if (appWorkTail[work->prio] == work) {
+    appWorkTail[work->prio] = prev;
+  }
+  work->next = NULL;
+  work->queued = false;
+  CORE_EXIT_ATOMIC();
+
+  return true;
+}
+
+void appWorkProcess(uint32_t signals)
+{
+  uint32_t start = DWT->CYCCNT;
+  uint32_t elapsed = 0;
+  appWork_t *work;
+
+  if (0 == (signals & APP_WORK_SIGNAL)) {
+    return;
+  }
+
+  appWorkSignalled = false;
+  appWorkStats.slices++;
+
+  /* At least one item is run per slice, so a single item over the budget cannot stall the queue */
+  do {
+    uint32_t itemStart;
+    uint32_t itemCycles;
+
+    work = appWorkTake();
+    if (NULL == work) {
+      break;
+    }
+
+    itemStart = DWT->CYCCNT;
+    work->cback(work->arg);
+    itemCycles = DWT->CYCCNT - itemStart;
+
+    appWorkStats.run++;
+    if (itemCycles > appWorkStats.maxItemCycles) {
+      appWorkStats.maxItemCycles = itemCycles;
+    }
+    elapsed = DWT->CYCCNT - start;
+  } while (elapsed < appWorkBudget);
+
+  if (elapsed > appWorkBudget) {
+    appWorkStats.overruns++;
+  }
+  if (elapsed > appWorkStats.maxSliceCycles) {
+    appWorkStats.maxSliceCycles = elapsed;
+  }
+
+  /* Yield to the stack, the remaining work continues on the next signal event */
+  if (work) {
+    uint8_t prio;
+    CORE_DECLARE_IRQ_STATE;
+
+    CORE_ENTER_ATOMIC();
+    for (prio = 0; prio < APP_WORK_PRIO_COUNT; prio++) {
+      if (appWorkHead[prio]) {
+        appWorkSignal();
+        break;
+      }
+    }
+    CORE_EXIT_ATOMIC();
+  }
+}
+
+const appWorkStats_t *appWorkGetStats(void)
+{
+  return &appWorkStats;
+}
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Dequeue the highest priority item.
+ *  \return  Work item, or NULL if the queue is empty.
+ **************************************************************************************************/
+static appWork_t *appWorkTake(void)
+{
+  appWork_t *work = NULL;
+  uint8_t prio;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  for (prio = 0; prio < APP_WORK_PRIO_COUNT; prio++) {
+    work = appWorkHead[prio];
+    if (work) {
+      appWorkHead[prio] = work->next;
+      if (NULL == appWorkHead[prio]) {
+        appWorkTail[prio] = NULL;
+      }
+      work->next = NULL;
+      work->queued = false;
+      break;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+
+  return work;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Raise the external signal unless it is already pending. Called with interrupts masked.
+ **************************************************************************************************/
+static void appWorkSignal(void)
+{
+  if (!appWorkSignalled) {
+    appWorkSignalled = true;
+    gecko_external_signal(APP_WORK_SIGNAL);
+  }
+}
+
+/** @} (end addtogroup app_work) */
+/** @} (end addtogroup Application) */
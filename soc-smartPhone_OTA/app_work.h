@@ -0,0 +1,137 @@
+/***************************************************************************//**
+ * @file
+ * @brief Application deferred work queue header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef APP_WORK_H
+#define APP_WORK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup app_work Application Work Queue
+ * \brief Priority ordered deferred work, run between stack events.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup app_work
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** External signal bit used to schedule the work queue. */
+#define APP_WORK_SIGNAL               0x00000001UL
+
+/** Time budget of one slice of work in microseconds. Once it is used up the queue yields back to
+ *  the stack and continues after the pending stack events have been handled. */
+#ifndef APP_WORK_SLICE_US
+#define APP_WORK_SLICE_US             2000
+#endif
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Work priorities, highest first. */
+typedef enum {
+  APP_WORK_PRIO_HIGH = 0,
+  APP_WORK_PRIO_NORMAL,
+  APP_WORK_PRIO_LOW,
+  APP_WORK_PRIO_COUNT
+} appWorkPrio_t;
+
+/** Work callback. */
+typedef void (*appWorkCback_t)(void *arg);
+
+/** Work item. Items are owned by the caller and must stay valid while queued. */
+typedef struct appWork {
+  struct appWork *next;   /**< Next item of the same priority. */
+  appWorkCback_t cback;   /**< Work function. */
+  void *arg;              /**< Argument passed to the work function. */
+  uint8_t prio;           /**< Priority the item is queued at. */
+  bool queued;            /**< Item is waiting to be run. */
+} appWork_t;
+
+/** Work queue statistics. Cycle counts are CPU cycles. */
+typedef struct {
+  uint32_t posted;          /**< Number of items queued. */
+  uint32_t run;             /**< Number of items run. */
+  uint32_t slices;          /**< Number of slices. */
+  uint32_t overruns;        /**< Number of slices that went over the budget. */
+  uint32_t maxItemCycles;   /**< Longest single item. */
+  uint32_t maxSliceCycles;  /**< Longest slice. */
+} appWorkStats_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Initialize the work queue.
+ **************************************************************************************************/
+void appWorkInit(void);
+
+/***********************************************************************************************//**
+ *  \brief  Queue a work item. Can be called from interrupt context.
+ *  \param[in]  work  Work item.
+ *  \param[in]  prio  Priority.
+ *  \param[in]  cback  Work function.
+ *  \param[in]  arg  Argument passed to the work function.
+ *  \return  false if the item was already queued, in which case it is left unchanged
+ **************************************************************************************************/
+bool appWorkPost(appWork_t *work, appWorkPrio_t prio, appWorkCback_t cback, void *arg);
+
+/***********************************************************************************************//**
+ *  \brief  Remove a work item from the queue.
+ *  \param[in]  work  Work item.
+ *  \return  true if the item was queued
+ **************************************************************************************************/
+bool appWorkCancel(appWork_t *work);
+
+/***********************************************************************************************//**
+ *  \brief  Run queued work for one slice. To be called on the external signal event.
+ *  \details  Items run to completion in priority order until the slice budget is used up. Longer
+ *  jobs should be split into steps that post themselves again.
+ *  \param[in]  signals  External signals of the event.
+ **************************************************************************************************/
+void appWorkProcess(uint32_t signals);
+
+/***********************************************************************************************//**
+ *  \brief  Get the work queue statistics.
+ *  \return  Pointer to the statistics.
+ **************************************************************************************************/
+const appWorkStats_t *appWorkGetStats(void);
+
+/** @} (end addtogroup app_work) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* APP_WORK_H */
@@ -28,7 +28,8 @@
   #define KEEP_SYMBOL
 #endif
 
-/// Version number for this application (uint32_t)
+/// Version number for this application (uint32_t). Must change with every OTA image,
+/// app_slots.c tells an image on trial from the fallback by its version.
 #define APP_PROPERTIES_VERSION 1
 /// Unique ID (e.g. UUID or GUID) for the product this application is built for (uint8_t[16])
 #define APP_PROPERTIES_ID { 0 }
@@ -25,9 +25,15 @@
 #endif /* !HOST */
 #include "infrastructure.h"
 
+/* em library */
+#include "em_device.h"
+#include "em_cmu.h"
+
 /* plugin headers */
 #include "app_hw.h"
 #include "app.h"
+#include "app_timer.h"
+#include "gatt_map.h"
 
 /* Own header*/
 #include "batt.h"
@@ -46,27 +52,84 @@
   Local Macros and Definitions
 ***************************************************************************************************/
 
-#define DUMMY_BATT_LEVEL 		(99U)
-/** Battery measurement period in ms. */
-#define BATT_IND_TIMEOUT                SILABS_AF_PLUGIN_BATT_NOTIFICATION_INT
-
 /** Indicates currently there is no active connection using this service. */
 #define BATT_NO_CONNECTION                   0xFF
 
+/** ADC input, AVDD or an APORT channel behind the divider. */
+#ifndef BATT_ADC_POSSEL
+#define BATT_ADC_POSSEL                      ADC_SINGLECTRL_POSSEL_AVDD
+#endif
+
+/** Hardware oversampling, the ADC averages this many conversions into one result. */
+#ifndef BATT_ADC_OVERSAMPLING
+#define BATT_ADC_OVERSAMPLING                ADC_CTRL_OVSRSEL_X16
+#endif
+
+/** ADC clock upper limit in Hz. */
+#define BATT_ADC_CLOCK_MAX                   16000000UL
+
+/** Full scale of the oversampled result with the 5 V reference. */
+#define BATT_ADC_FULL_SCALE_MV               5000UL
+#define BATT_ADC_FULL_SCALE_COUNT            65536UL
+
+/** Conversion timeout in polling loops, 16 conversions take some 40 us. */
+#define BATT_ADC_TIMEOUT                     100000UL
+
+/** Weight of a new sample in the running average of the voltage, 1/2^n. */
+#define BATT_AVERAGE_SHIFT                   2
+
 /***************************************************************************************************
  Local Type Definitions
  **************************************************************************************************/
 
+/** Point of the discharge curve. */
+typedef struct {
+  uint16_t mV;    /**< Battery voltage in mV. */
+  uint8_t level;  /**< Battery level in %. */
+} battCurvePoint_t;
+
 /***************************************************************************************************
  Local Variables
  **************************************************************************************************/
 
-static uint8 battBatteryLevel = DUMMY_BATT_LEVEL; /* Battery Level */
+/** Discharge curve of a CR2032 coin cell at a light load, in descending voltage order. */
+static const battCurvePoint_t battCurve[] = {
+  { 3000, 100 },
+  { 2900, 80 },
+  { 2800, 60 },
+  { 2700, 40 },
+  { 2600, 25 },
+  { 2500, 15 },
+  { 2400, 8 },
+  { 2200, 3 },
+  { 2000, 0 }
+};
+
+static uint8 battBatteryLevel = 0; /* Battery Level */
+/** Battery level last notified to the client. */
+static uint8_t battNotifiedLevel = 0;
+/** Running average of the battery voltage in mV, 0 until the first measurement. */
+static uint32_t battVoltage = 0;
+/** Connection with notifications enabled. */
+static uint8_t battConnection = BATT_NO_CONNECTION;
+/** A notification failed for lack of buffers and is to be sent again. */
+static bool battNotifyPending = false;
+/** Measurement timer. */
+static appTimer_t battTimer;
+/** Notification retry timer. */
+static appTimer_t battRetryTimer;
 
 /***************************************************************************************************
  Static Function Declarations
  **************************************************************************************************/
 
+static void battAdcInit(void);
+static bool battAdcSample(uint32_t *pmV);
+static uint8_t battLevelFromVoltage(uint32_t mV);
+static void battNotify(void);
+static void battTimerTick(void *arg);
+static void battRetryTick(void *arg);
+
 /***************************************************************************************************
  Public Variable Definitions
  **************************************************************************************************/
@@ -78,58 +141,263 @@ static uint8 battBatteryLevel = DUMMY_BATT_LEVEL; /* Battery Level */
 
 void battInit(void)
 {
+  battConnection = BATT_NO_CONNECTION;
+  battNotifyPending = false;
+  appTimerStop(&battRetryTimer);
+
+  if (!battVoltage) {
+    battAdcInit();
+    battMeasure();
+    battNotifiedLevel = battBatteryLevel;
+  }
+
+  appTimerStart(&battTimer, BATT_MEASURE_PERIOD_MS, BATT_MEASURE_SLACK_MS, true,
+                battTimerTick, NULL);
 }
 
 void battCharStatusChange(uint8_t connection, uint16_t clientConfig)
 {
-/* if the new value of CCC is not 0 (either indication or notification enabled)
-   *  start battery level measurement */
-  if (clientConfig)
-  {
-// printLog("battCharStatusChange: battMeasure( clientConfig == %d )\r\n", clientConfig); flushLog();
-
-    battMeasure(); /* make an initial measurement */
+  /* if the new value of CCC is not 0 (either indication or notification enabled)
+   * send the current level, later levels are sent when they change */
+  if (clientConfig) {
+    battConnection = connection;
+    battNotify();
+  } else {
+    battConnection = BATT_NO_CONNECTION;
   }
 }
 
 void battMeasure(void)
 {
-//  if (battBatteryLevel  > 0){
-//	battBatteryLevel  -= 1;
-//  } else {
-//   /* Update battery level based on battery level sensor */
-//   battBatteryLevel = DUMMY_BATT_LEVEL;
-//  }
+  uint32_t mV;
+  uint8_t level;
 
-  /* Send notification */
-  gecko_cmd_gatt_server_send_characteristic_notification(
-	conGetConnectionId(), gattdb_battery_level, sizeof(battBatteryLevel), &battBatteryLevel);
-}
+  if (!battAdcSample(&mV)) {
+    printLog("battMeasure: ADC timeout\r\n");
+    return;
+  }
 
-void battRead(void)
-{
-  /* Update battery level based on battery level sensor */
-  if (battBatteryLevel < DUMMY_BATT_LEVEL){
-    battBatteryLevel += 1;//= DUMMY_BATT_LEVEL;
+  mV = mV * BATT_DIVIDER_NUM / BATT_DIVIDER_DEN;
+
+  /* Oversampling averages out the noise, the running average the load transients */
+  if (battVoltage) {
+    battVoltage = (uint32_t)((int32_t)battVoltage
+                             + (((int32_t)mV - (int32_t)battVoltage) >> BATT_AVERAGE_SHIFT));
+  } else {
+    battVoltage = mV;
   }
-  else {
-    battBatteryLevel =0;
+
+  level = battLevelFromVoltage(battVoltage);
+  battBatteryLevel = level;
+
+  /* Notify only when the level has moved past the hysteresis, or reached empty or full */
+  if ((level + BATT_NOTIFY_HYSTERESIS <= battNotifiedLevel)
+      || (level >= battNotifiedLevel + BATT_NOTIFY_HYSTERESIS)
+      || ((level != battNotifiedLevel) && ((level == 0) || (level == 100)))) {
+    battNotify();
   }
+}
 
+void battRead(void)
+{
   /* Send response to read request */
   gecko_cmd_gatt_server_send_user_read_response(conGetConnectionId(), gattdb_battery_level, 0,
 		  sizeof(battBatteryLevel), &battBatteryLevel);
 
-printLog("battReadP: batteryVoltagePct == %d \r\n", battBatteryLevel); flushLog(); // tmp
+  printLog("battRead: %d %% (%lu mV)\r\n", battBatteryLevel, (unsigned long)battVoltage); flushLog();
 }
 
 void battSet(int amount){
-// printLog(" battReset \r\n" ); flushLog();
 	battBatteryLevel = amount;
 
-	battMeasure(); // calls the cmd_gatt_server_send_characteristic_notification()
+	battNotify(); // calls the cmd_gatt_server_send_characteristic_notification()
 }
 
+uint8_t battGetLevel(void)
+{
+  return battBatteryLevel;
+}
+
+uint32_t battGetVoltage(void)
+{
+  return battVoltage;
+}
+
+void battStatus(const struct gecko_msg_gatt_server_characteristic_status_evt_t *pEvt)
+{
+  if (pEvt->status_flags != gatt_server_client_config) {
+    return;
+  }
+
+  printLog("battStatus: client_config_flags (%d) \r\n", pEvt->client_config_flags); flushLog();
+
+  battCharStatusChange(pEvt->connection, pEvt->client_config_flags);
+}
+
+void battReadRequest(const struct gecko_msg_gatt_server_user_read_request_evt_t *pEvt)
+{
+  (void)pEvt;
+  battRead();
+}
+
+void battWriteRequest(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt)
+{
+  battSet(pEvt->value.data[0]);
+
+  /* Send response to Write Request */
+  gecko_cmd_gatt_server_send_user_write_response(pEvt->connection, gattdb_battery_level, bg_err_success);
+
+  printLog("battWriteRequest: battery level = (%d) \r\n", pEvt->value.data[0]); flushLog();
+}
+
+/***************************************************************************************************
+ Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Configure ADC0 for a single oversampled conversion of the battery input.
+ *  \details  The ADC is warmed up for each conversion and is off in between, its clock is only
+ *  enabled while sampling.
+ **************************************************************************************************/
+static void battAdcInit(void)
+{
+  uint32_t hfperFreq;
+  uint32_t presc;
+  uint32_t timebase;
+
+  CMU_ClockEnable(cmuClock_ADC0, true);
+  hfperFreq = CMU_ClockFreqGet(cmuClock_HFPER);
+
+  /* ADC clock no faster than 16 MHz, timebase counts 1 us of HFPERCLK for the warm-up */
+  presc = (hfperFreq + BATT_ADC_CLOCK_MAX - 1) / BATT_ADC_CLOCK_MAX - 1;
+  timebase = (hfperFreq + 999999UL) / 1000000UL - 1;
+
+  ADC0->CTRL = ADC_CTRL_WARMUPMODE_NORMAL
+               | (presc << _ADC_CTRL_PRESC_SHIFT)
+               | (timebase << _ADC_CTRL_TIMEBASE_SHIFT)
+               | BATT_ADC_OVERSAMPLING;
+
+  /* Single ended against the internal 5 V reference, 16 bit oversampled result */
+  ADC0->SINGLECTRL = ADC_SINGLECTRL_RES_OVS
+                     | ADC_SINGLECTRL_REF_5V
+                     | BATT_ADC_POSSEL
+                     | ADC_SINGLECTRL_NEGSEL_VSS
+                     | ADC_SINGLECTRL_AT_16CYCLES;
+
+  CMU_ClockEnable(cmuClock_ADC0, false);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Run one oversampled conversion.
+ *  \param[out]  pmV  Voltage at the ADC input in mV.
+ *  \return  true if the conversion completed.
+ **************************************************************************************************/
+static bool battAdcSample(uint32_t *pmV)
+{
+  uint32_t timeout = BATT_ADC_TIMEOUT;
+  uint32_t sample;
+
+  CMU_ClockEnable(cmuClock_ADC0, true);
+
+  ADC0->CMD = ADC_CMD_SINGLESTART;
+  while (!(ADC0->STATUS & ADC_STATUS_SINGLEDV) && --timeout) {
+  }
+  sample = ADC0->SINGLEDATA;
+
+  CMU_ClockEnable(cmuClock_ADC0, false);
+
+  if (!timeout) {
+    return false;
+  }
+
+  *pmV = sample * BATT_ADC_FULL_SCALE_MV / BATT_ADC_FULL_SCALE_COUNT;
+  return true;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Map a battery voltage to a level on the discharge curve.
+ *  \param[in]  mV  Battery voltage in mV.
+ *  \return  Battery level in %.
+ **************************************************************************************************/
+static uint8_t battLevelFromVoltage(uint32_t mV)
+{
+  const battCurvePoint_t *hi;
+  const battCurvePoint_t *lo;
+  uint32_t i;
+
+  if (mV >= battCurve[0].mV) {
+    return battCurve[0].level;
+  }
+
+  /* Linear between the two points around the voltage */
+  for (i = 1; i < COUNTOF(battCurve); i++) {
+    if (mV >= battCurve[i].mV) {
+      hi = &battCurve[i - 1];
+      lo = &battCurve[i];
+      return (uint8_t)(lo->level + ((mV - lo->mV) * (hi->level - lo->level)) / (hi->mV - lo->mV));
+    }
+  }
+
+  return battCurve[COUNTOF(battCurve) - 1].level;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Notify the battery level if a client has enabled notifications.
+ **************************************************************************************************/
+static void battNotify(void)
+{
+  uint16_t result;
+
+  battNotifyPending = false;
+  if (battConnection == BATT_NO_CONNECTION) {
+    return;
+  }
+
+  /* Send notification */
+  result = gecko_cmd_gatt_server_send_characteristic_notification(
+    battConnection, gattdb_battery_level, sizeof(battBatteryLevel), &battBatteryLevel)->result;
+
+  if ((result == bg_err_invalid_conn_handle) || (result == bg_err_disconnected)
+      || (result == bg_err_bt_unknown_connection_identifier)) {
+    /* connection is gone, wait for the next CCCD write */
+    battConnection = BATT_NO_CONNECTION;
+    return;
+  }
+
+  if (result != bg_err_success) {
+    /* out of buffers, the level is sent again when the retry timer expires, as it is then */
+    battNotifyPending = true;
+    if (!appTimerIsRunning(&battRetryTimer)) {
+      appTimerStart(&battRetryTimer, BATT_NOTIFY_RETRY_MS, BATT_NOTIFY_RETRY_MS / 4, false,
+                    battRetryTick, NULL);
+    }
+    return;
+  }
+
+  battNotifiedLevel = battBatteryLevel;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Measurement timer callback.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void battTimerTick(void *arg)
+{
+  (void)arg;
+  battMeasure();
+}
+
+/***********************************************************************************************//**
+ *  \brief  Notification retry timer callback.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void battRetryTick(void *arg)
+{
+  (void)arg;
+  if (battNotifyPending) {
+    battNotify();
+  }
+}
 
 /** @} (end addtogroup batt) */
 /** @} (end addtogroup Features) */
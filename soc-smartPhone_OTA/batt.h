@@ -36,14 +36,40 @@ extern "C" {
   Public Macros and Definitions
 ***************************************************************************************************/
 
+/** Battery measurement period in ms. The timer slack lets the measurement share a wakeup. */
+#ifndef BATT_MEASURE_PERIOD_MS
+#define BATT_MEASURE_PERIOD_MS               60000
+#endif
+#ifndef BATT_MEASURE_SLACK_MS
+#define BATT_MEASURE_SLACK_MS                10000
+#endif
+
+/** Level change in % that triggers a notification. */
+#ifndef BATT_NOTIFY_HYSTERESIS
+#define BATT_NOTIFY_HYSTERESIS               2
+#endif
+
+/** Delay before a notification the stack had no buffer for is sent again, in ms. */
+#ifndef BATT_NOTIFY_RETRY_MS
+#define BATT_NOTIFY_RETRY_MS                 1000
+#endif
+
+/** Supply voltage divider in front of the ADC input, battery voltage = input * NUM / DEN. */
+#ifndef BATT_DIVIDER_NUM
+#define BATT_DIVIDER_NUM                     1
+#endif
+#ifndef BATT_DIVIDER_DEN
+#define BATT_DIVIDER_DEN                     1
+#endif
+
 /***************************************************************************************************
   Function Declarations
 ***************************************************************************************************/
 
 /***********************************************************************************************//**
  *  \brief  Initialise Battery Service.
- *  \details  Initialise the connection ID, the configuration flags of the temperature measurement
- *  and stop temperature measurement timer.
+ *  \details  Clear the notifying connection and start the periodic measurement. The ADC is set up
+ *  and the first measurement made on the first call.
  **************************************************************************************************/
 void battInit(void);
 
@@ -55,20 +81,32 @@ void battInit(void);
 void battCharStatusChange(uint8_t connection, uint16_t clientConfig);
 
 /***********************************************************************************************//**
- *  \brief  Make one battery measurement.
+ *  \brief  Make one battery measurement, notify the level if it moved by the hysteresis.
  **************************************************************************************************/
 void battMeasure(void);
 
 /***********************************************************************************************//**
- *  \brief  Read battery measurement.
+ *  \brief  Respond to a battery level read with the last measured level.
  **************************************************************************************************/
 void battRead(void);
 
 /***********************************************************************************************//**
- *  \brief  whatever.
+ *  \brief  Override the battery level until the next measurement, and notify it.
  **************************************************************************************************/
 void battSet(int);
 
+/***********************************************************************************************//**
+ *  \brief  Get the battery level.
+ *  \return  Battery level in %.
+ **************************************************************************************************/
+uint8_t battGetLevel(void);
+
+/***********************************************************************************************//**
+ *  \brief  Get the battery voltage.
+ *  \return  Averaged battery voltage in mV, 0 before the first measurement.
+ **************************************************************************************************/
+uint32_t battGetVoltage(void);
+
 /***********************************************************************************************//**
  *  \brief  whatever.
  **************************************************************************************************/
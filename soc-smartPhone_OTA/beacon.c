@@ -15,17 +15,26 @@
  *
  ******************************************************************************/
 
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
 /* BG stack headers */
 #include "bg_types.h"
 #include "native_gecko.h"
 #include "infrastructure.h"
 
-/* application specific headers*/
-#include "app_ui.h"
-
 /* Own header */
 #include "beacon.h"
 
+#if BCN_BROADCAST_ENCRYPT
+/* em library */
+#include "em_device.h"
+#include "em_cmu.h"
+#include "em_core.h"
+#include "em_crypto.h"
+#endif
+
 /***********************************************************************************************//**
  * @addtogroup Services
  * @{
@@ -40,9 +49,6 @@
  * Local Macros and Definitions
  **************************************************************************************************/
 
-/* Text definitions*/
-#define BCN_LCD_TEXT                        "\nB E A C O N\n\nM O D E\n"
-
 /* Flags */
 /** Length of Flags field of the Beacon. */
 #define BCN_FLAGS_LEN                       2
@@ -74,15 +80,78 @@
 #define BCN_UUID                            0xE2, 0xC5, 0x6D, 0xB5, 0xDF, 0xFB, 0x48, 0xD2, \
   0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0
 
+/* Sensor broadcast */
+/** Company ID - 0x02FF - Silicon Labs. */
+#define BCN_SENSOR_COMP_ID                  0x02FF
+/** Length of the sensor readings: temperature, humidity and battery level. */
+#define BCN_SENSOR_DATA_LEN                 5
+/** Length of the CCM message integrity code. */
+#define BCN_MIC_LEN                         4
+/** Length of the CCM nonce: address, company ID, frame type and sequence counter. */
+#define BCN_NONCE_LEN                       13
+/** Offset of the sequence counter in the CCM nonce. */
+#define BCN_NONCE_SEQ                       9
+/** CCM B0 flags: no associated data, 4 byte MIC, 2 byte length field. */
+#define BCN_CCM_FLAGS_B0                    ((((BCN_MIC_LEN - 2) / 2) << 3) | (2 - 1))
+/** CCM counter block flags: 2 byte counter field. */
+#define BCN_CCM_FLAGS_A                     (2 - 1)
+#if BCN_BROADCAST_ENCRYPT
+#define BCN_SENSOR_FRAME                    BCN_FRAME_SENSOR_CCM
+#else
+#define BCN_SENSOR_FRAME                    BCN_FRAME_SENSOR
+#endif
+
 /***************************************************************************************************
  * Local Variables
  **************************************************************************************************/
 
+#if BCN_BROADCAST_MODE
+/** Structure that holds the sensor broadcast advertisement data. The readings are updated in
+ *  place, see the Sensor Broadcast section of beacon.h for the layout. */
+static struct {
+  uint8_t flagsLen;     /* Length of the Flags field. */
+  uint8_t flagsType;    /* Type of the Flags field. */
+  uint8_t flags;        /* Flags field. */
+  uint8_t mandataLen;   /* Length of the Manufacturer Data field. */
+  uint8_t mandataType;  /* Type of the Manufacturer Data field. */
+  uint8_t compId[2];    /* Company ID field. */
+  uint8_t frameType;    /* Sensor frame type. */
+  uint8_t seq[4];       /* Sequence counter. */
+  uint8_t data[BCN_SENSOR_DATA_LEN]; /* Sensor readings, encrypted in encrypted frames. */
+#if BCN_BROADCAST_ENCRYPT
+  uint8_t mic[BCN_MIC_LEN]; /* CCM message integrity code. */
+#endif
+}
+bcnBeaconAdvData = {
+  BCN_FLAGS_LEN,
+  BCN_TYPE_FLAGS,
+  BCN_FLAG_LE_BREDR_NOT_SUP | BCN_FLAG_LE_GENERAL_DISC,
+
+  sizeof(bcnBeaconAdvData) - 4, /* Everything after the Flags field and this length byte */
+  BCN_TYPE_MANUFACTURER,
+  { UINT16_TO_BYTES(BCN_SENSOR_COMP_ID) },
+  BCN_SENSOR_FRAME,
+  { 0 },
+  { UINT16_TO_BYTES(BCN_TEMPERATURE_UNKNOWN), 0, 0, 0 }
+};
+
+/** Sequence counter of the last sensor frame. */
+static uint32_t bcnSeq;
+
+#if BCN_BROADCAST_ENCRYPT
+/** Broadcast key. */
+static const uint8_t bcnKey[16] = { BCN_BROADCAST_KEY };
+
+/** CCM nonce, the sequence counter is filled in for each frame. */
+static uint8_t bcnNonce[BCN_NONCE_LEN];
+#endif
+
+#else /* !BCN_BROADCAST_MODE */
 /** Structure that holds Beacon advertisement data.
  *  The Beacon advertisement structure is filled here to serve as an example.
  *	See the iBeacon specification for futher details about the required structure. */
 
-static struct {
+static const struct {
   uint8_t flagsLen;     /* Length of the Flags field. */
   uint8_t flagsType;    /* Type of the Flags field. */
   uint8_t flags;        /* Flags field. */
@@ -121,19 +190,124 @@ bcnBeaconAdvData = {
   /* The Beacon's measured RSSI at 1 meter distance in dBm */
   BCN_RSSI
 };
+#endif /* BCN_BROADCAST_MODE */
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+#if BCN_BROADCAST_MODE && BCN_BROADCAST_ENCRYPT
+static void bcnEncrypt(void);
+#endif
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+void bcnInit(void)
+{
+#if BCN_BROADCAST_MODE
+  struct gecko_msg_system_get_random_data_rsp_t *pRandom;
+#if BCN_BROADCAST_ENCRYPT
+  struct gecko_msg_system_get_bt_address_rsp_t *pAddr;
+#endif
+
+  /* The counter starts from a random value on every boot, so an encrypted frame does not reuse the
+   * nonce of a frame sent before a reset */
+  pRandom = gecko_cmd_system_get_random_data(sizeof(bcnSeq));
+  if ((pRandom->result == 0) && (pRandom->data.len == sizeof(bcnSeq))) {
+    memcpy(&bcnSeq, pRandom->data.data, sizeof(bcnSeq));
+  }
 
-void bcnSetupAdvBeaconing(void)
+#if BCN_BROADCAST_ENCRYPT
+  pAddr = gecko_cmd_system_get_bt_address();
+  memcpy(&bcnNonce[0], pAddr->address.addr, 6);
+  memcpy(&bcnNonce[6], bcnBeaconAdvData.compId, 2);
+  bcnNonce[8] = bcnBeaconAdvData.frameType;
+#endif
+#endif /* BCN_BROADCAST_MODE */
+}
+
+const uint8_t *bcnGetAdvData(uint8_t *pLen)
 {
-  uint8_t len = sizeof(bcnBeaconAdvData);
-  uint8_t *pData = (uint8_t*)(&bcnBeaconAdvData);
-
-  /* Display text on LCD screen */
-  appUiWriteString(BCN_LCD_TEXT);
-  /* Set advertising data */
-  gecko_cmd_le_gap_bt5_set_adv_data(0, 0, len, pData);
-  /* start advertising in user mode */
-  gecko_cmd_le_gap_start_advertising(0, le_gap_user_data, le_gap_non_connectable);
+  *pLen = sizeof(bcnBeaconAdvData);
+  return (const uint8_t *)(&bcnBeaconAdvData);
+}
+
+bool bcnUpdateSensorData(int32_t temperature, uint32_t humidity, uint8_t battery)
+{
+#if BCN_BROADCAST_MODE
+  uint8_t *p = bcnBeaconAdvData.seq;
+  int16_t temp = (int16_t)(temperature / 10);
+  uint16_t rh = (uint16_t)(humidity / 10);
+
+  bcnSeq++;
+  UINT32_TO_BITSTREAM(p, bcnSeq);
+  UINT16_TO_BITSTREAM(p, temp);
+  UINT16_TO_BITSTREAM(p, rh);
+  UINT8_TO_BITSTREAM(p, battery);
+
+#if BCN_BROADCAST_ENCRYPT
+  bcnEncrypt();
+#endif
+  return true;
+#else
+  (void)temperature;
+  (void)humidity;
+  (void)battery;
+  return false;
+#endif
+}
+
+#if BCN_BROADCAST_MODE && BCN_BROADCAST_ENCRYPT
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Encrypt the sensor readings in place with AES-CCM and fill in the MIC.
+ *  \details  The CRYPTO block has no CCM mode, so the MIC is the last block of an AES-CBC pass over
+ *  B0 and the padded readings, and the readings and the MIC are encrypted with an AES-CTR pass
+ *  starting at counter block A0. The readings fit in one block.
+ **************************************************************************************************/
+static void bcnEncrypt(void)
+{
+  static const uint8_t iv[16] = { 0 };
+  uint8_t in[32];
+  uint8_t out[32];
+  uint8_t ctr[16];
+  uint8_t i;
+  CORE_DECLARE_IRQ_STATE;
+
+  memcpy(&bcnNonce[BCN_NONCE_SEQ], bcnBeaconAdvData.seq, sizeof(bcnBeaconAdvData.seq));
+
+  /* B0 followed by the readings padded with zeros */
+  memset(in, 0, sizeof(in));
+  in[0] = BCN_CCM_FLAGS_B0;
+  memcpy(&in[1], bcnNonce, BCN_NONCE_LEN);
+  in[15] = BCN_SENSOR_DATA_LEN;
+  memcpy(&in[16], bcnBeaconAdvData.data, BCN_SENSOR_DATA_LEN);
+
+  /* A0, the counter runs in the last bytes */
+  memset(ctr, 0, sizeof(ctr));
+  ctr[0] = BCN_CCM_FLAGS_A;
+  memcpy(&ctr[1], bcnNonce, BCN_NONCE_LEN);
+
+  /* The link layer uses the CRYPTO block from interrupt context as well */
+  CORE_ENTER_ATOMIC();
+  CMU_ClockEnable(cmuClock_CRYPTO, true);
+  CRYPTO_AES_CBC128(CRYPTO, out, in, sizeof(in), bcnKey, iv, true);
+  memcpy(bcnBeaconAdvData.mic, &out[16], BCN_MIC_LEN);
+
+  /* S0 lands in the first block, the encrypted readings in the second */
+  memset(in, 0, 16);
+  CRYPTO_AES_CTR128(CRYPTO, out, in, sizeof(in), bcnKey, ctr, NULL);
+  CORE_EXIT_ATOMIC();
+
+  for (i = 0; i < BCN_MIC_LEN; i++) {
+    bcnBeaconAdvData.mic[i] ^= out[i];
+  }
+  memcpy(bcnBeaconAdvData.data, &out[16], BCN_SENSOR_DATA_LEN);
 }
+#endif
 
 /** @} (end addtogroup beacon) */
 /** @} (end addtogroup Services) */
@@ -18,6 +18,9 @@
 #ifndef BEACON_H
 #define BEACON_H
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -42,10 +45,75 @@ extern "C" {
  * Public Macros and Definitions
  **************************************************************************************************/
 
+/** Sensor broadcast mode. The Beacon advertisement carries the sensor readings in manufacturer
+ *  data instead of the iBeacon payload, so gateways read them without connecting. Off by default,
+ *  the Beacon is a plain iBeacon. */
+#ifndef BCN_BROADCAST_MODE
+#define BCN_BROADCAST_MODE                  0
+#endif
+
+/** Encrypt the sensor readings with AES-CCM. */
+#ifndef BCN_BROADCAST_ENCRYPT
+#define BCN_BROADCAST_ENCRYPT               0
+#endif
+
+/* BCN_BROADCAST_KEY, the 128-bit AES key of encrypted sensor frames shared with the gateways, is
+ * given as 16 comma separated bytes by the product build. There is no default, a key compiled into
+ * every build would protect nothing. */
+#if BCN_BROADCAST_MODE && BCN_BROADCAST_ENCRYPT && !defined(BCN_BROADCAST_KEY)
+#error "BCN_BROADCAST_ENCRYPT needs the product key in BCN_BROADCAST_KEY"
+#endif
+
+/** Frame type of a plain sensor frame. */
+#define BCN_FRAME_SENSOR                    0x01
+/** Frame type of an AES-CCM encrypted sensor frame. */
+#define BCN_FRAME_SENSOR_CCM                0x02
+
+/** Temperature reading when the temperature is not known. */
+#define BCN_TEMPERATURE_UNKNOWN             0x8000
+
+/***********************************************************************************************//**
+ * \section bcn_broadcast Sensor Broadcast
+ *  Manufacturer specific data of the sensor broadcast, all fields little endian:
+ *  - Company ID, 0x02FF (Silicon Labs)
+ *  - Frame type, BCN_FRAME_SENSOR or BCN_FRAME_SENSOR_CCM
+ *  - Sequence counter (4 bytes), incremented on every sample, random after a reset
+ *  - Temperature, sint16 in 0.01 degrees Celsius
+ *  - Relative humidity, uint16 in 0.01 %
+ *  - Battery level, uint8 in %
+ *  - MIC (4 bytes), encrypted frames only
+ *
+ *  In encrypted frames the five reading bytes are AES-CCM encrypted with a 4 byte MIC, a 2 byte
+ *  length field and no associated data. The 13 byte nonce is the public device address (6 bytes,
+ *  least significant byte first), the company ID (2 bytes), the frame type and
+ *  the sequence counter (4 bytes). Gateways should drop frames whose sequence counter they have
+ *  already seen.
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Initialize the Beacon. To be called once the stack has booted.
+ **************************************************************************************************/
+void bcnInit(void);
+
+/***********************************************************************************************//**
+ *  \brief  Get the Beacon advertisement data.
+ *  \param[out]  pLen  Length of the advertisement data.
+ *  \return  Pointer to the advertisement data.
+ **************************************************************************************************/
+const uint8_t *bcnGetAdvData(uint8_t *pLen);
+
 /***********************************************************************************************//**
- *  \brief  Setup advertising for Beaconing mode
+ *  \brief  Update the sensor readings of the Beacon advertisement data in place.
+ *  \param[in]  temperature  Temperature in milli-degrees Celsius.
+ *  \param[in]  humidity  Relative humidity in milli-percent.
+ *  \param[in]  battery  Battery level in %.
+ *  \return  true if the advertisement data changed and has to be set again, false in iBeacon mode
  **************************************************************************************************/
-void bcnSetupAdvBeaconing(void);
+bool bcnUpdateSensorData(int32_t temperature, uint32_t humidity, uint8_t battery);
 
 /** @} (end addtogroup beacon) */
 /** @} (end addtogroup Services) */
@@ -0,0 +1,354 @@
+/***************************************************************************//**
+ * @file
+ * @brief Current Time Service
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#include "gatt_db.h"
+#include "native_gecko.h"
+#include "infrastructure.h"
+
+/* application specific headers */
+#include "app.h"
+#include "app_clock.h"
+#include "gatt_map.h"
+
+/* Own header */
+#include "cts.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Services
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup cts
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+
+/** Length of the Current Time characteristic: Exact Time 256 and Adjust Reason. */
+#define CTS_CURRENT_TIME_LEN                10
+
+/* Adjust Reason flags */
+#define CTS_ADJUST_MANUAL                   0x01
+#define CTS_ADJUST_EXTERNAL_REFERENCE       0x02
+
+/** Write error: the peer wrote a time the server does not accept. */
+#define CTS_ERR_DATA_FIELD_IGNORED          0x80
+
+/** Indicates currently there is no connection being synchronized. */
+#define CTS_NO_CONNECTION                   0xFF
+
+/** Client state. */
+typedef enum {
+  CTS_CLIENT_IDLE,              /**< Nothing to do on this connection. */
+  CTS_CLIENT_SERVICE,           /**< Discovering the Current Time Service. */
+  CTS_CLIENT_CHARACTERISTIC,    /**< Discovering Current Time. */
+  CTS_CLIENT_READ,              /**< Reading Current Time. */
+  CTS_CLIENT_SECURITY           /**< Waiting for encryption to read again. */
+} ctsClientState_t;
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+static const uint8_t ctsServiceUuid[] = { 0x05, 0x18 };
+static const uint8_t ctsCurrentTimeUuid[] = { 0x2b, 0x2a };
+
+static uint8_t ctsClientConnection = CTS_NO_CONNECTION; /* Connection being synchronized */
+static ctsClientState_t ctsClientState = CTS_CLIENT_IDLE;
+static uint32_t ctsServiceHandle = 0; /* Peer Current Time Service */
+static uint16_t ctsCharHandle = 0; /* Peer Current Time */
+static bool ctsSecurityTried = false; /* Encryption has been requested once */
+
+static uint32_t ctsLastSync = 0; /* Clock at the last synchronization */
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+
+static uint8_t ctsBuildCurrentTime(uint8_t *pBuf, uint8_t adjustReason);
+static bool ctsParseCurrentTime(const uint8array *value);
+static void ctsClientProcedureCompleted(uint16_t result);
+static void ctsClientDone(void);
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Current Time read handler, bound in gatt_handlers.txt.
+ *  \param[in]  pEvt  User read request.
+ **************************************************************************************************/
+void ctsReadRequest(const struct gecko_msg_gatt_server_user_read_request_evt_t *pEvt)
+{
+  uint8_t buf[CTS_CURRENT_TIME_LEN];
+  uint8_t len = ctsBuildCurrentTime(buf, 0);
+
+  gecko_cmd_gatt_server_send_user_read_response(pEvt->connection, gattdb_current_time,
+                                                bg_err_success, len, buf);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Current Time write handler, bound in gatt_handlers.txt. Sets the clock and notifies the
+ *  subscribed peers of the manual adjustment.
+ *  \param[in]  pEvt  User write request.
+ **************************************************************************************************/
+void ctsWriteRequest(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt)
+{
+  uint8_t buf[CTS_CURRENT_TIME_LEN];
+  uint8_t len;
+  uint8_t err = bg_err_success;
+
+  if (pEvt->value.len != CTS_CURRENT_TIME_LEN) {
+    err = (uint8_t)bg_err_att_invalid_att_length;
+  } else if (!ctsParseCurrentTime(&pEvt->value)) {
+    err = CTS_ERR_DATA_FIELD_IGNORED;
+  }
+
+  gecko_cmd_gatt_server_send_user_write_response(pEvt->connection, gattdb_current_time, err);
+
+  if (err == bg_err_success) {
+    len = ctsBuildCurrentTime(buf, CTS_ADJUST_MANUAL);
+    gecko_cmd_gatt_server_send_characteristic_notification(0xFF, gattdb_current_time, len, buf);
+  }
+}
+
+void ctsConnectionOpened(uint8_t connection)
+{
+  if (appClockIsSet() && ((uint32_t)(appClockGet(NULL) - ctsLastSync) < CTS_SYNC_PERIOD_S)) {
+    return;
+  }
+  /* one connection at a time, the others get the time from the server */
+  if (ctsClientConnection != CTS_NO_CONNECTION) {
+    return;
+  }
+
+  ctsClientConnection = connection;
+  ctsServiceHandle = 0;
+  ctsCharHandle = 0;
+  ctsSecurityTried = false;
+  ctsClientState = CTS_CLIENT_SERVICE;
+  if (gecko_cmd_gatt_discover_primary_services_by_uuid(connection, sizeof(ctsServiceUuid),
+                                                       ctsServiceUuid)->result != bg_err_success) {
+    ctsClientDone();
+  }
+}
+
+void ctsSecurityChanged(uint8_t connection, uint8_t securityMode)
+{
+  if ((connection != ctsClientConnection) || (ctsClientState != CTS_CLIENT_SECURITY)
+      || (securityMode == le_connection_mode1_level1)) {
+    return;
+  }
+
+  ctsClientState = CTS_CLIENT_READ;
+  if (gecko_cmd_gatt_read_characteristic_value(connection, ctsCharHandle)->result != bg_err_success) {
+    ctsClientDone();
+  }
+}
+
+bool ctsClientEvent(struct gecko_cmd_packet *evt)
+{
+  switch (BGLIB_MSG_ID(evt->header)) {
+    case gecko_evt_gatt_service_id:
+      if ((evt->data.evt_gatt_service.connection != ctsClientConnection)
+          || (ctsClientState != CTS_CLIENT_SERVICE)) {
+        return false;
+      }
+      ctsServiceHandle = evt->data.evt_gatt_service.service;
+      return true;
+
+    case gecko_evt_gatt_characteristic_id:
+      if ((evt->data.evt_gatt_characteristic.connection != ctsClientConnection)
+          || (ctsClientState != CTS_CLIENT_CHARACTERISTIC)) {
+        return false;
+      }
+      ctsCharHandle = evt->data.evt_gatt_characteristic.characteristic;
+      return true;
+
+    case gecko_evt_gatt_characteristic_value_id:
+      if ((evt->data.evt_gatt_characteristic_value.connection != ctsClientConnection)
+          || (evt->data.evt_gatt_characteristic_value.characteristic != ctsCharHandle)) {
+        return false;
+      }
+      if (ctsParseCurrentTime(&evt->data.evt_gatt_characteristic_value.value)) {
+        printLog("time synchronized from the peer\r\n");
+      }
+      return true;
+
+    case gecko_evt_gatt_procedure_completed_id:
+      if ((evt->data.evt_gatt_procedure_completed.connection != ctsClientConnection)
+          || (ctsClientState == CTS_CLIENT_IDLE)) {
+        return false;
+      }
+      ctsClientProcedureCompleted(evt->data.evt_gatt_procedure_completed.result);
+      return true;
+
+    case gecko_evt_le_connection_closed_id:
+      if (evt->data.evt_le_connection_closed.connection == ctsClientConnection) {
+        ctsClientDone();
+      }
+      return false;
+
+    default:
+      return false;
+  }
+}
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Build the Current Time characteristic from the clock.
+ *  \details  The Date Time fields are 0, meaning not known, while the clock has not been set.
+ *  \param[in]  pBuf  Buffer of CTS_CURRENT_TIME_LEN bytes.
+ *  \param[in]  adjustReason  Adjust Reason flags.
+ *  \return  Length of pBuf in bytes.
+ **************************************************************************************************/
+static uint8_t ctsBuildCurrentTime(uint8_t *pBuf, uint8_t adjustReason)
+{
+  uint8_t *p = pBuf;
+  appClockDateTime_t dateTime = { 0 };
+  uint8_t fractions256 = 0;
+  uint32_t time = appClockGet(&fractions256);
+
+  if (appClockIsSet()) {
+    appClockToDateTime(time, &dateTime);
+  } else {
+    fractions256 = 0;
+  }
+
+  UINT16_TO_BITSTREAM(p, dateTime.year);
+  UINT8_TO_BITSTREAM(p, dateTime.month);
+  UINT8_TO_BITSTREAM(p, dateTime.day);
+  UINT8_TO_BITSTREAM(p, dateTime.hours);
+  UINT8_TO_BITSTREAM(p, dateTime.minutes);
+  UINT8_TO_BITSTREAM(p, dateTime.seconds);
+  UINT8_TO_BITSTREAM(p, dateTime.weekday);
+  UINT8_TO_BITSTREAM(p, fractions256);
+  UINT8_TO_BITSTREAM(p, adjustReason);
+
+  return (uint8_t)(p - pBuf);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Set the clock from a Current Time value. The day of week is implied by the date.
+ *  \param[in]  value  Current Time value.
+ *  \return  false if the value is too short or the date is not valid
+ **************************************************************************************************/
+static bool ctsParseCurrentTime(const uint8array *value)
+{
+  const uint8_t *p = value->data;
+  appClockDateTime_t dateTime;
+  uint32_t time;
+
+  if (value->len < CTS_CURRENT_TIME_LEN) {
+    return false;
+  }
+
+  dateTime.year = (uint16_t)(p[0] | (p[1] << 8));
+  dateTime.month = p[2];
+  dateTime.day = p[3];
+  dateTime.hours = p[4];
+  dateTime.minutes = p[5];
+  dateTime.seconds = p[6];
+  dateTime.weekday = p[7];
+
+  if (!appClockFromDateTime(&dateTime, &time)) {
+    return false;
+  }
+
+  appClockSet(time, p[8]);
+  ctsLastSync = time;
+  return true;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Move the client on when a GATT procedure has completed.
+ *  \param[in]  result  Procedure result.
+ **************************************************************************************************/
+static void ctsClientProcedureCompleted(uint16_t result)
+{
+  uint8_t connection = ctsClientConnection;
+
+  switch (ctsClientState) {
+    case CTS_CLIENT_SERVICE:
+      if ((result != bg_err_success) || !ctsServiceHandle) {
+        ctsClientDone();
+        return;
+      }
+      ctsClientState = CTS_CLIENT_CHARACTERISTIC;
+      if (gecko_cmd_gatt_discover_characteristics_by_uuid(connection, ctsServiceHandle,
+                                                          sizeof(ctsCurrentTimeUuid),
+                                                          ctsCurrentTimeUuid)->result
+          != bg_err_success) {
+        ctsClientDone();
+      }
+      break;
+
+    case CTS_CLIENT_CHARACTERISTIC:
+      if ((result != bg_err_success) || !ctsCharHandle) {
+        ctsClientDone();
+        return;
+      }
+      ctsClientState = CTS_CLIENT_READ;
+      if (gecko_cmd_gatt_read_characteristic_value(connection, ctsCharHandle)->result
+          != bg_err_success) {
+        ctsClientDone();
+      }
+      break;
+
+    case CTS_CLIENT_READ:
+      /* phones only give the time on an encrypted link, ask for it once and read again */
+      if (((result == bg_err_att_insufficient_authentication)
+           || (result == bg_err_att_insufficient_encryption))
+          && !ctsSecurityTried) {
+        ctsSecurityTried = true;
+        ctsClientState = CTS_CLIENT_SECURITY;
+        if (gecko_cmd_sm_increase_security(connection)->result != bg_err_success) {
+          ctsClientDone();
+        }
+        return;
+      }
+      ctsClientDone();
+      break;
+
+    default:
+      break;
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  End the synchronization on the current connection.
+ **************************************************************************************************/
+static void ctsClientDone(void)
+{
+  ctsClientConnection = CTS_NO_CONNECTION;
+  ctsClientState = CTS_CLIENT_IDLE;
+}
+
+/** @} (end addtogroup cts) */
+/** @} (end addtogroup Services) */
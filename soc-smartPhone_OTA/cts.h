@@ -0,0 +1,84 @@
+/***************************************************************************//**
+ * @file
+ * @brief Current Time Service header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef CTS_H
+#define CTS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************//**
+ * \defgroup cts Current Time
+ * \brief Current Time Service server and client API
+ *
+ * The server exposes the calendar clock, a peer can read it and set it by writing Current Time.
+ * The client reads Current Time from a peer that has the service, as phones do, when a
+ * connection opens and the clock has not been synchronized for CTS_SYNC_PERIOD_S.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Services
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup cts
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Time after a synchronization in seconds before the client reads the peer time again. */
+#ifndef CTS_SYNC_PERIOD_S
+#define CTS_SYNC_PERIOD_S             (24UL * 3600UL)
+#endif
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Start the client on a new connection if the clock needs synchronizing.
+ *  \param[in]  connection  Connection handle.
+ **************************************************************************************************/
+void ctsConnectionOpened(uint8_t connection);
+
+/***********************************************************************************************//**
+ *  \brief  Retry a read that failed for lack of security once the connection is encrypted.
+ *  \param[in]  connection  Connection handle.
+ *  \param[in]  securityMode  Security mode from the connection parameters event.
+ **************************************************************************************************/
+void ctsSecurityChanged(uint8_t connection, uint8_t securityMode);
+
+/***********************************************************************************************//**
+ *  \brief  Handle GATT client events of the time synchronization.
+ *  \param[in]  evt  Stack event.
+ *  \return  true if the event belonged to the client
+ **************************************************************************************************/
+bool ctsClientEvent(struct gecko_cmd_packet *evt);
+
+/** @} (end addtogroup cts) */
+/** @} (end addtogroup Services) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* CTS_H */
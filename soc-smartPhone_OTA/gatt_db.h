@@ -18,14 +18,17 @@ extern const struct bg_gattdb_def bg_gattdb_data;
 #define gattdb_client_support_features          8
 #define gattdb_device_name                     11
 #define gattdb_temperature_measurement         19
+#define gattdb_intermediate_temperature        24
 #define gattdb_MeasInt                         27
-#define gattdb_alert_level                     30
-#define gattdb_ota_control                     33
-#define gattdb_ota_data                        35
-#define gattdb_battery_level                   38
-#define gattdb_characteristic_presentation_format         39
-#define gattdb_heart_rate_measurement          43
-#define gattdb_body_sensor_location            46
-#define gattdb_heart_rate_control_point         48
+#define gattdb_valid_range                     28
+#define gattdb_alert_level                     31
+#define gattdb_ota_control                     34
+#define gattdb_ota_data                        36
+#define gattdb_battery_level                   39
+#define gattdb_characteristic_presentation_format         40
+#define gattdb_heart_rate_measurement          44
+#define gattdb_body_sensor_location            47
+#define gattdb_heart_rate_control_point         49
+#define gattdb_current_time                    52
 
 #endif
@@ -0,0 +1,183 @@
+/***************************************************************************//**
+ * @file
+ * @brief GATT handle map
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* This file is generated by tools/gatt_map.py from gatt.xml, do not edit. */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#ifdef HOST
+#include "gecko_bglib.h"
+#else /* !HOST */
+#include "native_gecko.h"
+#endif /* !HOST */
+#include "gatt_db.h"
+
+/* Own header */
+#include "gatt_map.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup gatt_map
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+
+#if defined(__GNUC__) || (defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L))
+#define GATT_MAP_STATIC_ASSERT(expr, msg)  _Static_assert(expr, msg)
+#else
+#define GATT_MAP_ASSERT_NAME(line)         GATT_MAP_ASSERT_NAME2(line)
+#define GATT_MAP_ASSERT_NAME2(line)        gattMapAssert ## line
+#define GATT_MAP_STATIC_ASSERT(expr, msg)  typedef char GATT_MAP_ASSERT_NAME(__LINE__)[(expr) ? 1 : -1]
+#endif
+
+/* The handles must match the database the stack is built with */
+GATT_MAP_STATIC_ASSERT(GATT_MAP_SERVICE_CHANGED_CHAR == gattdb_service_changed_char, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_DATABASE_HASH == gattdb_database_hash, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_CLIENT_SUPPORT_FEATURES == gattdb_client_support_features, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_DEVICE_NAME == gattdb_device_name, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_TEMPERATURE_MEASUREMENT == gattdb_temperature_measurement, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_INTERMEDIATE_TEMPERATURE == gattdb_intermediate_temperature, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_MEASINT == gattdb_MeasInt, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_VALID_RANGE == gattdb_valid_range, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_ALERT_LEVEL == gattdb_alert_level, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_OTA_CONTROL == gattdb_ota_control, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_OTA_DATA == gattdb_ota_data, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_BATTERY_LEVEL == gattdb_battery_level, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_CHARACTERISTIC_PRESENTATION_FORMAT == gattdb_characteristic_presentation_format, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_HEART_RATE_MEASUREMENT == gattdb_heart_rate_measurement, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_BODY_SENSOR_LOCATION == gattdb_body_sensor_location, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_HEART_RATE_CONTROL_POINT == gattdb_heart_rate_control_point, "gatt_map.h is out of date");
+GATT_MAP_STATIC_ASSERT(GATT_MAP_CURRENT_TIME == gattdb_current_time, "gatt_map.h is out of date");
+
+/* Each handler must be reachable through the properties of its characteristic */
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_TEMPERATURE_MEASUREMENT & GATT_PROP_CCCD),
+                       "htmTemperatureStatus is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_INTERMEDIATE_TEMPERATURE & GATT_PROP_CCCD),
+                       "htmIntermediateStatus is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_MEASINT & GATT_PROP_READ) && (GATT_MAP_PROPS_MEASINT & GATT_PROP_USER),
+                       "htmMeasIntReadRequest is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_MEASINT & (GATT_PROP_WRITE | GATT_PROP_WRITE_NO_RESPONSE)) && (GATT_MAP_PROPS_MEASINT & GATT_PROP_USER),
+                       "htmMeasIntWriteRequest is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_ALERT_LEVEL & (GATT_PROP_WRITE | GATT_PROP_WRITE_NO_RESPONSE)) && !(GATT_MAP_PROPS_ALERT_LEVEL & GATT_PROP_USER),
+                       "iaAlertLevelValue is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_OTA_CONTROL & (GATT_PROP_WRITE | GATT_PROP_WRITE_NO_RESPONSE)) && (GATT_MAP_PROPS_OTA_CONTROL & GATT_PROP_USER),
+                       "appOtaControlWrite is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_OTA_DATA & (GATT_PROP_WRITE | GATT_PROP_WRITE_NO_RESPONSE)) && (GATT_MAP_PROPS_OTA_DATA & GATT_PROP_USER),
+                       "appOtaDataWrite is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_BATTERY_LEVEL & GATT_PROP_CCCD),
+                       "battStatus is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_BATTERY_LEVEL & GATT_PROP_READ) && (GATT_MAP_PROPS_BATTERY_LEVEL & GATT_PROP_USER),
+                       "battReadRequest is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_BATTERY_LEVEL & (GATT_PROP_WRITE | GATT_PROP_WRITE_NO_RESPONSE)) && (GATT_MAP_PROPS_BATTERY_LEVEL & GATT_PROP_USER),
+                       "battWriteRequest is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_HEART_RATE_MEASUREMENT & GATT_PROP_CCCD),
+                       "hrMeasurementStatus is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_HEART_RATE_CONTROL_POINT & (GATT_PROP_WRITE | GATT_PROP_WRITE_NO_RESPONSE)) && (GATT_MAP_PROPS_HEART_RATE_CONTROL_POINT & GATT_PROP_USER),
+                       "hrControlPointWrite is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_CURRENT_TIME & GATT_PROP_READ) && (GATT_MAP_PROPS_CURRENT_TIME & GATT_PROP_USER),
+                       "ctsReadRequest is never called");
+GATT_MAP_STATIC_ASSERT((GATT_MAP_PROPS_CURRENT_TIME & (GATT_PROP_WRITE | GATT_PROP_WRITE_NO_RESPONSE)) && (GATT_MAP_PROPS_CURRENT_TIME & GATT_PROP_USER),
+                       "ctsWriteRequest is never called");
+
+/***************************************************************************************************
+ * Public Variables
+ **************************************************************************************************/
+
+const gattMapHandlers_t gattMapHandlers[GATT_MAP_HANDLE_MAX + 1] = {
+  [GATT_MAP_TEMPERATURE_MEASUREMENT] = { .status = htmTemperatureStatus },
+  [GATT_MAP_INTERMEDIATE_TEMPERATURE] = { .status = htmIntermediateStatus },
+  [GATT_MAP_MEASINT] = { .read = htmMeasIntReadRequest, .write = htmMeasIntWriteRequest },
+  [GATT_MAP_ALERT_LEVEL] = { .value = iaAlertLevelValue },
+  [GATT_MAP_OTA_CONTROL] = { .write = appOtaControlWrite },
+  [GATT_MAP_OTA_DATA] = { .write = appOtaDataWrite },
+  [GATT_MAP_BATTERY_LEVEL] = { .status = battStatus, .read = battReadRequest, .write = battWriteRequest },
+  [GATT_MAP_HEART_RATE_MEASUREMENT] = { .status = hrMeasurementStatus },
+  [GATT_MAP_HEART_RATE_CONTROL_POINT] = { .write = hrControlPointWrite },
+  [GATT_MAP_CURRENT_TIME] = { .read = ctsReadRequest, .write = ctsWriteRequest },
+};
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+bool gattMapDispatch(struct gecko_cmd_packet *evt)
+{
+  const gattMapHandlers_t *pHandlers;
+
+  switch (BGLIB_MSG_ID(evt->header)) {
+    case gecko_evt_gatt_server_attribute_value_id:
+      if (evt->data.evt_gatt_server_attribute_value.attribute > GATT_MAP_HANDLE_MAX) {
+        break;
+      }
+      pHandlers = &gattMapHandlers[evt->data.evt_gatt_server_attribute_value.attribute];
+      if (pHandlers->value != NULL) {
+        pHandlers->value(&evt->data.evt_gatt_server_attribute_value);
+        return true;
+      }
+      break;
+
+    case gecko_evt_gatt_server_characteristic_status_id:
+      if (evt->data.evt_gatt_server_characteristic_status.characteristic > GATT_MAP_HANDLE_MAX) {
+        break;
+      }
+      pHandlers = &gattMapHandlers[evt->data.evt_gatt_server_characteristic_status.characteristic];
+      if (pHandlers->status != NULL) {
+        pHandlers->status(&evt->data.evt_gatt_server_characteristic_status);
+        return true;
+      }
+      break;
+
+    case gecko_evt_gatt_server_user_read_request_id:
+      if (evt->data.evt_gatt_server_user_read_request.characteristic > GATT_MAP_HANDLE_MAX) {
+        break;
+      }
+      pHandlers = &gattMapHandlers[evt->data.evt_gatt_server_user_read_request.characteristic];
+      if (pHandlers->read != NULL) {
+        pHandlers->read(&evt->data.evt_gatt_server_user_read_request);
+        return true;
+      }
+      break;
+
+    case gecko_evt_gatt_server_user_write_request_id:
+      if (evt->data.evt_gatt_server_user_write_request.characteristic > GATT_MAP_HANDLE_MAX) {
+        break;
+      }
+      pHandlers = &gattMapHandlers[evt->data.evt_gatt_server_user_write_request.characteristic];
+      if (pHandlers->write != NULL) {
+        pHandlers->write(&evt->data.evt_gatt_server_user_write_request);
+        return true;
+      }
+      break;
+
+    default:
+      break;
+  }
+
+  return false;
+}
+
+/** @} (end addtogroup gatt_map) */
+/** @} (end addtogroup Application) */
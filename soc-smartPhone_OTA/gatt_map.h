@@ -0,0 +1,203 @@
+/***************************************************************************//**
+ * @file
+ * @brief GATT handle map header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* This file is generated by tools/gatt_map.py from gatt.xml, do not edit. */
+
+#ifndef GATT_MAP_H
+#define GATT_MAP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#ifdef HOST
+#include "gecko_bglib.h"
+#else /* !HOST */
+#include "native_gecko.h"
+#endif /* !HOST */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************//**
+ * \defgroup gatt_map GATT Handle Map
+ * \brief Attribute handles, properties and event handlers of the GATT database.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Application
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup gatt_map
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/* Characteristic properties, the low byte is the declaration byte */
+#define GATT_PROP_BROADCAST             0x0001
+#define GATT_PROP_READ                  0x0002
+#define GATT_PROP_WRITE_NO_RESPONSE     0x0004
+#define GATT_PROP_WRITE                 0x0008
+#define GATT_PROP_NOTIFY                0x0010
+#define GATT_PROP_INDICATE              0x0020
+#define GATT_PROP_AUTH_SIGNED_WRITE     0x0040
+/** Value is handled by the application (type "user"). */
+#define GATT_PROP_USER                  0x0100
+/** Characteristic has a Client Characteristic Configuration descriptor. */
+#define GATT_PROP_CCCD                  0x0200
+
+/** Highest attribute handle. */
+#define GATT_MAP_HANDLE_MAX             53
+/** Number of attributes. */
+#define GATT_MAP_ATTRIBUTE_COUNT        53
+
+/* Properties of the named attributes */
+#define GATT_MAP_PROPS_SERVICE_CHANGED_CHAR                (GATT_PROP_INDICATE | GATT_PROP_CCCD)
+#define GATT_MAP_PROPS_DATABASE_HASH                       (GATT_PROP_READ)
+#define GATT_MAP_PROPS_CLIENT_SUPPORT_FEATURES             (GATT_PROP_READ | GATT_PROP_WRITE)
+#define GATT_MAP_PROPS_DEVICE_NAME                         (GATT_PROP_READ | GATT_PROP_WRITE)
+#define GATT_MAP_PROPS_TEMPERATURE_MEASUREMENT             (GATT_PROP_INDICATE | GATT_PROP_CCCD)
+#define GATT_MAP_PROPS_INTERMEDIATE_TEMPERATURE            (GATT_PROP_NOTIFY | GATT_PROP_CCCD)
+#define GATT_MAP_PROPS_MEASINT                             (GATT_PROP_READ | GATT_PROP_WRITE | GATT_PROP_USER)
+#define GATT_MAP_PROPS_VALID_RANGE                         (GATT_PROP_READ)
+#define GATT_MAP_PROPS_ALERT_LEVEL                         (GATT_PROP_WRITE_NO_RESPONSE)
+#define GATT_MAP_PROPS_OTA_CONTROL                         (GATT_PROP_WRITE | GATT_PROP_USER)
+#define GATT_MAP_PROPS_OTA_DATA                            (GATT_PROP_WRITE_NO_RESPONSE | GATT_PROP_WRITE | GATT_PROP_USER)
+#define GATT_MAP_PROPS_BATTERY_LEVEL                       (GATT_PROP_READ | GATT_PROP_WRITE | GATT_PROP_USER | GATT_PROP_CCCD)
+#define GATT_MAP_PROPS_CHARACTERISTIC_PRESENTATION_FORMAT  (GATT_PROP_READ)
+#define GATT_MAP_PROPS_HEART_RATE_MEASUREMENT              (GATT_PROP_NOTIFY | GATT_PROP_USER | GATT_PROP_CCCD)
+#define GATT_MAP_PROPS_BODY_SENSOR_LOCATION                (GATT_PROP_READ)
+#define GATT_MAP_PROPS_HEART_RATE_CONTROL_POINT            (GATT_PROP_WRITE | GATT_PROP_USER)
+#define GATT_MAP_PROPS_CURRENT_TIME                        (GATT_PROP_READ | GATT_PROP_WRITE | GATT_PROP_NOTIFY | GATT_PROP_USER | GATT_PROP_CCCD)
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Attribute handles. */
+typedef enum {
+  GATT_MAP_SERVICE_CHANGED_CHAR                      = 3,
+  GATT_MAP_DATABASE_HASH                             = 6,
+  GATT_MAP_CLIENT_SUPPORT_FEATURES                   = 8,
+  GATT_MAP_DEVICE_NAME                               = 11,
+  GATT_MAP_TEMPERATURE_MEASUREMENT                   = 19,
+  GATT_MAP_INTERMEDIATE_TEMPERATURE                  = 24,
+  GATT_MAP_MEASINT                                   = 27,
+  GATT_MAP_VALID_RANGE                               = 28,
+  GATT_MAP_ALERT_LEVEL                               = 31,
+  GATT_MAP_OTA_CONTROL                               = 34,
+  GATT_MAP_OTA_DATA                                  = 36,
+  GATT_MAP_BATTERY_LEVEL                             = 39,
+  GATT_MAP_CHARACTERISTIC_PRESENTATION_FORMAT        = 40,
+  GATT_MAP_HEART_RATE_MEASUREMENT                    = 44,
+  GATT_MAP_BODY_SENSOR_LOCATION                      = 47,
+  GATT_MAP_HEART_RATE_CONTROL_POINT                  = 49,
+  GATT_MAP_CURRENT_TIME                              = 52
+} gattMapHandle_t;
+
+/** Handler of a write to a value stored by the stack. */
+typedef void (*gattMapValueCback_t)(const struct gecko_msg_gatt_server_attribute_value_evt_t *pEvt);
+/** Handler of a CCCD write or an indication confirmation. */
+typedef void (*gattMapStatusCback_t)(const struct gecko_msg_gatt_server_characteristic_status_evt_t *pEvt);
+/** Handler of a read of a user type value. */
+typedef void (*gattMapReadCback_t)(const struct gecko_msg_gatt_server_user_read_request_evt_t *pEvt);
+/** Handler of a write of a user type value. */
+typedef void (*gattMapWriteCback_t)(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt);
+
+/** Handlers of one attribute. */
+typedef struct {
+  gattMapValueCback_t value;    /**< gatt_server_attribute_value. */
+  gattMapStatusCback_t status;  /**< gatt_server_characteristic_status. */
+  gattMapReadCback_t read;      /**< gatt_server_user_read_request. */
+  gattMapWriteCback_t write;    /**< gatt_server_user_write_request. */
+} gattMapHandlers_t;
+
+/** Attribute kinds of the host attribute table. */
+typedef enum {
+  GATT_MAP_ATTR_SERVICE,        /**< Service declaration. */
+  GATT_MAP_ATTR_CHARACTERISTIC, /**< Characteristic declaration. */
+  GATT_MAP_ATTR_VALUE,          /**< Characteristic value. */
+  GATT_MAP_ATTR_DESCRIPTOR      /**< Characteristic descriptor. */
+} gattMapAttrKind_t;
+
+/** Attribute of the host attribute table. */
+typedef struct {
+  uint16_t handle;        /**< Attribute handle. */
+  uint8_t kind;           /**< gattMapAttrKind_t. */
+  uint8_t uuidLen;        /**< UUID length, 2 or 16. */
+  uint8_t uuid[16];       /**< Attribute type, little endian. */
+  uint16_t props;         /**< GATT_PROP_ flags of values and descriptors. */
+  uint16_t maxLen;        /**< Maximum value length. */
+  bool variableLen;       /**< Value length is variable. */
+  uint8_t len;            /**< Initial value length. */
+  const uint8_t *pValue;  /**< Initial value. */
+} gattMapAttribute_t;
+
+/***************************************************************************************************
+ * Public Variables
+ **************************************************************************************************/
+
+/** Handlers indexed by attribute handle. */
+extern const gattMapHandlers_t gattMapHandlers[GATT_MAP_HANDLE_MAX + 1];
+
+#ifdef HOST
+/** Attribute table, indexed by attribute handle - 1. */
+extern const gattMapAttribute_t gattMapAttributes[GATT_MAP_ATTRIBUTE_COUNT];
+#endif
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Route a GATT server event to the handler of its attribute.
+ *  \param[in]  evt  Event.
+ *  \return  true if a handler was called, false if the event has no handler
+ **************************************************************************************************/
+bool gattMapDispatch(struct gecko_cmd_packet *evt);
+
+/* Bound handlers, see gatt_handlers.txt */
+void htmTemperatureStatus(const struct gecko_msg_gatt_server_characteristic_status_evt_t *pEvt);
+void htmIntermediateStatus(const struct gecko_msg_gatt_server_characteristic_status_evt_t *pEvt);
+void htmMeasIntReadRequest(const struct gecko_msg_gatt_server_user_read_request_evt_t *pEvt);
+void htmMeasIntWriteRequest(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt);
+void iaAlertLevelValue(const struct gecko_msg_gatt_server_attribute_value_evt_t *pEvt);
+void appOtaControlWrite(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt);
+void appOtaDataWrite(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt);
+void battStatus(const struct gecko_msg_gatt_server_characteristic_status_evt_t *pEvt);
+void battReadRequest(const struct gecko_msg_gatt_server_user_read_request_evt_t *pEvt);
+void battWriteRequest(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt);
+void hrMeasurementStatus(const struct gecko_msg_gatt_server_characteristic_status_evt_t *pEvt);
+void hrControlPointWrite(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt);
+void ctsReadRequest(const struct gecko_msg_gatt_server_user_read_request_evt_t *pEvt);
+void ctsWriteRequest(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt);
+
+/** @} (end addtogroup gatt_map) */
+/** @} (end addtogroup Application) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* GATT_MAP_H */
@@ -0,0 +1,137 @@
+/***************************************************************************//**
+ * @file
+ * @brief GATT attribute table for host builds
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* This file is generated by tools/gatt_map.py from gatt.xml, do not edit. */
+
+#ifdef HOST
+
+#include <stdint.h>
+#include <stddef.h>
+
+/* Own header */
+#include "gatt_map.h"
+
+/* Initial values */
+static const uint8_t gattMapValue1[] = { 0x01, 0x18 };
+static const uint8_t gattMapValue2[] = { 0x20, 0x03, 0x00, 0x05, 0x2a };
+static const uint8_t gattMapValue3[] = { 0x00, 0x00, 0x00, 0x00 };
+static const uint8_t gattMapValue4[] = { 0x00, 0x00 };
+static const uint8_t gattMapValue5[] = { 0x02, 0x06, 0x00, 0x2a, 0x2b };
+static const uint8_t gattMapValue6[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+static const uint8_t gattMapValue7[] = { 0x0a, 0x08, 0x00, 0x29, 0x2b };
+static const uint8_t gattMapValue8[] = { 0x00 };
+static const uint8_t gattMapValue9[] = { 0x00, 0x18 };
+static const uint8_t gattMapValue10[] = { 0x0a, 0x0b, 0x00, 0x00, 0x2a };
+static const uint8_t gattMapValue11[] = { 0x42, 0x47, 0x30, 0x30, 0x30, 0x30, 0x30 };
+static const uint8_t gattMapValue12[] = { 0x02, 0x0d, 0x00, 0x01, 0x2a };
+static const uint8_t gattMapValue13[] = { 0x00, 0x03 };
+static const uint8_t gattMapValue14[] = { 0x0a, 0x18 };
+static const uint8_t gattMapValue15[] = { 0x02, 0x10, 0x00, 0x29, 0x2a };
+static const uint8_t gattMapValue16[] = { 0x53, 0x69, 0x6c, 0x69, 0x63, 0x6f, 0x6e, 0x20, 0x4c, 0x61, 0x62, 0x73 };
+static const uint8_t gattMapValue17[] = { 0x09, 0x18 };
+static const uint8_t gattMapValue18[] = { 0x20, 0x13, 0x00, 0x1c, 0x2a };
+static const uint8_t gattMapValue19[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+static const uint8_t gattMapValue20[] = { 0x00, 0x00 };
+static const uint8_t gattMapValue21[] = { 0x02, 0x16, 0x00, 0x1d, 0x2a };
+static const uint8_t gattMapValue22[] = { 0x02 };
+static const uint8_t gattMapValue23[] = { 0x10, 0x18, 0x00, 0x1e, 0x2a };
+static const uint8_t gattMapValue24[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+static const uint8_t gattMapValue25[] = { 0x00, 0x00 };
+static const uint8_t gattMapValue26[] = { 0x0a, 0x1b, 0x00, 0x21, 0x2a };
+static const uint8_t gattMapValue27[] = { 0x00, 0x00 };
+static const uint8_t gattMapValue28[] = { 0x01, 0x00, 0xff, 0xff };
+static const uint8_t gattMapValue29[] = { 0x02, 0x18 };
+static const uint8_t gattMapValue30[] = { 0x04, 0x1f, 0x00, 0x06, 0x2a };
+static const uint8_t gattMapValue31[] = { 0x00 };
+static const uint8_t gattMapValue32[] = { 0xf0, 0x19, 0x21, 0xb4, 0x47, 0x8f, 0xa4, 0xbf, 0xa1, 0x4f, 0x63, 0xfd, 0xee, 0xd6, 0x14, 0x1d };
+static const uint8_t gattMapValue33[] = { 0x08, 0x22, 0x00, 0x63, 0x60, 0x32, 0xe0, 0x37, 0x5e, 0xa4, 0x88, 0x53, 0x4e, 0x6d, 0xfb, 0x64, 0x35, 0xbf, 0xf7 };
+static const uint8_t gattMapValue34[] = { 0x00 };
+static const uint8_t gattMapValue35[] = { 0x0c, 0x24, 0x00, 0x53, 0xa1, 0x81, 0x1f, 0x58, 0x2c, 0xd0, 0xa5, 0x45, 0x40, 0xfc, 0x34, 0xf3, 0x27, 0x42, 0x98 };
+static const uint8_t gattMapValue37[] = { 0x0f, 0x18 };
+static const uint8_t gattMapValue38[] = { 0x0a, 0x27, 0x00, 0x19, 0x2a };
+static const uint8_t gattMapValue39[] = { 0x00 };
+static const uint8_t gattMapValue40[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+static const uint8_t gattMapValue41[] = { 0x00, 0x00 };
+static const uint8_t gattMapValue42[] = { 0x0d, 0x18 };
+static const uint8_t gattMapValue43[] = { 0x10, 0x2c, 0x00, 0x37, 0x2a };
+static const uint8_t gattMapValue45[] = { 0x00, 0x00 };
+static const uint8_t gattMapValue46[] = { 0x02, 0x2f, 0x00, 0x38, 0x2a };
+static const uint8_t gattMapValue47[] = { 0x00 };
+static const uint8_t gattMapValue48[] = { 0x08, 0x31, 0x00, 0x39, 0x2a };
+static const uint8_t gattMapValue49[] = { 0x00 };
+static const uint8_t gattMapValue50[] = { 0x05, 0x18 };
+static const uint8_t gattMapValue51[] = { 0x1a, 0x34, 0x00, 0x2b, 0x2a };
+static const uint8_t gattMapValue52[] = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+static const uint8_t gattMapValue53[] = { 0x00, 0x00 };
+
+const gattMapAttribute_t gattMapAttributes[GATT_MAP_ATTRIBUTE_COUNT] = {
+  { 1, GATT_MAP_ATTR_SERVICE, 2, { 0x00, 0x28 }, 0x0000, 2, false, 2, gattMapValue1 },
+  { 2, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue2 },
+  { 3, GATT_MAP_ATTR_VALUE, 2, { 0x05, 0x2a }, 0x0220, 4, false, 4, gattMapValue3 }, /* service_changed_char */
+  { 4, GATT_MAP_ATTR_DESCRIPTOR, 2, { 0x02, 0x29 }, 0x000a, 2, false, 2, gattMapValue4 },
+  { 5, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue5 },
+  { 6, GATT_MAP_ATTR_VALUE, 2, { 0x2a, 0x2b }, 0x0002, 16, false, 16, gattMapValue6 }, /* database_hash */
+  { 7, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue7 },
+  { 8, GATT_MAP_ATTR_VALUE, 2, { 0x29, 0x2b }, 0x000a, 1, false, 1, gattMapValue8 }, /* client_support_features */
+  { 9, GATT_MAP_ATTR_SERVICE, 2, { 0x00, 0x28 }, 0x0000, 2, false, 2, gattMapValue9 },
+  { 10, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue10 },
+  { 11, GATT_MAP_ATTR_VALUE, 2, { 0x00, 0x2a }, 0x000a, 7, false, 7, gattMapValue11 }, /* device_name */
+  { 12, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue12 },
+  { 13, GATT_MAP_ATTR_VALUE, 2, { 0x01, 0x2a }, 0x0002, 2, false, 2, gattMapValue13 },
+  { 14, GATT_MAP_ATTR_SERVICE, 2, { 0x00, 0x28 }, 0x0000, 2, false, 2, gattMapValue14 },
+  { 15, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue15 },
+  { 16, GATT_MAP_ATTR_VALUE, 2, { 0x29, 0x2a }, 0x0002, 12, false, 12, gattMapValue16 },
+  { 17, GATT_MAP_ATTR_SERVICE, 2, { 0x00, 0x28 }, 0x0000, 2, false, 2, gattMapValue17 },
+  { 18, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue18 },
+  { 19, GATT_MAP_ATTR_VALUE, 2, { 0x1c, 0x2a }, 0x0220, 13, false, 13, gattMapValue19 }, /* temperature_measurement */
+  { 20, GATT_MAP_ATTR_DESCRIPTOR, 2, { 0x02, 0x29 }, 0x000a, 2, false, 2, gattMapValue20 },
+  { 21, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue21 },
+  { 22, GATT_MAP_ATTR_VALUE, 2, { 0x1d, 0x2a }, 0x0002, 1, false, 1, gattMapValue22 },
+  { 23, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue23 },
+  { 24, GATT_MAP_ATTR_VALUE, 2, { 0x1e, 0x2a }, 0x0210, 13, false, 13, gattMapValue24 }, /* intermediate_temperature */
+  { 25, GATT_MAP_ATTR_DESCRIPTOR, 2, { 0x02, 0x29 }, 0x000a, 2, false, 2, gattMapValue25 },
+  { 26, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue26 },
+  { 27, GATT_MAP_ATTR_VALUE, 2, { 0x21, 0x2a }, 0x010a, 2, false, 2, gattMapValue27 }, /* MeasInt */
+  { 28, GATT_MAP_ATTR_DESCRIPTOR, 2, { 0x06, 0x29 }, 0x0002, 4, false, 4, gattMapValue28 }, /* valid_range */
+  { 29, GATT_MAP_ATTR_SERVICE, 2, { 0x00, 0x28 }, 0x0000, 2, false, 2, gattMapValue29 },
+  { 30, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue30 },
+  { 31, GATT_MAP_ATTR_VALUE, 2, { 0x06, 0x2a }, 0x0004, 1, false, 1, gattMapValue31 }, /* alert_level */
+  { 32, GATT_MAP_ATTR_SERVICE, 2, { 0x00, 0x28 }, 0x0000, 16, false, 16, gattMapValue32 },
+  { 33, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 19, false, 19, gattMapValue33 },
+  { 34, GATT_MAP_ATTR_VALUE, 16, { 0x63, 0x60, 0x32, 0xe0, 0x37, 0x5e, 0xa4, 0x88, 0x53, 0x4e, 0x6d, 0xfb, 0x64, 0x35, 0xbf, 0xf7 }, 0x0108, 1, false, 1, gattMapValue34 }, /* ota_control */
+  { 35, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 19, false, 19, gattMapValue35 },
+  { 36, GATT_MAP_ATTR_VALUE, 16, { 0x53, 0xa1, 0x81, 0x1f, 0x58, 0x2c, 0xd0, 0xa5, 0x45, 0x40, 0xfc, 0x34, 0xf3, 0x27, 0x42, 0x98 }, 0x010c, 255, true, 0, NULL }, /* ota_data */
+  { 37, GATT_MAP_ATTR_SERVICE, 2, { 0x00, 0x28 }, 0x0000, 2, false, 2, gattMapValue37 },
+  { 38, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue38 },
+  { 39, GATT_MAP_ATTR_VALUE, 2, { 0x19, 0x2a }, 0x030a, 1, false, 1, gattMapValue39 }, /* battery_level */
+  { 40, GATT_MAP_ATTR_DESCRIPTOR, 2, { 0x04, 0x29 }, 0x0002, 7, false, 7, gattMapValue40 }, /* characteristic_presentation_format */
+  { 41, GATT_MAP_ATTR_DESCRIPTOR, 2, { 0x02, 0x29 }, 0x000a, 2, false, 2, gattMapValue41 },
+  { 42, GATT_MAP_ATTR_SERVICE, 2, { 0x00, 0x28 }, 0x0000, 2, false, 2, gattMapValue42 },
+  { 43, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue43 },
+  { 44, GATT_MAP_ATTR_VALUE, 2, { 0x37, 0x2a }, 0x0310, 247, true, 0, NULL }, /* heart_rate_measurement */
+  { 45, GATT_MAP_ATTR_DESCRIPTOR, 2, { 0x02, 0x29 }, 0x000a, 2, false, 2, gattMapValue45 },
+  { 46, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue46 },
+  { 47, GATT_MAP_ATTR_VALUE, 2, { 0x38, 0x2a }, 0x0002, 1, false, 1, gattMapValue47 }, /* body_sensor_location */
+  { 48, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue48 },
+  { 49, GATT_MAP_ATTR_VALUE, 2, { 0x39, 0x2a }, 0x0108, 1, false, 1, gattMapValue49 }, /* heart_rate_control_point */
+  { 50, GATT_MAP_ATTR_SERVICE, 2, { 0x00, 0x28 }, 0x0000, 2, false, 2, gattMapValue50 },
+  { 51, GATT_MAP_ATTR_CHARACTERISTIC, 2, { 0x03, 0x28 }, 0x0000, 5, false, 5, gattMapValue51 },
+  { 52, GATT_MAP_ATTR_VALUE, 2, { 0x2b, 0x2a }, 0x031a, 10, false, 10, gattMapValue52 }, /* current_time */
+  { 53, GATT_MAP_ATTR_DESCRIPTOR, 2, { 0x02, 0x29 }, 0x000a, 2, false, 2, gattMapValue53 }
+};
+
+#endif /* HOST */
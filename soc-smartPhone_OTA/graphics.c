@@ -28,6 +28,17 @@
 /* Own header */
 #include "graphics.h"
 
+/***************************************************************************************************
+   Local Macros and Definitions
+ **************************************************************************************************/
+
+/* Font atlas the text is drawn with */
+#define GRAPH_ATLAS                    (&GLIB_AtlasNarrow6x8)
+
+/* Size of the splash screen icon */
+#define GRAPH_SPLASH_WIDTH             24
+#define GRAPH_SPLASH_HEIGHT            48
+
 /***************************************************************************************************
    Local Variables
  **************************************************************************************************/
@@ -39,6 +50,35 @@ static uint8_t graphLineNum = 0;
 /* Device name string */
 static char *deviceHeader = NULL;
 
+#if defined(DMD_RASTER_1BPP)
+/* Splash screen icon, a thermometer as a 1-bit BMP kept in flash */
+static const uint8_t graphSplashBmp[] =
+{
+  0x42, 0x4d, 0xfe, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3e, 0x00,
+  0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x30, 0x00,
+  0x00, 0x00, 0x01, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0xc0, 0x00,
+  0x00, 0x00, 0x13, 0x0b, 0x00, 0x00, 0x13, 0x0b, 0x00, 0x00, 0x02, 0x00,
+  0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x01, 0xff,
+  0x80, 0x00, 0x03, 0x81, 0xc0, 0x00, 0x06, 0x3c, 0x60, 0x00, 0x0e, 0xff,
+  0x70, 0x00, 0x0c, 0xff, 0x30, 0x00, 0x0d, 0xff, 0xb0, 0x00, 0x0d, 0xff,
+  0xb0, 0x00, 0x0d, 0xff, 0xb0, 0x00, 0x0d, 0xff, 0xb0, 0x00, 0x0c, 0xff,
+  0x30, 0x00, 0x0e, 0xff, 0x70, 0x00, 0x06, 0x3c, 0x60, 0x00, 0x03, 0x99,
+  0xc0, 0x00, 0x01, 0x99, 0x80, 0x00, 0x01, 0x99, 0x80, 0x00, 0x01, 0x99,
+  0x80, 0x00, 0x01, 0x99, 0x80, 0x00, 0x01, 0x99, 0xe0, 0x00, 0x01, 0x99,
+  0x80, 0x00, 0x01, 0x99, 0x80, 0x00, 0x01, 0x99, 0x80, 0x00, 0x01, 0x99,
+  0xf8, 0x00, 0x01, 0x99, 0x80, 0x00, 0x01, 0x99, 0x80, 0x00, 0x01, 0x99,
+  0x80, 0x00, 0x01, 0x99, 0xe0, 0x00, 0x01, 0x99, 0x80, 0x00, 0x01, 0x99,
+  0x80, 0x00, 0x01, 0x81, 0x80, 0x00, 0x01, 0x81, 0xf8, 0x00, 0x01, 0x81,
+  0x80, 0x00, 0x01, 0x81, 0x80, 0x00, 0x01, 0x81, 0x80, 0x00, 0x01, 0x81,
+  0xe0, 0x00, 0x01, 0x81, 0x80, 0x00, 0x01, 0x81, 0x80, 0x00, 0x01, 0x81,
+  0x80, 0x00, 0x01, 0x81, 0x80, 0x00, 0x01, 0x81, 0x80, 0x00, 0x00, 0xc3,
+  0x00, 0x00, 0x00, 0xc3, 0x00, 0x00, 0x00, 0xff, 0x00, 0x00, 0x00, 0x7e,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00
+};
+#endif
+
 /***************************************************************************************************
    Static Function Declarations
  **************************************************************************************************/
@@ -74,10 +114,24 @@ void graphInit(char *header)
   glibContext.backgroundColor = White;
   glibContext.foregroundColor = Black;
 
-  /* Use Narrow font */
-  GLIB_setFont(&glibContext, (GLIB_Font_t *)&GLIB_FontNarrow6x8);
-
   deviceHeader = header;
+
+  /* Show the header and the icon until the first string is written */
+  GLIB_clear(&glibContext);
+  graphLineNum = 0;
+  graphPrintCenter(&glibContext, deviceHeader);
+#if defined(DMD_RASTER_1BPP)
+  {
+    int32_t top = ((GRAPH_ATLAS->lineSpacing + GRAPH_ATLAS->height) * graphLineNum)
+                  + GRAPH_ATLAS->lineSpacing;
+
+    GLIB_drawBmp(&glibContext,
+                 (glibContext.pDisplayGeometry->xSize - GRAPH_SPLASH_WIDTH) >> 1,
+                 top + ((glibContext.pDisplayGeometry->ySize - top - GRAPH_SPLASH_HEIGHT) >> 1),
+                 graphSplashBmp, sizeof(graphSplashBmp));
+  }
+#endif
+  DMD_updateDisplay();
 }
 
 void graphWriteString(char *string)
@@ -119,11 +173,10 @@ static void graphPrintCenter(GLIB_Context_t *pContext, char *pString)
     len = nextToken - pString;
     /* Print the line if it is not null length */
     if (len) {
-      uint8_t strWidth = len * pContext->font.fontWidth;
-      uint8_t posX = (pContext->pDisplayGeometry->xSize - strWidth) >> 1;
-      uint8_t posY = ((pContext->font.lineSpacing + pContext->font.fontHeight) * graphLineNum)
-                     + pContext->font.lineSpacing;
-      GLIB_drawString(pContext, pString, len, posX, posY, 0);
+      uint8_t posY = ((GRAPH_ATLAS->lineSpacing + GRAPH_ATLAS->height) * graphLineNum)
+                     + GRAPH_ATLAS->lineSpacing;
+      GLIB_drawText(pContext, GRAPH_ATLAS, pString, len, pContext->pDisplayGeometry->xSize >> 1, posY,
+                    GLIB_ALIGN_CENTER, false);
     }
     pString = nextToken;
     /* If the token at the end of the line is new line character, then increase line number */
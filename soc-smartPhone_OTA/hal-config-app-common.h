@@ -31,6 +31,29 @@
 
 #define HAL_EXTFLASH_FREQUENCY                        (1000000)
 
+/* LDMA channel allocation. Every channel has exactly one owner, the top channels are used to stay
+ * clear of DMADRV allocations. */
+#define APP_CONSOLE_TX_DMA_CH                         (7)
+#define APP_CONSOLE_RX_DMA_CH                         (6)
+#define IA_PWM_DMA_CH                                 (5)
+#define MX25_LDMA_CH_TX                               (4)
+#define MX25_LDMA_CH_RX                               (3)
+
+#define HAL_LDMA_CH_LIST                              ((1UL << APP_CONSOLE_TX_DMA_CH)   \
+                                                       + (1UL << APP_CONSOLE_RX_DMA_CH) \
+                                                       + (1UL << IA_PWM_DMA_CH)         \
+                                                       + (1UL << MX25_LDMA_CH_TX)       \
+                                                       + (1UL << MX25_LDMA_CH_RX))
+#define HAL_LDMA_CH_USED                              ((1UL << APP_CONSOLE_TX_DMA_CH)   \
+                                                       | (1UL << APP_CONSOLE_RX_DMA_CH) \
+                                                       | (1UL << IA_PWM_DMA_CH)         \
+                                                       | (1UL << MX25_LDMA_CH_TX)       \
+                                                       | (1UL << MX25_LDMA_CH_RX))
+/* The sum only equals the union if no two owners share a channel */
+#if (HAL_LDMA_CH_LIST != HAL_LDMA_CH_USED)
+#error "Two LDMA users are allocated the same channel"
+#endif
+
 #define HAL_PA_ENABLE                                 (1)
 
 #define HAL_PTI_ENABLE                                (1)
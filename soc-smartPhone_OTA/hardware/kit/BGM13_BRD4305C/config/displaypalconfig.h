@@ -39,6 +39,14 @@
  */
 #define PAL_SPI_BAUDRATE       (3500000) /* Max baudrate */
 
+/*
+ * Select the TIMER that times the SCS setup and hold delays. It keeps the
+ * display driver from calibrating the UDELAY loop on the RTCC, which is used
+ * by the Bluetooth stack.
+ */
+#define PAL_TIMER_UNIT         (TIMER1)
+#define PAL_TIMER_CLOCK        (cmuClock_TIMER1)
+
 /*
  * On this board we can use HW to toggle GPIO pins,
  * especially the GPIO port D pin 13 signal which is connected to the
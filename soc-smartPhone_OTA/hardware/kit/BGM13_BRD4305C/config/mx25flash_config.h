@@ -32,5 +32,7 @@
 
 #define MX25_USART             USART1
 #define MX25_USART_CLK         cmuClock_USART1
+#define MX25_DMAREQ_RX         DMAREQ_USART1_RXDATAV
+#define MX25_DMAREQ_TX         DMAREQ_USART1_TXBL
 
 #endif // MX25CONFIG_H
@@ -596,6 +596,16 @@ EMSTATUS DISPLAY_DeviceRegister(DISPLAY_Device_t *device)
 
  #define PAL_SPI_BAUDRATE
       Specifies the SPI baud rate.
+
+ #define PAL_TIMER_UNIT and PAL_TIMER_CLOCK
+      Select a free TIMER and its clock to time the chip select setup and
+      hold delays with a one-shot count. The display driver then never
+      calibrates the UDELAY busy loop, which borrows the RTC/RTCC.
+
+ #define PAL_TIMER_UDELAY
+      Time the chip select delays with the UDELAY busy loop even if a TIMER
+      is selected. The loop is calibrated at the first PAL_TimerInit and
+      again only when the core clock frequency has changed.
    @endverbatim
 
    @n @subsection display_textdisplayconfig TEXTDISPLAY Configuration
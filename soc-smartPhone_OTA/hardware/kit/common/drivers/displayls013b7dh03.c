@@ -317,10 +317,11 @@ static EMSTATUS DisplayClear(void)
   PAL_GpioPinOutSet(LCD_PORT_SCS, LCD_PIN_SCS);
 
   /* SCS setup time: min 6us */
-  PAL_TimerMicroSecondsDelay(6);
+  PAL_TimerDeadlineStart(6);
+  cmd = LS013B7DH03_CMD_ALL_CLEAR | lcdPolarity;
+  PAL_TimerDeadlineWait();
 
   /* Send command */
-  cmd = LS013B7DH03_CMD_ALL_CLEAR | lcdPolarity;
   PAL_SpiTransmit((uint8_t*) &cmd, 2);
 
   /* SCS hold time: min 2us */
@@ -633,6 +634,12 @@ static EMSTATUS PixelMatrixDraw(DISPLAY_Device_t*      device,
      from 1, while the DISPLAY interface starts from 0. */
   startRow++;
 
+  /* Assert SCS */
+  PAL_GpioPinOutSet(LCD_PORT_SCS, LCD_PIN_SCS);
+
+  /* SCS setup time: min 6us, the control words are set up meanwhile */
+  PAL_TimerDeadlineStart(6);
+
 #ifdef USE_CONTROL_BYTES
   /* Setup line addressing in control words. */
   pixelMatrixSetup(pixelMatrix, startRow, height
@@ -642,11 +649,7 @@ static EMSTATUS PixelMatrixDraw(DISPLAY_Device_t*      device,
                    );
 #endif
 
-  /* Assert SCS */
-  PAL_GpioPinOutSet(LCD_PORT_SCS, LCD_PIN_SCS);
-
-  /* SCS setup time: min 6us */
-  PAL_TimerMicroSecondsDelay(6);
+  PAL_TimerDeadlineWait();
 
   /* Send update command and first line address */
   cmd = LS013B7DH03_CMD_UPDATE | (startRow << 8);
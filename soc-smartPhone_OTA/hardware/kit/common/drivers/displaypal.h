@@ -215,6 +215,22 @@ EMSTATUS PAL_TimerShutdown (void);
  *****************************************************************************/
 EMSTATUS PAL_TimerMicroSecondsDelay(unsigned int usecs);
 
+/**************************************************************************//**
+ * @brief   Start a deadline the specified number of micro seconds from now.
+ *
+ * @param[in] usecs   Number of micro seconds to the deadline.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS PAL_TimerDeadlineStart(unsigned int usecs);
+
+/**************************************************************************//**
+ * @brief   Wait for the deadline started by PAL_TimerDeadlineStart().
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS PAL_TimerDeadlineWait(void);
+
 #ifdef PAL_TIMER_REPEAT_FUNCTION
 /**************************************************************************//**
  * @brief   Call a callback function at the given frequency.
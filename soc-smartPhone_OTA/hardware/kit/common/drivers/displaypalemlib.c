@@ -26,12 +26,20 @@
 #include "em_gpio.h"
 #include "em_usart.h"
 #include "bsp.h"
-#include "udelay.h"
 
 /* DISPLAY driver inclustions */
 #include "displayconfigall.h"
 #include "displaypal.h"
 
+/* The SCS setup and hold delays are timed by a TIMER one-shot if the kit
+   configuration selects one, or else by the calibrated UDELAY loop. */
+#if defined(PAL_TIMER_UNIT) && !defined(PAL_TIMER_UDELAY)
+#define PAL_TIMER_ONE_SHOT
+#include "em_timer.h"
+#else
+#include "udelay.h"
+#endif
+
 #ifdef INCLUDE_PAL_GPIO_PIN_AUTO_TOGGLE
 
 #if defined(RTCC_PRESENT) && (RTCC_COUNT > 0) && !defined(PAL_CLOCK_RTC)
@@ -71,6 +79,17 @@ static void rtcSetup(unsigned int frequency);
 
 #endif
 
+#if defined(PAL_TIMER_ONE_SHOT)
+/* Number of timer ticks per micro second, rounded up. */
+static uint32_t timerTicksPerUs;
+#else
+/* Core clock frequency the UDELAY loop was last calibrated at. */
+static uint32_t udelayCoreClock;
+
+/* Length of the deadline started by PAL_TimerDeadlineStart(). */
+static unsigned int udelayDeadline;
+#endif
+
 /*******************************************************************************
  **************************     GLOBAL FUNCTIONS      **************************
  ******************************************************************************/
@@ -180,15 +199,35 @@ EMSTATUS PAL_SpiTransmit(uint8_t* data, unsigned int len)
  * @brief   Initialize the PAL Timer interface
  *
  * @detail  This function initializes all resources required to support the
- *          PAL Timer interface functions.
+ *          PAL Timer interface functions. With a TIMER one-shot only the tick
+ *          rate is recomputed on a refresh. The UDELAY loop is calibrated
+ *          only when the core clock has changed since the last calibration,
+ *          since the calibration borrows the RTCC for several milliseconds.
  *
  * @return  EMSTATUS code of the operation.
  *****************************************************************************/
 EMSTATUS PAL_TimerInit(void)
 {
   EMSTATUS status = PAL_EMSTATUS_OK;
+#if defined(PAL_TIMER_ONE_SHOT)
+  TIMER_Init_TypeDef timerInit = TIMER_INIT_DEFAULT;
+
+  CMU_ClockEnable(PAL_TIMER_CLOCK, true);
+
+  /* Count up once from zero to TOP, then stop. */
+  timerInit.enable  = false;
+  timerInit.oneShot = true;
+  TIMER_Init(PAL_TIMER_UNIT, &timerInit);
+
+  timerTicksPerUs = (CMU_ClockFreqGet(PAL_TIMER_CLOCK) + 999999) / 1000000;
+#else
+  uint32_t coreClock = CMU_ClockFreqGet(cmuClock_CORE);
 
-  UDELAY_Calibrate();
+  if (coreClock != udelayCoreClock) {
+    UDELAY_Calibrate();
+    udelayCoreClock = coreClock;
+  }
+#endif
 
   return status;
 }
@@ -205,9 +244,68 @@ EMSTATUS PAL_TimerShutdown(void)
 {
   EMSTATUS status = PAL_EMSTATUS_OK;
 
+#if defined(PAL_TIMER_ONE_SHOT)
+  TIMER_Enable(PAL_TIMER_UNIT, false);
+  CMU_ClockEnable(PAL_TIMER_CLOCK, false);
+#else
   /* Nothing to do since the UDELAY_Delay does not use any resources after
      the UDELAY_Calibrate has been called. The UDELAY_Calibrate uses the
      RTC to calibrate the delay loop, and restores the RTC after use. */
+#endif
+
+  return status;
+}
+
+/**************************************************************************//**
+ * @brief   Start a deadline the specified number of micro seconds from now.
+ *
+ * @detail  The caller may do other work, like preparing the next SPI
+ *          transfer, before it waits for the deadline with
+ *          PAL_TimerDeadlineWait(). With a TIMER one-shot the deadline is
+ *          limited to the 16 bit range of the timer, about 1.7 ms at 38.4 MHz.
+ *
+ * @param[in] usecs   Number of micro seconds to the deadline.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS PAL_TimerDeadlineStart(unsigned int usecs)
+{
+  EMSTATUS status = PAL_EMSTATUS_OK;
+#if defined(PAL_TIMER_ONE_SHOT)
+  uint32_t ticks = usecs * timerTicksPerUs;
+
+  if (ticks > _TIMER_TOP_MASK) {
+    ticks = _TIMER_TOP_MASK;
+  }
+
+  TIMER_Enable(PAL_TIMER_UNIT, false);
+  TIMER_IntClear(PAL_TIMER_UNIT, TIMER_IFC_OF);
+  TIMER_TopSet(PAL_TIMER_UNIT, ticks);
+  TIMER_CounterSet(PAL_TIMER_UNIT, 0);
+  TIMER_Enable(PAL_TIMER_UNIT, true);
+#else
+  udelayDeadline = usecs;
+#endif
+
+  return status;
+}
+
+/**************************************************************************//**
+ * @brief   Wait for the deadline started by PAL_TimerDeadlineStart().
+ *
+ * @detail  With the UDELAY loop the whole delay is spent here.
+ *
+ * @return  EMSTATUS code of the operation.
+ *****************************************************************************/
+EMSTATUS PAL_TimerDeadlineWait(void)
+{
+  EMSTATUS status = PAL_EMSTATUS_OK;
+
+#if defined(PAL_TIMER_ONE_SHOT)
+  while (!(TIMER_IntGet(PAL_TIMER_UNIT) & TIMER_IF_OF)) ;
+#else
+  UDELAY_Delay(udelayDeadline);
+#endif
 
   return status;
 }
@@ -223,7 +321,12 @@ EMSTATUS PAL_TimerMicroSecondsDelay(unsigned int usecs)
 {
   EMSTATUS status = PAL_EMSTATUS_OK;
 
+#if defined(PAL_TIMER_ONE_SHOT)
+  PAL_TimerDeadlineStart(usecs);
+  PAL_TimerDeadlineWait();
+#else
   UDELAY_Delay(usecs);
+#endif
 
   return status;
 }
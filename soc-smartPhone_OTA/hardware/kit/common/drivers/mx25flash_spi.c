@@ -20,10 +20,12 @@
  * $Id: MX25_CMD.c,v 1.31 2015/03/24 01:06:33 mxclldb1 Exp $
  */
 
+#include <stddef.h>
 #include "mx25flash_spi.h"
 #include "em_gpio.h"
 #include "em_usart.h"
 #include "em_cmu.h"
+#include "em_bus.h"
 
 /* If the USART for the MX25 driver is not defined, these functions are unavailable */
 #ifdef MX25_USART
@@ -43,14 +45,39 @@
 #define MX25_BAUDRATE   8000000
 #endif
 
+/* LDMA channels for bulk transfers, used when the USART configuration names its DMA requests.
+ * With HAL_CONFIG they are allocated with all other channels in hal-config-app-common.h. */
+#ifndef MX25_LDMA_CH_RX
+#define MX25_LDMA_CH_RX        3
+#endif
+#ifndef MX25_LDMA_CH_TX
+#define MX25_LDMA_CH_TX        4
+#endif
+/* Shorter transfers are not worth the channel setup */
+#ifndef MX25_LDMA_MIN_LENGTH
+#define MX25_LDMA_MIN_LENGTH   16
+#endif
+#if defined(LDMA_PRESENT) && defined(MX25_DMAREQ_RX) && defined(MX25_DMAREQ_TX)
+#define MX25_USE_LDMA
+#define MX25_LDMA_MAX_XFER     ((_LDMA_CH_CTRL_XFERCNT_MASK >> _LDMA_CH_CTRL_XFERCNT_SHIFT) + 1)
+#endif
+
+/* Runtime counterpart of NON_SYNCHRONOUS_IO, set by MX25_SetAsyncIO() */
+static bool AsyncIO = FALSE;
+
 /* Local functions */
 
 /* Basic functions */
 void CS_High( void );
 void CS_Low( void );
 void InsertDummyCycle( uint8_t dummy_cycle );
+void InsertDelay( uint32_t delay_ns );
 void SendByte( uint8_t byte_value, uint8_t transfer_type );
 uint8_t GetByte( uint8_t transfer_type );
+void TransferBlock( const uint8_t *tx_address, uint8_t *rx_address, uint32_t byte_length );
+#ifdef MX25_USE_LDMA
+void TransferBlockDma( const uint8_t *tx_address, uint8_t *rx_address, uint32_t byte_length );
+#endif
 
 /* Utility functions */
 void Wait_Flash_WarmUp( void );
@@ -190,6 +217,25 @@ void InsertDummyCycle( uint8_t dummy_cycle )
    }
 }
 
+/*
+ * Function:       InsertDelay
+ * Arguments:      delay_ns, time to wait in ns
+ * Description:    Wait by clocking out dummy bytes at MX25_BAUDRATE, at least
+ *                 one byte. The USART clock is at most MX25_BAUDRATE, so the
+ *                 delay is never shorter than requested.
+ * Return Message: None.
+ */
+void InsertDelay( uint32_t delay_ns )
+{
+   uint32_t bytes = (uint32_t)(((uint64_t)delay_ns * MX25_BAUDRATE + 8000000000ULL - 1)
+                               / 8000000000ULL);
+
+   do
+   {
+      USART_SpiTransfer( MX25_USART, 0xff );
+   } while( bytes-- > 1 );
+}
+
 /*
  * Function:       SendByte
  * Arguments:      byte_value, data transfer to flash
@@ -313,6 +359,124 @@ uint8_t GetByte( uint8_t transfer_type )
     return data_buf;
 }
 
+/*
+ * Function:       TransferBlock
+ * Arguments:      tx_address, data to send, NULL to send 0xFF
+ *                 rx_address, buffer for the received data, NULL to discard it
+ *                 byte_length, number of bytes
+ * Description:    Single IO bulk transfer. Long transfers go through the
+ *                 LDMA, short ones keep both USART buffers full instead of
+ *                 waiting for each byte to complete.
+ * Return Message: None.
+ */
+void TransferBlock( const uint8_t *tx_address, uint8_t *rx_address, uint32_t byte_length )
+{
+    uint32_t tx_left = byte_length;
+    uint32_t rx_left = byte_length;
+    uint8_t  data;
+
+#ifdef MX25_USE_LDMA
+    if( byte_length >= MX25_LDMA_MIN_LENGTH )
+    {
+        TransferBlockDma( tx_address, rx_address, byte_length );
+        return;
+    }
+#endif
+
+    while( rx_left )
+    {
+        // At most two bytes in flight, the receive buffer can not overflow
+        if( tx_left && ((rx_left - tx_left) < 2) && (MX25_USART->STATUS & USART_STATUS_TXBL) )
+        {
+            MX25_USART->TXDATA = tx_address ? *tx_address++ : 0xff;
+            tx_left--;
+        }
+        if( MX25_USART->STATUS & USART_STATUS_RXDATAV )
+        {
+            data = (uint8_t)MX25_USART->RXDATA;
+            if( rx_address )
+            {
+                *rx_address++ = data;
+            }
+            rx_left--;
+        }
+    }
+}
+
+#ifdef MX25_USE_LDMA
+/*
+ * Function:       TransferBlockDma
+ * Arguments:      tx_address, data to send, NULL to send 0xFF
+ *                 rx_address, buffer for the received data, NULL to discard it
+ *                 byte_length, number of bytes
+ * Description:    Bulk transfer on two LDMA channels, one feeding the
+ *                 transmitter and one draining the receiver. The transfer
+ *                 is complete when the receive channel is done.
+ * Return Message: None.
+ */
+void TransferBlockDma( const uint8_t *tx_address, uint8_t *rx_address, uint32_t byte_length )
+{
+    static volatile uint32_t rx_desc[4];
+    static volatile uint32_t tx_desc[4];
+    static const uint8_t tx_fill = 0xff;
+    static uint8_t rx_sink;
+    uint32_t ch_mask = (1UL << MX25_LDMA_CH_RX) | (1UL << MX25_LDMA_CH_TX);
+    uint32_t count;
+    uint32_t ctrl;
+
+    CMU_ClockEnable( cmuClock_LDMA, true );
+
+    LDMA->CH[MX25_LDMA_CH_RX].REQSEL = MX25_DMAREQ_RX;
+    LDMA->CH[MX25_LDMA_CH_TX].REQSEL = MX25_DMAREQ_TX;
+    LDMA->CH[MX25_LDMA_CH_RX].CFG    = 0;
+    LDMA->CH[MX25_LDMA_CH_TX].CFG    = 0;
+    LDMA->CH[MX25_LDMA_CH_RX].LOOP   = 0;
+    LDMA->CH[MX25_LDMA_CH_TX].LOOP   = 0;
+    /* only the interrupts of the channels this driver owns */
+    BUS_RegMaskedClear( &LDMA->IEN, ch_mask );
+
+    MX25_USART->CMD = USART_CMD_CLEARRX;
+
+    while( byte_length )
+    {
+        count = (byte_length < MX25_LDMA_MAX_XFER) ? byte_length : MX25_LDMA_MAX_XFER;
+        ctrl  = LDMA_CH_CTRL_STRUCTTYPE_TRANSFER
+                | ((count - 1) << _LDMA_CH_CTRL_XFERCNT_SHIFT)
+                | LDMA_CH_CTRL_BLOCKSIZE_UNIT1
+                | LDMA_CH_CTRL_REQMODE_BLOCK
+                | LDMA_CH_CTRL_SIZE_BYTE;
+
+        rx_desc[0] = ctrl | LDMA_CH_CTRL_SRCINC_NONE
+                     | (rx_address ? LDMA_CH_CTRL_DSTINC_ONE : LDMA_CH_CTRL_DSTINC_NONE);
+        rx_desc[1] = (uint32_t)&MX25_USART->RXDATA;
+        rx_desc[2] = rx_address ? (uint32_t)rx_address : (uint32_t)&rx_sink;
+        rx_desc[3] = 0;
+
+        tx_desc[0] = ctrl | LDMA_CH_CTRL_DSTINC_NONE
+                     | (tx_address ? LDMA_CH_CTRL_SRCINC_ONE : LDMA_CH_CTRL_SRCINC_NONE);
+        tx_desc[1] = tx_address ? (uint32_t)tx_address : (uint32_t)&tx_fill;
+        tx_desc[2] = (uint32_t)&MX25_USART->TXDATA;
+        tx_desc[3] = 0;
+
+        LDMA->CH[MX25_LDMA_CH_RX].LINK = (uint32_t)rx_desc & _LDMA_CH_LINK_LINKADDR_MASK;
+        LDMA->CH[MX25_LDMA_CH_TX].LINK = (uint32_t)tx_desc & _LDMA_CH_LINK_LINKADDR_MASK;
+        BUS_RegMaskedClear( &LDMA->CHDONE, ch_mask );
+
+        // Receiver first, so that no byte is missed
+        LDMA->LINKLOAD = (1UL << MX25_LDMA_CH_RX);
+        LDMA->LINKLOAD = (1UL << MX25_LDMA_CH_TX);
+
+        while( !(LDMA->CHDONE & (1UL << MX25_LDMA_CH_RX)) )
+        {
+        }
+
+        if( tx_address ) tx_address += count;
+        if( rx_address ) rx_address += count;
+        byte_length -= count;
+    }
+}
+#endif
+
 /*
  * Function:       WaitFlashReady
  * Arguments:      ExpectTime, expected time-out value of flash operations.
@@ -328,6 +492,10 @@ bool WaitFlashReady( uint32_t ExpectTime )
 {
 #ifndef NON_SYNCHRONOUS_IO
     volatile uint32_t temp = 0;
+    if( AsyncIO )
+    {
+        return TRUE;
+    }
     while( IsFlashBusy() )
     {
         if( temp > ExpectTime )
@@ -795,7 +963,6 @@ ReturnMsg MX25_RDCR( uint8_t *ConfigReg )
  */
 ReturnMsg MX25_READ( uint32_t flash_address, uint8_t *target_address, uint32_t byte_length )
 {
-    uint32_t index;
     uint8_t  addr_4byte_mode;
 
     // Check flash address
@@ -814,12 +981,8 @@ ReturnMsg MX25_READ( uint32_t flash_address, uint8_t *target_address, uint32_t b
     SendByte( FLASH_CMD_READ, SIO );
     SendFlashAddr( flash_address, SIO, addr_4byte_mode );
 
-    // Set a loop to read data into buffer
-    for( index=0; index < byte_length; index++ )
-    {
-        // Read data one byte at a time
-        *(target_address + index) = GetByte( SIO );
-    }
+    // Read data into buffer
+    TransferBlock( NULL, target_address, byte_length );
 
     // Chip select go high to end a flash command
     CS_High();
@@ -1034,7 +1197,6 @@ ReturnMsg MX25_QREAD( uint32_t flash_address, uint8_t *target_address, uint32_t
  */
 ReturnMsg MX25_FASTREAD( uint32_t flash_address, uint8_t *target_address, uint32_t byte_length )
 {
-    uint32_t index;
     uint8_t  addr_4byte_mode;
     uint8_t  dc;
 
@@ -1057,11 +1219,8 @@ ReturnMsg MX25_FASTREAD( uint32_t flash_address, uint8_t *target_address, uint32
     SendFlashAddr( flash_address, SIO, addr_4byte_mode );
     InsertDummyCycle ( dc );          // Wait dummy cycle
 
-    // Set a loop to read data into data buffer
-    for( index=0; index < byte_length; index++ )
-    {
-        *(target_address + index) = GetByte( SIO );
-    }
+    // Read data into data buffer
+    TransferBlock( NULL, target_address, byte_length );
 
     // Chip select go high to end a flash command
     CS_High();
@@ -1175,7 +1334,6 @@ ReturnMsg MX25_WRDI( void )
  */
 ReturnMsg MX25_PP( uint32_t flash_address, uint8_t *source_address, uint32_t byte_length )
 {
-    uint32_t index;
     uint8_t  addr_4byte_mode;
 
     // Check flash address
@@ -1200,12 +1358,9 @@ ReturnMsg MX25_PP( uint32_t flash_address, uint8_t *source_address, uint32_t byt
     SendByte( FLASH_CMD_PP, SIO );
     SendFlashAddr( flash_address, SIO, addr_4byte_mode );
 
-    // Set a loop to down load whole page data into flash's buffer
+    // Down load whole page data into flash's buffer
     // Note: only last 256 byte ( or 32 byte ) will be programmed
-    for( index=0; index < byte_length; index++ )
-    {
-        SendByte( *(source_address + index), SIO );
-    }
+    TransferBlock( source_address, NULL, byte_length );
 
     // Chip select go high to end a flash command
     CS_High();
@@ -1455,10 +1610,9 @@ ReturnMsg MX25_DP( void )
 {
     // Wake up flash in case the device is in deep power down mode already.
     CS_Low();
-    InsertDummyCycle ( 20*8 );        // wait for tCRDP=20us  (20 x 8 bit / 8Mbps)
+    InsertDelay( tCRDP );             // hold chip select low for tCRDP
     CS_High();
-    InsertDummyCycle ( 30*8 );        // wait for tRDP=35us (20 x 8 bit / 8Mbps)
-    InsertDummyCycle ( 5*8 );
+    InsertDelay( tRDP );              // wait for tRDP before the next command
 
 	// Chip select go low to start a flash command
     CS_Low();
@@ -1473,6 +1627,48 @@ ReturnMsg MX25_DP( void )
 }
 
 
+/*
+ * Function:       MX25_RDP
+ * Arguments:      None.
+ * Description:    Release the device from deep power down mode, chip select
+ *                 is held low for tCRDP and the device is ready after tRDP.
+ * Return Message: FlashOperationSuccess
+ */
+ReturnMsg MX25_RDP( void )
+{
+    CS_Low();
+    InsertDelay( tCRDP );             // hold chip select low for tCRDP
+    CS_High();
+    InsertDelay( tRDP );              // wait for tRDP before the next command
+
+    return FlashOperationSuccess;
+}
+
+/*
+ * Function:       MX25_SetAsyncIO
+ * Arguments:      async, TRUE to return from program and erase commands
+ *                 without waiting for them to complete.
+ * Description:    With asynchronous IO the caller waits for MX25_IsBusy()
+ *                 to return FALSE before the next command, commands issued
+ *                 while the flash is busy return FlashIsBusy.
+ * Return Message: None.
+ */
+void MX25_SetAsyncIO( bool async )
+{
+    AsyncIO = async;
+}
+
+/*
+ * Function:       MX25_IsBusy
+ * Arguments:      None.
+ * Description:    Check whether a program or erase is in progress.
+ * Return Message: TRUE, FALSE
+ */
+bool MX25_IsBusy( void )
+{
+    return IsFlashBusy();
+}
+
 /*
  * Function:       MX25_ENSO
  * Arguments:      None.
@@ -97,6 +97,8 @@
 #define    CE_period        15625000       // tCE /  ( CLK_PERIOD * Min_Cycle_Per_Inst *One_Loop_Inst)
 #define    tW               40000000       // 40ms
 #define    tDP              10000          // 10us
+#define    tCRDP            20             // 20ns
+#define    tRDP             35000          // 35us
 #define    tBP              100000         // 100us
 #define    tPP              10000000       // 10ms
 #define    tSE              240000000      // 240ms
@@ -275,6 +277,9 @@ ReturnMsg MX25_BE( uint32_t flash_address );
 ReturnMsg MX25_CE( void );
 
 ReturnMsg MX25_DP( void );
+ReturnMsg MX25_RDP( void );
+void MX25_SetAsyncIO( bool async );
+bool MX25_IsBusy( void );
 ReturnMsg MX25_ENSO( void );
 ReturnMsg MX25_EXSO( void );
 ReturnMsg MX25_SBL( uint8_t burstconfig );
@@ -10,16 +10,22 @@
   #define MX25_USART                USART0
   #define MX25_USART_CLK            cmuClock_USART0
   #define MX25_USART_ROUTE          GPIO->USARTROUTE[0]
+  #define MX25_DMAREQ_RX            DMAREQ_USART0_RXDATAV
+  #define MX25_DMAREQ_TX            DMAREQ_USART0_TXBL
 #elif BSP_EXTFLASH_USART == HAL_SPI_PORT_USART1
 // USART1
   #define MX25_USART                USART1
   #define MX25_USART_CLK            cmuClock_USART1
   #define MX25_USART_ROUTE          GPIO->USARTROUTE[1]
+  #define MX25_DMAREQ_RX            DMAREQ_USART1_RXDATAV
+  #define MX25_DMAREQ_TX            DMAREQ_USART1_TXBL
 #elif BSP_EXTFLASH_USART == HAL_SPI_PORT_USART2
 // USART2
   #define MX25_USART                USART2
   #define MX25_USART_CLK            cmuClock_USART2
   #define MX25_USART_ROUTE          GPIO->USARTROUTE[2]
+  #define MX25_DMAREQ_RX            DMAREQ_USART2_RXDATAV
+  #define MX25_DMAREQ_TX            DMAREQ_USART2_TXBL
 #elif BSP_EXTFLASH_USART == HAL_SPI_PORT_USART3
 // USART3
   #define MX25_USART                USART3
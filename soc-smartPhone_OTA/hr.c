@@ -0,0 +1,344 @@
+/***************************************************************************//**
+ * @file
+ * @brief Heart Rate Service
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* BG stack headers */
+#include "bg_types.h"
+#include "gatt_db.h"
+#include "native_gecko.h"
+#include "infrastructure.h"
+
+/* application specific headers */
+#include "app.h"
+#include "app_timer.h"
+#include "gatt_map.h"
+#include "hr_meas.h"
+
+/* Own header */
+#include "hr.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Services
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup hr
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+
+/** Indicates currently there is no active connection using this service. */
+#define HR_NO_CONNECTION                0xFF
+
+/** RR-Intervals queued between notifications, a power of 2. 300 bpm gives 5 per second. */
+#define HR_RR_QUEUE                     32
+
+/** Connections the ATT_MTU is tracked for, handles run from 1. */
+#define HR_CONNECTIONS                  4
+
+/** Default ATT_MTU and the notification header it loses. */
+#define HR_ATT_MTU_DEFAULT              23
+#define HR_ATT_NOTIFY_HEADER            3
+/** Largest measurement, the longest notification of the stack. */
+#define HR_MEAS_MAX_LEN                 (250 - HR_ATT_NOTIFY_HEADER)
+
+/** Heart Rate Control Point: reset Energy Expended. */
+#define HR_CP_RESET_ENERGY              0x01
+/** Write error: Control Point value not supported. */
+#define HR_ATT_ERR_CP_NOT_SUPPORTED     0x80
+
+/***************************************************************************************************
+ * Local Variables
+ **************************************************************************************************/
+
+static uint8_t hrConnection = HR_NO_CONNECTION; /* Subscribed connection */
+static uint16_t hrMtu[HR_CONNECTIONS]; /* ATT_MTU per connection, 0 for the default */
+
+static const hrSource_t *hrSource = NULL; /* Beat source, NULL until a source is selected */
+static appTimer_t hrNotifyTimer; /* Notification timer */
+
+static uint16_t hrRrQueue[HR_RR_QUEUE]; /* RR-Intervals not yet sent */
+static uint8_t hrRrHead = 0; /* Oldest queued RR-Interval */
+static uint8_t hrRrCount = 0; /* Queued RR-Intervals */
+static uint32_t hrRrDropped = 0; /* RR-Intervals lost to a full queue */
+static uint16_t hrBpm = 0; /* Heart rate of the last batch */
+static uint32_t hrEnergyJ = 0; /* Energy Expended since the last reset in J */
+static uint8_t hrEnergyCountdown = 0; /* Notifications until the next Energy Expended */
+
+static hrSynth_t hrSynth; /* Synthetic beat generator */
+static hrBeatCback_t hrSynthBeat = NULL; /* Beat callback of the synthetic source */
+static appTimer_t hrSynthTimer; /* Synthetic beat timer */
+static uint16_t hrSynthRr = 0; /* RR-Interval ending at the next synthetic beat */
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+
+static void hrStart(uint8_t connection);
+static void hrStop(void);
+static void hrBeat(uint16_t rr, uint16_t energyJ);
+static void hrNotifyTimerCback(void *arg);
+static void hrSynthStart(hrBeatCback_t beat);
+static void hrSynthStop(void);
+static void hrSynthSchedule(void);
+static void hrSynthTimerCback(void *arg);
+static const hrSource_t *hrActiveSource(void);
+
+/** Synthetic beat source. */
+static const hrSource_t hrSynthSource = { hrSynthStart, hrSynthStop };
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+
+void hrSetSource(const hrSource_t *source)
+{
+  bool running = (hrConnection != HR_NO_CONNECTION);
+
+  if (running) {
+    hrActiveSource()->stop();
+  }
+  hrSource = source;
+  if (running) {
+    hrActiveSource()->start(hrBeat);
+  }
+}
+
+void hrMtuExchanged(uint8_t connection, uint16_t mtu)
+{
+  if ((connection >= 1) && (connection <= HR_CONNECTIONS)) {
+    hrMtu[connection - 1] = mtu;
+  }
+}
+
+void hrConnectionClosed(uint8_t connection)
+{
+  if ((connection >= 1) && (connection <= HR_CONNECTIONS)) {
+    hrMtu[connection - 1] = 0;
+  }
+  if (connection == hrConnection) {
+    hrStop();
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Heart Rate Measurement status handler, bound in gatt_handlers.txt.
+ *  \param[in]  pEvt  Characteristic status.
+ **************************************************************************************************/
+void hrMeasurementStatus(const struct gecko_msg_gatt_server_characteristic_status_evt_t *pEvt)
+{
+  if (pEvt->status_flags != gatt_server_client_config) {
+    return;
+  }
+
+  if (pEvt->client_config_flags) {
+    hrStart(pEvt->connection);
+  } else if (pEvt->connection == hrConnection) {
+    hrStop();
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Heart Rate Control Point write handler, bound in gatt_handlers.txt.
+ *  \param[in]  pEvt  User write request.
+ **************************************************************************************************/
+void hrControlPointWrite(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt)
+{
+  uint8_t err = HR_ATT_ERR_CP_NOT_SUPPORTED;
+
+  if ((pEvt->value.len == 1) && (pEvt->value.data[0] == HR_CP_RESET_ENERGY)) {
+    hrEnergyJ = 0;
+    /* the next measurement shows the reset */
+    hrEnergyCountdown = 0;
+    err = bg_err_success;
+  }
+
+  gecko_cmd_gatt_server_send_user_write_response(pEvt->connection, gattdb_heart_rate_control_point,
+                                                 err);
+}
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Start the beats and the notifications.
+ *  \param[in]  connection  Subscribed connection.
+ **************************************************************************************************/
+static void hrStart(uint8_t connection)
+{
+  if (hrConnection == HR_NO_CONNECTION) {
+    hrRrHead = 0;
+    hrRrCount = 0;
+    hrEnergyCountdown = 0;
+    hrActiveSource()->start(hrBeat);
+    appTimerStart(&hrNotifyTimer, HR_NOTIFY_MS, 0, true, hrNotifyTimerCback, NULL);
+  }
+  hrConnection = connection;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Stop the beats and the notifications.
+ **************************************************************************************************/
+static void hrStop(void)
+{
+  if (hrConnection == HR_NO_CONNECTION) {
+    return;
+  }
+  hrConnection = HR_NO_CONNECTION;
+  hrActiveSource()->stop();
+  appTimerStop(&hrNotifyTimer);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Queue a beat for the next notification.
+ *  \param[in]  rr  RR-Interval in 1/1024 s.
+ *  \param[in]  energyJ  Energy expended during the beat in J.
+ **************************************************************************************************/
+static void hrBeat(uint16_t rr, uint16_t energyJ)
+{
+  if (hrRrCount == HR_RR_QUEUE) {
+    /* the oldest interval makes room */
+    hrRrHead = (hrRrHead + 1) & (HR_RR_QUEUE - 1);
+    hrRrCount--;
+    hrRrDropped++;
+  }
+  hrRrQueue[(hrRrHead + hrRrCount) & (HR_RR_QUEUE - 1)] = rr;
+  hrRrCount++;
+
+  hrEnergyJ += energyJ;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Notification timer callback, sends the queued beats.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void hrNotifyTimerCback(void *arg)
+{
+  uint16_t rr[HR_RR_QUEUE];
+  uint8_t buf[HR_MEAS_MAX_LEN];
+  hrMeas_t meas;
+  uint16_t maxLen = HR_ATT_MTU_DEFAULT - HR_ATT_NOTIFY_HEADER;
+  uint16_t len;
+  uint8_t used;
+  uint8_t i;
+
+  (void)arg;
+  if (hrConnection == HR_NO_CONNECTION) {
+    return;
+  }
+
+  if ((hrConnection >= 1) && (hrConnection <= HR_CONNECTIONS) && hrMtu[hrConnection - 1]) {
+    maxLen = hrMtu[hrConnection - 1] - HR_ATT_NOTIFY_HEADER;
+  }
+  if (maxLen > sizeof(buf)) {
+    maxLen = sizeof(buf);
+  }
+
+  /* the queue in order for the encoder, the rate is taken over all of it */
+  for (i = 0; i < hrRrCount; i++) {
+    rr[i] = hrRrQueue[(hrRrHead + i) & (HR_RR_QUEUE - 1)];
+  }
+  if (hrRrCount) {
+    hrBpm = hrMeasBpm(rr, hrRrCount);
+  }
+
+  meas.bpm = hrBpm;
+  meas.flags = 0;
+  meas.energyPresent = (hrEnergyCountdown == 0);
+  meas.energy = (hrEnergyJ / 1000 < HR_MEAS_ENERGY_MAX) ? (uint16_t)(hrEnergyJ / 1000)
+                : HR_MEAS_ENERGY_MAX;
+  meas.rr = rr;
+  meas.rrCount = hrRrCount;
+
+  len = hrMeasEncode(buf, maxLen, &meas, &used);
+  if (gecko_cmd_gatt_server_send_characteristic_notification(hrConnection,
+                                                             gattdb_heart_rate_measurement,
+                                                             (uint8_t)len, buf)->result
+      != bg_err_success) {
+    /* out of buffers, the beats go with the next notification */
+    return;
+  }
+
+  /* intervals that did not fit stay queued */
+  hrRrHead = (hrRrHead + used) & (HR_RR_QUEUE - 1);
+  hrRrCount -= used;
+  hrEnergyCountdown = meas.energyPresent ? (HR_ENERGY_EVERY - 1) : (hrEnergyCountdown - 1);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Get the selected beat source.
+ *  \return  Source, the synthetic one unless another has been selected.
+ **************************************************************************************************/
+static const hrSource_t *hrActiveSource(void)
+{
+  return hrSource ? hrSource : &hrSynthSource;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Start the synthetic source.
+ *  \param[in]  beat  Beat callback.
+ **************************************************************************************************/
+static void hrSynthStart(hrBeatCback_t beat)
+{
+  hrSynthBeat = beat;
+  hrSynthInit(&hrSynth, HR_SYNTH_BPM, HR_SYNTH_VARIABILITY, 0x2545F491UL);
+  hrSynthSchedule();
+}
+
+/***********************************************************************************************//**
+ *  \brief  Stop the synthetic source.
+ **************************************************************************************************/
+static void hrSynthStop(void)
+{
+  appTimerStop(&hrSynthTimer);
+  hrSynthBeat = NULL;
+}
+
+/***********************************************************************************************//**
+ *  \brief  Schedule the next synthetic beat one RR-Interval from now.
+ **************************************************************************************************/
+static void hrSynthSchedule(void)
+{
+  hrSynthRr = hrSynthNext(&hrSynth);
+  appTimerStart(&hrSynthTimer, ((uint32_t)hrSynthRr * 1000 + HR_MEAS_RR_PER_S / 2) / HR_MEAS_RR_PER_S,
+                0, false, hrSynthTimerCback, NULL);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Synthetic beat timer callback.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void hrSynthTimerCback(void *arg)
+{
+  (void)arg;
+  if (hrSynthBeat) {
+    hrSynthBeat(hrSynthRr, HR_ENERGY_J_PER_BEAT);
+  }
+  hrSynthSchedule();
+}
+
+/** @} (end addtogroup hr) */
+/** @} (end addtogroup Services) */
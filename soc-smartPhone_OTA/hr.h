@@ -0,0 +1,117 @@
+/***************************************************************************//**
+ * @file
+ * @brief Heart Rate Service header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef HR_H
+#define HR_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+/***********************************************************************************************//**
+ * \defgroup hr Heart Rate
+ * \brief Heart Rate Service API
+ *
+ * Beats come from a pluggable source as RR-Intervals. They are queued and sent once per
+ * HR_NOTIFY_MS in a Heart Rate Measurement, packed up to the connection's ATT_MTU, together with
+ * the heart rate over the batch and, every HR_ENERGY_EVERY notifications, the Energy Expended.
+ * Without a sensor the source is a synthetic generator.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Services
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup hr
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Notification period in ms. */
+#ifndef HR_NOTIFY_MS
+#define HR_NOTIFY_MS                    1000
+#endif
+
+/** Notifications between two that carry the Energy Expended. */
+#ifndef HR_ENERGY_EVERY
+#define HR_ENERGY_EVERY                 10
+#endif
+
+/** Energy per beat in J used by the synthetic source, about 5 kJ per minute at 80 bpm. */
+#ifndef HR_ENERGY_J_PER_BEAT
+#define HR_ENERGY_J_PER_BEAT            60
+#endif
+
+/** Mean rate and interval variation in percent of the synthetic source. */
+#ifndef HR_SYNTH_BPM
+#define HR_SYNTH_BPM                    72
+#endif
+#ifndef HR_SYNTH_VARIABILITY
+#define HR_SYNTH_VARIABILITY            8
+#endif
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Beat callback, called by a source with the RR-Interval in 1/1024 s and the energy in J. */
+typedef void (*hrBeatCback_t)(uint16_t rr, uint16_t energyJ);
+
+/** Beat source. */
+typedef struct {
+  void (*start)(hrBeatCback_t beat);  /**< Start calling beat for every heart beat. */
+  void (*stop)(void);                 /**< Stop calling beat. */
+} hrSource_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Select the beat source.
+ *  \param[in]  source  Source, NULL for the synthetic source.
+ **************************************************************************************************/
+void hrSetSource(const hrSource_t *source);
+
+/***********************************************************************************************//**
+ *  \brief  Record the ATT_MTU of a connection, the measurements are packed up to it.
+ *  \param[in]  connection  Connection ID.
+ *  \param[in]  mtu  ATT_MTU.
+ **************************************************************************************************/
+void hrMtuExchanged(uint8_t connection, uint16_t mtu);
+
+/***********************************************************************************************//**
+ *  \brief  Stop the measurements of a closed connection.
+ *  \param[in]  connection  Connection ID.
+ **************************************************************************************************/
+void hrConnectionClosed(uint8_t connection);
+
+/** @} (end addtogroup hr) */
+/** @} (end addtogroup Services) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* HR_H */
@@ -0,0 +1,138 @@
+/***************************************************************************//**
+ * @file
+ * @brief Heart Rate Measurement encoder
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* standard library headers */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* Own header */
+#include "hr_meas.h"
+
+/***********************************************************************************************//**
+ * @addtogroup Services
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup hr_meas
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Local Macros and Definitions
+ **************************************************************************************************/
+
+/** Beats per breathing cycle of the synthetic source. */
+#define HR_SYNTH_BREATH_BEATS           4
+
+/** Breathing modulation per beat, a coarse sine in 1/4 of the swing. */
+static const int8_t hrSynthBreath[HR_SYNTH_BREATH_BEATS] = { 0, 4, 0, -4 };
+
+/***************************************************************************************************
+ * Public Function Definitions
+ **************************************************************************************************/
+
+uint16_t hrMeasEncode(uint8_t *buf, uint16_t maxLen, const hrMeas_t *meas, uint8_t *rrUsed)
+{
+  uint8_t flags = meas->flags & (HR_MEAS_FLAG_VALUE_16BIT | HR_MEAS_FLAG_CONTACT_DETECTED
+                                 | HR_MEAS_FLAG_CONTACT_SUPPORTED);
+  uint16_t len = 1;
+  uint8_t count = 0;
+
+  if (meas->bpm > 0xFF) {
+    flags |= HR_MEAS_FLAG_VALUE_16BIT;
+  }
+
+  buf[len++] = (uint8_t)meas->bpm;
+  if (flags & HR_MEAS_FLAG_VALUE_16BIT) {
+    buf[len++] = (uint8_t)(meas->bpm >> 8);
+  }
+
+  if (meas->energyPresent) {
+    flags |= HR_MEAS_FLAG_ENERGY_PRESENT;
+    buf[len++] = (uint8_t)meas->energy;
+    buf[len++] = (uint8_t)(meas->energy >> 8);
+  }
+
+  while ((count < meas->rrCount) && (len + 2 <= maxLen)) {
+    buf[len++] = (uint8_t)meas->rr[count];
+    buf[len++] = (uint8_t)(meas->rr[count] >> 8);
+    count++;
+  }
+  if (count) {
+    flags |= HR_MEAS_FLAG_RR_PRESENT;
+  }
+
+  buf[0] = flags;
+  *rrUsed = count;
+  return len;
+}
+
+uint16_t hrMeasBpm(const uint16_t *rr, uint8_t count)
+{
+  uint32_t sum = 0;
+  uint8_t i;
+
+  for (i = 0; i < count; i++) {
+    sum += rr[i];
+  }
+  if (!sum) {
+    return 0;
+  }
+  /* beats per minute is 60 s over the mean interval */
+  return (uint16_t)(((uint32_t)count * 60UL * HR_MEAS_RR_PER_S + sum / 2) / sum);
+}
+
+void hrSynthInit(hrSynth_t *synth, uint16_t bpm, uint8_t variability, uint32_t seed)
+{
+  uint32_t variation;
+
+  if (bpm < 20) {
+    bpm = 20;
+  } else if (bpm > 300) {
+    bpm = 300;
+  }
+
+  synth->rrMean = (uint16_t)((60UL * HR_MEAS_RR_PER_S + bpm / 2) / bpm);
+  variation = (uint32_t)synth->rrMean * variability / 100;
+  /* two thirds of the variation follows the breathing, one third is random */
+  synth->rrSwing = (uint16_t)(variation * 2 / 3);
+  synth->rrJitter = (uint16_t)(variation - synth->rrSwing);
+  synth->lfsr = seed ? seed : 1;
+  synth->breath = 0;
+}
+
+uint16_t hrSynthNext(hrSynth_t *synth)
+{
+  int32_t rr = synth->rrMean;
+
+  /* xorshift32 */
+  synth->lfsr ^= synth->lfsr << 13;
+  synth->lfsr ^= synth->lfsr >> 17;
+  synth->lfsr ^= synth->lfsr << 5;
+
+  rr += (int32_t)synth->rrSwing * hrSynthBreath[synth->breath] / 4;
+  if (synth->rrJitter) {
+    rr += (int32_t)(synth->lfsr % (2U * synth->rrJitter + 1)) - synth->rrJitter;
+  }
+  synth->breath = (uint8_t)((synth->breath + 1) % HR_SYNTH_BREATH_BEATS);
+
+  return (uint16_t)((rr > 1) ? rr : 1);
+}
+
+/** @} (end addtogroup hr_meas) */
+/** @} (end addtogroup Services) */
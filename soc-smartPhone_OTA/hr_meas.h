@@ -0,0 +1,136 @@
+/***************************************************************************//**
+ * @file
+ * @brief Heart Rate Measurement encoder header file
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+#ifndef HR_MEAS_H
+#define HR_MEAS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/***********************************************************************************************//**
+ * \defgroup hr_meas Heart Rate Measurement
+ * \brief Heart Rate Measurement characteristic encoder and synthetic beat source.
+ *
+ * Neither uses the stack, so both also build on a host, see tools/hr_bench.c and
+ * tools/hr_test.c.
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup Services
+ * @{
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ * @addtogroup hr_meas
+ * @{
+ **************************************************************************************************/
+
+/***************************************************************************************************
+ * Public Macros and Definitions
+ **************************************************************************************************/
+
+/** Flags field. */
+#define HR_MEAS_FLAG_VALUE_16BIT        0x01  /**< Heart Rate Value is a uint16. */
+#define HR_MEAS_FLAG_CONTACT_DETECTED   0x02  /**< Sensor contact is detected. */
+#define HR_MEAS_FLAG_CONTACT_SUPPORTED  0x04  /**< Sensor contact is supported. */
+#define HR_MEAS_FLAG_ENERGY_PRESENT     0x08  /**< Energy Expended field is present. */
+#define HR_MEAS_FLAG_RR_PRESENT         0x10  /**< RR-Interval fields are present. */
+
+/** RR-Interval resolution, intervals are in 1/1024 s. */
+#define HR_MEAS_RR_PER_S                1024
+
+/** Largest Energy Expended in kJ, the field stays there until it is reset. */
+#define HR_MEAS_ENERGY_MAX              0xFFFF
+
+/***************************************************************************************************
+ * Data Types
+ **************************************************************************************************/
+
+/** Heart Rate Measurement. */
+typedef struct {
+  uint16_t bpm;             /**< Heart rate in beats per minute. */
+  uint8_t flags;            /**< HR_MEAS_FLAG_CONTACT_x and HR_MEAS_FLAG_VALUE_16BIT, the field
+                                 flags are set by the encoder. */
+  bool energyPresent;       /**< Send the Energy Expended field. */
+  uint16_t energy;          /**< Energy Expended in kJ. */
+  const uint16_t *rr;       /**< RR-Intervals in 1/1024 s, oldest first. */
+  uint8_t rrCount;          /**< Number of RR-Intervals. */
+} hrMeas_t;
+
+/** Synthetic beat source state. */
+typedef struct {
+  uint32_t lfsr;            /**< Jitter generator. */
+  uint16_t rrMean;          /**< Mean RR-Interval in 1/1024 s. */
+  uint16_t rrSwing;         /**< Breathing modulation amplitude in 1/1024 s. */
+  uint16_t rrJitter;        /**< Random jitter amplitude in 1/1024 s. */
+  uint8_t breath;           /**< Beat within the breathing cycle. */
+} hrSynth_t;
+
+/***************************************************************************************************
+ * Function Declarations
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Encode a Heart Rate Measurement with as many RR-Intervals as fit.
+ *  \details  The value is 8 bit unless it exceeds 255 or HR_MEAS_FLAG_VALUE_16BIT is set.
+ *  RR-Intervals that do not fit in maxLen are left for the next measurement, oldest first.
+ *  \param[out]  buf  Characteristic value.
+ *  \param[in]  maxLen  Space in buf, the notification payload of ATT_MTU - 3 bytes.
+ *  \param[in]  meas  Measurement.
+ *  \param[out]  rrUsed  Number of RR-Intervals encoded.
+ *  \return  Length of buf in bytes.
+ **************************************************************************************************/
+uint16_t hrMeasEncode(uint8_t *buf, uint16_t maxLen, const hrMeas_t *meas, uint8_t *rrUsed);
+
+/***********************************************************************************************//**
+ *  \brief  Compute the heart rate from RR-Intervals.
+ *  \param[in]  rr  RR-Intervals in 1/1024 s.
+ *  \param[in]  count  Number of RR-Intervals, not 0.
+ *  \return  Beats per minute, rounded.
+ **************************************************************************************************/
+uint16_t hrMeasBpm(const uint16_t *rr, uint8_t count);
+
+/***********************************************************************************************//**
+ *  \brief  Start a synthetic beat source.
+ *  \details  The RR-Intervals follow a breathing cycle of 4 beats, as sinus arrhythmia does, with
+ *  random jitter on top, so that the packing sees realistic interval variation.
+ *  \param[out]  synth  Source.
+ *  \param[in]  bpm  Mean heart rate, 20 to 300.
+ *  \param[in]  variability  Interval variation in percent of the mean.
+ *  \param[in]  seed  Jitter seed, not 0.
+ **************************************************************************************************/
+void hrSynthInit(hrSynth_t *synth, uint16_t bpm, uint8_t variability, uint32_t seed);
+
+/***********************************************************************************************//**
+ *  \brief  Get the next beat of a synthetic source.
+ *  \param[in,out]  synth  Source.
+ *  \return  RR-Interval in 1/1024 s.
+ **************************************************************************************************/
+uint16_t hrSynthNext(hrSynth_t *synth);
+
+/** @} (end addtogroup hr_meas) */
+/** @} (end addtogroup Services) */
+
+#ifdef __cplusplus
+};
+#endif
+
+#endif /* HR_MEAS_H */
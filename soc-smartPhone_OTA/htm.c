@@ -16,7 +16,7 @@
  ******************************************************************************/
 /* standard library headers */
 #include <stdint.h>
-#include <stdio.h>
+#include <string.h>
 #include <stdbool.h>
 
 /* BG stack headers */
@@ -26,9 +26,15 @@
 #include "infrastructure.h"
 
 /* application specific headers */
+#include "app.h"
 #include "app_hw.h"
 #include "app_ui.h"
 #include "app_timer.h"
+#include "app_work.h"
+#include "app_clock.h"
+#include "app_filter.h"
+#include "app_sensor.h"
+#include "gatt_map.h"
 
 /* Own header*/
 #include "htm.h"
@@ -46,10 +52,6 @@
 /***************************************************************************************************
  * Local Macros and Definitions
  **************************************************************************************************/
-/// The macro returns the first digit behind the decimal point. This is to work around the
-/// GCC+snprintf() floating point display issues
-/// It expects a floating point value and evaluates to unit8_t.
-#define FLOAT_FRACTION_1STDIGIT(VALUE) ((uint8)(((VALUE) -(uint8_t)(VALUE)) * 10.0f) % 10u)
 
 /** Temperature Units Flag.
  *  Temperature Measurement Value in units of Celsius. */
@@ -90,9 +92,11 @@
 #define HTM_TT                              HTM_TT_ARMPIT
 /* Other profile specific macros */
 /* Text definitions*/
-#define HTM_TEMP_VALUE_TEXT                 "\nTemperature:\n%3d.%1d C / %3d.%1d F\n"
-#define HTM_TEMP_VALUE_TEXT_DEFAULT         "\nTemperature:\n---.- C / ---.- F\n"
-#define HTM_TEMP_VALUE_TEXT_SIZE            (sizeof(HTM_TEMP_VALUE_TEXT_DEFAULT))
+#define HTM_TEMP_VALUE_TEXT_HEAD            "\nTemperature:\n"
+#define HTM_TEMP_VALUE_TEXT_C               " C / "
+#define HTM_TEMP_VALUE_TEXT_F               " F\n"
+#define HTM_TEMP_VALUE_TEXT_SIZE            (sizeof(HTM_TEMP_VALUE_TEXT_HEAD) + sizeof(HTM_TEMP_VALUE_TEXT_C) \
+                                             + sizeof(HTM_TEMP_VALUE_TEXT_F) + 2 * APP_SENSOR_FORMAT_MAX)
 /* Temperature Measurement field lengths */
 /** Length of Flags field. */
 #define HTM_FLAGS_LEN                       1
@@ -107,37 +111,41 @@
 #define HTM_FLAG_TEMP_UNIT_MASK             0x01
 /** Default maximum payload length for most PDUs. */
 #define ATT_DEFAULT_PAYLOAD_LEN             20
-/** Temperature measurement period in ms. */
+/** Temperature measurement period in ms until a Measurement Interval is written. */
 #define HTM_TEMP_IND_TIMEOUT                1000
+/** Length of the Measurement Interval characteristic. */
+#define HTM_MEAS_INT_LEN                    2
+/** Intermediate Temperature sample period in ms, the sensor conversion time. */
+#define HTM_STREAM_SAMPLE_MS                (APP_HW_RH_TM_CONV_MS + 2)
+/** Samples per Intermediate Temperature notification, 8 gives 5 notifications per second. */
+#ifndef HTM_STREAM_DECIMATION
+#define HTM_STREAM_DECIMATION               8
+#endif
+/** Number of connections that can request an interval, the stack connection limit. */
+#ifndef HTM_MEAS_INT_CLIENTS
+#define HTM_MEAS_INT_CLIENTS                4
+#endif
 /** Indicates currently there is no active connection using this service. */
 #define HTM_NO_CONNECTION                   0xFF
 /***************************************************************************************************
  * Local Type Definitions
  **************************************************************************************************/
 
-/** The Date Time characteristic is used to represent time.
- *
- * The Date Time characteristic contains fields for year, month, day, hours, minutes and seconds.
- * Calendar days in Date Time are represented using Gregorian calendar. Hours in Date Time are
- * represented in the 24h system. */
-typedef struct {
-  uint16_t tm_year; /**< Year */
-  uint8_t tm_mon;   /**< Month */
-  uint8_t tm_mday;  /**< Day */
-  uint8_t tm_hour;  /**< Hour */
-  uint8_t tm_min;   /**< Minutes */
-  uint8_t tm_sec;   /**< Seconds */
-} htmDateTime_t;
-
 /** Temperature measurement structure. */
 typedef struct {
-  htmDateTime_t timestamp; /**< Date-time */
+  appClockDateTime_t timestamp; /**< Date-time */
   uint32_t temperature;    /**< Temperature */
   uint8_t flags;           /**< Flags */
   uint8_t tempType;        /**< Temperature type */
-  uint16_t period; /**< Measurement timer expiration period in seconds */
+  uint32_t period; /**< Measurement timer expiration period in ms */
 } htmTempMeas_t;
 
+/** Measurement Interval requested by a connection. */
+typedef struct {
+  uint8_t connection; /**< Connection, HTM_NO_CONNECTION if the entry is free */
+  uint16_t interval;  /**< Requested interval in seconds, 0 for no periodic measurements */
+} htmMeasIntRequest_t;
+
 /***************************************************************************************************
  * Local Variables
  **************************************************************************************************/
@@ -147,22 +155,39 @@ static htmTempMeas_t htmTempMeas = {
   .period = HTM_TEMP_IND_TIMEOUT
 };
 
-/* timestamp */
-static htmDateTime_t htmDateTime = { 2000, /*! Year, 0 means not known */
-                                     4,    /*! Month, 0 means not known */
-                                     1,    /*! Day, 0 means not known */
-                                     12,   /*! Hour */
-                                     0,    /*! Minutes */
-                                     0     /*! Seconds */
-};
-
 static uint8_t htmClientConnection = HTM_NO_CONNECTION; /* Current connection or 0xFF if invalid */
 
+static appTimer_t htmTimer; /* Temperature measurement timer */
+static appWork_t htmWork; /* Deferred temperature measurement */
+
+static htmMeasIntRequest_t htmMeasIntRequests[HTM_MEAS_INT_CLIENTS]; /* Intervals per connection */
+static uint16_t htmMeasIntStored = 0; /* Interval in the PS key in seconds */
+static bool htmMeasIntHasStored = false; /* PS key holds an interval */
+static bool htmMeasIntLoaded = false; /* PS key has been read */
+static appWork_t htmMeasIntWork; /* Deferred PS key write */
+
+static uint8_t htmStreamConnection = HTM_NO_CONNECTION; /* Intermediate Temperature subscriber */
+static appTimer_t htmStreamTimer; /* Intermediate Temperature sample timer */
+static appWork_t htmStreamWork; /* Deferred sensor conversion */
+static appFilterCic_t htmStreamFilter; /* Intermediate Temperature decimator */
+static bool htmStreamConverting = false; /* Sensor conversion started */
+static bool htmStreamHasTemp = false; /* htmStreamTemp holds a sample */
+static bool htmStreamFiltered = false; /* htmStreamTemp is filtered */
+static int32_t htmStreamTemp; /* Latest temperature of the stream in milli-degrees Celsius */
+
 /***************************************************************************************************
  * Static Function Declarations
  **************************************************************************************************/
 static uint8_t htmBuildTempMeas(uint8_t *pBuf, htmTempMeas_t *pTempMeas);
 static uint8_t htmProcMsg(uint8_t *buf);
+static void htmTimerCback(void *arg);
+static void htmMeasureWork(void *arg);
+static void htmMeasIntUpdate(void);
+static void htmMeasIntSaveWork(void *arg);
+static void htmStreamStop(void);
+static void htmStreamTimerCback(void *arg);
+static void htmStreamWorkCback(void *arg);
+static uint32_t htmTempToFloat(int32_t tempData);
 
 /***************************************************************************************************
  * Public Function Definitions
@@ -173,8 +198,42 @@ static uint8_t htmProcMsg(uint8_t *buf);
  **************************************************************************************************/
 void htmInit(void)
 {
+  struct gecko_msg_flash_ps_load_rsp_t *rsp;
+  uint8_t i;
+
   htmClientConnection = HTM_NO_CONNECTION; /* Initially no connection is set. */
-  gecko_cmd_hardware_set_soft_timer(TIMER_STOP, TEMP_TIMER, true); /* Initially stop the timer. */
+  appTimerStop(&htmTimer); /* Initially stop the timer. */
+  appWorkCancel(&htmWork);
+
+  /* The interval set before the last reset applies until a client writes a new one */
+  if (!htmMeasIntLoaded) {
+    rsp = gecko_cmd_flash_ps_load(HTM_MEAS_INT_PS_KEY);
+    if ((rsp->result == bg_err_success) && (rsp->value.len == HTM_MEAS_INT_LEN)) {
+      htmMeasIntStored = (uint16_t)(rsp->value.data[0] | (rsp->value.data[1] << 8));
+      htmMeasIntHasStored = true;
+    }
+    for (i = 0; i < HTM_MEAS_INT_CLIENTS; i++) {
+      htmMeasIntRequests[i].connection = HTM_NO_CONNECTION;
+    }
+    htmMeasIntLoaded = true;
+  }
+  htmMeasIntUpdate();
+}
+
+void htmConnectionClosed(uint8_t connection)
+{
+  uint8_t i;
+
+  if (connection == htmStreamConnection) {
+    htmStreamStop();
+  }
+
+  for (i = 0; i < HTM_MEAS_INT_CLIENTS; i++) {
+    if (htmMeasIntRequests[i].connection == connection) {
+      htmMeasIntRequests[i].connection = HTM_NO_CONNECTION;
+    }
+  }
+  htmMeasIntUpdate();
 }
 
 /***********************************************************************************************//**
@@ -187,13 +246,106 @@ void htmTemperatureCharStatusChange(uint8_t connection, uint16_t clientConfig)
   if (clientConfig) {
     htmClientConnection = connection; /* Save connection ID */
     htmTemperatureMeasure(); /* Make an initial measurement */
-    /* Start the repeating timer */
-    gecko_cmd_hardware_set_soft_timer(TIMER_MS_2_TIMERTICK(htmTempMeas.period), TEMP_TIMER, false);
+    /* Start the repeating timer, unless the Measurement Interval is 0 */
+    if (htmTempMeas.period) {
+      appTimerStart(&htmTimer, htmTempMeas.period, 0, true, htmTimerCback, NULL);
+    }
   } else {
-    gecko_cmd_hardware_set_soft_timer(TIMER_STOP, TEMP_TIMER, true);
+    htmClientConnection = HTM_NO_CONNECTION;
+    appTimerStop(&htmTimer);
+    appWorkCancel(&htmWork);
   }
 }
 
+/***********************************************************************************************//**
+ *  \brief Temperature Measurement characteristic status handler, bound in gatt_handlers.txt.
+ **************************************************************************************************/
+void htmTemperatureStatus(const struct gecko_msg_gatt_server_characteristic_status_evt_t *pEvt)
+{
+  /* Only client configuration changes, indication confirmations are ignored */
+  if (pEvt->status_flags == gatt_server_client_config) {
+    htmTemperatureCharStatusChange(pEvt->connection, pEvt->client_config_flags);
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief Intermediate Temperature characteristic status handler, bound in gatt_handlers.txt.
+ *  Enabling notifications starts sampling the sensor continuously.
+ **************************************************************************************************/
+void htmIntermediateStatus(const struct gecko_msg_gatt_server_characteristic_status_evt_t *pEvt)
+{
+  if (pEvt->status_flags != gatt_server_client_config) {
+    return;
+  }
+
+  if (pEvt->client_config_flags) {
+    htmStreamConnection = pEvt->connection;
+    htmStreamConverting = false;
+    htmStreamHasTemp = false;
+    htmStreamFiltered = false;
+    appFilterCicInit(&htmStreamFilter, HTM_STREAM_DECIMATION);
+    appTimerStart(&htmStreamTimer, HTM_STREAM_SAMPLE_MS, 0, true, htmStreamTimerCback, NULL);
+    appWorkPost(&htmStreamWork, APP_WORK_PRIO_LOW, htmStreamWorkCback, NULL);
+  } else if (pEvt->connection == htmStreamConnection) {
+    htmStreamStop();
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief Measurement Interval read handler, bound in gatt_handlers.txt.
+ **************************************************************************************************/
+void htmMeasIntReadRequest(const struct gecko_msg_gatt_server_user_read_request_evt_t *pEvt)
+{
+  uint8_t buf[HTM_MEAS_INT_LEN];
+  uint8_t *p = buf;
+
+  UINT16_TO_BITSTREAM(p, (uint16_t)(htmTempMeas.period / 1000));
+  gecko_cmd_gatt_server_send_user_read_response(pEvt->connection, gattdb_MeasInt, bg_err_success,
+                                                HTM_MEAS_INT_LEN, buf);
+}
+
+/***********************************************************************************************//**
+ *  \brief Measurement Interval write handler, bound in gatt_handlers.txt. The interval is
+ *  remembered for the writing connection and the fastest one requested is used. 0 asks for no
+ *  periodic measurements.
+ **************************************************************************************************/
+void htmMeasIntWriteRequest(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt)
+{
+  htmMeasIntRequest_t *request = NULL;
+  uint16_t interval = 0;
+  uint8_t err = bg_err_success;
+  uint8_t i;
+
+  if (pEvt->value.len != HTM_MEAS_INT_LEN) {
+    err = (uint8_t)bg_err_att_invalid_att_length;
+  } else {
+    /* The Valid Range descriptor in gatt.xml is 1..65535 s, so with 0 every value is accepted */
+    interval = (uint16_t)(pEvt->value.data[0] | (pEvt->value.data[1] << 8));
+  }
+
+  if (err == bg_err_success) {
+    /* the connection's own entry, or a free one */
+    for (i = 0; i < HTM_MEAS_INT_CLIENTS; i++) {
+      if (htmMeasIntRequests[i].connection == pEvt->connection) {
+        request = &htmMeasIntRequests[i];
+        break;
+      }
+      if (!request && (htmMeasIntRequests[i].connection == HTM_NO_CONNECTION)) {
+        request = &htmMeasIntRequests[i];
+      }
+    }
+    if (request) {
+      request->connection = pEvt->connection;
+      request->interval = interval;
+      htmMeasIntUpdate();
+    } else {
+      err = (uint8_t)bg_err_att_insufficient_resources;
+    }
+  }
+
+  gecko_cmd_gatt_server_send_user_write_response(pEvt->connection, gattdb_MeasInt, err);
+}
+
 /***********************************************************************************************//**
  *  \brief Function for taking a single temperature measurement with the WSTK Temperature sensor.
  **************************************************************************************************/
@@ -221,6 +373,179 @@ void htmTemperatureMeasure(void)
  * Static Function Definitions
  **************************************************************************************************/
 
+/***********************************************************************************************//**
+ *  \brief  Temperature measurement timer callback.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void htmTimerCback(void *arg)
+{
+  (void)arg;
+  /* The sensor read blocks on I2C, so it is run from the work queue */
+  appWorkPost(&htmWork, APP_WORK_PRIO_LOW, htmMeasureWork, NULL);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Temperature measurement work item.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void htmMeasureWork(void *arg)
+{
+  (void)arg;
+  htmTemperatureMeasure(); /* Make a temperature measurement */
+}
+
+/***********************************************************************************************//**
+ *  \brief  Apply the fastest Measurement Interval requested by the open connections.
+ *  \details  Without requests the stored interval applies. 0 applies only when every requesting
+ *  connection asked for it, and stops the periodic measurements. The measurement timer of a
+ *  subscribed client is restarted at the new period, the interval in use is stored when it changes.
+ **************************************************************************************************/
+static void htmMeasIntUpdate(void)
+{
+  bool requested = false;
+  uint16_t interval = 0;
+  uint32_t period;
+  uint8_t i;
+
+  for (i = 0; i < HTM_MEAS_INT_CLIENTS; i++) {
+    if (htmMeasIntRequests[i].connection == HTM_NO_CONNECTION) {
+      continue;
+    }
+    if (!requested
+        || (htmMeasIntRequests[i].interval
+            && (!interval || (htmMeasIntRequests[i].interval < interval)))) {
+      interval = htmMeasIntRequests[i].interval;
+    }
+    requested = true;
+  }
+
+  if (requested && (!htmMeasIntHasStored || (interval != htmMeasIntStored))) {
+    htmMeasIntStored = interval;
+    htmMeasIntHasStored = true;
+    appWorkPost(&htmMeasIntWork, APP_WORK_PRIO_LOW, htmMeasIntSaveWork, NULL);
+  }
+
+  period = htmMeasIntHasStored ? (htmMeasIntStored * 1000UL) : HTM_TEMP_IND_TIMEOUT;
+  if (period == htmTempMeas.period) {
+    return;
+  }
+  htmTempMeas.period = period;
+  printLog("measurement interval %lu ms\r\n", (unsigned long)period);
+
+  if (HTM_NO_CONNECTION == htmClientConnection) {
+    return;
+  }
+  if (period) {
+    appTimerStart(&htmTimer, htmTempMeas.period, 0, true, htmTimerCback, NULL);
+  } else {
+    appTimerStop(&htmTimer);
+    appWorkCancel(&htmWork);
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Store the Measurement Interval in its PS key.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void htmMeasIntSaveWork(void *arg)
+{
+  uint8_t buf[HTM_MEAS_INT_LEN];
+  uint8_t *p = buf;
+  uint16_t result;
+
+  (void)arg;
+  UINT16_TO_BITSTREAM(p, htmMeasIntStored);
+  result = gecko_cmd_flash_ps_save(HTM_MEAS_INT_PS_KEY, HTM_MEAS_INT_LEN, buf)->result;
+  if (result != bg_err_success) {
+    printLog("measurement interval not saved, error 0x%4.4x\r\n", result);
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Stop the Intermediate Temperature stream.
+ **************************************************************************************************/
+static void htmStreamStop(void)
+{
+  htmStreamConnection = HTM_NO_CONNECTION;
+  htmStreamHasTemp = false;
+  appTimerStop(&htmStreamTimer);
+  appWorkCancel(&htmStreamWork);
+  if (htmStreamConverting) {
+    htmStreamConverting = false;
+    appHwStopRhTm();
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Intermediate Temperature sample timer callback.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void htmStreamTimerCback(void *arg)
+{
+  (void)arg;
+  appWorkPost(&htmStreamWork, APP_WORK_PRIO_LOW, htmStreamWorkCback, NULL);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Intermediate Temperature sample work item.
+ *  \details  Fetches the conversion started one sample period ago and starts the next one, so the
+ *  sensor converts while the CPU sleeps. Every HTM_STREAM_DECIMATION samples the filtered
+ *  temperature is notified.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void htmStreamWorkCback(void *arg)
+{
+  htmTempMeas_t meas;
+  uint8_t buf[ATT_DEFAULT_PAYLOAD_LEN];
+  uint32_t rhData;
+  int32_t tempData;
+  int32_t filtered;
+  uint8_t len;
+
+  (void)arg;
+  if (HTM_NO_CONNECTION == htmStreamConnection) {
+    return;
+  }
+
+  if (htmStreamConverting && (appHwFetchRhTm(&rhData, &tempData) == 0)) {
+    /* raw samples stand in for the final measurement until the filter has settled */
+    if (!htmStreamFiltered) {
+      htmStreamTemp = tempData;
+      htmStreamHasTemp = true;
+    }
+    if (appFilterCicPut(&htmStreamFilter, tempData, &filtered)) {
+      htmStreamTemp = filtered;
+      htmStreamFiltered = true;
+
+      meas.flags = (htmTempMeas.flags & HTM_FLAG_TEMP_UNIT_MASK) | HTM_FLAG_TEMP_TYPE_FIELD;
+      meas.temperature = htmTempToFloat(filtered);
+      meas.tempType = HTM_TT;
+      if (appClockIsSet()) {
+        appClockToDateTime(appClockGet(NULL), &meas.timestamp);
+        meas.flags |= HTM_FLAG_TIMESTAMP_PRESENT;
+      }
+      len = htmBuildTempMeas(buf, &meas);
+      gecko_cmd_gatt_server_send_characteristic_notification(
+        htmStreamConnection, gattdb_intermediate_temperature, len, buf);
+    }
+  }
+
+  htmStreamConverting = (appHwStartRhTm() == 0);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Encode a temperature in the unit of the measurement flags.
+ *  \param[in]  tempData  Temperature in milli-degrees Celsius.
+ *  \return  Temperature as an IEEE-11073 FLOAT.
+ **************************************************************************************************/
+static uint32_t htmTempToFloat(int32_t tempData)
+{
+  if (HTM_FLAG_TEMP_UNIT_F == (htmTempMeas.flags & HTM_FLAG_TEMP_UNIT_MASK)) {
+    tempData = appSensorCToF(tempData);
+  }
+  return appSensorFloat(tempData, -3);
+}
+
 /***********************************************************************************************//**
  *  \brief  Build a temperature measurement characteristic.
  *  \param[in]  pBuf  Pointer to buffer to hold the built temperature measurement characteristic.
@@ -240,12 +565,12 @@ static uint8_t htmBuildTempMeas(uint8_t *pBuf, htmTempMeas_t *pTempMeas)
 
   /* If time stamp field present in HTM flags, convert timestamp to bitstream. */
   if (flags & HTM_FLAG_TIMESTAMP_PRESENT) {
-    UINT16_TO_BITSTREAM(p, pTempMeas->timestamp.tm_year);
-    UINT8_TO_BITSTREAM(p, pTempMeas->timestamp.tm_mon);
-    UINT8_TO_BITSTREAM(p, pTempMeas->timestamp.tm_mday);
-    UINT8_TO_BITSTREAM(p, pTempMeas->timestamp.tm_hour);
-    UINT8_TO_BITSTREAM(p, pTempMeas->timestamp.tm_min);
-    UINT8_TO_BITSTREAM(p, pTempMeas->timestamp.tm_sec);
+    UINT16_TO_BITSTREAM(p, pTempMeas->timestamp.year);
+    UINT8_TO_BITSTREAM(p, pTempMeas->timestamp.month);
+    UINT8_TO_BITSTREAM(p, pTempMeas->timestamp.day);
+    UINT8_TO_BITSTREAM(p, pTempMeas->timestamp.hours);
+    UINT8_TO_BITSTREAM(p, pTempMeas->timestamp.minutes);
+    UINT8_TO_BITSTREAM(p, pTempMeas->timestamp.seconds);
   }
 
   /* If temperature type field present, convert type to bitstream */
@@ -266,51 +591,48 @@ static uint8_t htmProcMsg(uint8_t *buf)
 {
   uint8_t len; /* Length of the temperature measurement */
   char tempString[HTM_TEMP_VALUE_TEXT_SIZE]; /* Temperature as string for the LCD */
+  char *pText = tempString; /* End of the string */
   int32_t tempData; /* Temperature data from the sensor */
   int32_t tempDataF; /* Temperature in deg F*/
   static int32_t DummyValue = 0; /* Should sawtooth between 0 and 20 */
+  int32_t readStatus; /* Result of the sensor read */
 
-  if (appHwReadTm(&tempData) != 0) {
+  /* While streaming the sensor is busy converting, the stream has its latest temperature */
+  if ((htmStreamConnection != HTM_NO_CONNECTION) && htmStreamHasTemp) {
+    tempData = htmStreamTemp;
+    readStatus = 0;
+  } else {
+    readStatus = appHwReadTm(&tempData);
+  }
+
+  if (readStatus != 0) {
     /* Dummy value sawtooths from 20 degrees */
     tempData = DummyValue + 20000l;
-    /* Fahrenheit value is the same to give integer values */
-    tempDataF = tempData;
     /* ramping up to 40 degrees */
     DummyValue = (DummyValue + 1000l) % 21000l;
-  } else {
-    /* Conversion to Fahrenheit: F = C * 1.8 + 32  The multiplication and offset
-       is 10x value to get around the 1.8x scale, then scaling back  */
-    tempDataF = (tempData * 18 + 320000l) / 10l;
   }
+  tempDataF = appSensorCToF(tempData);
 
-  if (HTM_FLAG_TEMP_UNIT_F == (htmTempMeas.flags & HTM_FLAG_TEMP_UNIT_MASK)) {
-    htmTempMeas.temperature = FLT_TO_UINT32(tempDataF, -3);
-  } else {
-    htmTempMeas.temperature = FLT_TO_UINT32(tempData, -3);
-  }
+  htmTempMeas.temperature = htmTempToFloat(tempData);
 
   /* Temp in C and F should both appear on LCD display */
-  /* +4 is needed to not to see the warning as printf don't know,
-     that we already ensured that higher value than 9 cannot be added */
-  snprintf(tempString,
-           sizeof(HTM_TEMP_VALUE_TEXT_DEFAULT) + 4,
-           HTM_TEMP_VALUE_TEXT,
-           (uint8_t)(tempData / 1000),
-           (uint8_t)((tempData / 100) % 10),
-           (uint8_t)(tempDataF / 1000),
-           (uint8_t)((tempDataF / 100) % 10));
+  memcpy(pText, HTM_TEMP_VALUE_TEXT_HEAD, sizeof(HTM_TEMP_VALUE_TEXT_HEAD) - 1);
+  pText += sizeof(HTM_TEMP_VALUE_TEXT_HEAD) - 1;
+  pText += appSensorFormat(pText, tempData, 3, 1);
+  memcpy(pText, HTM_TEMP_VALUE_TEXT_C, sizeof(HTM_TEMP_VALUE_TEXT_C) - 1);
+  pText += sizeof(HTM_TEMP_VALUE_TEXT_C) - 1;
+  pText += appSensorFormat(pText, tempDataF, 3, 1);
+  memcpy(pText, HTM_TEMP_VALUE_TEXT_F, sizeof(HTM_TEMP_VALUE_TEXT_F));
 
   /* Write the string to LCD */
   appUiWriteString(tempString);
 
-  /* Set the timestamp */
-  htmTempMeas.timestamp = htmDateTime;
-
-  /* Increment Seconds and Minutes fields to simulate time */
-  htmDateTime.tm_sec += htmTempMeas.period / 1000;
-  if (htmDateTime.tm_sec > 59) {
-    htmDateTime.tm_sec = 0;
-    htmDateTime.tm_min = (htmDateTime.tm_min > 59) ? 0 : (htmDateTime.tm_min + 1);
+  /* Time stamp the measurement once the clock shows calendar time */
+  if (appClockIsSet()) {
+    appClockToDateTime(appClockGet(NULL), &htmTempMeas.timestamp);
+    htmTempMeas.flags |= HTM_FLAG_TIMESTAMP_PRESENT;
+  } else {
+    htmTempMeas.flags &= ~HTM_FLAG_TIMESTAMP_PRESENT;
   }
 
   /* Set temperature type */
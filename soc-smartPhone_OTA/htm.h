@@ -41,6 +41,11 @@ extern "C" {
  * Public Macros and Definitions
  **************************************************************************************************/
 
+/** PS key holding the Measurement Interval, next to the slot state in APP_SLOTS_PS_KEY. */
+#ifndef HTM_MEAS_INT_PS_KEY
+#define HTM_MEAS_INT_PS_KEY           0x4001
+#endif
+
 /***************************************************************************************************
  * Function Declarations
  **************************************************************************************************/
@@ -48,10 +53,16 @@ extern "C" {
 /***********************************************************************************************//**
  *  \brief  Initialise Health Thermometer Service.
  *  \details  Initialise the connection ID, the configuration flags of the temperature measurement
- *  and stop temperature measurement timer.
+ *  and stop temperature measurement timer. The first call loads the stored Measurement Interval.
  **************************************************************************************************/
 void htmInit(void);
 
+/***********************************************************************************************//**
+ *  \brief  Drop the Measurement Interval requested by a closed connection.
+ *  \param[in]  connection  Connection ID.
+ **************************************************************************************************/
+void htmConnectionClosed(uint8_t connection);
+
 /***********************************************************************************************//**
  *  \brief  Temperature CCCD has changed event handler function.
  *  \param[in]  connection  Connection ID.
@@ -14,12 +14,31 @@
  * sections of the MSLA applicable to Source Code.
  *
  ******************************************************************************/
+/* Board headers */
+#include "ble-configuration.h"
+#include "board_features.h"
+
 /* BG stack headers */
 #include "bg_types.h"
 #include "native_gecko.h"
+#include "infrastructure.h"
+
+/* em library */
+#include "em_device.h"
+#include "em_bus.h"
+#include "em_cmu.h"
+#include "em_timer.h"
+
+/* emdrv */
+#include "sleep.h"
+
+/* Hardware configuration, LDMA channel allocation */
+#include "hal-config.h"
 
 /* application specific headers */
+#include "app_timer.h"
 #include "app_ui.h"
+#include "gatt_map.h"
 
 /* Own header */
 #include "ia.h"
@@ -41,6 +60,7 @@
 #define IA_HIGH_ALERT_TEXT          "\nAlert level:\n\nHIGH\n"
 #define IA_LOW_ALERT_TEXT           "\nAlert level:\n\nLOW\n"
 #define IA_NO_ALERT_TEXT            "\nAlert level:\n\nNo Alert\n"
+#define IA_LINK_LOSS_TEXT           "\nAlert level:\n\nLINK LOST\n"
 
 /** Immediate Alert Level.
  *  Client sent a No Immediate Alert message. */
@@ -52,40 +72,309 @@
  *  Client sent a High Immediate Alert Level message. */
 #define ALERT_HIGH                  2
 
+#ifdef FEATURE_LED_BUTTON_ON_SAME_PIN
+#error "The alert output needs LED pins that are not shared with the buttons"
+#endif
+
+/** The TIMER0 locations of LED0 (PF4) on CC0 and LED1 (PF5) on CC1. */
+#define IA_PWM_TIMER                TIMER0
+#define IA_PWM_CLOCK                cmuClock_TIMER0
+#define IA_PWM_ROUTELOC             (TIMER_ROUTELOC0_CC0LOC_LOC28 | TIMER_ROUTELOC0_CC1LOC_LOC28)
+#define IA_PWM_REQSEL               (LDMA_CH_REQSEL_SOURCESEL_TIMER0 | LDMA_CH_REQSEL_SIGSEL_TIMER0UFOF)
+/** Divider of timerPrescale1024 as a shift. */
+#define IA_PWM_PRESC_SHIFT          10
+
+/** Number of LEDs the patterns drive, one compare channel each. */
+#define IA_OUTPUTS                  2
+/** Longest pattern in steps. */
+#define IA_PATTERN_MAX              8
+/** Duty of a step in percent that keeps the LED on for the whole step. */
+#define IA_DUTY_ON                  100
+
+#define IA_DMA_MASK                 (1UL << IA_PWM_DMA_CH)
+/** Each step moves the compare values of both channels, CC1 CCVB is 4 words after CC0 CCVB. */
+#define IA_DMA_CTRL                 (LDMA_CH_CTRL_STRUCTTYPE_TRANSFER                          \
+                                     | (((uint32_t)IA_OUTPUTS - 1) << _LDMA_CH_CTRL_XFERCNT_SHIFT) \
+                                     | LDMA_CH_CTRL_BLOCKSIZE_UNIT2                            \
+                                     | LDMA_CH_CTRL_REQMODE_BLOCK                              \
+                                     | LDMA_CH_CTRL_SIZE_WORD                                  \
+                                     | LDMA_CH_CTRL_SRCINC_ONE                                 \
+                                     | LDMA_CH_CTRL_DSTINC_FOUR)
+
 /***************************************************************************************************
  * Type Definitions
  **************************************************************************************************/
 
+/** Output pattern, a sequence of equally long steps. */
+typedef struct {
+  uint16_t stepMs;                      /**< Step length in ms, at most 1700 ms. */
+  uint8_t len;                          /**< Number of steps, at most IA_PATTERN_MAX. */
+  const uint8_t *duty[IA_OUTPUTS];      /**< Part of each step in percent that the LED is on. */
+} iaPattern_t;
+
+/** Alert stages. A stage plays its level for its duration and then moves on to the next one. */
+typedef enum {
+  IA_STAGE_NONE,
+  IA_STAGE_MILD,
+  IA_STAGE_HIGH,
+  IA_STAGE_LINK_LOSS,
+  IA_STAGE_LINK_LOSS_HIGH
+} iaStageId_t;
+
+typedef struct {
+  uint8_t level;                        /**< Alert level, selects the pattern. */
+  uint32_t durationMs;                  /**< Time the stage plays. */
+  iaStageId_t next;                     /**< Stage that follows. */
+  char *text;                           /**< Display text. */
+} iaStage_t;
+
 /***************************************************************************************************
  * Local Variables
  **************************************************************************************************/
 
+/** Mild: two short flashes per second, alternating between the LEDs. */
+static const uint8_t iaMildLed0[] = { 40, 0, 40, 0, 0, 0, 0, 0 };
+static const uint8_t iaMildLed1[] = { 0, 0, 0, 0, 40, 0, 40, 0 };
+/** High: the LEDs take turns at full on, 2.5 times per second. */
+static const uint8_t iaHighLed0[] = { IA_DUTY_ON, IA_DUTY_ON, 0, 0 };
+static const uint8_t iaHighLed1[] = { 0, 0, IA_DUTY_ON, IA_DUTY_ON };
+
+/** Patterns by alert level. */
+static const iaPattern_t iaPatterns[] = {
+  [ALERT_NO] = { 0, 0, { NULL, NULL } },
+  [ALERT_MILD] = { 125, COUNTOF(iaMildLed0), { iaMildLed0, iaMildLed1 } },
+  [ALERT_HIGH] = { 100, COUNTOF(iaHighLed0), { iaHighLed0, iaHighLed1 } },
+};
+
+static const iaStage_t iaStages[] = {
+  [IA_STAGE_NONE] = { ALERT_NO, 0, IA_STAGE_NONE, IA_NO_ALERT_TEXT },
+  [IA_STAGE_MILD] = { ALERT_MILD, IA_MILD_TIMEOUT_MS, IA_STAGE_NONE, IA_LOW_ALERT_TEXT },
+  [IA_STAGE_HIGH] = { ALERT_HIGH, IA_HIGH_TIMEOUT_MS, IA_STAGE_NONE, IA_HIGH_ALERT_TEXT },
+  [IA_STAGE_LINK_LOSS] = { ALERT_MILD, IA_LINK_LOSS_ESCALATE_MS, IA_STAGE_LINK_LOSS_HIGH,
+                           IA_LINK_LOSS_TEXT },
+  [IA_STAGE_LINK_LOSS_HIGH] = { ALERT_HIGH, IA_LINK_LOSS_TIMEOUT_MS, IA_STAGE_NONE,
+                                IA_LINK_LOSS_TEXT },
+};
+
+/** Stage playing and the connection whose write started it, 0xFF for a link loss alert. */
+static iaStageId_t iaStage = IA_STAGE_NONE;
+static uint8_t iaConnection = 0xFF;
+/** Ends the stage playing. */
+static appTimer_t iaStageTimer;
+
+/** Compare values of the pattern steps and one looping descriptor per step. */
+static uint32_t iaPwmCompare[IA_PATTERN_MAX][IA_OUTPUTS];
+static DMA_DESCRIPTOR_TypeDef iaPwmDesc[IA_PATTERN_MAX];
+/** Output is running and holds off EM2. */
+static bool iaPwmRunning = false;
+/** TIMER0 and the LDMA channel have been set up. */
+static bool iaInitialized = false;
+
+/***************************************************************************************************
+ * Static Function Declarations
+ **************************************************************************************************/
+static void iaPlay(iaStageId_t stage, uint8_t connection);
+static void iaStageTimerCback(void *arg);
+static void iaPwmStart(const iaPattern_t *pattern);
+static void iaPwmStop(void);
+
 /***************************************************************************************************
  * Function Definitions
  **************************************************************************************************/
-void iaImmediateAlertWrite(uint8array *writeValue)
+void iaInit(void)
 {
-  switch (writeValue->data[0]) {
+  TIMER_Init_TypeDef init = TIMER_INIT_DEFAULT;
+  TIMER_InitCC_TypeDef initCc = TIMER_INITCC_DEFAULT;
+  uint8_t i;
+
+  /* appInit() runs again on every disconnect, a link loss alert may be playing by then */
+  if (iaInitialized) {
+    return;
+  }
+
+  CMU_ClockEnable(cmuClock_HFPER, true);
+  CMU_ClockEnable(IA_PWM_CLOCK, true);
+  CMU_ClockEnable(cmuClock_LDMA, true);
+
+  /* The DMA request clears once the channel takes it, so each overflow moves one step */
+  init.enable = false;
+  init.prescale = timerPrescale1024;
+  init.dmaClrAct = true;
+  TIMER_Init(IA_PWM_TIMER, &init);
+
+  /* Active on overflow, inactive on compare. The output is inverted where the LEDs are active
+   * low, so the duty is always the on-time. */
+  initCc.mode = timerCCModePWM;
+  initCc.outInvert = appUiLedActiveLow();
+  for (i = 0; i < IA_OUTPUTS; i++) {
+    TIMER_InitCC(IA_PWM_TIMER, i, &initCc);
+  }
+  IA_PWM_TIMER->ROUTELOC0 = IA_PWM_ROUTELOC;
+
+  LDMA->CH[IA_PWM_DMA_CH].REQSEL = IA_PWM_REQSEL;
+  LDMA->CH[IA_PWM_DMA_CH].CFG = 0;
+  LDMA->CH[IA_PWM_DMA_CH].LOOP = 0;
+
+  iaInitialized = true;
+}
+
+void iaAlertLevelValue(const struct gecko_msg_gatt_server_attribute_value_evt_t *pEvt)
+{
+  if (pEvt->value.len < 1) {
+    return;
+  }
+
+  switch (pEvt->value.data[0]) {
     default:
     case ALERT_NO:
-      /* No Alert received */
-      appUiWriteString(IA_NO_ALERT_TEXT);
-      appUiLedOff();
+      iaPlay(IA_STAGE_NONE, pEvt->connection);
       break;
 
     case ALERT_MILD:
-      /* Low Alert received */
-      appUiWriteString(IA_LOW_ALERT_TEXT);
-      appUiLedLowAlert();
+      iaPlay(IA_STAGE_MILD, pEvt->connection);
       break;
 
     case ALERT_HIGH:
-      /* High Alert received */
-      appUiWriteString(IA_HIGH_ALERT_TEXT);
-      appUiLedHighAlert();
+      iaPlay(IA_STAGE_HIGH, pEvt->connection);
       break;
   }
 }
 
+void iaConnectionOpened(uint8_t connection)
+{
+  (void)connection;
+
+  if ((iaStage == IA_STAGE_LINK_LOSS) || (iaStage == IA_STAGE_LINK_LOSS_HIGH)) {
+    iaPlay(IA_STAGE_NONE, 0xFF);
+  }
+}
+
+void iaConnectionClosed(uint8_t connection, uint16_t reason)
+{
+  if (reason == bg_err_bt_connection_timeout) {
+    iaPlay(IA_STAGE_LINK_LOSS, 0xFF);
+  } else if ((iaStage != IA_STAGE_NONE) && (iaConnection == connection)) {
+    /* The alert of a peer lasts until its link is disconnected */
+    iaPlay(IA_STAGE_NONE, 0xFF);
+  }
+}
+
+bool iaAlertSilence(void)
+{
+  if (iaStage == IA_STAGE_NONE) {
+    return false;
+  }
+  iaPlay(IA_STAGE_NONE, 0xFF);
+  return true;
+}
+
+/***************************************************************************************************
+ * Static Function Definitions
+ **************************************************************************************************/
+
+/***********************************************************************************************//**
+ *  \brief  Play an alert stage, replacing the one playing.
+ *  \param[in]  stage  Stage to play.
+ *  \param[in]  connection  Connection that wrote the alert level, 0xFF if none.
+ **************************************************************************************************/
+static void iaPlay(iaStageId_t stage, uint8_t connection)
+{
+  const iaStage_t *s = &iaStages[stage];
+
+  iaPwmStop();
+  appTimerStop(&iaStageTimer);
+
+  iaStage = stage;
+  iaConnection = connection;
+  appUiWriteString(s->text);
+
+  if (s->level != ALERT_NO) {
+    iaPwmStart(&iaPatterns[s->level]);
+    appTimerStart(&iaStageTimer, s->durationMs, 0, false, iaStageTimerCback, NULL);
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Stage timer callback, the stage has played for its duration.
+ *  \param[in]  arg  Unused.
+ **************************************************************************************************/
+static void iaStageTimerCback(void *arg)
+{
+  (void)arg;
+  iaPlay(iaStages[iaStage].next, iaConnection);
+}
+
+/***********************************************************************************************//**
+ *  \brief  Start playing a pattern on the LEDs.
+ *  \details  One PWM period is one step. A compare value written to CCVB takes effect at the
+ *  overflow after the one that triggered the write, so the first two steps are set up directly
+ *  and the descriptors start two steps into the pattern.
+ *  \param[in]  pattern  Pattern to play.
+ **************************************************************************************************/
+static void iaPwmStart(const iaPattern_t *pattern)
+{
+  uint32_t period = ((CMU_ClockFreqGet(IA_PWM_CLOCK) >> IA_PWM_PRESC_SHIFT) * pattern->stepMs) / 1000;
+  uint32_t duty;
+  uint8_t step;
+  uint8_t i;
+
+  /* a compare value of period keeps the output on, it has to fit the 16 bit timer */
+  if (period > _TIMER_TOP_MASK) {
+    period = _TIMER_TOP_MASK;
+  }
+
+  for (step = 0; step < pattern->len; step++) {
+    for (i = 0; i < IA_OUTPUTS; i++) {
+      duty = pattern->duty[i][(step + 2) % pattern->len];
+      iaPwmCompare[step][i] = (duty >= IA_DUTY_ON) ? period : (period * duty) / IA_DUTY_ON;
+    }
+    iaPwmDesc[step].CTRL = IA_DMA_CTRL;
+    iaPwmDesc[step].SRC = iaPwmCompare[step];
+    iaPwmDesc[step].DST = (void *)&IA_PWM_TIMER->CC[0].CCVB;
+    iaPwmDesc[step].LINK = (void *)(((uint32_t)&iaPwmDesc[(step + 1) % pattern->len]
+                                     & _LDMA_CH_LINK_LINKADDR_MASK)
+                                    | LDMA_CH_LINK_LINK);
+  }
+
+  TIMER_TopSet(IA_PWM_TIMER, period - 1);
+  TIMER_CounterSet(IA_PWM_TIMER, 0);
+  for (i = 0; i < IA_OUTPUTS; i++) {
+    duty = pattern->duty[i][0];
+    TIMER_CompareSet(IA_PWM_TIMER, i, (duty >= IA_DUTY_ON) ? period : (period * duty) / IA_DUTY_ON);
+    duty = pattern->duty[i][1 % pattern->len];
+    TIMER_CompareBufSet(IA_PWM_TIMER, i, (duty >= IA_DUTY_ON) ? period : (period * duty) / IA_DUTY_ON);
+  }
+
+  LDMA->CH[IA_PWM_DMA_CH].LINK = (uint32_t)&iaPwmDesc[0] & _LDMA_CH_LINK_LINKADDR_MASK;
+  LDMA->LINKLOAD = IA_DMA_MASK;
+
+  IA_PWM_TIMER->ROUTEPEN = TIMER_ROUTEPEN_CC0PEN | TIMER_ROUTEPEN_CC1PEN;
+  TIMER_Enable(IA_PWM_TIMER, true);
+
+  /* the timer needs the high frequency clock */
+  if (!iaPwmRunning) {
+    SLEEP_SleepBlockBegin(sleepEM2);
+    iaPwmRunning = true;
+  }
+}
+
+/***********************************************************************************************//**
+ *  \brief  Stop the pattern and switch the LEDs off.
+ **************************************************************************************************/
+static void iaPwmStop(void)
+{
+  if (!iaPwmRunning) {
+    return;
+  }
+
+  TIMER_Enable(IA_PWM_TIMER, false);
+  BUS_RegMaskedClear(&LDMA->CHEN, IA_DMA_MASK);
+  IA_PWM_TIMER->ROUTEPEN = 0;
+  appUiLedDark();
+
+  SLEEP_SleepBlockEnd(sleepEM2);
+  iaPwmRunning = false;
+}
+
 /** @} (end addtogroup ia) */
 /** @} (end addtogroup Services) */
@@ -22,9 +22,19 @@
 extern "C" {
 #endif
 
+#include <stdint.h>
+#include <stdbool.h>
+
 /***********************************************************************************************//**
  * \defgroup ia Immediate Alert
  * \brief Immediate Alert Service API
+ *
+ * An alert plays a pattern on the two LEDs. Each pattern step is one period of a TIMER0 PWM
+ * channel per LED, and the LDMA loads the compare value of the next step on every overflow, so
+ * nothing runs on the CPU while a pattern plays. An alert ends after a timeout that depends on
+ * its level, when a new level is written, when the writing peer disconnects or when the user
+ * presses a button. A link lost to a supervision timeout starts a mild alert that escalates to a
+ * high one.
  **************************************************************************************************/
 
 /***********************************************************************************************//**
@@ -38,18 +48,60 @@ extern "C" {
  **************************************************************************************************/
 
 /***************************************************************************************************
- * Type Definitions
+ * Public Macros and Definitions
  **************************************************************************************************/
 
+/** Time in ms a Mild Alert plays before it stops. */
+#ifndef IA_MILD_TIMEOUT_MS
+#define IA_MILD_TIMEOUT_MS            30000
+#endif
+
+/** Time in ms a High Alert plays before it stops. */
+#ifndef IA_HIGH_TIMEOUT_MS
+#define IA_HIGH_TIMEOUT_MS            60000
+#endif
+
+/** Time in ms a link loss alert plays at the mild level before it escalates. */
+#ifndef IA_LINK_LOSS_ESCALATE_MS
+#define IA_LINK_LOSS_ESCALATE_MS      10000
+#endif
+
+/** Time in ms a link loss alert plays at the high level before it stops. */
+#ifndef IA_LINK_LOSS_TIMEOUT_MS
+#define IA_LINK_LOSS_TIMEOUT_MS       50000
+#endif
+
+/* The LDMA channel IA_PWM_DMA_CH is allocated with all other channels in
+ * hal-config-app-common.h. */
+
 /***************************************************************************************************
  * Function Declarations
  **************************************************************************************************/
 
 /***********************************************************************************************//**
- *  \brief  Immediate Alert Write request with new Alert Level data.
- *  \param[in]  writeValue  Pointer to generic array holding written value.
+ *  \brief  Set up TIMER0 and the LDMA channels of the alert output.
+ **************************************************************************************************/
+void iaInit(void);
+
+/***********************************************************************************************//**
+ *  \brief  Stop a link loss alert once a peer has connected again.
+ *  \param[in]  connection  Connection handle.
+ **************************************************************************************************/
+void iaConnectionOpened(uint8_t connection);
+
+/***********************************************************************************************//**
+ *  \brief  Stop the alert written by a peer that disconnected, or start the link loss alert if
+ *  the link was lost.
+ *  \param[in]  connection  Connection handle.
+ *  \param[in]  reason  Reason from the connection closed event.
+ **************************************************************************************************/
+void iaConnectionClosed(uint8_t connection, uint16_t reason);
+
+/***********************************************************************************************//**
+ *  \brief  Stop the alert on user interaction.
+ *  \return  true if an alert was playing
  **************************************************************************************************/
-void iaImmediateAlertWrite(uint8array *writeValue);
+bool iaAlertSilence(void);
 
 /** @} (end addtogroup ia) */
 /** @} (end addtogroup Services) */
@@ -50,6 +50,10 @@ extern "C" {
 
 void initMcu(void);
 
+// Wait for the oscillators started by initMcu() and switch to them. Only
+// has an effect with APP_BOOT_FAST_START, else initMcu() has done it.
+void initMcuWaitClocks(void);
+
 #ifdef __cplusplus
 }
 #endif
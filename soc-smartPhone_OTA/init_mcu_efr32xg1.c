@@ -32,6 +32,8 @@
 #include "bsp.h"
 
 #include "init_mcu.h"
+#include "app_boot.h"
+#include "app_clock.h"
 
 
 // Bit [19] in MODULEINFO is the HFXOCALVAL:
@@ -45,6 +47,8 @@
 #define DEVINFO_HFXOCTUNE_MASK  0x01FFUL
 
 static void initMcu_clocks(void);
+static void initMcu_clocksReady(void);
+static void initMcu_rtcc(void);
 
 void initMcu(void)
 {
@@ -58,19 +62,12 @@ void initMcu(void)
   #endif
   EMU_DCDCInit(&dcdcInit);
 
-  // Set up clocks
+  // Set up clocks. With fast start the oscillators are only started here and
+  // initMcuWaitClocks() selects them once the board has been initialized.
   initMcu_clocks();
-
-  RTCC_Init_TypeDef rtccInit = RTCC_INIT_DEFAULT;
-  rtccInit.enable                = true;
-  rtccInit.debugRun              = false;
-  rtccInit.precntWrapOnCCV0      = false;
-  rtccInit.cntWrapOnCCV1         = false;
-  rtccInit.prescMode             = rtccCntTickPresc;
-  rtccInit.presc                 = rtccCntPresc_1;
-  rtccInit.enaOSCFailDetect      = false;
-  rtccInit.cntMode               = rtccCntModeNormal;
-  RTCC_Init(&rtccInit);
+#if !APP_BOOT_FAST_START
+  initMcu_clocksReady();
+#endif
 
 #if defined(_EMU_CMD_EM01VSCALE0_MASK)
   // Set up EM0, EM1 energy mode configuration
@@ -120,7 +117,31 @@ static void initMcu_clocks(void)
   // Set system HFXO frequency
   SystemHFXOClockSet(BSP_CLK_HFXO_FREQ);
 
-  // Enable HFXO oscillator, and wait for it to be stable
+  // Start the HFXO oscillator, initMcu_clocksReady() waits for it to be stable
+  CMU_OscillatorEnable(cmuOsc_HFXO, true, false);
+
+  // Initialize LFXO
+  CMU_LFXOInit_TypeDef lfxoInit = BSP_CLK_LFXO_INIT;
+  lfxoInit.ctune = BSP_CLK_LFXO_CTUNE;
+  CMU_LFXOInit(&lfxoInit);
+
+  // Set system LFXO frequency
+  SystemLFXOClockSet(BSP_CLK_LFXO_FREQ);
+
+  // Start the LFXO oscillator, it is waited for when it is selected
+  CMU_OscillatorEnable(cmuOsc_LFXO, true, false);
+}
+
+void initMcuWaitClocks(void)
+{
+#if APP_BOOT_FAST_START
+  initMcu_clocksReady();
+#endif
+}
+
+static void initMcu_clocksReady(void)
+{
+  // Wait for the HFXO oscillator to be stable
   CMU_OscillatorEnable(cmuOsc_HFXO, true, true);
 
   // Enable HFXO Autostart only if EM2 voltage scaling is disabled.
@@ -139,16 +160,30 @@ static void initMcu_clocks(void)
   // Enabling HFBUSCLKLE clock for LE peripherals
   CMU_ClockEnable(cmuClock_HFLE, true);
 
-  // Initialize LFXO
-  CMU_LFXOInit_TypeDef lfxoInit = BSP_CLK_LFXO_INIT;
-  lfxoInit.ctune = BSP_CLK_LFXO_CTUNE;
-  CMU_LFXOInit(&lfxoInit);
-
-  // Set system LFXO frequency
-  SystemLFXOClockSet(BSP_CLK_LFXO_FREQ);
-
   // Set LFXO if selected as LFCLK
   CMU_ClockSelectSet(cmuClock_LFA, cmuSelect_LFXO);
   CMU_ClockSelectSet(cmuClock_LFB, cmuSelect_LFXO);
   CMU_ClockSelectSet(cmuClock_LFE, cmuSelect_LFXO);
+
+  initMcu_rtcc();
+}
+
+static void initMcu_rtcc(void)
+{
+  RTCC_Init_TypeDef rtccInit = RTCC_INIT_DEFAULT;
+  rtccInit.enable                = true;
+  rtccInit.debugRun              = false;
+  rtccInit.precntWrapOnCCV0      = false;
+  rtccInit.cntWrapOnCCV1         = false;
+  rtccInit.prescMode             = rtccCntTickPresc;
+  rtccInit.presc                 = rtccCntPresc_1;
+  rtccInit.enaOSCFailDetect      = false;
+  rtccInit.cntMode               = rtccCntModeNormal;
+  RTCC_Init(&rtccInit);
+
+  // Boot phases are timed by the RTCC from here on
+  appBootClockStarted();
+
+  // The calendar clock counts from here until a peer sets it
+  appClockInit();
 }
\ No newline at end of file
@@ -30,6 +30,12 @@
 
 /* application specific files */
 #include "app.h"
+#include "app_timer.h"
+#include "app_work.h"
+#include "app_idle.h"
+#include "app_boot.h"
+#include "app_clock.h"
+#include "advertisement.h"
 
 /* libraries containing default gecko configuration values */
 #include "em_emu.h"
@@ -70,6 +76,7 @@ static const gecko_configuration_t config = {
   .sleep.flags = 0,
 #endif // LFXO
   .bluetooth.max_connections = MAX_CONNECTIONS,
+  .bluetooth.max_advertisers = ADV_SET_COUNT, // HTM, Beacon and sensor sets
   .bluetooth.heap = bluetooth_stack_heap,
   .bluetooth.heap_size = sizeof(bluetooth_stack_heap),
   .bluetooth.sleep_clock_accuracy = 100, // ppm
@@ -89,12 +96,14 @@ static const gecko_configuration_t config = {
 
 int main(void)
 {
+  // Start timing the boot phases
+  appBootStart();
   // Initialize device
   initMcu();
+  appBootMark(APP_BOOT_MCU);
   // Initialize board
   initBoard();
-  // Initialize application
-  initApp();
+  appBootMark(APP_BOOT_BOARD);
 
   // Initialize LEDs
   BSP_LedsInit();
@@ -106,18 +115,42 @@ int main(void)
   GPIO_PinModeSet(BSP_BUTTON1_PORT, BSP_BUTTON1_PIN, gpioModeInput, 1);
 #endif
 
+  // Wait for the HFXO and LFXO if they were still starting. Everything after
+  // this point sets up baud rates from the final clocks.
+  initMcuWaitClocks();
+
+  // Initialize application
+  initApp();
+  appBootMark(APP_BOOT_APP);
+
   /* Initialize debug prints. Note: debug prints are off by default. See DEBUG_LEVEL in app.h */
      initLog(); // GN: added debug prints to soc_smartphone
+  appBootMark(APP_BOOT_LOG);
 
   // Initialize stack
   gecko_init(&config);
+  appBootMark(APP_BOOT_STACK);
+
+  // Initialize application timers, they run on one stack soft timer
+  appTimerInit();
+
+  // Keep the calendar clock across RTCC wraps
+  appClockStart();
+
+  // Initialize deferred work queue, it is run on the external signal event
+  appWorkInit();
 
   while (1) {
     struct gecko_cmd_packet* evt;
-    // Check for stack event.
-    evt = gecko_wait_event();
-    // Run application and event handler.
-    appHandleEvents(evt);
+    // Check for stack event, without blocking.
+    evt = gecko_peek_event();
+    if (evt) {
+      // Run application and event handler.
+      appHandleEvents(evt);
+    } else {
+      // No event pending, run background work and sleep until the stack needs to run again.
+      appIdleRun();
+    }
   }
 }
 
@@ -30,6 +30,9 @@
 #include "btl_interface_storage.h"
 
 #include "app.h"
+#include "app_flash.h"
+#include "app_storage.h"
+#include "app_slots.h"
 
 /* Print boot message */
 //static
@@ -41,6 +44,10 @@ static uint8_t boot_to_dfu = 0;
 #if 1 // GN:
 static BootloaderInformation_t bldInfo;
 static BootloaderStorageSlot_t slotInfo;
+static BootloaderStorageInformation_t storageInfo;
+
+/* Slot receiving the next download, APP_SLOTS_NONE while the running image is on trial */
+int32_t ota_slot = 0;
 
 /* OTA variables */
 #if 0
@@ -69,18 +76,38 @@ void ota_update_ota_control(void){}
 void ota_update_ota_data(void){}
 #endif
 
+int32_t get_download_slot_info();
+
 int32_t get_slot_info()
 {
-	int32_t err;
-
 	bootloader_getInfo(&bldInfo);
 	printf("Gecko bootloader version: %u.%u\r\n", (bldInfo.version & 0xFF000000) >> 24, (bldInfo.version & 0x00FF0000) >> 16);
 
-	err = bootloader_getStorageSlotInfo(0, &slotInfo);
+	bootloader_getStorageInfo(&storageInfo);
+
+	/* confirms or rolls back an installed image, which decides the download slot */
+	appSlotsInit(storageInfo.numStorageSlots);
+
+	return get_download_slot_info();
+}
+
+/* Read the information of the slot for the next download */
+int32_t get_download_slot_info()
+{
+	int32_t err;
+
+	ota_slot = appSlotsDownloadSlot();
+	if(ota_slot == APP_SLOTS_NONE)
+	{
+		printf("image on trial, download slots locked\r\n");
+		return BOOTLOADER_OK;
+	}
+
+	err = bootloader_getStorageSlotInfo(ota_slot, &slotInfo);
 
 	if(err == BOOTLOADER_OK)
 	{
-		printf("Slot 0 starts @ 0x%8.8x, size %u bytes\r\n", slotInfo.address, slotInfo.length);
+		printf("Slot %ld starts @ 0x%8.8x, size %u bytes\r\n", (long)ota_slot, slotInfo.address, slotInfo.length);
 	}
 	else
 	{
@@ -90,8 +117,53 @@ int32_t get_slot_info()
 	return(err);
 }
 
+/* Open the download slot for direct burst programming. Only possible when the slot is in internal
+ * flash, returns false otherwise and the image must go through bootloader_writeStorage() */
+bool ota_flash_begin(void)
+{
+	if((ota_slot == APP_SLOTS_NONE) || (storageInfo.storageType != INTERNAL_FLASH))
+	{
+		return false;
+	}
+	return appFlashBegin(slotInfo.address, slotInfo.length);
+}
+
+/* Check whether the download slot is on the MX25 and clear of the measurement log. The image is
+ * then programmed through app_storage.c, returns false otherwise */
+bool ota_storage_begin(uint32_t *address)
+{
+	if((ota_slot == APP_SLOTS_NONE) || (storageInfo.storageType != SPIFLASH)
+	   || !appStorageInSlots(slotInfo.address, slotInfo.length))
+	{
+		return false;
+	}
+	*address = slotInfo.address;
+	return true;
+}
+
+/* Check whether the bootloader keeps its slots on the MX25 */
+bool ota_slots_external(void)
+{
+	return (storageInfo.storageType == SPIFLASH);
+}
+
+/* Background erase of an MX25 slot has completed */
+static void ota_erase_done(int32_t err)
+{
+	if(err)
+	{
+		printf("error erasing flash! %lx\r\n", (unsigned long)err);
+	}
+	else
+	{
+		printf("download area erased\r\n");
+	}
+}
+
 void erase_slot_if_needed()
 {
+	uint32_t slot_address = 0;
+	bool external = ota_storage_begin(&slot_address);
 	uint32_t offset = 0;
 	uint8_t buffer[256];
 	int i;
@@ -99,13 +171,26 @@ void erase_slot_if_needed()
 	int32_t err = BOOTLOADER_OK;
 	int num_blocks = 0;
 
+	/* the slots hold the image on trial and the fallback until it is confirmed */
+	if(ota_slot == APP_SLOTS_NONE)
+	{
+		return;
+	}
+
 	/* check the download area content by reading it in 256-byte blocks */
 
 	num_blocks = slotInfo.length / 256;
 
 	while((dirty == 0) && (offset < 256*num_blocks) && (err == BOOTLOADER_OK))
 	{
-		err = bootloader_readStorage(0, offset, buffer, 256);
+		if(external)
+		{
+			err = appStorageRead(slot_address + offset, buffer, 256);
+		}
+		else
+		{
+			err = bootloader_readStorage(ota_slot, offset, buffer, 256);
+		}
 		if(err == BOOTLOADER_OK)
 		{
 			i=0;
@@ -129,8 +214,16 @@ void erase_slot_if_needed()
 	else if(dirty)
 	{
 		printf("download area is not empty, erasing...\r\n");
-		bootloader_eraseStorageSlot(0);
-		printf("done\r\n");
+		if(external)
+		{
+			/* the MX25 is erased block by block while the stack runs */
+			appStorageEraseStart(slot_address, slotInfo.length, ota_erase_done);
+		}
+		else
+		{
+			bootloader_eraseStorageSlot(ota_slot);
+			printf("done\r\n");
+		}
 	}
 	else
 	{
@@ -32,6 +32,13 @@
 #define DIRTY_WORD_BITS_LOG2       (5)
 #define DIRTY_WORD_BITS_LOG2_MASK  ((1 << DIRTY_WORD_BITS_LOG2) - 1)
 
+#if defined(DMD_RASTER_1BPP)
+/* Whole rows are filled this many at a time, with at most this many control
+   bytes per row saved and put back. */
+#define FILL_ROWS_CHUNK    (16)
+#define FILL_GAP_MAX       (4)
+#endif
+
 /* Definitions for RGB_3BIT mode */
 #define RGB_3BIT_BITS_PER_PIXEL  3
 
@@ -45,6 +52,11 @@ static DISPLAY_PixelMatrix_t pixelMatrixBuffer = NULL;
 /* Dimensions of the display */
 static DMD_DisplayGeometry dimensions;
 
+#if defined(DMD_RASTER_1BPP)
+/* 1bpp raster view of the active framebuffer. */
+static DMD_Raster1bpp raster1bpp;
+#endif
+
 /* Dirty rows flags.
    The dirty table contains one bit per row/line on the display which
    indicates whether the corresponding row/line is dirty (written to without
@@ -56,6 +68,11 @@ EMSTATUS DMD_allocateFramebuffer(void **framebuffer);
 EMSTATUS DMD_freeFramebuffer(void *framebuffer);
 EMSTATUS DMD_copyFramebuffer (void *dst, void *src);
 
+#if defined(DMD_RASTER_1BPP)
+static void fillRow1bpp(uint8_t *pRow, unsigned int xStart, unsigned int xEnd,
+                        uint8_t fill);
+#endif
+
 /**************************************************************************//**
 *  @brief
 *  Initializes the DIDPLAY driver module
@@ -896,4 +913,232 @@ EMSTATUS DMD_getFrameBuffer(void **framebuffer)
   return DMD_OK;
 }
 
+#if defined(DMD_RASTER_1BPP)
+/**************************************************************************//**
+*  @brief
+*  Get the 1bpp raster view of the active framebuffer. The raster uses
+*  absolute display coordinates, the clipping area does not apply.
+*
+*  @param raster
+*  Gets set to the raster of the active framebuffer
+*
+*  @return
+*  DMD_OK on success, otherwise error code
+******************************************************************************/
+EMSTATUS DMD_getRaster1bpp(const DMD_Raster1bpp **raster)
+{
+  if (!moduleInitialized || (NULL == pixelMatrixBuffer)) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  /* The framebuffer can be swapped with DMD_selectFramebuffer(), so the view
+     is refreshed on every call. */
+  raster1bpp.pBits       = (uint8_t *) pixelMatrixBuffer;
+  raster1bpp.bytesPerRow = displayDevice.geometry.stride >> 3;
+  raster1bpp.invert      =
+    (displayDevice.colourMode == DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE)
+    ? 0xff : 0x00;
+  *raster = &raster1bpp;
+
+  return DMD_OK;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Fills a rectangle of the 1bpp raster and marks its rows as dirty.
+*
+*  @param x
+*  X coordinate of the top left corner, in absolute display coordinates
+*  @param y
+*  Y coordinate of the top left corner, in absolute display coordinates
+*  @param width
+*  Width of the rectangle
+*  @param height
+*  Height of the rectangle
+*  @param fill
+*  Fill byte returned by DMD_raster1bppFill()
+*
+*  @return
+*  DMD_OK on success, otherwise error code
+******************************************************************************/
+EMSTATUS DMD_raster1bppFillRect(uint16_t x, uint16_t y, uint16_t width,
+                                uint16_t height, uint8_t fill)
+{
+  uint8_t      *pRow;
+  unsigned int  bytesPerRow = displayDevice.geometry.stride >> 3;
+  unsigned int  rows;
+
+  if (!moduleInitialized || (NULL == pixelMatrixBuffer)) {
+    return DMD_ERROR_DRIVER_NOT_INITIALIZED;
+  }
+
+  if (width == 0 || height == 0) {
+    return DMD_ERROR_EMPTY_CLIPPING_AREA;
+  }
+
+  if (x + width > dimensions.xSize || y + height > dimensions.ySize) {
+    return DMD_ERROR_PIXEL_OUT_OF_BOUNDS;
+  }
+
+  pRow = (uint8_t *) pixelMatrixBuffer + y * bytesPerRow;
+
+  /* Whole rows are one run of bytes but for the control bytes after each
+     row. A chunk of rows is filled with one memset(), then the control bytes
+     it overwrote are put back. */
+  if ((height > 1) && (x == 0) && (width == displayDevice.geometry.width)
+      && !(width & 0x7) && ((bytesPerRow - (width >> 3)) <= FILL_GAP_MAX)) {
+    unsigned int rowBytes = width >> 3;
+    unsigned int gap      = bytesPerRow - rowBytes;
+    uint8_t      saved[FILL_ROWS_CHUNK * FILL_GAP_MAX];
+    unsigned int chunk;
+    unsigned int i;
+    unsigned int j;
+
+    for (rows = height; rows; rows -= chunk) {
+      chunk = (rows < FILL_ROWS_CHUNK) ? rows : FILL_ROWS_CHUNK;
+      for (i = 0; i < chunk - 1; i++) {
+        for (j = 0; j < gap; j++) {
+          saved[i * gap + j] = pRow[i * bytesPerRow + rowBytes + j];
+        }
+      }
+      memset(pRow, fill, chunk * bytesPerRow - gap);
+      for (i = 0; i < chunk - 1; i++) {
+        for (j = 0; j < gap; j++) {
+          pRow[i * bytesPerRow + rowBytes + j] = saved[i * gap + j];
+        }
+      }
+      pRow += chunk * bytesPerRow;
+    }
+  } else {
+    for (rows = height; rows; rows--) {
+      fillRow1bpp(pRow, x, x + width, fill);
+      pRow += bytesPerRow;
+    }
+  }
+
+  return DMD_raster1bppMarkDirty(y, y + height - 1);
+}
+
+/**************************************************************************//**
+*  @brief
+*  Fills a horizontal span of the 1bpp raster. The coordinates are absolute
+*  display coordinates and are not checked, and the row is not marked as
+*  dirty. Used by GLIB to emit the spans of filled shapes.
+*
+*  @param raster
+*  1bpp raster returned by DMD_getRaster1bpp()
+*  @param x
+*  X coordinate of the first pixel of the span
+*  @param y
+*  Y coordinate of the span
+*  @param width
+*  Number of pixels in the span, at least one
+*  @param fill
+*  Fill byte returned by DMD_raster1bppFill()
+******************************************************************************/
+void DMD_raster1bppFillSpan(const DMD_Raster1bpp *raster, uint16_t x,
+                            uint16_t y, uint16_t width, uint8_t fill)
+{
+  fillRow1bpp(raster->pBits + y * raster->bytesPerRow, x, x + width, fill);
+}
+
+/**************************************************************************//**
+*  @brief
+*  Marks a range of rows as dirty after drawing into the 1bpp raster.
+*
+*  @param yStart
+*  First row of the range
+*  @param yEnd
+*  Last row of the range, inclusive
+*
+*  @return
+*  DMD_OK on success, otherwise error code
+******************************************************************************/
+EMSTATUS DMD_raster1bppMarkDirty(uint16_t yStart, uint16_t yEnd)
+{
+  unsigned int word    = yStart >> DIRTY_WORD_BITS_LOG2;
+  unsigned int endWord = yEnd >> DIRTY_WORD_BITS_LOG2;
+  uint32_t     first   = 0xffffffffUL << (yStart & DIRTY_WORD_BITS_LOG2_MASK);
+  uint32_t     last    =
+    0xffffffffUL >> (DIRTY_WORD_BITS_LOG2_MASK - (yEnd & DIRTY_WORD_BITS_LOG2_MASK));
+
+  if (yStart > yEnd || yEnd >= dimensions.ySize) {
+    return DMD_ERROR_PIXEL_OUT_OF_BOUNDS;
+  }
+
+  /* Set the flags a word at a time rather than row by row. */
+  if (word == endWord) {
+    dirtyRows[word] |= first & last;
+  } else {
+    dirtyRows[word++] |= first;
+    while (word < endWord) {
+      dirtyRows[word++] = 0xffffffffUL;
+    }
+    dirtyRows[word] |= last;
+  }
+
+#ifdef UPDATE_PER_WRITE_CALL
+  /* Update the display device now. */
+  displayDevice.pPixelMatrixDraw(&displayDevice,
+                                 (uint8_t *) pixelMatrixBuffer
+                                 + yStart * (displayDevice.geometry.stride >> 3),
+                                 0,
+                                 displayDevice.geometry.width,
+                                 yStart,
+                                 yEnd - yStart + 1);
+#endif
+
+  return DMD_OK;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Fills the pixels xStart to xEnd - 1 of a framebuffer row. The partial bytes
+*  at the ends are masked, the inner bytes are stored whole.
+*
+*  @param pRow
+*  First byte of the row
+*  @param xStart
+*  First pixel to fill
+*  @param xEnd
+*  Pixel after the last one to fill
+*  @param fill
+*  Fill byte, 0x00 or 0xff
+******************************************************************************/
+static void fillRow1bpp(uint8_t *pRow, unsigned int xStart, unsigned int xEnd,
+                        uint8_t fill)
+{
+  uint8_t  *pDst     = pRow + (xStart >> 3);
+  uint8_t  *pLast    = pRow + (xEnd >> 3);
+  uint8_t   headMask = 0xff << (xStart & 0x7);
+  uint8_t   tailMask = (1 << (xEnd & 0x7)) - 1;
+
+  /* Span within a single byte */
+  if (pDst == pLast) {
+    headMask &= tailMask;
+    *pDst = (*pDst & ~headMask) | (fill & headMask);
+    return;
+  }
+
+  if (headMask != 0xff) {
+    *pDst = (*pDst & ~headMask) | (fill & headMask);
+    pDst++;
+  }
+
+  /* Short runs are stored bytewise. Longer runs go to memset(), which
+     aligns and stores words, as DMD_writeColor() does for whole rows. */
+  if (pLast - pDst >= 4) {
+    memset(pDst, fill, pLast - pDst);
+  } else {
+    while (pDst < pLast) {
+      *pDst++ = fill;
+    }
+  }
+
+  if (tailMask) {
+    *pLast = (*pLast & ~tailMask) | (fill & tailMask);
+  }
+}
+#endif
+
 /** @endcond */
@@ -46,6 +46,7 @@
 
 #include <stdint.h>
 #include "em_types.h"
+#include "displayconfigall.h"
 /* TODO: remove this and replace with include types and ecodes */
 #define ECODE_DMD_BASE    0x00000000
 
@@ -90,6 +91,14 @@
 #define DMD_MEMORY_TEST_WIDTH        4
 #define DMD_MEMORY_TEST_HEIGHT       3
 
+/** The display colour mode is selected at compile time. For monochrome
+    displays the active framebuffer is exposed as a 1 bit per pixel raster,
+    which GLIB draws into directly instead of going through DMD_writeColor().
+    Define DMD_NO_RASTER_1BPP to keep the DMD_writeColor() path. */
+#if !defined(DISPLAY_COLOUR_MODE_IS_RGB_3BIT) && !defined(DMD_NO_RASTER_1BPP)
+#define DMD_RASTER_1BPP
+#endif
+
 /** Configuration parameter for DMD_init. This typedef is defined 'void' and
     may be defined differently in the future. */
 typedef void DMD_InitConfig;
@@ -126,6 +135,20 @@ typedef struct __DMD_MemoryError{
   uint8_t  readColor[3];
 } DMD_MemoryError; /**< Typedef for memory error information */
 
+#if defined(DMD_RASTER_1BPP)
+/** @struct __DMD_Raster1bpp
+ *  @brief 1 bit per pixel view of the active framebuffer
+ */
+typedef struct __DMD_Raster1bpp{
+  /** First byte of the top row. Pixel x of a row is bit (x & 7) of byte (x >> 3) */
+  uint8_t  *pBits;
+  /** Distance between two rows in bytes, including the display control bytes */
+  uint16_t bytesPerRow;
+  /** 0xff if a set bit turns the pixel off (inverse colour mode), else 0x00 */
+  uint8_t  invert;
+} DMD_Raster1bpp; /**< Typedef for the 1bpp raster */
+#endif
+
 /* Module prototypes */
 EMSTATUS DMD_init(DMD_InitConfig *initConfig);
 EMSTATUS DMD_getDisplayGeometry(DMD_DisplayGeometry **geometry);
@@ -150,6 +173,57 @@ EMSTATUS DMD_selectFramebuffer (void *framebuffer);
 EMSTATUS DMD_getFrameBuffer (void **framebuffer);
 EMSTATUS DMD_updateDisplay (void);
 
+#if defined(DMD_RASTER_1BPP)
+EMSTATUS DMD_getRaster1bpp(const DMD_Raster1bpp **raster);
+EMSTATUS DMD_raster1bppFillRect(uint16_t x, uint16_t y, uint16_t width,
+                                uint16_t height, uint8_t fill);
+EMSTATUS DMD_raster1bppMarkDirty(uint16_t yStart, uint16_t yEnd);
+void DMD_raster1bppFillSpan(const DMD_Raster1bpp *raster, uint16_t x,
+                            uint16_t y, uint16_t width, uint8_t fill);
+
+/**************************************************************************//**
+*  @brief
+*  Returns the raster fill byte for a colour, in the same way DMD_writeColor()
+*  maps a colour to a monochrome pixel.
+*
+*  @param raster
+*  1bpp raster returned by DMD_getRaster1bpp()
+*  @param green
+*  Green component of the colour
+*
+*  @return
+*  0xff to set the pixels, 0x00 to clear them
+******************************************************************************/
+static inline uint8_t DMD_raster1bppFill(const DMD_Raster1bpp *raster,
+                                         uint8_t green)
+{
+  return (green ? 0x00 : 0xff) ^ raster->invert;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Writes one pixel of the raster. The coordinates are absolute display
+*  coordinates and are not checked, and the row is not marked as dirty.
+*
+*  @param raster
+*  1bpp raster returned by DMD_getRaster1bpp()
+*  @param x
+*  X coordinate of the pixel
+*  @param y
+*  Y coordinate of the pixel
+*  @param fill
+*  Fill byte returned by DMD_raster1bppFill()
+******************************************************************************/
+static inline void DMD_raster1bppPlot(const DMD_Raster1bpp *raster,
+                                      uint16_t x, uint16_t y, uint8_t fill)
+{
+  uint8_t *pByte = raster->pBits + y * raster->bytesPerRow + (x >> 3);
+  uint8_t  mask  = 1 << (x & 0x7);
+
+  *pByte = (*pByte & ~mask) | (fill & mask);
+}
+#endif
+
 /** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
 /* Test functions */
 EMSTATUS DMD_testParameterChecks(void);
@@ -67,6 +67,8 @@ static EMSTATUS BMP_readRawDataRLE8(BMP_DataType *dataType, uint8_t buffer[], ui
 static EMSTATUS BMP_readPaddingBytes(uint8_t paddingBytes);
 static EMSTATUS BMP_readRleData(BMP_DataType *dataType, uint8_t buffer[], uint32_t bufLength);
 static EMSTATUS BMP_readRgbDataRLE8(uint8_t buffer[], uint32_t bufLength, uint32_t *pixelsRead);
+static EMSTATUS BMP_decodeMonoRLE8(const BMP_Image *image, const BMP_MonoTarget *target,
+                                   const uint8_t darkTable[]);
 
 /**************************************************************************//**
 *  @brief
@@ -913,6 +915,297 @@ EMSTATUS BMP_readRawData(BMP_DataType *dataType, uint8_t buffer[], uint32_t bufL
   return status;
 }
 
+/** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
+
+/* Luma of a pixel, 0 to 255 */
+#define BMP_LUMA(red, green, blue)    (((red) * 77 + (green) * 150 + (blue) * 29) >> 8)
+
+/* Writes one decoded pixel into a row of the mono target, if it is inside
+ * the clipping rectangle. */
+static inline void BMP_monoPut(const BMP_MonoTarget *target, uint8_t *pRow,
+                                 int32_t col, uint8_t isDark)
+{
+  int32_t x = target->x + col;
+  uint8_t mask;
+
+  if ((x < target->xMin) || (x > target->xMax)) {
+    return;
+  }
+  mask = 1 << (x & 0x7);
+  if (isDark == target->dark) {
+    pRow[x >> 3] |= mask;
+  } else {
+    pRow[x >> 3] &= ~mask;
+  }
+}
+
+/** @endcond */
+
+/**************************************************************************//**
+*  @brief
+*  Sets up a BMP image that is mapped in memory, for example a constant array
+*  in flash. The header is checked and the palette and pixel data are located
+*  in place, nothing is copied. This does not use or change the state of the
+*  streaming interface (BMP_init() and BMP_reset()).
+*
+*  Support:
+*   - 24-bit Uncompressed.
+*   - 8-bit Uncompressed.
+*   - 8-bit RLE compressed.
+*   - 1-bit Uncompressed.
+*
+*  @param image
+*  Image structure to set up
+*  @param data
+*  BMP file data
+*  @param length
+*  Length of the BMP file data in bytes
+*
+*  @return
+*  Returns BMP_OK on success, or else error code
+******************************************************************************/
+EMSTATUS BMP_mapImage(BMP_Image *image, const uint8_t *data, uint32_t length)
+{
+  const BMP_Header *header = (const BMP_Header *) data;
+  uint32_t paletteOffset;
+  uint32_t dataSize;
+
+  if ((image == NULL) || (data == NULL)) {
+    return BMP_ERROR_INVALID_ARGUMENT;
+  }
+
+  if (length < BMP_HEADER_SIZE) {
+    return BMP_ERROR_FILE_INVALID;
+  }
+
+  /* Check for little-endian */
+  if (header->magic != 0x4D42) {
+    if (header->magic == 0x424D) {
+      return BMP_ERROR_ENDIAN_MISMATCH;
+    } else {
+      return BMP_ERROR_FILE_INVALID;
+    }
+  }
+
+  /* The later header versions extend the 40 byte one, the palette follows them */
+  if (header->headerSize < 40) {
+    return BMP_ERROR_FILE_NOT_SUPPORTED;
+  }
+
+  /* Check if file is supported. Top-down images (negative height) are not. */
+  if ((header->bitsPerPixel != 24 && header->bitsPerPixel != 8 && header->bitsPerPixel != 1)
+      || ((int32_t) header->width <= 0) || ((int32_t) header->height <= 0)) {
+    return BMP_ERROR_FILE_NOT_SUPPORTED;
+  }
+
+  /* Check if compression is supported */
+  if ((header->compressionType != NO_COMPRESSION)
+      && !((header->compressionType == RLE8_COMPRESSION) && (header->bitsPerPixel == 8))) {
+    return BMP_ERROR_FILE_NOT_SUPPORTED;
+  }
+
+  if (header->dataOffset >= length) {
+    return BMP_ERROR_FILE_INVALID;
+  }
+
+  /* Do a fix if imageDataSize is broken, and never read past the end of the data */
+  dataSize = header->imageDataSize;
+  if ((dataSize == 0) || (dataSize > length - header->dataOffset)) {
+    dataSize = length - header->dataOffset;
+  }
+
+  image->header          = header;
+  image->width           = header->width;
+  image->height          = header->height;
+  image->bitsPerPixel    = header->bitsPerPixel;
+  image->compressionType = header->compressionType;
+  image->rowBytes        = ((header->width * header->bitsPerPixel + 31) / 32) * 4;
+  image->pixels          = data + header->dataOffset;
+  image->pixelsEnd       = image->pixels + dataSize;
+  image->palette         = NULL;
+  image->paletteEntries  = 0;
+
+  if ((image->compressionType == NO_COMPRESSION)
+      && (image->rowBytes * image->height > dataSize)) {
+    return BMP_ERROR_FILE_INVALID;
+  }
+
+  /* Locate the palette */
+  if (header->bitsPerPixel <= 8) {
+    paletteOffset = 14 + header->headerSize;
+    image->paletteEntries = header->colorsUsed ? header->colorsUsed : (1UL << header->bitsPerPixel);
+    if ((image->paletteEntries > (1UL << header->bitsPerPixel))
+        || (paletteOffset + 4 * image->paletteEntries > header->dataOffset)) {
+      return BMP_ERROR_INVALID_PALETTE_SIZE;
+    }
+    image->palette = data + paletteOffset;
+  }
+
+  return BMP_OK;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Decodes a memory mapped BMP image straight into a 1 bit per pixel raster,
+*  such as the display framebuffer. Colors are thresholded to dark or light
+*  on their luma while decoding, and each row is written in place, so no
+*  intermediate RGB buffer is used. Pixels outside of the clipping rectangle
+*  of the target are skipped, and pixels skipped by RLE8 deltas are left
+*  unchanged.
+*
+*  @param image
+*  Image set up by BMP_mapImage()
+*  @param target
+*  Raster to decode into
+*
+*  @return
+*  Returns BMP_OK on success, or else error code
+******************************************************************************/
+EMSTATUS BMP_decodeMono(const BMP_Image *image, const BMP_MonoTarget *target)
+{
+  uint8_t       darkTable[256 / 8];
+  const uint8_t *pSrc;
+  uint8_t       *pRow;
+  uint8_t       isDark;
+  uint32_t      i;
+  int32_t       row;
+  int32_t       col;
+  int32_t       colFirst;
+  int32_t       colLast;
+  int32_t       y;
+
+  if ((image == NULL) || (target == NULL)) {
+    return BMP_ERROR_INVALID_ARGUMENT;
+  }
+
+  /* Threshold the palette once, one bit per entry */
+  for (i = 0; i < sizeof(darkTable); i++) {
+    darkTable[i] = 0;
+  }
+  for (i = 0; i < image->paletteEntries; i++) {
+    pSrc = &image->palette[4 * i];
+    if (BMP_LUMA(pSrc[2], pSrc[1], pSrc[0]) < target->threshold) {
+      darkTable[i >> 3] |= 1 << (i & 0x7);
+    }
+  }
+
+  if (image->compressionType == RLE8_COMPRESSION) {
+    return BMP_decodeMonoRLE8(image, target, darkTable);
+  }
+
+  /* Columns of the image inside the clipping rectangle */
+  colFirst = (target->xMin > target->x) ? target->xMin - target->x : 0;
+  colLast  = (target->xMax - target->x < image->width - 1)
+             ? target->xMax - target->x : image->width - 1;
+
+  /* Rows are stored bottom-up. Rows outside of the clipping rectangle are
+   * skipped without being decoded. */
+  for (row = 0; row < image->height; row++) {
+    y = target->y + image->height - 1 - row;
+    if ((y < target->yMin) || (y > target->yMax)) {
+      continue;
+    }
+    pSrc = image->pixels + row * image->rowBytes;
+    pRow = target->pBits + y * target->bytesPerRow;
+
+    for (col = colFirst; col <= colLast; col++) {
+      switch (image->bitsPerPixel) {
+        case 1:
+          i = (pSrc[col >> 3] >> (7 - (col & 0x7))) & 0x1;
+          isDark = (darkTable[0] >> i) & 0x1;
+          break;
+        case 8:
+          i = pSrc[col];
+          isDark = (darkTable[i >> 3] >> (i & 0x7)) & 0x1;
+          break;
+        default:
+          isDark = BMP_LUMA(pSrc[3 * col + 2], pSrc[3 * col + 1], pSrc[3 * col])
+                   < target->threshold;
+          break;
+      }
+      BMP_monoPut(target, pRow, col, isDark);
+    }
+  }
+
+  return BMP_OK;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Help function to decode a memory mapped RLE8 image into a 1 bit per pixel
+*  raster.
+*
+*  @param image
+*  Image set up by BMP_mapImage()
+*  @param target
+*  Raster to decode into
+*  @param darkTable
+*  One bit per palette entry, set for the dark colors
+*
+*  @return
+*  Returns BMP_OK on success, or else error code
+******************************************************************************/
+static EMSTATUS BMP_decodeMonoRLE8(const BMP_Image *image, const BMP_MonoTarget *target,
+                                   const uint8_t darkTable[])
+{
+  const uint8_t *pSrc = image->pixels;
+  uint8_t       *pRow = NULL;
+  uint8_t       count;
+  uint8_t       value;
+  int32_t       row = 0;
+  int32_t       col = 0;
+  int32_t       y;
+
+  while (row < image->height) {
+    /* Set up the destination row, or none if it is clipped */
+    y = target->y + image->height - 1 - row;
+    pRow = ((y < target->yMin) || (y > target->yMax))
+           ? NULL : target->pBits + y * target->bytesPerRow;
+
+    if (pSrc + 2 > image->pixelsEnd) {
+      return BMP_ERROR_FILE_INVALID;
+    }
+    count = *pSrc++;
+    value = *pSrc++;
+
+    if (count > 0) {
+      /* Encoded run of one color */
+      for (; count && (col < image->width); count--, col++) {
+        if (pRow) {
+          BMP_monoPut(target, pRow, col, (darkTable[value >> 3] >> (value & 0x7)) & 0x1);
+        }
+      }
+    } else if (value == 0) {
+      /* End of row */
+      row++;
+      col = 0;
+    } else if (value == 1) {
+      /* End of bitmap */
+      break;
+    } else if (value == 2) {
+      /* Delta, the skipped pixels are left as they are */
+      if (pSrc + 2 > image->pixelsEnd) {
+        return BMP_ERROR_FILE_INVALID;
+      }
+      col += *pSrc++;
+      row += *pSrc++;
+    } else {
+      /* Absolute run of value pixels, padded to an even number of bytes */
+      if (pSrc + value + (value & 0x1) > image->pixelsEnd) {
+        return BMP_ERROR_FILE_INVALID;
+      }
+      for (count = 0; count < value; count++, col++) {
+        if (pRow && (col < image->width)) {
+          BMP_monoPut(target, pRow, col, (darkTable[pSrc[count] >> 3] >> (pSrc[count] & 0x7)) & 0x1);
+        }
+      }
+      pSrc += value + (value & 0x1);
+    }
+  }
+
+  return BMP_OK;
+}
+
 /**************************************************************************//**
 *  @brief
 *  Get width of BMP image in pixels
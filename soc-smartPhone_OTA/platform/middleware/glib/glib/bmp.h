@@ -80,6 +80,11 @@
 /** BMP Local cache size */
 #define BMP_LOCAL_CACHE_SIZE                (BMP_CONFIG_LOCAL_CACHE_SIZE)
 
+/** Default luma threshold for BMP_decodeMono(). Pixels darker than this are dark. */
+#ifndef BMP_MONO_THRESHOLD
+#define BMP_MONO_THRESHOLD                  (128)
+#endif
+
 /** @brief BMP Module header structure. Must be packed to exact 54 bytes.
  */
 #if defined (__GNUC__)
@@ -150,12 +155,68 @@ typedef struct __BMP_DataType{
   uint32_t endOfRow;
 } BMP_DataType;
 
+/** @brief Memory mapped BMP image, set up by BMP_mapImage(). The image data
+ *  stays where it is, typically in flash, and is read in place.
+ */
+typedef struct __BMP_Image{
+  /** Header, in place in the image data */
+  const BMP_Header *header;
+  /** Palette entries (blue, green, red, reserved) in place, or NULL for 24bpp */
+  const uint8_t    *palette;
+  /** Number of palette entries */
+  uint32_t         paletteEntries;
+  /** First byte of the pixel data */
+  const uint8_t    *pixels;
+  /** Byte after the last byte of the pixel data */
+  const uint8_t    *pixelsEnd;
+  /** Width in pixels */
+  int32_t          width;
+  /** Height in pixels */
+  int32_t          height;
+  /** Color depth, 1, 8 or 24 */
+  uint16_t         bitsPerPixel;
+  /** Compression type, NO_COMPRESSION or RLE8_COMPRESSION */
+  uint32_t         compressionType;
+  /** Bytes per row of uncompressed pixel data, including padding */
+  uint32_t         rowBytes;
+} BMP_Image;
+
+/** @brief Destination of BMP_decodeMono(). A 1 bit per pixel raster, where
+ *  pixel x of a row is bit (x & 7) of byte (x >> 3).
+ */
+typedef struct __BMP_MonoTarget{
+  /** First byte of the top row of the raster */
+  uint8_t  *pBits;
+  /** Distance between two rows in bytes */
+  uint32_t bytesPerRow;
+  /** X-coordinate of the top left corner of the image in the raster */
+  int32_t  x;
+  /** Y-coordinate of the top left corner of the image in the raster */
+  int32_t  y;
+  /** Clipping rectangle in the raster, inclusive */
+  int32_t  xMin;
+  /** Clipping rectangle in the raster, inclusive */
+  int32_t  yMin;
+  /** Clipping rectangle in the raster, inclusive */
+  int32_t  xMax;
+  /** Clipping rectangle in the raster, inclusive */
+  int32_t  yMax;
+  /** Luma threshold, pixels below it are dark */
+  uint8_t  threshold;
+  /** Bit value written for a dark pixel, 0 or 1 */
+  uint8_t  dark;
+} BMP_MonoTarget;
+
 /* Module prototypes */
 EMSTATUS BMP_init(uint8_t *palette, uint32_t paletteSize, EMSTATUS (*fp)(uint8_t buffer[], uint32_t bufLength, uint32_t bytesToRead));
 EMSTATUS BMP_reset(void);
 EMSTATUS BMP_readRgbData(uint8_t buffer[], uint32_t bufLength, uint32_t *pixelsRead);
 EMSTATUS BMP_readRawData(BMP_DataType *dataType, uint8_t buffer[], uint32_t bufLength);
 
+/* Memory mapped decoding */
+EMSTATUS BMP_mapImage(BMP_Image *image, const uint8_t *data, uint32_t length);
+EMSTATUS BMP_decodeMono(const BMP_Image *image, const BMP_MonoTarget *target);
+
 /* Accessor functions */
 int32_t BMP_getWidth(void);
 int32_t BMP_getHeight(void);
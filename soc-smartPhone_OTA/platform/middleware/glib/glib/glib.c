@@ -43,6 +43,31 @@ static __INLINE void GLIB_colorTranslate24bppInl(uint32_t color, uint8_t *red, u
   *green = (color >> GreenShift) & 0xFF;
   *blue  = (color >> BlueShift) & 0xFF;
 }
+
+/**
+ * @brief Writes a single pixel that has already been checked against the
+ * clipping region. With a monochrome display the pixel is set directly in the
+ * 1bpp raster instead of going through DMD_writeColor().
+ */
+static __INLINE EMSTATUS GLIB_writePixel(int32_t x, int32_t y, uint8_t red, uint8_t green, uint8_t blue)
+{
+#if defined(DMD_RASTER_1BPP)
+  EMSTATUS status;
+  const DMD_Raster1bpp *raster;
+
+  (void) red;
+  (void) blue;
+
+  status = DMD_getRaster1bpp(&raster);
+  if (status != DMD_OK) {
+    return status;
+  }
+  DMD_raster1bppPlot(raster, x, y, DMD_raster1bppFill(raster, green));
+  return DMD_raster1bppMarkDirty(y, y);
+#else
+  return DMD_writeColor(x, y, red, green, blue, 1);
+#endif
+}
 /** @endcond */
 
 /**************************************************************************//**
@@ -179,6 +204,9 @@ EMSTATUS GLIB_clear(GLIB_Context_t *pContext)
   uint8_t  blue;
   uint32_t width;
   uint32_t height;
+#if defined(DMD_RASTER_1BPP)
+  const DMD_Raster1bpp *raster;
+#endif
 
   /* Check arguments */
   if (pContext == NULL) {
@@ -197,7 +225,17 @@ EMSTATUS GLIB_clear(GLIB_Context_t *pContext)
   /* Fill the display with the background color of the GLIB_Context_t  */
   width = pContext->pDisplayGeometry->clipWidth;
   height = pContext->pDisplayGeometry->clipHeight;
+#if defined(DMD_RASTER_1BPP)
+  status = DMD_getRaster1bpp(&raster);
+  if (status != DMD_OK) {
+    return status;
+  }
+  (void) red;
+  (void) blue;
+  return DMD_raster1bppFillRect(0, 0, width, height, DMD_raster1bppFill(raster, green));
+#else
   return DMD_writeColor(0, 0, red, green, blue, width * height);
+#endif
 }
 
 /**************************************************************************//**
@@ -219,6 +257,9 @@ EMSTATUS GLIB_clearRegion(const GLIB_Context_t *pContext)
   uint8_t  blue;
   uint32_t width;
   uint32_t height;
+#if defined(DMD_RASTER_1BPP)
+  const DMD_Raster1bpp *raster;
+#endif
 
   /* Check arguments */
   if (pContext == NULL) {
@@ -236,7 +277,20 @@ EMSTATUS GLIB_clearRegion(const GLIB_Context_t *pContext)
   /* Fill the region with the background color of the GLIB_Context_t */
   width = pContext->clippingRegion.xMax - pContext->clippingRegion.xMin + 1;
   height = pContext->clippingRegion.yMax - pContext->clippingRegion.yMin + 1;
+#if defined(DMD_RASTER_1BPP)
+  status = DMD_getRaster1bpp(&raster);
+  if (status != DMD_OK) {
+    return status;
+  }
+  (void) red;
+  (void) blue;
+  status = DMD_raster1bppFillRect(pContext->clippingRegion.xMin,
+                                  pContext->clippingRegion.yMin,
+                                  width, height,
+                                  DMD_raster1bppFill(raster, green));
+#else
   status = DMD_writeColor(0, 0, red, green, blue, width * height);
+#endif
   if (status != DMD_OK) {
     return status;
   }
@@ -390,7 +444,7 @@ EMSTATUS GLIB_drawPixel(GLIB_Context_t *pContext, int32_t x, int32_t y)
 
   /* Translate color and draw pixel */
   GLIB_colorTranslate24bppInl(pContext->foregroundColor, &red, &green, &blue);
-  return DMD_writeColor(x, y, red, green, blue, 1);
+  return GLIB_writePixel(x, y, red, green, blue);
 }
 
 /**************************************************************************//**
@@ -426,7 +480,7 @@ EMSTATUS GLIB_drawPixelColor(GLIB_Context_t *pContext, int32_t x, int32_t y,
 
   /* Translate color and draw pixel */
   GLIB_colorTranslate24bppInl(color, &red, &green, &blue);
-  return DMD_writeColor(x, y, red, green, blue, 1);
+  return GLIB_writePixel(x, y, red, green, blue);
 }
 
 /**************************************************************************//**
@@ -465,5 +519,5 @@ EMSTATUS GLIB_drawPixelRGB(GLIB_Context_t *pContext, int32_t x, int32_t y,
   }
 
   /* Call Display driver function */
-  return DMD_writeColor(x, y, red, green, blue, 1);
+  return GLIB_writePixel(x, y, red, green, blue);
 }
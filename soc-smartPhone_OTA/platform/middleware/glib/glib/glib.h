@@ -139,6 +139,16 @@
  *   height of each character and it also contains the bitmap of each
  *   character.
  *
+ *   For text that is redrawn often, the fonts can also be compiled into font
+ *   atlases (@ref GLIB_FontAtlas_t) by tools/font_atlas.py. An atlas holds
+ *   each glyph trimmed to its ink box as rows of whole bytes together with a
+ *   width table and optional kerning pairs. @ref GLIB_drawText() blits the
+ *   glyph rows a byte at a time and aligns each line left, centered or right,
+ *   and @ref GLIB_measureText() returns the extent of a string, caching the
+ *   most recent results.
+ *
+ *   @li @ref GLIB_AtlasNarrow6x8 Proportional atlas of the 6x8 font.
+ *
  * @n @section glib_bitmap Draw Bitmap
  *
  *   To draw an image or custom bitmaps on the display the @ref GLIB_drawBitmap()
@@ -250,6 +260,76 @@ typedef struct __GLIB_Font_t{
   GLIB_Font_Class class;
 } GLIB_Font_t;
 
+/** @brief Glyph of a font atlas
+ */
+typedef struct __GLIB_Glyph_t{
+  /** Offset of the first glyph row in the atlas bits. */
+  uint16_t offset;
+
+  /** Width of the ink box in pixels, each row is (width + 7) / 8 bytes. */
+  uint8_t width;
+
+  /** Height of the ink box in pixels. */
+  uint8_t height;
+
+  /** Position of the ink box relative to the pen position. */
+  uint8_t xOffset;
+  uint8_t yOffset;
+
+  /** Number of pixels the pen advances after this glyph. */
+  uint8_t advance;
+} GLIB_Glyph_t;
+
+/** @brief Kerning pair of a font atlas
+ */
+typedef struct __GLIB_KerningPair_t{
+  /** Left character of the pair. */
+  char left;
+
+  /** Right character of the pair. */
+  char right;
+
+  /** Adjustment of the advance of the left character in pixels. */
+  int8_t adjust;
+} GLIB_KerningPair_t;
+
+/** @brief Font atlas definition structure, generated by tools/font_atlas.py
+ */
+typedef struct __GLIB_FontAtlas_t{
+  /** Glyph rows, bit 0 of each byte is the leftmost pixel. */
+  const uint8_t *pBits;
+
+  /** Glyph table. */
+  const GLIB_Glyph_t *pGlyphs;
+
+  /** Glyph index of each character from firstChar, 0xff if it is missing. */
+  const uint8_t *pCharMap;
+
+  /** Kerning pairs sorted by left and right character, or NULL. */
+  const GLIB_KerningPair_t *pKerning;
+
+  /** Number of kerning pairs. */
+  uint16_t numKerning;
+
+  /** First and last character of the character map. */
+  char firstChar;
+  char lastChar;
+
+  /** Height in pixels of each line. */
+  uint8_t height;
+
+  /** Number of pixels between each line. */
+  uint8_t lineSpacing;
+} GLIB_FontAtlas_t;
+
+/** @brief Horizontal alignment of each line of a text
+ */
+typedef enum __GLIB_Align_t{
+  GLIB_ALIGN_LEFT = 0,  /**< Lines start at the x-coordinate. */
+  GLIB_ALIGN_CENTER,    /**< Lines are centered on the x-coordinate. */
+  GLIB_ALIGN_RIGHT,     /**< Lines end at the x-coordinate. */
+} GLIB_Align_t;
+
 /** @brief Rectangle structure
  */
 typedef struct __GLIB_Rectangle_t{
@@ -283,6 +363,30 @@ typedef struct __GLIB_Context_t{
   GLIB_Font_t font;
 } GLIB_Context_t;
 
+/** @brief Horizontal span emitter used by the filled primitives.
+ *  Spans are clipped to the clipping region of the context. With a
+ *  monochrome display they are written straight into the 1bpp raster and the
+ *  rows are marked dirty once in GLIB_spansEnd().
+ */
+typedef struct __GLIB_Spans_t{
+  /** Context the spans are drawn in */
+  GLIB_Context_t *pContext;
+
+#if defined(DMD_RASTER_1BPP)
+  /** Raster of the active framebuffer */
+  const DMD_Raster1bpp *raster;
+
+  /** Raster fill byte for the foreground color */
+  uint8_t fill;
+#endif
+
+  /** First row drawn */
+  int32_t yFirst;
+
+  /** Last row drawn, less than yFirst while nothing is drawn */
+  int32_t yLast;
+} GLIB_Spans_t;
+
 /* Prototypes for graphics library functions */
 EMSTATUS GLIB_contextInit(GLIB_Context_t *pContext);
 
@@ -327,9 +431,21 @@ EMSTATUS GLIB_drawString(GLIB_Context_t *pContext, const char* pString, uint32_t
 EMSTATUS GLIB_drawChar(GLIB_Context_t *pContext, char myChar, int32_t x,
                        int32_t y, bool opaque);
 
+EMSTATUS GLIB_measureText(const GLIB_FontAtlas_t *pAtlas, const char *pString,
+                          uint32_t sLength, uint32_t *pWidth, uint32_t *pHeight);
+
+EMSTATUS GLIB_drawText(GLIB_Context_t *pContext, const GLIB_FontAtlas_t *pAtlas,
+                       const char *pString, uint32_t sLength, int32_t x,
+                       int32_t y, GLIB_Align_t align, bool opaque);
+
 EMSTATUS GLIB_drawBitmap(GLIB_Context_t* pContext, int32_t x, int32_t y,
                          uint32_t width, uint32_t height, const uint8_t *picData);
 
+#if defined(DMD_RASTER_1BPP)
+EMSTATUS GLIB_drawBmp(GLIB_Context_t *pContext, int32_t x, int32_t y,
+                      const uint8_t *bmpData, uint32_t bmpSize);
+#endif
+
 EMSTATUS GLIB_drawLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
                        int32_t x2, int32_t y2);
 
@@ -358,11 +474,21 @@ EMSTATUS GLIB_drawPixel(GLIB_Context_t *pContext, int32_t x, int32_t y);
 EMSTATUS GLIB_drawPixelColor(GLIB_Context_t *pContext, int32_t x, int32_t y,
                              uint32_t color);
 
+EMSTATUS GLIB_spansBegin(GLIB_Spans_t *pSpans, GLIB_Context_t *pContext);
+
+EMSTATUS GLIB_spansFill(GLIB_Spans_t *pSpans, int32_t x1, int32_t y,
+                        int32_t x2);
+
+EMSTATUS GLIB_spansEnd(GLIB_Spans_t *pSpans);
+
 /* Fonts included in the library */
 extern const GLIB_Font_t GLIB_FontNormal8x8; /* Default */
 extern const GLIB_Font_t GLIB_FontNarrow6x8;
 extern const GLIB_Font_t GLIB_FontNumber16x20;
 
+/* Font atlases included in the library */
+extern const GLIB_FontAtlas_t GLIB_AtlasNarrow6x8;
+
 /** @} (end addtogroup glib) */
 
 #ifdef __cplusplus
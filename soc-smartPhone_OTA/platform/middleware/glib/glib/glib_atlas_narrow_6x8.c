@@ -0,0 +1,199 @@
+/***************************************************************************//**
+ * @file
+ * @brief Silicon Labs Graphics Library: GLIB_AtlasNarrow6x8 font atlas
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc.  Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.  This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* This file is generated by tools/font_atlas.py from glib_font_narrow_6x8.c, do not edit. */
+
+/* Standard C header files */
+#include <stdint.h>
+
+/* GLIB header files */
+#include "glib.h"
+
+/** @brief Packed glyph rows of the "GLIB_AtlasNarrow6x8" atlas. */
+static const uint8_t GLIB_AtlasNarrow6x8Bits[] =
+{
+  0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x01, 0x05, 0x05, 0x05, 0x0a, 0x0a,
+  0x1f, 0x0a, 0x1f, 0x0a, 0x0a, 0x04, 0x1e, 0x01, 0x0e, 0x10, 0x0f, 0x04,
+  0x03, 0x13, 0x08, 0x04, 0x02, 0x19, 0x18, 0x06, 0x09, 0x05, 0x02, 0x15,
+  0x09, 0x16, 0x03, 0x02, 0x01, 0x04, 0x02, 0x01, 0x01, 0x01, 0x02, 0x04,
+  0x01, 0x02, 0x04, 0x04, 0x04, 0x02, 0x01, 0x04, 0x15, 0x0e, 0x15, 0x04,
+  0x04, 0x04, 0x1f, 0x04, 0x04, 0x03, 0x02, 0x01, 0x1f, 0x03, 0x03, 0x10,
+  0x08, 0x04, 0x02, 0x01, 0x0e, 0x11, 0x19, 0x15, 0x13, 0x11, 0x0e, 0x02,
+  0x03, 0x02, 0x02, 0x02, 0x02, 0x07, 0x0e, 0x11, 0x10, 0x08, 0x04, 0x02,
+  0x1f, 0x1f, 0x08, 0x04, 0x08, 0x10, 0x11, 0x0e, 0x08, 0x0c, 0x0a, 0x09,
+  0x1f, 0x08, 0x08, 0x1f, 0x01, 0x0f, 0x10, 0x10, 0x11, 0x0e, 0x0c, 0x02,
+  0x01, 0x0f, 0x11, 0x11, 0x0e, 0x1f, 0x10, 0x08, 0x04, 0x02, 0x02, 0x02,
+  0x0e, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x0e, 0x0e, 0x11, 0x11, 0x1e, 0x10,
+  0x08, 0x06, 0x03, 0x03, 0x00, 0x03, 0x03, 0x03, 0x03, 0x00, 0x03, 0x02,
+  0x01, 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08, 0x1f, 0x00, 0x1f, 0x01,
+  0x02, 0x04, 0x08, 0x04, 0x02, 0x01, 0x0e, 0x11, 0x10, 0x08, 0x04, 0x00,
+  0x04, 0x0e, 0x10, 0x10, 0x16, 0x15, 0x15, 0x0e, 0x0e, 0x11, 0x11, 0x11,
+  0x1f, 0x11, 0x11, 0x0f, 0x11, 0x11, 0x0f, 0x11, 0x11, 0x0f, 0x0e, 0x11,
+  0x01, 0x01, 0x01, 0x11, 0x0e, 0x07, 0x09, 0x11, 0x11, 0x11, 0x09, 0x07,
+  0x1f, 0x01, 0x01, 0x0f, 0x01, 0x01, 0x1f, 0x1f, 0x01, 0x01, 0x0f, 0x01,
+  0x01, 0x01, 0x0e, 0x11, 0x01, 0x1d, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x11,
+  0x1f, 0x11, 0x11, 0x11, 0x07, 0x02, 0x02, 0x02, 0x02, 0x02, 0x07, 0x1c,
+  0x08, 0x08, 0x08, 0x08, 0x09, 0x06, 0x11, 0x09, 0x05, 0x03, 0x05, 0x09,
+  0x11, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x1f, 0x11, 0x1b, 0x15, 0x15,
+  0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x15, 0x19, 0x11, 0x11, 0x0e, 0x11,
+  0x11, 0x11, 0x11, 0x11, 0x0e, 0x0f, 0x11, 0x11, 0x0f, 0x01, 0x01, 0x01,
+  0x0e, 0x11, 0x11, 0x11, 0x15, 0x09, 0x16, 0x0f, 0x11, 0x11, 0x0f, 0x05,
+  0x09, 0x11, 0x1e, 0x01, 0x01, 0x0e, 0x10, 0x10, 0x0f, 0x1f, 0x04, 0x04,
+  0x04, 0x04, 0x04, 0x04, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0e, 0x11,
+  0x11, 0x11, 0x11, 0x11, 0x0a, 0x04, 0x11, 0x11, 0x11, 0x15, 0x15, 0x15,
+  0x0a, 0x11, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0a,
+  0x04, 0x04, 0x04, 0x1f, 0x10, 0x08, 0x04, 0x02, 0x01, 0x1f, 0x07, 0x01,
+  0x01, 0x01, 0x01, 0x01, 0x07, 0x01, 0x02, 0x04, 0x08, 0x10, 0x07, 0x04,
+  0x04, 0x04, 0x04, 0x04, 0x07, 0x04, 0x0a, 0x11, 0x1f, 0x01, 0x02, 0x04,
+  0x0e, 0x10, 0x1e, 0x11, 0x1e, 0x01, 0x01, 0x0d, 0x13, 0x11, 0x11, 0x0f,
+  0x0e, 0x01, 0x01, 0x11, 0x0e, 0x10, 0x10, 0x16, 0x19, 0x11, 0x11, 0x1e,
+  0x0e, 0x11, 0x1f, 0x01, 0x0e, 0x0c, 0x12, 0x02, 0x07, 0x02, 0x02, 0x02,
+  0x1e, 0x11, 0x11, 0x1e, 0x10, 0x0e, 0x01, 0x01, 0x0d, 0x13, 0x11, 0x11,
+  0x11, 0x02, 0x00, 0x03, 0x02, 0x02, 0x02, 0x07, 0x08, 0x00, 0x0c, 0x08,
+  0x08, 0x09, 0x06, 0x01, 0x01, 0x09, 0x05, 0x03, 0x05, 0x09, 0x03, 0x02,
+  0x02, 0x02, 0x02, 0x02, 0x07, 0x0b, 0x15, 0x15, 0x11, 0x11, 0x0d, 0x13,
+  0x11, 0x11, 0x11, 0x0e, 0x11, 0x11, 0x11, 0x0e, 0x0f, 0x11, 0x0f, 0x01,
+  0x01, 0x16, 0x19, 0x1e, 0x10, 0x10, 0x0d, 0x13, 0x01, 0x01, 0x01, 0x0e,
+  0x01, 0x0e, 0x10, 0x0f, 0x02, 0x02, 0x07, 0x02, 0x02, 0x12, 0x0c, 0x11,
+  0x11, 0x11, 0x19, 0x16, 0x11, 0x11, 0x11, 0x0a, 0x04, 0x11, 0x11, 0x15,
+  0x15, 0x0a, 0x11, 0x0a, 0x04, 0x0a, 0x11, 0x11, 0x11, 0x1e, 0x10, 0x0e,
+  0x1f, 0x08, 0x04, 0x02, 0x1f, 0x0c, 0x02, 0x02, 0x01, 0x02, 0x02, 0x0c,
+  0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x03, 0x04, 0x04, 0x08, 0x04,
+  0x04, 0x03, 0x02, 0x15, 0x08
+};
+
+/** @brief Glyphs of the "GLIB_AtlasNarrow6x8" atlas. */
+static const GLIB_Glyph_t GLIB_AtlasNarrow6x8Glyphs[] =
+{
+  {    0,  0,  0,  0,  0,  3 }, /* ' ' */
+  {    0,  1,  7,  0,  0,  2 }, /* '!' */
+  {    7,  3,  3,  0,  0,  4 }, /* '"' */
+  {   10,  5,  7,  0,  0,  6 }, /* '#' */
+  {   17,  5,  7,  0,  0,  6 }, /* '$' */
+  {   24,  5,  7,  0,  0,  6 }, /* '%' */
+  {   31,  5,  7,  0,  0,  6 }, /* '&' */
+  {   38,  2,  3,  0,  0,  3 }, /* '\'' */
+  {   41,  3,  7,  0,  0,  4 }, /* '(' */
+  {   48,  3,  7,  0,  0,  4 }, /* ')' */
+  {   55,  5,  5,  0,  1,  6 }, /* '*' */
+  {   60,  5,  5,  0,  1,  6 }, /* '+' */
+  {   65,  2,  3,  0,  4,  3 }, /* ',' */
+  {   68,  5,  1,  0,  3,  6 }, /* '-' */
+  {   69,  2,  2,  0,  5,  3 }, /* '.' */
+  {   71,  5,  5,  0,  2,  6 }, /* '/' */
+  {   76,  5,  7,  0,  0,  6 }, /* '0' */
+  {   83,  3,  7,  0,  0,  4 }, /* '1' */
+  {   90,  5,  7,  0,  0,  6 }, /* '2' */
+  {   97,  5,  7,  0,  0,  6 }, /* '3' */
+  {  104,  5,  7,  0,  0,  6 }, /* '4' */
+  {  111,  5,  7,  0,  0,  6 }, /* '5' */
+  {  118,  5,  7,  0,  0,  6 }, /* '6' */
+  {  125,  5,  7,  0,  0,  6 }, /* '7' */
+  {  132,  5,  7,  0,  0,  6 }, /* '8' */
+  {  139,  5,  7,  0,  0,  6 }, /* '9' */
+  {  146,  2,  5,  0,  1,  3 }, /* ':' */
+  {  151,  2,  6,  0,  1,  3 }, /* ';' */
+  {  157,  4,  7,  0,  0,  5 }, /* '<' */
+  {  164,  5,  3,  0,  2,  6 }, /* '=' */
+  {  167,  4,  7,  0,  0,  5 }, /* '>' */
+  {  174,  5,  7,  0,  0,  6 }, /* '?' */
+  {  181,  5,  7,  0,  0,  6 }, /* '@' */
+  {  188,  5,  7,  0,  0,  6 }, /* 'A' */
+  {  195,  5,  7,  0,  0,  6 }, /* 'B' */
+  {  202,  5,  7,  0,  0,  6 }, /* 'C' */
+  {  209,  5,  7,  0,  0,  6 }, /* 'D' */
+  {  216,  5,  7,  0,  0,  6 }, /* 'E' */
+  {  223,  5,  7,  0,  0,  6 }, /* 'F' */
+  {  230,  5,  7,  0,  0,  6 }, /* 'G' */
+  {  237,  5,  7,  0,  0,  6 }, /* 'H' */
+  {  244,  3,  7,  0,  0,  4 }, /* 'I' */
+  {  251,  5,  7,  0,  0,  6 }, /* 'J' */
+  {  258,  5,  7,  0,  0,  6 }, /* 'K' */
+  {  265,  5,  7,  0,  0,  6 }, /* 'L' */
+  {  272,  5,  7,  0,  0,  6 }, /* 'M' */
+  {  279,  5,  7,  0,  0,  6 }, /* 'N' */
+  {  286,  5,  7,  0,  0,  6 }, /* 'O' */
+  {  293,  5,  7,  0,  0,  6 }, /* 'P' */
+  {  300,  5,  7,  0,  0,  6 }, /* 'Q' */
+  {  307,  5,  7,  0,  0,  6 }, /* 'R' */
+  {  314,  5,  7,  0,  0,  6 }, /* 'S' */
+  {  321,  5,  7,  0,  0,  6 }, /* 'T' */
+  {  328,  5,  7,  0,  0,  6 }, /* 'U' */
+  {  335,  5,  7,  0,  0,  6 }, /* 'V' */
+  {  342,  5,  7,  0,  0,  6 }, /* 'W' */
+  {  349,  5,  7,  0,  0,  6 }, /* 'X' */
+  {  356,  5,  7,  0,  0,  6 }, /* 'Y' */
+  {  363,  5,  7,  0,  0,  6 }, /* 'Z' */
+  {  370,  3,  7,  0,  0,  4 }, /* '[' */
+  {  377,  5,  5,  0,  2,  6 }, /* '\\' */
+  {  382,  3,  7,  0,  0,  4 }, /* ']' */
+  {  389,  5,  3,  0,  0,  6 }, /* '^' */
+  {  392,  5,  1,  0,  6,  6 }, /* '_' */
+  {  393,  3,  3,  0,  0,  4 }, /* '`' */
+  {  396,  5,  5,  0,  2,  6 }, /* 'a' */
+  {  401,  5,  7,  0,  0,  6 }, /* 'b' */
+  {  408,  5,  5,  0,  2,  6 }, /* 'c' */
+  {  413,  5,  7,  0,  0,  6 }, /* 'd' */
+  {  420,  5,  5,  0,  2,  6 }, /* 'e' */
+  {  425,  5,  7,  0,  0,  6 }, /* 'f' */
+  {  432,  5,  6,  0,  1,  6 }, /* 'g' */
+  {  438,  5,  7,  0,  0,  6 }, /* 'h' */
+  {  445,  3,  7,  0,  0,  4 }, /* 'i' */
+  {  452,  4,  7,  0,  0,  5 }, /* 'j' */
+  {  459,  4,  7,  0,  0,  5 }, /* 'k' */
+  {  466,  3,  7,  0,  0,  4 }, /* 'l' */
+  {  473,  5,  5,  0,  2,  6 }, /* 'm' */
+  {  478,  5,  5,  0,  2,  6 }, /* 'n' */
+  {  483,  5,  5,  0,  2,  6 }, /* 'o' */
+  {  488,  5,  5,  0,  2,  6 }, /* 'p' */
+  {  493,  5,  5,  0,  2,  6 }, /* 'q' */
+  {  498,  5,  5,  0,  2,  6 }, /* 'r' */
+  {  503,  5,  5,  0,  2,  6 }, /* 's' */
+  {  508,  5,  7,  0,  0,  6 }, /* 't' */
+  {  515,  5,  5,  0,  2,  6 }, /* 'u' */
+  {  520,  5,  5,  0,  2,  6 }, /* 'v' */
+  {  525,  5,  5,  0,  2,  6 }, /* 'w' */
+  {  530,  5,  5,  0,  2,  6 }, /* 'x' */
+  {  535,  5,  5,  0,  2,  6 }, /* 'y' */
+  {  540,  5,  5,  0,  2,  6 }, /* 'z' */
+  {  545,  4,  7,  0,  0,  5 }, /* '{' */
+  {  552,  1,  7,  0,  0,  2 }, /* '|' */
+  {  559,  4,  7,  0,  0,  5 }, /* '}' */
+  {  566,  5,  3,  0,  1,  6 }  /* '~' */
+};
+
+/** @brief Glyph index of each character from ' ', 0xff if missing. */
+static const uint8_t GLIB_AtlasNarrow6x8CharMap[] =
+{
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b,
+  0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+  0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f, 0x20, 0x21, 0x22, 0x23,
+  0x24, 0x25, 0x26, 0x27, 0x28, 0x29, 0x2a, 0x2b, 0x2c, 0x2d, 0x2e, 0x2f,
+  0x30, 0x31, 0x32, 0x33, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3a, 0x3b,
+  0x3c, 0x3d, 0x3e, 0x3f, 0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47,
+  0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f, 0x50, 0x51, 0x52, 0x53,
+  0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5a, 0x5b, 0x5c, 0x5d, 0x5e
+};
+
+/**
+ * @brief Proportional atlas compiled from glib_font_narrow_6x8.c.
+ */
+const GLIB_FontAtlas_t GLIB_AtlasNarrow6x8 = { GLIB_AtlasNarrow6x8Bits,
+                                               GLIB_AtlasNarrow6x8Glyphs,
+                                               GLIB_AtlasNarrow6x8CharMap,
+                                               NULL, 0,
+                                               ' ', '~', 8, 2 };
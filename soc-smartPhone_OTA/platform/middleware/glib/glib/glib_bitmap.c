@@ -23,6 +23,7 @@
 
 /* GLIB header files */
 #include "glib.h"
+#include "bmp.h"
 
 /**************************************************************************//**
 *  @brief
@@ -83,3 +84,83 @@ EMSTATUS GLIB_drawBitmap(GLIB_Context_t *pContext, int32_t x, int32_t y,
   /* Reset driver clipping area to GLIB clipping region */
   return GLIB_applyClippingRegion(pContext);
 }
+
+#if defined(DMD_RASTER_1BPP)
+/**************************************************************************//**
+*  @brief
+*  Draws a BMP image that is mapped in memory, for example a splash screen or
+*  an icon stored as a constant array in flash.
+*
+*  The image is decoded row by row straight into the framebuffer, with the
+*  colors thresholded to the foreground (dark) and background (light) pixel
+*  values, so neither an RGB buffer nor the read callback of BMP_init() is
+*  needed. Supports 1-bit, 8-bit and 24-bit uncompressed and 8-bit RLE
+*  compressed images. Only available with monochrome displays.
+*
+*  @param pContext
+*  Pointer to a GLIB_Context_t which holds the clipping region
+*  @param x
+*  Start x-coordinate for the image
+*  @param y
+*  Start y-coordinate for the image
+*  @param bmpData
+*  BMP file data
+*  @param bmpSize
+*  Length of the BMP file data in bytes
+*
+*  @return
+*  Returns GLIB_OK on success, GLIB_ERROR_NOTHING_TO_DRAW if the image is
+*  outside of the clipping region, or else error code
+******************************************************************************/
+EMSTATUS GLIB_drawBmp(GLIB_Context_t *pContext, int32_t x, int32_t y,
+                      const uint8_t *bmpData, uint32_t bmpSize)
+{
+  EMSTATUS status;
+  const DMD_Raster1bpp *raster;
+  BMP_Image image;
+  BMP_MonoTarget target;
+
+  /* Check arguments */
+  if ((pContext == NULL) || (bmpData == NULL)) {
+    return GLIB_ERROR_INVALID_ARGUMENT;
+  }
+
+  status = BMP_mapImage(&image, bmpData, bmpSize);
+  if (status == BMP_ERROR_FILE_NOT_SUPPORTED) {
+    return GLIB_ERROR_FILE_NOT_SUPPORTED;
+  } else if (status != BMP_OK) {
+    return GLIB_ERROR_INVALID_FILE;
+  }
+
+  status = DMD_getRaster1bpp(&raster);
+  if (status != DMD_OK) {
+    return status;
+  }
+
+  /* Clip the image against the clipping region */
+  target.xMin = (x > pContext->clippingRegion.xMin) ? x : pContext->clippingRegion.xMin;
+  target.yMin = (y > pContext->clippingRegion.yMin) ? y : pContext->clippingRegion.yMin;
+  target.xMax = (x + image.width - 1 < pContext->clippingRegion.xMax)
+                ? x + image.width - 1 : pContext->clippingRegion.xMax;
+  target.yMax = (y + image.height - 1 < pContext->clippingRegion.yMax)
+                ? y + image.height - 1 : pContext->clippingRegion.yMax;
+  if ((target.xMin > target.xMax) || (target.yMin > target.yMax)) {
+    return GLIB_ERROR_NOTHING_TO_DRAW;
+  }
+
+  /* Dark pixels get the value of a black foreground pixel */
+  target.pBits       = raster->pBits;
+  target.bytesPerRow = raster->bytesPerRow;
+  target.x           = x;
+  target.y           = y;
+  target.threshold   = BMP_MONO_THRESHOLD;
+  target.dark        = DMD_raster1bppFill(raster, 0x00) & 0x1;
+
+  status = BMP_decodeMono(&image, &target);
+  if (status != BMP_OK) {
+    return GLIB_ERROR_INVALID_FILE;
+  }
+
+  return DMD_raster1bppMarkDirty(target.yMin, target.yMax);
+}
+#endif
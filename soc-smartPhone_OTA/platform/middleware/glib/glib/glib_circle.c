@@ -27,6 +27,9 @@
 static EMSTATUS GLIB_drawPartialCirclePoints(GLIB_Context_t *pContext,
                                              int32_t xCenter, int32_t yCenter,
                                              int32_t x, int32_t y, uint8_t bitMask);
+static EMSTATUS GLIB_drawCircleFilledRows(GLIB_Spans_t *pSpans,
+                                          int32_t xCenter, int32_t yCenter,
+                                          int32_t row, int32_t halfWidth);
 
 /**************************************************************************//**
 *  @brief
@@ -132,7 +135,8 @@ EMSTATUS GLIB_drawPartialCircle(GLIB_Context_t *pContext, int32_t xCenter,
 *  Draws a filled circle with center at x, y, and a radius.
 *
 *  Draws a circle using the Midpoint Circle Algorithm and using horizontal lines.
-*  See Wikipedia for algorithm.
+*  See Wikipedia for algorithm. Each row is filled once, with the widest span
+*  the algorithm produces for it.
 *
 *  @param pContext
 *  Pointer to a GLIB_Context_t in which the circle is drawn. The circle is drawn using the foreground color.
@@ -152,24 +156,26 @@ EMSTATUS GLIB_drawCircleFilled(GLIB_Context_t *pContext, int32_t xCenter,
                                int32_t yCenter, uint32_t radius)
 {
   EMSTATUS status;
+  GLIB_Spans_t spans;
   int32_t x = 0;
   int32_t y = radius;
   int32_t d = 1 - radius;
-  uint32_t drawnElements = 0;
 
   /* Check arguments */
   if (pContext == NULL) {
     return GLIB_ERROR_INVALID_ARGUMENT;
   }
 
+  status = GLIB_spansBegin(&spans, pContext);
+  if (status != GLIB_OK) {
+    return status;
+  }
+
   /* Draws the initial circle fill line */
-  status = GLIB_drawLineH(pContext, xCenter - y, yCenter, xCenter + y);
+  status = GLIB_spansFill(&spans, xCenter - y, yCenter, xCenter + y);
   if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
     return status;
   }
-  if (status == GLIB_OK) {
-    drawnElements++;
-  }
 
   /* Loops through all points from 0 to 45 degrees of the circle
    * (0 is defined straight upward) */
@@ -181,42 +187,26 @@ EMSTATUS GLIB_drawCircleFilled(GLIB_Context_t *pContext, int32_t xCenter,
       d += 2 * (x - y) + 1;
     }
 
-    /* Draws horizontal fill lines using 4 way symmetry */
-    status = GLIB_drawLineH(pContext, xCenter - x, yCenter + y, xCenter + x);
-    if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
-      return status;
-    }
-    if (status == GLIB_OK) {
-      drawnElements++;
-    }
-
-    status = GLIB_drawLineH(pContext, xCenter - y, yCenter + x, xCenter + y);
-    if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
-      return status;
-    }
-    if (status == GLIB_OK) {
-      drawnElements++;
-    }
-
-    status = GLIB_drawLineH(pContext, xCenter - x, yCenter - y, xCenter + x);
-    if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
-      return status;
-    }
-    if (status == GLIB_OK) {
-      drawnElements++;
+    /* The rows at +-x get a span of half width y. Every x is visited once. */
+    if ((x > 0) && (x < y)) {
+      status = GLIB_drawCircleFilledRows(&spans, xCenter, yCenter, x, y);
+      if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
+        return status;
+      }
     }
 
-    status = GLIB_drawLineH(pContext, xCenter - y, yCenter - x, xCenter + y);
-    if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
-      return status;
-    }
-    if (status == GLIB_OK) {
-      drawnElements++;
+    /* The rows at +-y get a span of half width x, which grows while y stays
+     * the same. Draw them on the last step before y moves on. */
+    if (((x + 1 >= y) || (d >= 0)) && (y >= x) && (y > 0)) {
+      status = GLIB_drawCircleFilledRows(&spans, xCenter, yCenter, y, x);
+      if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
+        return status;
+      }
     }
 
     x++;
   }
-  return ((drawnElements == 0) ? GLIB_ERROR_NOTHING_TO_DRAW : GLIB_OK);
+  return GLIB_spansEnd(&spans);
 }
 
 /**************************************************************************//**
@@ -275,3 +265,39 @@ static EMSTATUS GLIB_drawPartialCirclePoints(GLIB_Context_t *pContext,
   }
   return ((drawnElements == 0) ? GLIB_ERROR_NOTHING_TO_DRAW : GLIB_OK);
 }
+
+/**************************************************************************//**
+*  @brief
+*  Fills the two rows at yCenter +- row of a filled circle
+*
+*  @param pSpans
+*  Pointer to the span emitter of the circle
+*  @param xCenter
+*  Center x-coordinate
+*  @param yCenter
+*  Center y-coordinate
+*  @param row
+*  Row offset from the center, greater than zero
+*  @param halfWidth
+*  Half width of the spans
+*
+*  @return
+*  Returns GLIB_OK on success, or else error code. Rows outside of the clipping
+*  region are skipped.
+******************************************************************************/
+static EMSTATUS GLIB_drawCircleFilledRows(GLIB_Spans_t *pSpans,
+                                          int32_t xCenter, int32_t yCenter,
+                                          int32_t row, int32_t halfWidth)
+{
+  EMSTATUS status;
+
+  status = GLIB_spansFill(pSpans, xCenter - halfWidth, yCenter + row, xCenter + halfWidth);
+  if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
+    return status;
+  }
+  status = GLIB_spansFill(pSpans, xCenter - halfWidth, yCenter - row, xCenter + halfWidth);
+  if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
+    return status;
+  }
+  return GLIB_OK;
+}
@@ -57,6 +57,9 @@ EMSTATUS GLIB_drawLineH(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
   uint8_t green;
   uint8_t blue;
   uint32_t length;
+#if defined(DMD_RASTER_1BPP)
+  const DMD_Raster1bpp *raster;
+#endif
 
   /* Check arguments */
   if (pContext == NULL) {
@@ -90,6 +93,14 @@ EMSTATUS GLIB_drawLineH(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
 
   /* Translate color and draw line using display driver */
   length = x2 - x1 + 1;
+#if defined(DMD_RASTER_1BPP)
+  status = DMD_getRaster1bpp(&raster);
+  if (status != DMD_OK) {
+    return status;
+  }
+  GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
+  return DMD_raster1bppFillRect(x1, y1, length, 1, DMD_raster1bppFill(raster, green));
+#else
   status = DMD_setClippingArea(x1, y1, length, 1);
   if (status != DMD_OK) {
     return status;
@@ -103,6 +114,7 @@ EMSTATUS GLIB_drawLineH(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
 
   /* Reset driver clipping area to GLIB clipping region */
   return GLIB_applyClippingRegion(pContext);
+#endif
 }
 
 /**************************************************************************//**
@@ -131,6 +143,9 @@ EMSTATUS GLIB_drawLineV(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
   uint8_t red;
   uint8_t green;
   uint8_t blue;
+#if defined(DMD_RASTER_1BPP)
+  const DMD_Raster1bpp *raster;
+#endif
 
   /* Check arguments */
   if (pContext == NULL) {
@@ -164,6 +179,14 @@ EMSTATUS GLIB_drawLineV(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
 
   /* Translate color and draw line using display driver clipping (width = 1 => height <=> length) */
   length = y2 - y1 + 1;
+#if defined(DMD_RASTER_1BPP)
+  status = DMD_getRaster1bpp(&raster);
+  if (status != DMD_OK) {
+    return status;
+  }
+  GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
+  return DMD_raster1bppFillRect(x1, y1, 1, length, DMD_raster1bppFill(raster, green));
+#else
   status = DMD_setClippingArea(x1, y1, 1, length);
   if (status != DMD_OK) {
     return status;
@@ -177,6 +200,7 @@ EMSTATUS GLIB_drawLineV(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
 
   /* Reset driver clipping area to GLIB clipping region */
   return GLIB_applyClippingRegion(pContext);
+#endif
 }
 
 /**************************************************************************//**
@@ -345,6 +369,15 @@ EMSTATUS GLIB_drawLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
   int32_t xMotion;
   bool steepLine = false;
   int32_t yStep = 1;
+#if defined(DMD_RASTER_1BPP)
+  const DMD_Raster1bpp *raster;
+  uint8_t red;
+  uint8_t green;
+  uint8_t blue;
+  uint8_t fill;
+  int32_t rowFirst;
+  int32_t rowLast;
+#endif
 
   /* Check arguments */
   if (pContext == NULL) {
@@ -366,6 +399,20 @@ EMSTATUS GLIB_drawLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
     return GLIB_ERROR_NOTHING_TO_DRAW;
   }
 
+#if defined(DMD_RASTER_1BPP)
+  /* The clipped line stays inside the clipping region, so the pixels are
+   * plotted into the raster without further checks and the rows they touch
+   * are marked dirty once at the end */
+  status = DMD_getRaster1bpp(&raster);
+  if (status != DMD_OK) {
+    return status;
+  }
+  GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
+  fill     = DMD_raster1bppFill(raster, green);
+  rowFirst = (y1 < y2) ? y1 : y2;
+  rowLast  = (y1 < y2) ? y2 : y1;
+#endif
+
   /* Determine if steep or not steep
    * (Steep means more motion in Y-direction than X-direction) */
   yMotion = (y2 > y1) ? (y2 - y1) : (y1 - y2);
@@ -410,6 +457,14 @@ EMSTATUS GLIB_drawLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
 
   /* Loop through all points along the x-axis */
   for (; x1 <= x2; x1++) {
+#if defined(DMD_RASTER_1BPP)
+    if (steepLine) {
+      /* If steep, swap x and y coordinates */
+      DMD_raster1bppPlot(raster, y1, x1, fill);
+    } else {
+      DMD_raster1bppPlot(raster, x1, y1, fill);
+    }
+#else
     if (steepLine) {
       /* If steep, swap x and y coordinates */
       status = GLIB_drawPixel(pContext, y1, x1);
@@ -420,6 +475,7 @@ EMSTATUS GLIB_drawLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
     if (status != GLIB_OK) {
       return status;
     }
+#endif
 
     error += deltaY;
 
@@ -429,5 +485,9 @@ EMSTATUS GLIB_drawLine(GLIB_Context_t *pContext, int32_t x1, int32_t y1,
     }
   }
 
+#if defined(DMD_RASTER_1BPP)
+  return DMD_raster1bppMarkDirty(rowFirst, rowLast);
+#else
   return GLIB_OK;
+#endif
 }
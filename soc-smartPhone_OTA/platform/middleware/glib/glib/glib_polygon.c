@@ -29,6 +29,19 @@ enum {
   MAX_CROSSES = 64, /* Maximum intersection points (arbitrary limit) */
 };
 
+/* Polygon edge in the edge table of the scan line fill */
+typedef struct {
+  int32_t x;      /* X-coordinate on the current row, 16.16 fixed point */
+  int32_t dxdy;   /* X increment per row, 16.16 fixed point */
+  int32_t yStart; /* First row crossed by the edge */
+  int32_t yEnd;   /* Row after the last row crossed by the edge */
+} GLIB_PolygonEdge_t;
+
+/* Edge table, sorted by start row, and the indices of the active edges,
+ * sorted by x. They are kept off the stack because of their size. */
+static GLIB_PolygonEdge_t edgeTable[MAX_CROSSES];
+static uint8_t activeEdges[MAX_CROSSES];
+
 /**************************************************************************//**
  * @brief
  * Draws a polygon using Bresnham's Midpoint Line Algorithm.
@@ -106,11 +119,13 @@ EMSTATUS GLIB_drawPolygon(GLIB_Context_t *pContext,
 
 /**************************************************************************//**
  * @brief
- * Draws a filled polygon using a scan line algorithm.
+ * Draws a filled polygon using an active edge table scan line algorithm.
  *
  * This function draws a line between all points outlining the polygon.
  * The first and last point doesn't have to be the same. The function
  * automatically draws a line from the start point to the end point.
+ * The rows strictly between the top and the bottom point are filled,
+ * the top and bottom rows are left to the outline.
  *
  * @param pContext
  *   Pointer to a GLIB_Context_t where the polygon is drawn.
@@ -128,12 +143,15 @@ EMSTATUS GLIB_drawPolygon(GLIB_Context_t *pContext,
 EMSTATUS GLIB_drawPolygonFilled(GLIB_Context_t *pContext,
                                 uint32_t numPoints, const int32_t *polyPoints)
 {
-  size_t i, j, numcrosses;
-  int32_t clip_y0 = pContext->clippingRegion.yMin;
-  int32_t clip_y1 = pContext->clippingRegion.yMax;
-  int32_t cur_y, min_y, max_y;
-  int32_t cross_x[MAX_CROSSES];
+  EMSTATUS status;
+  GLIB_Spans_t spans;
+  GLIB_PolygonEdge_t edge;
+  uint32_t i, j, numEdges, numActive, nextEdge;
+  int32_t clip_y0;
+  int32_t clip_y1;
+  int32_t cur_y, min_y, max_y, bottom_y;
   int32_t curpoint_y, curpoint_x, prvpoint_y, prvpoint_x;
+  uint8_t index;
 
   /* Check arguments */
   if (pContext == NULL || polyPoints == NULL || numPoints < 2
@@ -141,42 +159,116 @@ EMSTATUS GLIB_drawPolygonFilled(GLIB_Context_t *pContext,
     return GLIB_ERROR_INVALID_ARGUMENT;
   }
 
-  /* Find bounding box (respecting clipping region) */
-  min_y = max_y = polyPoints[1];
-  for (i = 1; i < numPoints; i++) {
-    cur_y = polyPoints[2 * i + 1];
-    min_y = (cur_y < min_y) ? cur_y : min_y;
-    max_y = (cur_y > max_y) ? cur_y : max_y;
+  clip_y0 = pContext->clippingRegion.yMin;
+  clip_y1 = pContext->clippingRegion.yMax;
+
+  /* Build the edge table. An edge crosses the rows below its upper end point
+   * down to and including its lower end point. Horizontal edges and edges
+   * outside of the clipping region are left out, and the edges that start
+   * above the clipping region are advanced to its first row. */
+  numEdges = 0;
+  min_y = clip_y1 + 1;
+  max_y = clip_y0 - 1;
+  bottom_y = clip_y0 - 1;
+  j = numPoints - 1;
+  for (i = 0; i < numPoints; i++) {
+    curpoint_x = polyPoints[i * 2];
+    curpoint_y = polyPoints[i * 2 + 1];
+    prvpoint_x = polyPoints[j * 2];
+    prvpoint_y = polyPoints[j * 2 + 1];
+    j = i;
+
+    if (curpoint_y == prvpoint_y) {
+      continue;
+    }
+    if (curpoint_y > prvpoint_y) {
+      edge.yStart = prvpoint_y;
+      edge.yEnd   = curpoint_y;
+      edge.x      = prvpoint_x;
+      edge.dxdy   = curpoint_x - prvpoint_x;
+    } else {
+      edge.yStart = curpoint_y;
+      edge.yEnd   = prvpoint_y;
+      edge.x      = curpoint_x;
+      edge.dxdy   = prvpoint_x - curpoint_x;
+    }
+    bottom_y = (edge.yEnd > bottom_y) ? edge.yEnd : bottom_y;
+    if ((edge.yEnd < clip_y0) || (edge.yStart >= clip_y1)) {
+      continue;
+    }
+
+    /* Fixed point x on the start row, rounded to the nearest pixel */
+    cur_y = (edge.yStart < clip_y0) ? clip_y0 : edge.yStart + 1;
+    edge.x = (int32_t) (((int64_t) edge.x * 65536)
+                        + ((int64_t) edge.dxdy * 65536) * (cur_y - edge.yStart)
+                        / (edge.yEnd - edge.yStart)
+                        + 0x8000);
+    edge.dxdy = (int32_t) (((int64_t) edge.dxdy * 65536) / (edge.yEnd - edge.yStart));
+    edge.yStart = cur_y;
+    edge.yEnd++;
+
+    min_y = (edge.yStart < min_y) ? edge.yStart : min_y;
+    max_y = (edge.yEnd - 1 > max_y) ? edge.yEnd - 1 : max_y;
+
+    /* Insert the edge sorted by start row */
+    for (j = numEdges; (j > 0) && (edgeTable[j - 1].yStart > edge.yStart); j--) {
+      edgeTable[j] = edgeTable[j - 1];
+    }
+    edgeTable[j] = edge;
+    numEdges++;
+    j = i;
   }
-  min_y = (min_y < clip_y0) ? clip_y0 : min_y;
+  /* The bottom row of the polygon is left out, like its top row */
+  max_y = (max_y >= bottom_y) ? bottom_y - 1 : max_y;
   max_y = (max_y > clip_y1) ? clip_y1 : max_y;
 
-  /* Find intersection points */
-  for (cur_y = min_y; cur_y < max_y; cur_y++) {
-    /* Find where the current line intersects each 2-tuple */
-    numcrosses = 0;
-    j = numPoints - 1;
-    for (i = 0; i < numPoints; i++) {
-      curpoint_y = polyPoints[i * 2 + 1];
-      prvpoint_y = polyPoints[j * 2 + 1];
-      if ((curpoint_y < cur_y && prvpoint_y >= cur_y)
-          || (prvpoint_y < cur_y && curpoint_y >= cur_y)) {
-        curpoint_x = polyPoints[i * 2];
-        prvpoint_x = polyPoints[j * 2];
-        cross_x[numcrosses] = (int) (curpoint_x
-                                     + (cur_y - curpoint_y)
-                                     / (float)(prvpoint_y - curpoint_y)
-                                     * (float) (prvpoint_x - curpoint_x));
-        numcrosses++;
+  status = GLIB_spansBegin(&spans, pContext);
+  if (status != GLIB_OK) {
+    return status;
+  }
+
+  /* Walk the rows, keeping the list of the edges that cross the current row
+   * sorted by x. The edges move little from one row to the next, so the
+   * insertion sort mostly just verifies the order. */
+  numActive = 0;
+  nextEdge = 0;
+  for (cur_y = min_y; cur_y <= max_y; cur_y++) {
+    /* Drop the edges that ended on the previous row */
+    for (i = 0, j = 0; i < numActive; i++) {
+      if (edgeTable[activeEdges[i]].yEnd > cur_y) {
+        activeEdges[j++] = activeEdges[i];
+      }
+    }
+    numActive = j;
+
+    /* Add the edges that start on this row */
+    while ((nextEdge < numEdges) && (edgeTable[nextEdge].yStart == cur_y)) {
+      activeEdges[numActive++] = nextEdge++;
+    }
+
+    for (i = 1; i < numActive; i++) {
+      index = activeEdges[i];
+      for (j = i; (j > 0) && (edgeTable[activeEdges[j - 1]].x > edgeTable[index].x); j--) {
+        activeEdges[j] = activeEdges[j - 1];
       }
-      j = i;
+      activeEdges[j] = index;
     }
 
-    /* Draw horizontal lines between intersection point 2-tuples */
-    for (i = 0; i < numcrosses; i += 2) {
-      GLIB_drawLineH(pContext, cross_x[i], cur_y, cross_x[i + 1]);
+    /* Fill between the pairs of crossings, then step the edges to the next row */
+    for (i = 0; i + 1 < numActive; i += 2) {
+      status = GLIB_spansFill(&spans,
+                              edgeTable[activeEdges[i]].x >> 16,
+                              cur_y,
+                              edgeTable[activeEdges[i + 1]].x >> 16);
+      if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
+        return status;
+      }
+    }
+    for (i = 0; i < numActive; i++) {
+      edgeTable[activeEdges[i]].x += edgeTable[activeEdges[i]].dxdy;
     }
   }
 
-  return GLIB_OK;
+  status = GLIB_spansEnd(&spans);
+  return (status == GLIB_ERROR_NOTHING_TO_DRAW) ? GLIB_OK : status;
 }
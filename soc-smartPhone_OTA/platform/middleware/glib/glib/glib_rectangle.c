@@ -175,6 +175,9 @@ EMSTATUS GLIB_drawRectFilled(GLIB_Context_t *pContext, const GLIB_Rectangle_t *p
   uint8_t blue;
   int32_t width;
   int32_t height;
+#if defined(DMD_RASTER_1BPP)
+  const DMD_Raster1bpp *raster;
+#endif
   GLIB_Rectangle_t tmpRectangle = *pRect;
 
   GLIB_normalizeRect(&tmpRectangle);
@@ -199,6 +202,17 @@ EMSTATUS GLIB_drawRectFilled(GLIB_Context_t *pContext, const GLIB_Rectangle_t *p
   width  = tmpRectangle.xMax - tmpRectangle.xMin + 1;
   height = tmpRectangle.yMax - tmpRectangle.yMin + 1;
 
+#if defined(DMD_RASTER_1BPP)
+  if ((width <= 0) || (height <= 0)) {
+    return GLIB_ERROR_NOTHING_TO_DRAW;
+  }
+  status = DMD_getRaster1bpp(&raster);
+  if (status != DMD_OK) {
+    return status;
+  }
+  return DMD_raster1bppFillRect(tmpRectangle.xMin, tmpRectangle.yMin, width, height,
+                                DMD_raster1bppFill(raster, green));
+#else
   status = DMD_setClippingArea(tmpRectangle.xMin, tmpRectangle.yMin, width, height);
   if (status != DMD_OK) {
     return status;
@@ -211,4 +225,5 @@ EMSTATUS GLIB_drawRectFilled(GLIB_Context_t *pContext, const GLIB_Rectangle_t *p
 
   /* Reset driver clipping area to GLIB clipping region */
   return GLIB_applyClippingRegion(pContext);
+#endif
 }
@@ -0,0 +1,158 @@
+/***************************************************************************//**
+ * @file
+ * @brief Silicon Labs Graphics Library: Horizontal Span Routines
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc.  Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.  This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* Standard C header files */
+#include <stdint.h>
+
+/* EM types */
+#include "em_types.h"
+
+/* GLIB header files */
+#include "glib.h"
+
+/**************************************************************************//**
+*  @brief
+*  Starts emitting the spans of a filled shape in the foreground color.
+*
+*  @param pSpans
+*  Pointer to the span emitter state
+*  @param pContext
+*  Pointer to a GLIB_Context_t which holds the foreground color and clipping
+*  region
+*
+*  @return
+*  Returns GLIB_OK on success, or else error code
+******************************************************************************/
+EMSTATUS GLIB_spansBegin(GLIB_Spans_t *pSpans, GLIB_Context_t *pContext)
+{
+#if defined(DMD_RASTER_1BPP)
+  EMSTATUS status;
+  uint8_t red;
+  uint8_t green;
+  uint8_t blue;
+#endif
+
+  /* Check arguments */
+  if ((pSpans == NULL) || (pContext == NULL)) {
+    return GLIB_ERROR_INVALID_ARGUMENT;
+  }
+
+  pSpans->pContext = pContext;
+  pSpans->yFirst   = 0;
+  pSpans->yLast    = -1;
+
+#if defined(DMD_RASTER_1BPP)
+  status = DMD_getRaster1bpp(&pSpans->raster);
+  if (status != DMD_OK) {
+    return status;
+  }
+  GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
+  pSpans->fill = DMD_raster1bppFill(pSpans->raster, green);
+#endif
+
+  return GLIB_OK;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Fills the pixels x1 to x2 of row y, clipped to the clipping region.
+*
+*  @param pSpans
+*  Pointer to the span emitter state
+*  @param x1
+*  Start x-coordinate
+*  @param y
+*  Y-coordinate
+*  @param x2
+*  End x-coordinate, inclusive
+*
+*  @return
+*  Returns GLIB_OK on success, GLIB_ERROR_NOTHING_TO_DRAW if the span is
+*  outside of the clipping region, or else error code
+******************************************************************************/
+EMSTATUS GLIB_spansFill(GLIB_Spans_t *pSpans, int32_t x1, int32_t y,
+                        int32_t x2)
+{
+  const GLIB_Rectangle_t *pClip = &pSpans->pContext->clippingRegion;
+  int32_t swap;
+
+  /* Check if the span is outside of the clipping region */
+  if ((y < pClip->yMin) || (y > pClip->yMax)) {
+    return GLIB_ERROR_NOTHING_TO_DRAW;
+  }
+
+  /* Swap the coordinates if x1 is larger than x2 */
+  if (x1 > x2) {
+    swap = x1;
+    x1   = x2;
+    x2   = swap;
+  }
+
+  if ((x1 > pClip->xMax) || (x2 < pClip->xMin)) {
+    return GLIB_ERROR_NOTHING_TO_DRAW;
+  }
+
+  /* Clip the span if necessary */
+  if (x1 < pClip->xMin) {
+    x1 = pClip->xMin;
+  }
+  if (x2 > pClip->xMax) {
+    x2 = pClip->xMax;
+  }
+
+  /* Track the rows that have been drawn */
+  if (pSpans->yLast < pSpans->yFirst) {
+    pSpans->yFirst = y;
+    pSpans->yLast  = y;
+  } else if (y < pSpans->yFirst) {
+    pSpans->yFirst = y;
+  } else if (y > pSpans->yLast) {
+    pSpans->yLast = y;
+  }
+
+#if defined(DMD_RASTER_1BPP)
+  DMD_raster1bppFillSpan(pSpans->raster, x1, y, x2 - x1 + 1, pSpans->fill);
+  return GLIB_OK;
+#else
+  return GLIB_drawLineH(pSpans->pContext, x1, y, x2);
+#endif
+}
+
+/**************************************************************************//**
+*  @brief
+*  Finishes a filled shape. With a monochrome display the rows that were
+*  drawn are marked dirty here, once for the whole shape.
+*
+*  @param pSpans
+*  Pointer to the span emitter state
+*
+*  @return
+*  Returns GLIB_OK if at least one span was drawn, GLIB_ERROR_NOTHING_TO_DRAW
+*  if none was, or else error code
+******************************************************************************/
+EMSTATUS GLIB_spansEnd(GLIB_Spans_t *pSpans)
+{
+  if (pSpans->yLast < pSpans->yFirst) {
+    return GLIB_ERROR_NOTHING_TO_DRAW;
+  }
+
+#if defined(DMD_RASTER_1BPP)
+  return DMD_raster1bppMarkDirty(pSpans->yFirst, pSpans->yLast);
+#else
+  return GLIB_OK;
+#endif
+}
@@ -0,0 +1,524 @@
+/***************************************************************************//**
+ * @file
+ * @brief Silicon Labs Graphics Library: Font Atlas Text Routines
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc.  Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.  This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+
+/* Standard C header files */
+#include <stdint.h>
+#include <stdbool.h>
+
+/* EM types */
+#include "em_types.h"
+
+/* GLIB header files */
+#include "glib.h"
+
+/** Number of string extents kept by GLIB_measureText() */
+#ifndef GLIB_TEXT_CACHE_SIZE
+#define GLIB_TEXT_CACHE_SIZE  8
+#endif
+
+/** @brief Cached extent of a string */
+typedef struct __GLIB_TextExtent_t{
+  /** Atlas the string was measured with, NULL if the entry is unused */
+  const GLIB_FontAtlas_t *pAtlas;
+
+  /** Address and length of the string */
+  const char *pString;
+  uint32_t sLength;
+
+  /** Hash of the characters, a buffer that is reused for a new string misses */
+  uint32_t hash;
+
+  /** Extent of the string in pixels */
+  uint16_t width;
+  uint16_t height;
+} GLIB_TextExtent_t;
+
+/** @brief State of a text being drawn */
+typedef struct __GLIB_TextTarget_t{
+  GLIB_Context_t *pContext;
+
+#if defined(DMD_RASTER_1BPP)
+  /** Raster of the active framebuffer */
+  const DMD_Raster1bpp *raster;
+
+  /** Raster fill bytes for the foreground and background colors */
+  uint8_t fill;
+  uint8_t background;
+#endif
+
+  /** First and last row drawn, yLast is less than yFirst while nothing is drawn */
+  int32_t yFirst;
+  int32_t yLast;
+} GLIB_TextTarget_t;
+
+static GLIB_TextExtent_t textCache[GLIB_TEXT_CACHE_SIZE];
+static uint8_t textCacheNext;
+
+/**************************************************************************//**
+*  @brief
+*  Looks up the glyph of a char in a font atlas.
+******************************************************************************/
+static const GLIB_Glyph_t *GLIB_atlasGlyph(const GLIB_FontAtlas_t *pAtlas,
+                                           char myChar)
+{
+  uint8_t glyphIdx;
+
+  if ((myChar < pAtlas->firstChar) || (myChar > pAtlas->lastChar)) {
+    return NULL;
+  }
+  glyphIdx = pAtlas->pCharMap[myChar - pAtlas->firstChar];
+  if (glyphIdx == 0xff) {
+    return NULL;
+  }
+  return &pAtlas->pGlyphs[glyphIdx];
+}
+
+/**************************************************************************//**
+*  @brief
+*  Returns the kerning adjustment of a pair of chars, the pairs are sorted so
+*  they are searched by bisection.
+******************************************************************************/
+static int32_t GLIB_atlasKerning(const GLIB_FontAtlas_t *pAtlas, char left,
+                                 char right)
+{
+  const GLIB_KerningPair_t *pPair;
+  uint32_t lo = 0;
+  uint32_t hi = pAtlas->numKerning;
+  uint32_t mid;
+  int32_t  diff;
+
+  while (lo < hi) {
+    mid   = (lo + hi) / 2;
+    pPair = &pAtlas->pKerning[mid];
+    diff  = (pPair->left != left) ? (pPair->left - left) : (pPair->right - right);
+    if (diff == 0) {
+      return pPair->adjust;
+    } else if (diff < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return 0;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Returns the pen advance after a char, including the kerning with the next
+*  char of the same line.
+******************************************************************************/
+static int32_t GLIB_atlasAdvance(const GLIB_FontAtlas_t *pAtlas,
+                                 const GLIB_Glyph_t *pGlyph,
+                                 const char *pString, uint32_t index,
+                                 uint32_t sLength)
+{
+  int32_t advance = pGlyph->advance;
+
+  if ((pAtlas->numKerning != 0) && (index + 1 < sLength)
+      && (pString[index + 1] != '\n')) {
+    advance += GLIB_atlasKerning(pAtlas, pString[index], pString[index + 1]);
+  }
+  return advance;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Measures a string without the cache.
+******************************************************************************/
+static EMSTATUS GLIB_textExtent(const GLIB_FontAtlas_t *pAtlas,
+                                const char *pString, uint32_t sLength,
+                                uint32_t *pWidth, uint32_t *pHeight)
+{
+  const GLIB_Glyph_t *pGlyph;
+  uint32_t stringIndex;
+  uint32_t lines = 1;
+  int32_t  width = 0;
+  int32_t  maxWidth = 0;
+
+  for (stringIndex = 0; stringIndex < sLength; stringIndex++) {
+    if (pString[stringIndex] == '\n') {
+      width = 0;
+      lines++;
+      continue;
+    }
+    pGlyph = GLIB_atlasGlyph(pAtlas, pString[stringIndex]);
+    if (pGlyph == NULL) {
+      return GLIB_ERROR_INVALID_CHAR;
+    }
+    width += GLIB_atlasAdvance(pAtlas, pGlyph, pString, stringIndex, sLength);
+    if (width > maxWidth) {
+      maxWidth = width;
+    }
+  }
+
+  *pWidth  = maxWidth;
+  *pHeight = lines * pAtlas->height + (lines - 1) * pAtlas->lineSpacing;
+  return GLIB_OK;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Marks a row as drawn.
+******************************************************************************/
+static void GLIB_textTrackRow(GLIB_TextTarget_t *pTarget, int32_t y)
+{
+  if (pTarget->yLast < pTarget->yFirst) {
+    pTarget->yFirst = y;
+    pTarget->yLast  = y;
+  } else if (y < pTarget->yFirst) {
+    pTarget->yFirst = y;
+  } else if (y > pTarget->yLast) {
+    pTarget->yLast = y;
+  }
+}
+
+/**************************************************************************//**
+*  @brief
+*  Fills the background of a glyph cell with the background color.
+******************************************************************************/
+static EMSTATUS GLIB_textFillCell(GLIB_TextTarget_t *pTarget, int32_t x,
+                                  int32_t y, int32_t width, int32_t height)
+{
+  const GLIB_Rectangle_t *pClip = &pTarget->pContext->clippingRegion;
+  int32_t xMin = (x > pClip->xMin) ? x : pClip->xMin;
+  int32_t yMin = (y > pClip->yMin) ? y : pClip->yMin;
+  int32_t xMax = (x + width - 1 < pClip->xMax) ? x + width - 1 : pClip->xMax;
+  int32_t yMax = (y + height - 1 < pClip->yMax) ? y + height - 1 : pClip->yMax;
+  int32_t row;
+#if !defined(DMD_RASTER_1BPP)
+  EMSTATUS status;
+  int32_t col;
+#endif
+
+  for (row = yMin; row <= yMax; row++) {
+    if (xMin > xMax) {
+      break;
+    }
+    GLIB_textTrackRow(pTarget, row);
+#if defined(DMD_RASTER_1BPP)
+    DMD_raster1bppFillSpan(pTarget->raster, xMin, row, xMax - xMin + 1,
+                           pTarget->background);
+#else
+    for (col = xMin; col <= xMax; col++) {
+      status = GLIB_drawPixelColor(pTarget->pContext, col, row,
+                                   pTarget->pContext->backgroundColor);
+      if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
+        return status;
+      }
+    }
+#endif
+  }
+  return GLIB_OK;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Draws the ink of a glyph in the foreground color. With a monochrome
+*  display each byte of a glyph row is shifted into place and written to the
+*  two framebuffer bytes it covers.
+******************************************************************************/
+static EMSTATUS GLIB_textDrawGlyph(GLIB_TextTarget_t *pTarget,
+                                   const GLIB_FontAtlas_t *pAtlas,
+                                   const GLIB_Glyph_t *pGlyph,
+                                   int32_t x, int32_t y)
+{
+  const GLIB_Rectangle_t *pClip = &pTarget->pContext->clippingRegion;
+  const uint8_t *pSrc;
+  uint32_t bytesPerRow = (pGlyph->width + 7) / 8;
+  int32_t  row;
+  int32_t  col;
+  int32_t  rowFirst;
+  int32_t  rowLast;
+  uint32_t byteIdx;
+  uint8_t  bits;
+#if defined(DMD_RASTER_1BPP)
+  const DMD_Raster1bpp *raster = pTarget->raster;
+  uint8_t  *pDst;
+  uint16_t mask;
+  int32_t  clip;
+#else
+  EMSTATUS status;
+  uint32_t bit;
+#endif
+
+  x += pGlyph->xOffset;
+  y += pGlyph->yOffset;
+
+  rowFirst = (y > pClip->yMin) ? 0 : pClip->yMin - y;
+  rowLast  = (y + pGlyph->height - 1 < pClip->yMax)
+             ? pGlyph->height - 1 : pClip->yMax - y;
+  if ((pGlyph->width == 0) || (x > pClip->xMax)
+      || (x + pGlyph->width - 1 < pClip->xMin)) {
+    return GLIB_ERROR_NOTHING_TO_DRAW;
+  }
+
+  for (row = rowFirst; row <= rowLast; row++) {
+    pSrc = pAtlas->pBits + pGlyph->offset + row * bytesPerRow;
+    GLIB_textTrackRow(pTarget, y + row);
+
+    for (byteIdx = 0; byteIdx < bytesPerRow; byteIdx++) {
+      bits = pSrc[byteIdx];
+      col  = x + 8 * byteIdx;
+
+#if defined(DMD_RASTER_1BPP)
+      /* Mask the pixels outside of the clipping region */
+      clip = pClip->xMin - col;
+      if (clip > 0) {
+        bits = (clip < 8) ? (bits & (0xff << clip)) : 0;
+      }
+      clip = col + 7 - pClip->xMax;
+      if (clip > 0) {
+        bits = (clip < 8) ? (bits & (0xff >> clip)) : 0;
+      }
+      if (bits == 0) {
+        continue;
+      }
+      if (col < 0) {
+        bits >>= -col;
+        col    = 0;
+      }
+
+      mask = (uint16_t)bits << (col & 0x7);
+      pDst = raster->pBits + (y + row) * raster->bytesPerRow + (col >> 3);
+      pDst[0] = (pDst[0] & ~mask) | (pTarget->fill & mask);
+      mask >>= 8;
+      if (mask != 0) {
+        pDst[1] = (pDst[1] & ~mask) | (pTarget->fill & mask);
+      }
+#else
+      for (bit = 0; bits != 0; bit++, bits >>= 1) {
+        if (bits & 0x1) {
+          status = GLIB_drawPixel(pTarget->pContext, col + bit, y + row);
+          if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
+            return status;
+          }
+        }
+      }
+#endif
+    }
+  }
+  return GLIB_OK;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Measures a string drawn with a font atlas. The width is the widest line,
+*  including the advance of its last char. The most recent extents are cached
+*  by string address, length and contents, so measuring the same string
+*  every frame costs a hash of its characters.
+*
+*  @param pAtlas
+*  Pointer to the font atlas
+*
+*  @param pString
+*  Pointer to the string that is measured
+*
+*  @param sLength
+*  number of characters in the string
+*
+*  @param pWidth
+*  Returns the width of the string in pixels
+*
+*  @param pHeight
+*  Returns the height of the string in pixels
+*
+*  @return
+*  Returns GLIB_OK on success, GLIB_ERROR_INVALID_CHAR if the atlas has no
+*  glyph for a char, or else error code
+******************************************************************************/
+EMSTATUS GLIB_measureText(const GLIB_FontAtlas_t *pAtlas, const char *pString,
+                          uint32_t sLength, uint32_t *pWidth, uint32_t *pHeight)
+{
+  EMSTATUS status;
+  GLIB_TextExtent_t *pEntry;
+  uint32_t hash = 2166136261u;
+  uint32_t stringIndex;
+  uint32_t i;
+
+  /* Check arguments */
+  if ((pAtlas == NULL) || (pString == NULL) || (pWidth == NULL)
+      || (pHeight == NULL)) {
+    return GLIB_ERROR_INVALID_ARGUMENT;
+  }
+
+  /* FNV-1a hash of the characters */
+  for (stringIndex = 0; stringIndex < sLength; stringIndex++) {
+    hash = (hash ^ (uint8_t)pString[stringIndex]) * 16777619u;
+  }
+
+  for (i = 0; i < GLIB_TEXT_CACHE_SIZE; i++) {
+    pEntry = &textCache[i];
+    if ((pEntry->pAtlas == pAtlas) && (pEntry->pString == pString)
+        && (pEntry->sLength == sLength) && (pEntry->hash == hash)) {
+      *pWidth  = pEntry->width;
+      *pHeight = pEntry->height;
+      return GLIB_OK;
+    }
+  }
+
+  status = GLIB_textExtent(pAtlas, pString, sLength, pWidth, pHeight);
+  if (status != GLIB_OK) {
+    return status;
+  }
+
+  /* Replace the oldest entry */
+  pEntry = &textCache[textCacheNext];
+  textCacheNext = (textCacheNext + 1) % GLIB_TEXT_CACHE_SIZE;
+  pEntry->pAtlas  = pAtlas;
+  pEntry->pString = pString;
+  pEntry->sLength = sLength;
+  pEntry->hash    = hash;
+  pEntry->width   = *pWidth;
+  pEntry->height  = *pHeight;
+
+  return GLIB_OK;
+}
+
+/**************************************************************************//**
+*  @brief
+*  Draws a string using a font atlas. Each line of the string is aligned on
+*  the x-coordinate on its own. With a monochrome display the glyph rows are
+*  written straight into the framebuffer and the rows are marked dirty once
+*  for the whole string.
+*
+*  @param pContext
+*  Pointer to a GLIB_Context_t
+*
+*  @param pAtlas
+*  Pointer to the font atlas
+*
+*  @param pString
+*  Pointer to the string that is drawn
+*
+*  @param sLength
+*  number of characters in the string
+*
+*  @param x
+*  X-coordinate the lines are aligned on
+*
+*  @param y
+*  Y-coordinate of the top of the first line
+*
+*  @param align
+*  Horizontal alignment of each line
+*
+*  @param opaque
+*  Determines whether to show the background or color it with the background
+*  color specified by the GLIB_Context_t. If opaque == true, the background
+*  color is used for the cell of each char.
+*
+*  @return
+*  Returns GLIB_OK on success, or else error code
+******************************************************************************/
+EMSTATUS GLIB_drawText(GLIB_Context_t *pContext, const GLIB_FontAtlas_t *pAtlas,
+                       const char *pString, uint32_t sLength, int32_t x,
+                       int32_t y, GLIB_Align_t align, bool opaque)
+{
+  EMSTATUS status;
+  GLIB_TextTarget_t target;
+  const GLIB_Glyph_t *pGlyph;
+  uint32_t stringIndex;
+  uint32_t lineLength;
+  uint32_t width;
+  uint32_t height;
+  int32_t  advance;
+  int32_t  penX = 0;
+  bool     lineStart = true;
+#if defined(DMD_RASTER_1BPP)
+  uint8_t  red;
+  uint8_t  green;
+  uint8_t  blue;
+#endif
+
+  /* Check arguments */
+  if ((pContext == NULL) || (pAtlas == NULL) || (pString == NULL)) {
+    return GLIB_ERROR_INVALID_ARGUMENT;
+  }
+
+  target.pContext = pContext;
+  target.yFirst   = 0;
+  target.yLast    = -1;
+
+#if defined(DMD_RASTER_1BPP)
+  status = DMD_getRaster1bpp(&target.raster);
+  if (status != DMD_OK) {
+    return status;
+  }
+  GLIB_colorTranslate24bpp(pContext->foregroundColor, &red, &green, &blue);
+  target.fill = DMD_raster1bppFill(target.raster, green);
+  GLIB_colorTranslate24bpp(pContext->backgroundColor, &red, &green, &blue);
+  target.background = DMD_raster1bppFill(target.raster, green);
+#endif
+
+  for (stringIndex = 0; stringIndex < sLength; stringIndex++) {
+    /* Newline char */
+    if (pString[stringIndex] == '\n') {
+      y += pAtlas->height + pAtlas->lineSpacing;
+      lineStart = true;
+      continue;
+    }
+
+    /* Align the line */
+    if (lineStart) {
+      lineStart = false;
+      penX = x;
+      if (align != GLIB_ALIGN_LEFT) {
+        for (lineLength = 0; stringIndex + lineLength < sLength; lineLength++) {
+          if (pString[stringIndex + lineLength] == '\n') {
+            break;
+          }
+        }
+        status = GLIB_measureText(pAtlas, &pString[stringIndex], lineLength,
+                                  &width, &height);
+        if (status != GLIB_OK) {
+          return status;
+        }
+        penX -= (align == GLIB_ALIGN_CENTER) ? (int32_t)(width / 2) : (int32_t)width;
+      }
+    }
+
+    pGlyph = GLIB_atlasGlyph(pAtlas, pString[stringIndex]);
+    if (pGlyph == NULL) {
+      return GLIB_ERROR_INVALID_CHAR;
+    }
+    advance = GLIB_atlasAdvance(pAtlas, pGlyph, pString, stringIndex, sLength);
+
+    if (opaque && (advance > 0)) {
+      status = GLIB_textFillCell(&target, penX, y, advance, pAtlas->height);
+      if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
+        return status;
+      }
+    }
+
+    status = GLIB_textDrawGlyph(&target, pAtlas, pGlyph, penX, y);
+    if (status > GLIB_ERROR_NOTHING_TO_DRAW) {
+      return status;
+    }
+
+    penX += advance;
+  }
+
+  if (target.yLast < target.yFirst) {
+    return GLIB_ERROR_NOTHING_TO_DRAW;
+  }
+
+#if defined(DMD_RASTER_1BPP)
+  return DMD_raster1bppMarkDirty(target.yFirst, target.yLast);
+#else
+  return GLIB_OK;
+#endif
+}
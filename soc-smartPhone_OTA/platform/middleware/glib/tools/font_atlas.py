@@ -0,0 +1,226 @@
+#!/usr/bin/env python3
+"""Font atlas compiler for the Silicon Labs Graphics Library (GLIB).
+
+Reads a GLIB pixel map font (glib_font_*.c) and writes a GLIB_FontAtlas_t:
+every glyph is trimmed to its ink box and stored as rows of whole bytes,
+bit 0 being the leftmost pixel, so a glyph row can be shifted straight into
+the 1bpp framebuffer. A width table gives the pen advance of each glyph and
+an optional kerning table adjusts the advance of character pairs.
+
+Usage:
+  font_atlas.py glib_font_narrow_6x8.c GLIB_AtlasNarrow6x8 \\
+      -o glib_atlas_narrow_6x8.c [--proportional] [--kerning pairs.txt]
+
+By default the advance is the cell width of the source font plus its
+character spacing, which keeps the layout of GLIB_drawString() and gives
+tabular digits. With --proportional the advance is the ink width plus one
+pixel, and half a cell for glyphs without ink.
+
+The kerning file has one pair per line, "<left><right> <adjust>", for
+example "T. -1". Lines starting with '#' are ignored.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+LICENSE = """\
+/***************************************************************************//**
+ * @file
+ * @brief Silicon Labs Graphics Library: {brief}
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc.  Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement.  This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+"""
+
+NUMBERS_ONLY_CHARS = "0123456789: "
+
+
+def parse_font(path):
+    """Returns (glyph rows by character, cell width, height, line spacing, char spacing)."""
+    with open(path) as f:
+        text = f.read()
+
+    pixmap = re.search(r"uint(8|16|32)_t\s+\w+\[\]\s*=\s*\{(.*?)\};", text, re.S)
+    if not pixmap:
+        sys.exit("%s: no pixel map found" % path)
+    values = [int(v, 0) for v in re.findall(r"0x[0-9a-fA-F]+|\d+", pixmap.group(2))]
+
+    font = re.search(r"GLIB_Font_t\s+\w+\s*=\s*\{(.*?)\};", text, re.S)
+    if not font:
+        sys.exit("%s: no GLIB_Font_t definition found" % path)
+    fields = [v.strip() for v in font.group(1).split(",")]
+    row_offset, width, height, line_spacing, char_spacing = [int(v, 0) for v in fields[3:8]]
+    font_class = fields[8]
+
+    if font_class == "NumbersOnlyFont":
+        chars = NUMBERS_ONLY_CHARS
+    else:
+        chars = "".join(chr(c) for c in range(ord(" "), ord("~") + 1))
+
+    glyphs = {}
+    for index, char in enumerate(chars):
+        if index >= row_offset:
+            break
+        glyphs[char] = [values[row * row_offset + index] for row in range(height)]
+    return glyphs, width, height, line_spacing, char_spacing
+
+
+def parse_kerning(path):
+    pairs = []
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if not line.strip() or line.startswith("#"):
+                continue
+            if len(line) < 4 or line[2] != " ":
+                sys.exit("%s: bad kerning line '%s'" % (path, line))
+            pairs.append((line[0], line[1], int(line[3:])))
+    return sorted(pairs)
+
+
+def ink_box(rows, width):
+    """Returns (x, y, w, h) of the set pixels, or None for a blank glyph."""
+    columns = 0
+    for row in rows:
+        columns |= row
+    columns &= (1 << width) - 1
+    used_rows = [i for i, row in enumerate(rows) if row & columns]
+    if not columns:
+        return None
+    x0 = (columns & -columns).bit_length() - 1
+    x1 = columns.bit_length() - 1
+    return x0, used_rows[0], x1 - x0 + 1, used_rows[-1] - used_rows[0] + 1
+
+
+def c_char(char):
+    if char in "\\'":
+        return "'\\%s'" % char
+    return "'%s'" % char
+
+
+def compile_atlas(args):
+    glyphs, cell_width, height, line_spacing, char_spacing = parse_font(args.font)
+    kerning = parse_kerning(args.kerning) if args.kerning else []
+
+    chars = sorted(glyphs)
+    first, last = chars[0], chars[-1]
+
+    bits = []
+    table = []
+    char_map = [0xff] * (ord(last) - ord(first) + 1)
+    for char in chars:
+        rows = glyphs[char]
+        box = ink_box(rows, cell_width)
+        if box is None:
+            x, y, w, h = 0, 0, 0, 0
+        else:
+            x, y, w, h = box
+        offset = len(bits)
+        for row in rows[y:y + h]:
+            packed = (row >> x) & ((1 << w) - 1)
+            for i in range((w + 7) // 8):
+                bits.append((packed >> (8 * i)) & 0xff)
+
+        # With a proportional layout the ink starts at the pen position
+        if args.proportional:
+            advance = (w + 1) if box else (cell_width + 1) // 2
+            x = 0
+        else:
+            advance = cell_width + char_spacing
+
+        if offset > 0xffff:
+            sys.exit("atlas too large")
+        char_map[ord(char) - ord(first)] = len(table)
+        table.append((offset, w, h, x, y, advance, char))
+
+    name = args.name
+    out = []
+    out.append(LICENSE.format(brief="%s font atlas" % name))
+    out.append("/* This file is generated by tools/font_atlas.py from %s, do not edit. */"
+               % os.path.basename(args.font))
+    out.append("")
+    out.append("/* Standard C header files */")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("/* GLIB header files */")
+    out.append("#include \"glib.h\"")
+    out.append("")
+    out.append("/** @brief Packed glyph rows of the \"%s\" atlas. */" % name)
+    out.append("static const uint8_t %sBits[] =" % name)
+    out.append("{")
+    for i in range(0, len(bits), 12):
+        chunk = ", ".join("0x%02x" % b for b in bits[i:i + 12])
+        out.append("  " + chunk + ("," if i + 12 < len(bits) else ""))
+    out.append("};")
+    out.append("")
+    out.append("/** @brief Glyphs of the \"%s\" atlas. */" % name)
+    out.append("static const GLIB_Glyph_t %sGlyphs[] =" % name)
+    out.append("{")
+    for i, (offset, w, h, x, y, advance, char) in enumerate(table):
+        sep = "," if i + 1 < len(table) else " "
+        out.append("  { %4d, %2d, %2d, %2d, %2d, %2d }%s /* %s */"
+                   % (offset, w, h, x, y, advance, sep, c_char(char)))
+    out.append("};")
+    out.append("")
+    out.append("/** @brief Glyph index of each character from %s, 0xff if missing. */"
+               % c_char(first))
+    out.append("static const uint8_t %sCharMap[] =" % name)
+    out.append("{")
+    for i in range(0, len(char_map), 12):
+        chunk = ", ".join("0x%02x" % b for b in char_map[i:i + 12])
+        out.append("  " + chunk + ("," if i + 12 < len(char_map) else ""))
+    out.append("};")
+    out.append("")
+    if kerning:
+        out.append("/** @brief Kerning pairs of the \"%s\" atlas, sorted. */" % name)
+        out.append("static const GLIB_KerningPair_t %sKerning[] =" % name)
+        out.append("{")
+        for i, (left, right, adjust) in enumerate(kerning):
+            sep = "," if i + 1 < len(kerning) else ""
+            out.append("  { %s, %s, %d }%s" % (c_char(left), c_char(right), adjust, sep))
+        out.append("};")
+        out.append("")
+    out.append("/**")
+    out.append(" * @brief %s atlas compiled from %s."
+               % ("Proportional" if args.proportional else "Fixed width",
+                  os.path.basename(args.font)))
+    out.append(" */")
+    out.append("const GLIB_FontAtlas_t %s = { %sBits," % (name, name))
+    indent = " " * len("const GLIB_FontAtlas_t %s = { " % name)
+    out.append("%s%sGlyphs," % (indent, name))
+    out.append("%s%sCharMap," % (indent, name))
+    if kerning:
+        out.append("%s%sKerning, %d," % (indent, name, len(kerning)))
+    else:
+        out.append("%sNULL, 0," % indent)
+    out.append("%s%s, %s, %d, %d };" % (indent, c_char(first), c_char(last), height, line_spacing))
+
+    with open(args.output, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("font", help="GLIB pixel map font source file")
+    parser.add_argument("name", help="name of the GLIB_FontAtlas_t to define")
+    parser.add_argument("-o", "--output", required=True, help="atlas source file to write")
+    parser.add_argument("--proportional", action="store_true",
+                        help="advance by the ink width instead of the cell width")
+    parser.add_argument("--kerning", help="kerning pair file")
+    compile_atlas(parser.parse_args())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,465 @@
+/*
+ * Encrypted sensor broadcast test.
+ *
+ * Runs beacon.c in encrypted sensor broadcast mode with the CRYPTO block
+ * replaced by a software AES-128 that chains and counts the way the CRYPTO
+ * block does, and checks the frames against a plain AES-CCM written from
+ * RFC 3610:
+ *
+ *   vectors   the reference AES and AES-CCM reproduce FIPS-197 C.1, RFC 3610
+ *             packet vectors 1 and 2 and NIST SP 800-38C example 1, the
+ *             last one with a 4 byte MIC as the beacon uses
+ *   frames    100000 frames from random addresses, sequence counters and
+ *             readings carry the readings and the MIC of the reference
+ *             CCM over the nonce of beacon.h, with the frame header in
+ *             the clear and the counter one up from the previous frame
+ *   tamper    a frame with any bit of the readings flipped fails the MIC
+ *
+ * Build and run from the project directory:
+ *   gcc -O2 -DHOST -DBGM13S22F512GA=1 -I. -Iapp/bluetooth/common/util \
+ *     -Iplatform/CMSIS/Include -Iplatform/Device/SiliconLabs/BGM13/Include \
+ *     -Iplatform/emlib/inc -Iprotocol/bluetooth/ble_stack/inc/common \
+ *     -Iprotocol/bluetooth/ble_stack/inc/soc -o beacon_test tools/beacon_test.c && ./beacon_test
+ *
+ * The file sits on the firmware source path, without HOST it compiles to nothing.
+ */
+
+#ifdef HOST
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* the key of RFC 3610 packet vector 1 */
+#define BCN_BROADCAST_MODE                  1
+#define BCN_BROADCAST_ENCRYPT               1
+#define BCN_BROADCAST_KEY \
+  0xC0, 0xC1, 0xC2, 0xC3, 0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xCB, 0xCC, 0xCD, 0xCE, 0xCF
+
+#include "beacon.c"
+
+#define FRAMES          100000
+
+static unsigned failures;
+
+#define CHECK(cond, ...)            \
+  do {                              \
+    if (!(cond)) {                  \
+      fprintf(stderr, "%s: ", hostScenario); \
+      fprintf(stderr, __VA_ARGS__); \
+      fputc('\n', stderr);          \
+      failures++;                   \
+    }                               \
+  } while (0)
+
+static const char *hostScenario;
+
+/* command and response of the stack commands */
+static uint32_t hostCmd[64];
+static uint32_t hostRsp[64];
+void *gecko_cmd_msg_buf = hostCmd;
+void *gecko_rsp_msg_buf = hostRsp;
+
+/* what the stack answers */
+static uint8_t hostAddress[6];
+static uint32_t hostRandom;
+static bool hostAtomic;
+
+static unsigned long seed;
+
+static uint32_t rnd(uint32_t n)
+{
+  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (uint32_t)((seed >> 33) % n);
+}
+
+/***************************************************************************************************
+ * Reference AES-128 and AES-CCM
+ **************************************************************************************************/
+
+static const uint8_t sbox[256] = {
+  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+  0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+  0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+  0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+  0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+  0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+  0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+  0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+  0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+  0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+  0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16
+};
+
+static uint8_t xtime(uint8_t x)
+{
+  return (uint8_t)((x << 1) ^ ((x & 0x80) ? 0x1b : 0));
+}
+
+static void aesEncrypt(const uint8_t key[16], const uint8_t in[16], uint8_t out[16])
+{
+  uint8_t rk[16];
+  uint8_t s[16];
+  uint8_t t[16];
+  uint8_t rcon = 1;
+  unsigned round, i, c;
+
+  memcpy(rk, key, 16);
+  for (i = 0; i < 16; i++) {
+    s[i] = in[i] ^ rk[i];
+  }
+  for (round = 1; round <= 10; round++) {
+    /* next round key */
+    rk[0] ^= sbox[rk[13]] ^ rcon;
+    rk[1] ^= sbox[rk[14]];
+    rk[2] ^= sbox[rk[15]];
+    rk[3] ^= sbox[rk[12]];
+    for (i = 4; i < 16; i++) {
+      rk[i] ^= rk[i - 4];
+    }
+    rcon = xtime(rcon);
+
+    /* SubBytes and ShiftRows */
+    for (i = 0; i < 16; i++) {
+      t[i] = sbox[s[(i + 4 * (i % 4)) % 16]];
+    }
+    /* MixColumns, except in the last round */
+    for (c = 0; c < 16; c += 4) {
+      uint8_t all = t[c] ^ t[c + 1] ^ t[c + 2] ^ t[c + 3];
+
+      for (i = 0; i < 4; i++) {
+        s[c + i] = t[c + i];
+        if (round < 10) {
+          s[c + i] ^= all ^ xtime(t[c + i] ^ t[c + (i + 1) % 4]);
+        }
+      }
+    }
+    for (i = 0; i < 16; i++) {
+      s[i] ^= rk[i];
+    }
+  }
+  memcpy(out, s, 16);
+}
+
+/* AES-CCM of RFC 3610, out gets the ciphertext followed by the micLen byte MIC */
+static void ccm(const uint8_t key[16], const uint8_t *nonce, unsigned nonceLen, const uint8_t *aad,
+                unsigned aadLen, const uint8_t *msg, unsigned msgLen, unsigned micLen, uint8_t *out)
+{
+  unsigned lenLen = 15 - nonceLen;
+  uint8_t x[16] = { 0 };
+  uint8_t b[16];
+  uint8_t a[16];
+  uint8_t s[16];
+  unsigned i, pos, n;
+
+  /* CBC-MAC over B0, the associated data with its length, and the message */
+  b[0] = (uint8_t)(((aadLen > 0) << 6) | (((micLen - 2) / 2) << 3) | (lenLen - 1));
+  memcpy(&b[1], nonce, nonceLen);
+  for (i = 0; i < lenLen; i++) {
+    b[15 - i] = (uint8_t)((uint64_t)msgLen >> (8 * i));
+  }
+  for (i = 0; i < 16; i++) {
+    x[i] ^= b[i];
+  }
+  aesEncrypt(key, x, x);
+
+  if (aadLen > 0) {
+    memset(b, 0, 16);
+    b[0] = (uint8_t)(aadLen >> 8);
+    b[1] = (uint8_t)aadLen;
+    pos = 2;
+    for (i = 0; i < aadLen; i++) {
+      b[pos++] = aad[i];
+      if ((pos == 16) || (i == aadLen - 1)) {
+        for (n = 0; n < 16; n++) {
+          x[n] ^= b[n];
+        }
+        aesEncrypt(key, x, x);
+        memset(b, 0, 16);
+        pos = 0;
+      }
+    }
+  }
+  for (pos = 0; pos < msgLen; pos += 16) {
+    for (i = 0; (i < 16) && (pos + i < msgLen); i++) {
+      x[i] ^= msg[pos + i];
+    }
+    aesEncrypt(key, x, x);
+  }
+
+  /* CTR from A1 over the message, S0 over the MIC */
+  memset(a, 0, 16);
+  a[0] = (uint8_t)(lenLen - 1);
+  memcpy(&a[1], nonce, nonceLen);
+  for (pos = 0; pos < msgLen; pos += 16) {
+    n = pos / 16 + 1;
+    a[14] = (uint8_t)(n >> 8);
+    a[15] = (uint8_t)n;
+    aesEncrypt(key, a, s);
+    for (i = 0; (i < 16) && (pos + i < msgLen); i++) {
+      out[pos + i] = msg[pos + i] ^ s[i];
+    }
+  }
+  a[14] = 0;
+  a[15] = 0;
+  aesEncrypt(key, a, s);
+  for (i = 0; i < micLen; i++) {
+    out[msgLen + i] = x[i] ^ s[i];
+  }
+}
+
+/***************************************************************************************************
+ * CRYPTO block, CMU, CORE and stack
+ **************************************************************************************************/
+
+void CRYPTO_AES_CBC128(CRYPTO_TypeDef *crypto, uint8_t *out, const uint8_t *in, unsigned int len,
+                       const uint8_t *key, const uint8_t *iv, bool encrypt)
+{
+  uint8_t x[16];
+  unsigned pos, i;
+
+  (void)crypto;
+  CHECK(hostAtomic, "CRYPTO used outside a critical section");
+  CHECK(encrypt && !(len % 16), "CBC decryption or a partial block");
+  memcpy(x, iv, 16);
+  for (pos = 0; pos < len; pos += 16) {
+    for (i = 0; i < 16; i++) {
+      x[i] ^= in[pos + i];
+    }
+    aesEncrypt(key, x, x);
+    memcpy(&out[pos], x, 16);
+  }
+}
+
+/* the CRYPTO block counts in the last 32 bits, big endian, and hands the counter back */
+void CRYPTO_AES_CTR128(CRYPTO_TypeDef *crypto, uint8_t *out, const uint8_t *in, unsigned int len,
+                       const uint8_t *key, uint8_t *ctr, CRYPTO_AES_CtrFuncPtr_TypeDef ctrFunc)
+{
+  uint8_t s[16];
+  uint32_t count;
+  unsigned pos, i;
+
+  (void)crypto;
+  CHECK(hostAtomic, "CRYPTO used outside a critical section");
+  CHECK(!ctrFunc && !(len % 16), "counter function or a partial block");
+  for (pos = 0; pos < len; pos += 16) {
+    aesEncrypt(key, ctr, s);
+    for (i = 0; i < 16; i++) {
+      out[pos + i] = in[pos + i] ^ s[i];
+    }
+    count = ((uint32_t)ctr[12] << 24) | ((uint32_t)ctr[13] << 16) | ((uint32_t)ctr[14] << 8) | ctr[15];
+    count++;
+    ctr[12] = (uint8_t)(count >> 24);
+    ctr[13] = (uint8_t)(count >> 16);
+    ctr[14] = (uint8_t)(count >> 8);
+    ctr[15] = (uint8_t)count;
+  }
+}
+
+void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable)
+{
+  (void)clock;
+  (void)enable;
+}
+
+CORE_irqState_t CORE_EnterAtomic(void)
+{
+  hostAtomic = true;
+  return 0;
+}
+
+void CORE_ExitAtomic(CORE_irqState_t irqState)
+{
+  (void)irqState;
+  hostAtomic = false;
+}
+
+void sli_bt_cmd_handler_delegate(uint32_t header, gecko_cmd_handler handler, const void *payload)
+{
+  (void)header;
+  handler(payload);
+}
+
+void sli_bt_cmd_system_get_random_data(const void *payload)
+{
+  struct gecko_cmd_packet *rsp = gecko_rsp_msg_buf;
+
+  (void)payload;
+  rsp->data.rsp_system_get_random_data.result = 0;
+  rsp->data.rsp_system_get_random_data.data.len = sizeof(hostRandom);
+  memcpy(rsp->data.rsp_system_get_random_data.data.data, &hostRandom, sizeof(hostRandom));
+}
+
+void sli_bt_cmd_system_get_bt_address(const void *payload)
+{
+  struct gecko_cmd_packet *rsp = gecko_rsp_msg_buf;
+
+  (void)payload;
+  memcpy(rsp->data.rsp_system_get_bt_address.address.addr, hostAddress, sizeof(hostAddress));
+}
+
+/***************************************************************************************************
+ * Scenarios
+ **************************************************************************************************/
+
+static void vectors(void)
+{
+  static const uint8_t fipsKey[16] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+  };
+  static const uint8_t fipsIn[16] = {
+    0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+  };
+  static const uint8_t fipsOut[16] = {
+    0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+  };
+  static const uint8_t rfcKey[16] = { BCN_BROADCAST_KEY };
+  static const uint8_t rfcNonce1[13] = {
+    0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5
+  };
+  static const uint8_t rfcOut1[31] = {
+    0x58, 0x8c, 0x97, 0x9a, 0x61, 0xc6, 0x63, 0xd2, 0xf0, 0x66, 0xd0, 0xc2, 0xc0, 0xf9, 0x89, 0x80,
+    0x6d, 0x5f, 0x6b, 0x61, 0xda, 0xc3, 0x84, 0x17, 0xe8, 0xd1, 0x2c, 0xfd, 0xf9, 0x26, 0xe0
+  };
+  static const uint8_t rfcNonce2[13] = {
+    0x00, 0x00, 0x00, 0x04, 0x03, 0x02, 0x01, 0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5
+  };
+  static const uint8_t rfcOut2[32] = {
+    0x72, 0xc9, 0x1a, 0x36, 0xe1, 0x35, 0xf8, 0xcf, 0x29, 0x1c, 0xa8, 0x94, 0x08, 0x5c, 0x87, 0xe3,
+    0xcc, 0x15, 0xc4, 0x39, 0xc9, 0xe4, 0x3a, 0x3b, 0xa0, 0x91, 0xd5, 0x6e, 0x10, 0x40, 0x09, 0x16
+  };
+  static const uint8_t nistKey[16] = {
+    0x40, 0x41, 0x42, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49, 0x4a, 0x4b, 0x4c, 0x4d, 0x4e, 0x4f
+  };
+  static const uint8_t nistNonce[7] = { 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16 };
+  static const uint8_t nistMsg[4] = { 0x20, 0x21, 0x22, 0x23 };
+  static const uint8_t nistOut[8] = { 0x71, 0x62, 0x01, 0x5b, 0x4d, 0xac, 0x25, 0x5d };
+  uint8_t packet[32];
+  uint8_t out[40];
+  unsigned i;
+
+  hostScenario = "vectors";
+  aesEncrypt(fipsKey, fipsIn, out);
+  CHECK(!memcmp(out, fipsOut, 16), "FIPS-197 C.1");
+
+  for (i = 0; i < sizeof(packet); i++) {
+    packet[i] = (uint8_t)i;
+  }
+  ccm(rfcKey, rfcNonce1, 13, packet, 8, &packet[8], 23, 8, out);
+  CHECK(!memcmp(out, rfcOut1, sizeof(rfcOut1)), "RFC 3610 packet vector 1");
+  ccm(rfcKey, rfcNonce2, 13, packet, 8, &packet[8], 24, 8, out);
+  CHECK(!memcmp(out, rfcOut2, sizeof(rfcOut2)), "RFC 3610 packet vector 2");
+  ccm(nistKey, nistNonce, 7, packet, 8, nistMsg, 4, 4, out);
+  CHECK(!memcmp(out, nistOut, sizeof(nistOut)), "SP 800-38C example 1");
+}
+
+static void frames(void)
+{
+  static const uint8_t key[16] = { BCN_BROADCAST_KEY };
+  const uint8_t *adv;
+  uint8_t len;
+  uint8_t nonce[BCN_NONCE_LEN];
+  uint8_t plain[BCN_SENSOR_DATA_LEN];
+  uint8_t expect[BCN_SENSOR_DATA_LEN + BCN_MIC_LEN];
+  uint32_t seq = 0;
+  int32_t temperature;
+  uint32_t humidity;
+  uint8_t battery;
+  unsigned long frame;
+  unsigned i;
+
+  hostScenario = "frames";
+  for (frame = 0; frame < FRAMES; frame++) {
+    /* a new boot now and then */
+    if (!(frame % 1000)) {
+      for (i = 0; i < sizeof(hostAddress); i++) {
+        hostAddress[i] = (uint8_t)rnd(256);
+      }
+      hostRandom = (frame == 1000) ? 0xFFFFFFF0UL : rnd(0xFFFFFFFFUL);
+      bcnInit();
+      seq = hostRandom;
+    }
+
+    temperature = (int32_t)rnd(100001) - 40000;
+    humidity = rnd(100001);
+    battery = (uint8_t)rnd(101);
+    CHECK(bcnUpdateSensorData(temperature, humidity, battery), "frame %lu not changed", frame);
+    seq++;
+
+    adv = bcnGetAdvData(&len);
+    CHECK(len == 21, "frame %lu is %u bytes", frame, len);
+    CHECK((adv[3] == len - 4) && (adv[4] == 0xFF) && (adv[5] == 0xFF) && (adv[6] == 0x02)
+          && (adv[7] == BCN_FRAME_SENSOR_CCM), "frame %lu header", frame);
+    CHECK((adv[8] | (adv[9] << 8) | ((uint32_t)adv[10] << 16) | ((uint32_t)adv[11] << 24)) == seq,
+          "frame %lu counter", frame);
+
+    /* the nonce and the readings of beacon.h */
+    memcpy(&nonce[0], hostAddress, 6);
+    memcpy(&nonce[6], &adv[5], 3);
+    memcpy(&nonce[9], &adv[8], 4);
+    plain[0] = (uint8_t)(temperature / 10);
+    plain[1] = (uint8_t)((temperature / 10) >> 8);
+    plain[2] = (uint8_t)(humidity / 10);
+    plain[3] = (uint8_t)((humidity / 10) >> 8);
+    plain[4] = battery;
+    ccm(key, nonce, BCN_NONCE_LEN, NULL, 0, plain, BCN_SENSOR_DATA_LEN, BCN_MIC_LEN, expect);
+    CHECK(!memcmp(&adv[12], expect, sizeof(expect)), "frame %lu differs from the reference CCM",
+          frame);
+  }
+}
+
+static void tamper(void)
+{
+  static const uint8_t key[16] = { BCN_BROADCAST_KEY };
+  const uint8_t *adv;
+  uint8_t len;
+  uint8_t nonce[BCN_NONCE_LEN];
+  uint8_t frame[BCN_SENSOR_DATA_LEN + BCN_MIC_LEN];
+  uint8_t plain[BCN_SENSOR_DATA_LEN];
+  uint8_t check[BCN_SENSOR_DATA_LEN + BCN_MIC_LEN];
+  uint8_t s[16];
+  unsigned bit, i;
+
+  hostScenario = "tamper";
+  bcnUpdateSensorData(21500, 45000, 87);
+  adv = bcnGetAdvData(&len);
+  memcpy(&nonce[0], hostAddress, 6);
+  memcpy(&nonce[6], &adv[5], 3);
+  memcpy(&nonce[9], &adv[8], 4);
+
+  for (bit = 0; bit < 8 * BCN_SENSOR_DATA_LEN; bit++) {
+    memcpy(frame, &adv[12], sizeof(frame));
+    frame[bit / 8] ^= (uint8_t)(1 << (bit % 8));
+
+    /* decrypt with the keystream from A1, then recompute the MIC */
+    memset(s, 0, sizeof(s));
+    s[0] = BCN_CCM_FLAGS_A;
+    memcpy(&s[1], nonce, BCN_NONCE_LEN);
+    s[15] = 1;
+    aesEncrypt(key, s, s);
+    for (i = 0; i < BCN_SENSOR_DATA_LEN; i++) {
+      plain[i] = frame[i] ^ s[i];
+    }
+    ccm(key, nonce, BCN_NONCE_LEN, NULL, 0, plain, BCN_SENSOR_DATA_LEN, BCN_MIC_LEN, check);
+    CHECK(memcmp(&check[BCN_SENSOR_DATA_LEN], &frame[BCN_SENSOR_DATA_LEN], BCN_MIC_LEN),
+          "bit %u flipped and the MIC still matches", bit);
+  }
+}
+
+int main(void)
+{
+  seed = 0x2545F4914F6CDD1DULL;
+  vectors();
+  frames();
+  tamper();
+
+  printf("%u failures\n", failures);
+  return failures != 0;
+}
+
+#endif /* HOST */
@@ -0,0 +1,313 @@
+/*
+ * Calendar clock test.
+ *
+ * Runs app_clock.c on a simulated RTCC whose crystal is off by a given
+ * drift, against the true time kept by the test:
+ *
+ *   convert   appClockToDateTime() agrees with gmtime() on every day from
+ *             1970 to the end of the 32 bit range, at seconds spread over
+ *             the day and at every second of the first and the last day,
+ *             and appClockFromDateTime() turns every date back into the
+ *             same time
+ *   validate  appClockFromDateTime() accepts a date exactly when timegm()
+ *             leaves it unchanged, for every day 0 to 31 of every month
+ *             from 1969 to 2106, and rejects out of range times
+ *   trim      a clock set every 2 hours learns a 150 ppm drift and is then
+ *             within 5 ms of the true time over the next 72 hours, read
+ *             once an hour and across RTCC wraps
+ *   limits    a drift above APP_CLOCK_TRIM_MAX_PPM, a setting less than
+ *             APP_CLOCK_TRIM_MIN_S after the previous one, the first
+ *             setting and a jump of the time leave the trim alone
+ *
+ * Build and run from the project directory:
+ *   gcc -O2 -DHOST -DBGM13S22F512GA=1 -I. -Iplatform/CMSIS/Include \
+ *     -Iplatform/Device/SiliconLabs/BGM13/Include -Iplatform/emlib/inc \
+ *     -o clock_test tools/clock_test.c && ./clock_test
+ *
+ * The file sits on the firmware source path, without HOST it compiles to nothing.
+ */
+
+#ifdef HOST
+
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "em_device.h"
+
+/* the counter app_clock.c reads */
+static RTCC_TypeDef hostRtcc;
+#undef RTCC
+#define RTCC (&hostRtcc)
+
+#include "app_clock.c"
+
+#define FREQ            32768
+/* seconds in the 32 bit range, it ends on 2106-02-07 */
+#define RANGE           (1ULL << 32)
+
+static unsigned failures;
+
+#define CHECK(cond, ...)            \
+  do {                              \
+    if (!(cond)) {                  \
+      fprintf(stderr, "%s: ", hostScenario); \
+      fprintf(stderr, __VA_ARGS__); \
+      fputc('\n', stderr);          \
+      failures++;                   \
+    }                               \
+  } while (0)
+
+static const char *hostScenario;
+
+/* true time in RTCC ticks of a perfect crystal since the start of the scenario */
+static uint64_t hostTime;
+static uint32_t hostRtccStart;
+/* crystal error in ppm, positive runs fast */
+static double hostDriftPpm;
+
+/***************************************************************************************************
+ * Stubs
+ **************************************************************************************************/
+
+uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock)
+{
+  (void)clock;
+  return FREQ;
+}
+
+void appTimerStart(appTimer_t *timer, uint32_t timeoutMs, uint32_t slackMs, bool periodic,
+                   appTimerCback_t cback, void *arg)
+{
+  (void)timer;
+  (void)timeoutMs;
+  (void)slackMs;
+  (void)periodic;
+  (void)cback;
+  (void)arg;
+}
+
+static void hostSetTime(uint64_t time)
+{
+  hostTime = time;
+  hostRtcc.CNT = (uint32_t)(hostRtccStart + (uint64_t)(time * (1.0 + hostDriftPpm * 1e-6)));
+}
+
+static void hostReset(const char *scenario, uint32_t rtccStart, double driftPpm)
+{
+  hostScenario = scenario;
+  hostRtccStart = rtccStart;
+  hostDriftPpm = driftPpm;
+  hostSetTime(0);
+  appClockTrimPpb = 0;
+  appClockTrimRem = 0;
+  appClockRawSinceSet = 0;
+  appClockInit();
+}
+
+/* set the clock to the true time plus an offset in seconds, at a whole second */
+static void hostSetClock(uint32_t base, int32_t offset)
+{
+  appClockSet((uint32_t)(base + hostTime / FREQ + offset), 0);
+}
+
+/* clock minus true time in ms, the clock read the way app.c reads it */
+static double hostClockError(uint32_t base)
+{
+  uint32_t seconds = appClockGet(NULL);
+
+  return ((seconds - base) + (double)appClockTicks / FREQ - (double)hostTime / FREQ) * 1000.0;
+}
+
+/***************************************************************************************************
+ * Conversions
+ **************************************************************************************************/
+
+static void checkSecond(uint32_t time)
+{
+  time_t t = (time_t)time;
+  struct tm tm;
+  appClockDateTime_t dt;
+  uint32_t back = 0;
+
+  gmtime_r(&t, &tm);
+  appClockToDateTime(time, &dt);
+  CHECK((dt.year == tm.tm_year + 1900) && (dt.month == tm.tm_mon + 1) && (dt.day == tm.tm_mday)
+        && (dt.hours == tm.tm_hour) && (dt.minutes == tm.tm_min) && (dt.seconds == tm.tm_sec)
+        && (dt.weekday == (tm.tm_wday + 6) % 7 + 1),
+        "%lu is %04u-%02u-%02u %02u:%02u:%02u day %u, not %04d-%02d-%02d %02d:%02d:%02d day %d",
+        (unsigned long)time, dt.year, dt.month, dt.day, dt.hours, dt.minutes, dt.seconds,
+        dt.weekday, tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min,
+        tm.tm_sec, tm.tm_wday);
+
+  /* the conversion back stops at the end of 2105 */
+  if (dt.year <= 2105) {
+    CHECK(appClockFromDateTime(&dt, &back) && (back == time), "%lu comes back as %lu",
+          (unsigned long)time, (unsigned long)back);
+  }
+}
+
+static void convert(void)
+{
+  uint64_t day;
+  uint32_t second;
+
+  hostScenario = "convert";
+  for (day = 0; day < RANGE; day += APP_CLOCK_SECONDS_PER_DAY) {
+    /* a different second of the day each day, 86400 and 997 are coprime */
+    for (second = (uint32_t)(day / APP_CLOCK_SECONDS_PER_DAY % 997);
+         (second < APP_CLOCK_SECONDS_PER_DAY) && (day + second < RANGE); second += 997) {
+      checkSecond((uint32_t)(day + second));
+    }
+    checkSecond((uint32_t)day);
+  }
+  for (second = 0; second < APP_CLOCK_SECONDS_PER_DAY; second++) {
+    checkSecond(second);
+    checkSecond((uint32_t)(RANGE - 1 - second));
+  }
+}
+
+static void validate(void)
+{
+  appClockDateTime_t dt;
+  struct tm tm;
+  unsigned year, month, day;
+  uint32_t time;
+  bool valid;
+
+  hostScenario = "validate";
+  memset(&dt, 0, sizeof(dt));
+  for (year = 1969; year <= 2106; year++) {
+    for (month = 0; month <= 13; month++) {
+      for (day = 0; day <= 31; day++) {
+        memset(&tm, 0, sizeof(tm));
+        tm.tm_year = (int)year - 1900;
+        tm.tm_mon = (int)month - 1;
+        tm.tm_mday = (int)day;
+        timegm(&tm);
+        valid = (year >= 1970) && (year <= 2105) && (tm.tm_year == (int)year - 1900)
+                && (tm.tm_mon == (int)month - 1) && (tm.tm_mday == (int)day);
+
+        dt.year = (uint16_t)year;
+        dt.month = (uint8_t)month;
+        dt.day = (uint8_t)day;
+        dt.hours = 23;
+        dt.minutes = 59;
+        dt.seconds = 59;
+        CHECK(appClockFromDateTime(&dt, &time) == valid, "%04u-%02u-%02u %s", year, month, day,
+              valid ? "rejected" : "accepted");
+      }
+    }
+  }
+
+  dt.year = 2000;
+  dt.month = 2;
+  dt.day = 29;
+  dt.hours = 24;
+  CHECK(!appClockFromDateTime(&dt, &time), "hour 24 accepted");
+  dt.hours = 0;
+  dt.minutes = 60;
+  CHECK(!appClockFromDateTime(&dt, &time), "minute 60 accepted");
+  dt.minutes = 0;
+  dt.seconds = 60;
+  CHECK(!appClockFromDateTime(&dt, &time), "second 60 accepted");
+}
+
+/***************************************************************************************************
+ * Trim
+ **************************************************************************************************/
+
+/* set the clock every 2 hours for 6 hours, then run free for 72 hours */
+static void trim(const char *scenario, uint32_t rtccStart, double driftPpm)
+{
+  const uint32_t base = 1600000000UL;
+  double error;
+  double worst = 0;
+  unsigned hour;
+
+  hostReset(scenario, rtccStart, driftPpm);
+  hostSetTime(12345ULL * FREQ);
+  hostSetClock(base, 0);
+  for (hour = 1; hour <= 6; hour++) {
+    hostSetTime(hostTime + 3600ULL * FREQ);
+    appClockGet(NULL);
+    if (!(hour % 2)) {
+      hostSetClock(base, 0);
+    }
+  }
+  CHECK((appClockTrimPpb > -(driftPpm + 1) * 1000) && (appClockTrimPpb < -(driftPpm - 1) * 1000),
+        "trim %ld ppb for a drift of %.0f ppm", (long)appClockTrimPpb, driftPpm);
+
+  for (hour = 1; hour <= 72; hour++) {
+    hostSetTime(hostTime + 3600ULL * FREQ + (hour * 7919ULL) % FREQ);
+    error = hostClockError(base);
+    if (error < 0) {
+      error = -error;
+    }
+    if (error > worst) {
+      worst = error;
+    }
+  }
+  CHECK(worst < 5.0, "%.2f ms off after the trim", worst);
+}
+
+static void limits(void)
+{
+  const uint32_t base = 1600000000UL;
+
+  /* a crystal this far off is taken as a series of time changes */
+  hostReset("limits", 0, 400);
+  hostSetClock(base, 0);
+  hostSetTime(hostTime + 4 * 3600ULL * FREQ);
+  hostSetClock(base, 0);
+  CHECK(appClockTrimPpb == 0, "trim %ld ppb for a drift above the limit", (long)appClockTrimPpb);
+
+  /* nothing to compare the first setting with */
+  hostReset("limits", 0, 100);
+  hostSetTime(4 * 3600ULL * FREQ);
+  CHECK(!appClockIsSet(), "set before the first setting");
+  hostSetClock(base, 0);
+  CHECK(appClockIsSet() && (appClockTrimPpb == 0), "trim %ld ppb after the first setting",
+        (long)appClockTrimPpb);
+
+  /* too short to tell the drift from the resolution of the setting */
+  hostSetTime(hostTime + (APP_CLOCK_TRIM_MIN_S - 1ULL) * FREQ);
+  hostSetClock(base, 0);
+  CHECK(appClockTrimPpb == 0, "trim %ld ppb after %u s", (long)appClockTrimPpb,
+        APP_CLOCK_TRIM_MIN_S - 1);
+
+  /* a time zone change is not drift */
+  hostSetTime(hostTime + 4 * 3600ULL * FREQ);
+  hostSetClock(base, 3600);
+  CHECK(appClockTrimPpb == 0, "trim %ld ppb after a time change", (long)appClockTrimPpb);
+
+  /* the fraction of a second */
+  hostReset("limits", 0, 0);
+  appClockSet(base, 128);
+  hostSetTime(FREQ / 4);
+  {
+    uint8_t fractions;
+    uint32_t seconds = appClockGet(&fractions);
+
+    CHECK((seconds == base) && (fractions == 192), "%lu and %u/256 s", (unsigned long)seconds,
+          fractions);
+  }
+}
+
+int main(void)
+{
+  convert();
+  validate();
+  trim("trim", 0, 150);
+  trim("trim", 0, -150);
+  trim("trim wrap", 0xFFFFFFFFUL - 3600UL * FREQ, 150);
+  limits();
+
+  printf("%u failures\n", failures);
+  return failures != 0;
+}
+
+#endif /* HOST */
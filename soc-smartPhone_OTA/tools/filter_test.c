@@ -0,0 +1,223 @@
+/*
+ * Decimating filter test.
+ *
+ * Checks the CIC decimator of app_filter.c against a direct convolution with
+ * its impulse response, APP_FILTER_CIC_ORDER boxcars of the ratio convolved,
+ * summed in 64 bits:
+ *
+ *   ratio     appFilterCicInit() rounds the ratio down to a power of 2 and
+ *             clamps it to APP_FILTER_CIC_MAX_RATIO
+ *   dc        a constant input comes out unchanged after the warmup
+ *   random    every output of random input at every ratio, over enough
+ *             samples for the integrators to wrap
+ *   extremes  the largest input range the gain allows, alternating ends
+ *
+ * and then times appFilterCicPut() as host time per input sample.
+ *
+ * Build and run from the project directory:
+ *   gcc -O2 -DHOST -I. -o filter_test tools/filter_test.c app_filter.c && ./filter_test
+ *
+ * The file sits on the firmware source path, without HOST it compiles to nothing.
+ */
+
+#ifdef HOST
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "app_filter.h"
+
+#define SAMPLES         (1UL << 20)
+#define BENCH_RUNS      10000000UL
+
+static unsigned failures;
+
+#define CHECK(cond, ...)            \
+  do {                              \
+    if (!(cond)) {                  \
+      fprintf(stderr, __VA_ARGS__); \
+      fputc('\n', stderr);          \
+      failures++;                   \
+    }                               \
+  } while (0)
+
+static int32_t input[SAMPLES];
+static int64_t response[APP_FILTER_CIC_ORDER * APP_FILTER_CIC_MAX_RATIO];
+
+static double now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* impulse response of the filter before the shift, returns its length */
+static unsigned impulse(unsigned ratio)
+{
+  int64_t next[APP_FILTER_CIC_ORDER * APP_FILTER_CIC_MAX_RATIO];
+  unsigned len = 1;
+  unsigned stage, i, k;
+
+  response[0] = 1;
+  for (stage = 0; stage < APP_FILTER_CIC_ORDER; stage++) {
+    memset(next, 0, sizeof(next));
+    for (i = 0; i < len; i++) {
+      for (k = 0; k < ratio; k++) {
+        next[i + k] += response[i];
+      }
+    }
+    len += ratio - 1;
+    memcpy(response, next, len * sizeof(response[0]));
+  }
+  return len;
+}
+
+static unsigned log2u(unsigned v)
+{
+  unsigned n = 0;
+
+  while (v >>= 1) {
+    n++;
+  }
+  return n;
+}
+
+/* feed input[0..count) and compare every output with the convolution */
+static void check_ratio(uint8_t ratio, unsigned long count, const char *what)
+{
+  appFilterCic_t filter;
+  unsigned len = impulse(ratio);
+  unsigned shift = log2u(ratio) * APP_FILTER_CIC_ORDER;
+  unsigned long n, outputs = 0;
+  int32_t output;
+  unsigned k;
+
+  appFilterCicInit(&filter, ratio);
+  for (n = 0; n < count; n++) {
+    bool got = appFilterCicPut(&filter, input[n], &output);
+    /* an output after every ratio inputs, once the warmup outputs are dropped */
+    bool want = ((n + 1) % ratio == 0) && ((n + 1) / ratio > APP_FILTER_CIC_ORDER);
+
+    CHECK(got == want, "%s ratio %u: output %s after sample %lu", what, ratio,
+          got ? "unexpected" : "missing", n);
+    if (got && want) {
+      int64_t sum = 0;
+
+      for (k = 0; (k < len) && (k <= n); k++) {
+        sum += response[k] * input[n - k];
+      }
+      /* floor division, as the arithmetic shift of the filter */
+      sum = (sum >= 0) ? (sum >> shift) : -((-sum + (1LL << shift) - 1) >> shift);
+      CHECK(output == (int32_t)sum, "%s ratio %u: output %lu is %d, want %lld", what, ratio,
+            outputs, output, (long long)sum);
+      outputs++;
+    }
+  }
+}
+
+static void test_ratio(void)
+{
+  static const struct {
+    uint8_t ratio;
+    uint8_t want;
+  } cases[] = {
+    { 0, 1 }, { 1, 1 }, { 2, 2 }, { 3, 2 }, { 8, 8 }, { 100, 64 }, { 128, 128 }, { 129, 128 },
+    { 255, 128 }
+  };
+  appFilterCic_t filter;
+  unsigned i;
+
+  for (i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    appFilterCicInit(&filter, cases[i].ratio);
+    CHECK((filter.ratio == cases[i].want)
+          && (filter.shift == log2u(cases[i].want) * APP_FILTER_CIC_ORDER),
+          "ratio: %u gives %u shift %u, want %u", cases[i].ratio, filter.ratio, filter.shift,
+          cases[i].want);
+  }
+}
+
+static void test_dc(void)
+{
+  static const int32_t levels[] = { 0, 1, -1, 36600, -47000, 125000 };
+  appFilterCic_t filter;
+  unsigned l, ratio, n;
+  int32_t output;
+
+  for (l = 0; l < sizeof(levels) / sizeof(levels[0]); l++) {
+    for (ratio = 1; ratio <= APP_FILTER_CIC_MAX_RATIO; ratio <<= 1) {
+      appFilterCicInit(&filter, (uint8_t)ratio);
+      for (n = 0; n < ratio * 8; n++) {
+        if (appFilterCicPut(&filter, levels[l], &output)) {
+          CHECK(output == levels[l], "dc: %d at ratio %u gives %d", levels[l], ratio, output);
+        }
+      }
+    }
+  }
+}
+
+static void test_random(void)
+{
+  unsigned long seed = 0x2545F491UL;
+  unsigned long n;
+  unsigned ratio;
+
+  /* milli-degrees of the Si7013 range with noise, the sums wrap within the run */
+  for (n = 0; n < SAMPLES; n++) {
+    seed = seed * 1103515245UL + 12345UL;
+    input[n] = (int32_t)((seed >> 8) % 180001) - 50000;
+  }
+  for (ratio = 1; ratio <= APP_FILTER_CIC_MAX_RATIO; ratio <<= 1) {
+    check_ratio((uint8_t)ratio, SAMPLES, "random");
+  }
+}
+
+static void test_extremes(void)
+{
+  unsigned long n;
+  unsigned ratio;
+
+  for (ratio = 1; ratio <= APP_FILTER_CIC_MAX_RATIO; ratio <<= 1) {
+    /* the gain times the input range has to fit in 32 bits */
+    int32_t limit = (int32_t)((1UL << 31) / ((unsigned long)ratio * ratio) - 1);
+
+    for (n = 0; n < 64UL * ratio; n++) {
+      input[n] = ((n / ratio) & 1) ? limit : -limit;
+    }
+    check_ratio((uint8_t)ratio, 64UL * ratio, "extremes");
+  }
+}
+
+static void bench(void)
+{
+  appFilterCic_t filter;
+  volatile int32_t sink = 0;
+  int32_t output;
+  unsigned long n;
+  double t0;
+
+  appFilterCicInit(&filter, 8);
+  t0 = now_ns();
+  for (n = 0; n < BENCH_RUNS; n++) {
+    if (appFilterCicPut(&filter, (int32_t)(n & 0xFFFF), &output)) {
+      sink += output;
+    }
+  }
+  printf("cic put: %.2f ns per sample\n", (now_ns() - t0) / BENCH_RUNS);
+  (void)sink;
+}
+
+int main(void)
+{
+  test_ratio();
+  test_dc();
+  test_random();
+  test_extremes();
+  printf("%u failures\n", failures);
+  bench();
+  return failures != 0;
+}
+
+#endif /* HOST */
@@ -0,0 +1,567 @@
+#!/usr/bin/env python3
+"""GATT handle map generator.
+
+Reads the GATT database description (gatt.xml) and a handler binding file,
+and writes:
+
+  gatt_map.h       typed attribute handle constants, characteristic property
+                   flags, the handler function types and the declarations of
+                   the bound handlers
+  gatt_map.c       a dense handle-indexed table of handler function pointers,
+                   the event dispatcher and static assertions that check the
+                   handles against the stack generated gatt_db.h and the
+                   handlers against the characteristic properties
+  gatt_map_host.c  the attribute table of the same database for host builds
+                   (HOST defined), so a simulator serves identical handles
+
+The attribute handles are assigned the way the GATT configurator assigns
+them: the Generic Attribute service first when generic_attribute_service is
+set, then the services in file order, each characteristic taking a
+declaration and a value handle followed by its descriptors, with a Client
+Characteristic Configuration descriptor added after the value of a notify or
+indicate characteristic that does not declare one.
+
+Usage:
+  gatt_map.py gatt.xml gatt_handlers.txt [-o <output directory>]
+
+The binding file has one handler per line, "<characteristic id> <event>
+<function>", where the event is one of:
+
+  value   gatt_server_attribute_value, a stack stored value was written
+  status  gatt_server_characteristic_status, CCCD write or confirmation
+  read    gatt_server_user_read_request, read of a "user" type value
+  write   gatt_server_user_write_request, write of a "user" type value
+
+Lines starting with '#' are ignored. A handler that can never be called for
+its characteristic is an error.
+"""
+
+import argparse
+import os
+import sys
+import xml.etree.ElementTree as ET
+
+LICENSE = """\
+/***************************************************************************//**
+ * @file
+ * @brief {brief}
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2018 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * The licensor of this software is Silicon Laboratories Inc. Your use of this
+ * software is governed by the terms of Silicon Labs Master Software License
+ * Agreement (MSLA) available at
+ * www.silabs.com/about-us/legal/master-software-license-agreement. This
+ * software is distributed to you in Source Code format and is governed by the
+ * sections of the MSLA applicable to Source Code.
+ *
+ ******************************************************************************/
+"""
+
+# Characteristic properties, as in the characteristic declaration
+PROPS = [
+    ("broadcast", "GATT_PROP_BROADCAST", 0x01),
+    ("read", "GATT_PROP_READ", 0x02),
+    ("write_no_response", "GATT_PROP_WRITE_NO_RESPONSE", 0x04),
+    ("write", "GATT_PROP_WRITE", 0x08),
+    ("notify", "GATT_PROP_NOTIFY", 0x10),
+    ("indicate", "GATT_PROP_INDICATE", 0x20),
+    ("authenticated_write", "GATT_PROP_AUTH_SIGNED_WRITE", 0x40),
+]
+# Generator flags above the declaration byte
+PROP_USER = ("GATT_PROP_USER", 0x100)
+PROP_CCCD = ("GATT_PROP_CCCD", 0x200)
+
+UUID_PRIMARY_SERVICE = 0x2800
+UUID_SECONDARY_SERVICE = 0x2801
+UUID_CHARACTERISTIC = 0x2803
+UUID_CCCD = 0x2902
+
+EVENTS = {
+    "value": ("gattMapValueCback_t", "gatt_server_attribute_value", "attribute"),
+    "status": ("gattMapStatusCback_t", "gatt_server_characteristic_status", "characteristic"),
+    "read": ("gattMapReadCback_t", "gatt_server_user_read_request", "characteristic"),
+    "write": ("gattMapWriteCback_t", "gatt_server_user_write_request", "characteristic"),
+}
+
+
+class Attribute:
+    def __init__(self, kind, uuid, props=0, value=b"", max_len=0, variable=False, name=None):
+        self.handle = 0
+        self.kind = kind
+        self.uuid = uuid
+        self.props = props
+        self.value = value
+        self.max_len = max_len
+        self.variable = variable
+        self.name = name
+
+
+def parse_uuid(text):
+    text = text.replace("-", "")
+    if len(text) <= 4:
+        return int(text, 16).to_bytes(2, "little")
+    return bytes.fromhex(text)[::-1]
+
+
+def parse_value(node):
+    if node is None:
+        return b"", 0, False, "hex"
+    vtype = node.get("type", "hex")
+    length = int(node.get("length", "0"))
+    variable = node.get("variable_length", "false") == "true"
+    text = (node.text or "").strip()
+    if vtype == "utf-8":
+        data = text.encode("utf-8")
+    elif vtype == "hex" and text:
+        if len(text) % 2:
+            text = "0" + text
+        data = bytes.fromhex(text)
+    else:
+        data = b""
+    if not variable:
+        data = data.ljust(length, b"\0")
+    return data[:length], length, variable, vtype
+
+
+def parse_props(node):
+    props = 0
+    if node is None:
+        return props
+    for attr, _, bit in PROPS:
+        if node.get(attr, "false") == "true":
+            props |= bit
+    return props
+
+
+def characteristic(attrs, uuid, props, value, length, variable, vtype, name, descriptors):
+    decl = Attribute("characteristic", UUID_CHARACTERISTIC.to_bytes(2, "little"))
+    attrs.append(decl)
+    char = Attribute("value", uuid, props, value, length, variable, name)
+    if vtype == "user":
+        char.props |= PROP_USER[1]
+    attrs.append(char)
+    has_cccd = any(d.uuid == UUID_CCCD.to_bytes(2, "little") for d in descriptors)
+    if props & 0x30 and not has_cccd:
+        attrs.append(Attribute("descriptor", UUID_CCCD.to_bytes(2, "little"), 0x0a, b"\0\0", 2))
+        has_cccd = True
+    if has_cccd:
+        char.props |= PROP_CCCD[1]
+    attrs.extend(descriptors)
+    # Declaration value: properties, value handle and UUID, patched once handles are known
+    decl.char = char
+    return char
+
+
+def parse_gatt(path):
+    root = ET.parse(path).getroot()
+    attrs = []
+
+    if root.get("generic_attribute_service", "false") == "true":
+        attrs.append(Attribute("service", UUID_PRIMARY_SERVICE.to_bytes(2, "little"),
+                               value=(0x1801).to_bytes(2, "little")))
+        characteristic(attrs, (0x2a05).to_bytes(2, "little"), 0x20, b"\0" * 4, 4, False, "hex",
+                       "service_changed_char", [])
+        if root.get("gatt_caching", "false") == "true":
+            characteristic(attrs, (0x2b2a).to_bytes(2, "little"), 0x02, b"\0" * 16, 16, False,
+                           "hex", "database_hash", [])
+            characteristic(attrs, (0x2b29).to_bytes(2, "little"), 0x0a, b"\0", 1, False, "hex",
+                           "client_support_features", [])
+
+    for service in root.findall("service"):
+        kind = UUID_PRIMARY_SERVICE if service.get("type", "primary") == "primary" \
+            else UUID_SECONDARY_SERVICE
+        attrs.append(Attribute("service", kind.to_bytes(2, "little"),
+                               value=parse_uuid(service.get("uuid"))))
+        for char in service.findall("characteristic"):
+            value, length, variable, vtype = parse_value(char.find("value"))
+            descriptors = []
+            for desc in char.findall("descriptor"):
+                dvalue, dlength, dvariable, _ = parse_value(desc.find("value"))
+                duuid = parse_uuid(desc.get("uuid"))
+                # The configurator does not name Client Characteristic Configuration descriptors
+                dname = None if duuid == UUID_CCCD.to_bytes(2, "little") else desc.get("id")
+                descriptors.append(Attribute("descriptor", duuid, parse_props(desc.find("properties")),
+                                             dvalue, dlength, dvariable, dname))
+            characteristic(attrs, parse_uuid(char.get("uuid")), parse_props(char.find("properties")),
+                           value, length, variable, vtype, char.get("id"), descriptors)
+
+    for handle, attr in enumerate(attrs, 1):
+        attr.handle = handle
+    for attr in attrs:
+        if attr.kind == "characteristic":
+            attr.value = bytes([attr.char.props & 0xff]) + attr.char.handle.to_bytes(2, "little") \
+                + attr.char.uuid
+    return attrs
+
+
+def parse_handlers(path, attrs):
+    named = {a.name: a for a in attrs if a.name}
+    handlers = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            fields = line.split()
+            if len(fields) != 3:
+                sys.exit("%s:%d: expected '<id> <event> <function>'" % (path, number))
+            name, event, function = fields
+            if name not in named:
+                sys.exit("%s:%d: no characteristic with id '%s'" % (path, number, name))
+            if event not in EVENTS:
+                sys.exit("%s:%d: unknown event '%s'" % (path, number, event))
+            attr = named[name]
+            problem = check_handler(attr, event)
+            if problem:
+                sys.exit("%s:%d: %s handler for '%s' is never called, %s"
+                         % (path, number, event, name, problem))
+            handlers.append((attr, event, function))
+    return handlers
+
+
+def check_handler(attr, event):
+    props = attr.props
+    user = props & PROP_USER[1]
+    writable = props & 0x0c
+    if event == "value" and (user or not writable):
+        return "the value is not stored by the stack or not writable"
+    if event == "status" and not props & PROP_CCCD[1]:
+        return "it has no Client Characteristic Configuration"
+    if event == "read" and not (user and props & 0x02):
+        return "it is not a readable user type characteristic"
+    if event == "write" and not (user and writable):
+        return "it is not a writable user type characteristic"
+    return None
+
+
+def macro(name):
+    return name.upper()
+
+
+def prop_expr(props):
+    names = [n for _, n, bit in PROPS if props & bit]
+    names += [n for n, bit in (PROP_USER, PROP_CCCD) if props & bit]
+    return " | ".join(names) if names else "0"
+
+
+def c_bytes(data):
+    return ", ".join("0x%02x" % b for b in data)
+
+
+def write_header(out_dir, attrs, handlers, source):
+    named = [a for a in attrs if a.name]
+    width = max(len(macro(a.name)) for a in named) + len("GATT_MAP_PROPS_") + 2
+    out = [LICENSE.format(brief="GATT handle map header file").rstrip("\n"), ""]
+    out.append("/* This file is generated by tools/gatt_map.py from %s, do not edit. */" % source)
+    out.append("")
+    out.append("#ifndef GATT_MAP_H")
+    out.append("#define GATT_MAP_H")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("#include <stdbool.h>")
+    out.append("")
+    out.append("/* BG stack headers */")
+    out.append("#include \"bg_types.h\"")
+    out.append("#ifdef HOST")
+    out.append("#include \"gecko_bglib.h\"")
+    out.append("#else /* !HOST */")
+    out.append("#include \"native_gecko.h\"")
+    out.append("#endif /* !HOST */")
+    out.append("")
+    out.append("#ifdef __cplusplus")
+    out.append("extern \"C\" {")
+    out.append("#endif")
+    out.append("")
+    out.append("/***********************************************************************************************//**")
+    out.append(" * \\defgroup gatt_map GATT Handle Map")
+    out.append(" * \\brief Attribute handles, properties and event handlers of the GATT database.")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("/***********************************************************************************************//**")
+    out.append(" * @addtogroup Application")
+    out.append(" * @{")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("/***********************************************************************************************//**")
+    out.append(" * @addtogroup gatt_map")
+    out.append(" * @{")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("/***************************************************************************************************")
+    out.append(" * Public Macros and Definitions")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("/* Characteristic properties, the low byte is the declaration byte */")
+    for _, name, bit in PROPS:
+        out.append("#define %-32s0x%04x" % (name, bit))
+    out.append("/** Value is handled by the application (type \"user\"). */")
+    out.append("#define %-32s0x%04x" % PROP_USER)
+    out.append("/** Characteristic has a Client Characteristic Configuration descriptor. */")
+    out.append("#define %-32s0x%04x" % PROP_CCCD)
+    out.append("")
+    out.append("/** Highest attribute handle. */")
+    out.append("#define %-32s%d" % ("GATT_MAP_HANDLE_MAX", attrs[-1].handle))
+    out.append("/** Number of attributes. */")
+    out.append("#define %-32s%d" % ("GATT_MAP_ATTRIBUTE_COUNT", len(attrs)))
+    out.append("")
+    out.append("/* Properties of the named attributes */")
+    for a in named:
+        out.append("#define %-*s(%s)" % (width, "GATT_MAP_PROPS_" + macro(a.name), prop_expr(a.props)))
+    out.append("")
+    out.append("/***************************************************************************************************")
+    out.append(" * Data Types")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("/** Attribute handles. */")
+    out.append("typedef enum {")
+    for i, a in enumerate(named):
+        sep = "," if i + 1 < len(named) else ""
+        out.append("  %-*s= %d%s" % (width, "GATT_MAP_" + macro(a.name), a.handle, sep))
+    out.append("} gattMapHandle_t;")
+    out.append("")
+    out.append("/** Handler of a write to a value stored by the stack. */")
+    out.append("typedef void (*gattMapValueCback_t)(const struct gecko_msg_gatt_server_attribute_value_evt_t *pEvt);")
+    out.append("/** Handler of a CCCD write or an indication confirmation. */")
+    out.append("typedef void (*gattMapStatusCback_t)(const struct gecko_msg_gatt_server_characteristic_status_evt_t *pEvt);")
+    out.append("/** Handler of a read of a user type value. */")
+    out.append("typedef void (*gattMapReadCback_t)(const struct gecko_msg_gatt_server_user_read_request_evt_t *pEvt);")
+    out.append("/** Handler of a write of a user type value. */")
+    out.append("typedef void (*gattMapWriteCback_t)(const struct gecko_msg_gatt_server_user_write_request_evt_t *pEvt);")
+    out.append("")
+    out.append("/** Handlers of one attribute. */")
+    out.append("typedef struct {")
+    out.append("  gattMapValueCback_t value;    /**< gatt_server_attribute_value. */")
+    out.append("  gattMapStatusCback_t status;  /**< gatt_server_characteristic_status. */")
+    out.append("  gattMapReadCback_t read;      /**< gatt_server_user_read_request. */")
+    out.append("  gattMapWriteCback_t write;    /**< gatt_server_user_write_request. */")
+    out.append("} gattMapHandlers_t;")
+    out.append("")
+    out.append("/** Attribute kinds of the host attribute table. */")
+    out.append("typedef enum {")
+    out.append("  GATT_MAP_ATTR_SERVICE,        /**< Service declaration. */")
+    out.append("  GATT_MAP_ATTR_CHARACTERISTIC, /**< Characteristic declaration. */")
+    out.append("  GATT_MAP_ATTR_VALUE,          /**< Characteristic value. */")
+    out.append("  GATT_MAP_ATTR_DESCRIPTOR      /**< Characteristic descriptor. */")
+    out.append("} gattMapAttrKind_t;")
+    out.append("")
+    out.append("/** Attribute of the host attribute table. */")
+    out.append("typedef struct {")
+    out.append("  uint16_t handle;        /**< Attribute handle. */")
+    out.append("  uint8_t kind;           /**< gattMapAttrKind_t. */")
+    out.append("  uint8_t uuidLen;        /**< UUID length, 2 or 16. */")
+    out.append("  uint8_t uuid[16];       /**< Attribute type, little endian. */")
+    out.append("  uint16_t props;         /**< GATT_PROP_ flags of values and descriptors. */")
+    out.append("  uint16_t maxLen;        /**< Maximum value length. */")
+    out.append("  bool variableLen;       /**< Value length is variable. */")
+    out.append("  uint8_t len;            /**< Initial value length. */")
+    out.append("  const uint8_t *pValue;  /**< Initial value. */")
+    out.append("} gattMapAttribute_t;")
+    out.append("")
+    out.append("/***************************************************************************************************")
+    out.append(" * Public Variables")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("/** Handlers indexed by attribute handle. */")
+    out.append("extern const gattMapHandlers_t gattMapHandlers[GATT_MAP_HANDLE_MAX + 1];")
+    out.append("")
+    out.append("#ifdef HOST")
+    out.append("/** Attribute table, indexed by attribute handle - 1. */")
+    out.append("extern const gattMapAttribute_t gattMapAttributes[GATT_MAP_ATTRIBUTE_COUNT];")
+    out.append("#endif")
+    out.append("")
+    out.append("/***************************************************************************************************")
+    out.append(" * Function Declarations")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("/***********************************************************************************************//**")
+    out.append(" *  \\brief  Route a GATT server event to the handler of its attribute.")
+    out.append(" *  \\param[in]  evt  Event.")
+    out.append(" *  \\return  true if a handler was called, false if the event has no handler")
+    out.append(" **************************************************************************************************/")
+    out.append("bool gattMapDispatch(struct gecko_cmd_packet *evt);")
+    out.append("")
+    out.append("/* Bound handlers, see gatt_handlers.txt */")
+    for attr, event, function in handlers:
+        ctype, evt, _ = EVENTS[event]
+        out.append("void %s(const struct gecko_msg_%s_evt_t *pEvt);" % (function, evt))
+    out.append("")
+    out.append("/** @} (end addtogroup gatt_map) */")
+    out.append("/** @} (end addtogroup Application) */")
+    out.append("")
+    out.append("#ifdef __cplusplus")
+    out.append("};")
+    out.append("#endif")
+    out.append("")
+    out.append("#endif /* GATT_MAP_H */")
+    with open(os.path.join(out_dir, "gatt_map.h"), "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def write_source(out_dir, attrs, handlers, source):
+    named = [a for a in attrs if a.name]
+    out = [LICENSE.format(brief="GATT handle map").rstrip("\n"), ""]
+    out.append("/* This file is generated by tools/gatt_map.py from %s, do not edit. */" % source)
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("#include <stdbool.h>")
+    out.append("")
+    out.append("/* BG stack headers */")
+    out.append("#include \"bg_types.h\"")
+    out.append("#ifdef HOST")
+    out.append("#include \"gecko_bglib.h\"")
+    out.append("#else /* !HOST */")
+    out.append("#include \"native_gecko.h\"")
+    out.append("#endif /* !HOST */")
+    out.append("#include \"gatt_db.h\"")
+    out.append("")
+    out.append("/* Own header */")
+    out.append("#include \"gatt_map.h\"")
+    out.append("")
+    out.append("/***********************************************************************************************//**")
+    out.append(" * @addtogroup Application")
+    out.append(" * @{")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("/***********************************************************************************************//**")
+    out.append(" * @addtogroup gatt_map")
+    out.append(" * @{")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("/***************************************************************************************************")
+    out.append(" * Local Macros and Definitions")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("#if defined(__GNUC__) || (defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L))")
+    out.append("#define GATT_MAP_STATIC_ASSERT(expr, msg)  _Static_assert(expr, msg)")
+    out.append("#else")
+    out.append("#define GATT_MAP_ASSERT_NAME(line)         GATT_MAP_ASSERT_NAME2(line)")
+    out.append("#define GATT_MAP_ASSERT_NAME2(line)        gattMapAssert ## line")
+    out.append("#define GATT_MAP_STATIC_ASSERT(expr, msg)  typedef char GATT_MAP_ASSERT_NAME(__LINE__)[(expr) ? 1 : -1]")
+    out.append("#endif")
+    out.append("")
+    out.append("/* The handles must match the database the stack is built with */")
+    for a in named:
+        out.append("GATT_MAP_STATIC_ASSERT(GATT_MAP_%s == gattdb_%s, \"gatt_map.h is out of date\");"
+                   % (macro(a.name), a.name))
+    out.append("")
+    out.append("/* Each handler must be reachable through the properties of its characteristic */")
+    checks = {
+        "value": ("(GATT_MAP_PROPS_%s & (GATT_PROP_WRITE | GATT_PROP_WRITE_NO_RESPONSE))"
+                  " && !(GATT_MAP_PROPS_%s & GATT_PROP_USER)"),
+        "status": "(GATT_MAP_PROPS_%s & GATT_PROP_CCCD)",
+        "read": "(GATT_MAP_PROPS_%s & GATT_PROP_READ) && (GATT_MAP_PROPS_%s & GATT_PROP_USER)",
+        "write": ("(GATT_MAP_PROPS_%s & (GATT_PROP_WRITE | GATT_PROP_WRITE_NO_RESPONSE))"
+                  " && (GATT_MAP_PROPS_%s & GATT_PROP_USER)"),
+    }
+    for attr, event, function in handlers:
+        expr = checks[event]
+        expr = expr % ((macro(attr.name),) * expr.count("%s"))
+        out.append("GATT_MAP_STATIC_ASSERT(%s," % expr)
+        out.append("                       \"%s is never called\");" % function)
+    out.append("")
+    out.append("/***************************************************************************************************")
+    out.append(" * Public Variables")
+    out.append(" **************************************************************************************************/")
+    out.append("")
+    out.append("const gattMapHandlers_t gattMapHandlers[GATT_MAP_HANDLE_MAX + 1] = {")
+    by_attr = {}
+    for attr, event, function in handlers:
+        by_attr.setdefault(attr.handle, (attr, []))[1].append((event, function))
+    for handle in sorted(by_attr):
+        attr, bound = by_attr[handle]
+        fields = ", ".join(".%s = %s" % (event, function) for event, function in bound)
+        out.append("  [GATT_MAP_%s] = { %s }," % (macro(attr.name), fields))
+    out.append("};")
+    out.append("")
+    out.append("/***************************************************************************************************")
+    out.append(" * Public Function Definitions")
+    out.append(" **************************************************************************************************/")
+    out.append("bool gattMapDispatch(struct gecko_cmd_packet *evt)")
+    out.append("{")
+    out.append("  const gattMapHandlers_t *pHandlers;")
+    out.append("")
+    out.append("  switch (BGLIB_MSG_ID(evt->header)) {")
+    for event, (ctype, name, field) in EVENTS.items():
+        out.append("    case gecko_evt_%s_id:" % name)
+        out.append("      if (evt->data.evt_%s.%s > GATT_MAP_HANDLE_MAX) {" % (name, field))
+        out.append("        break;")
+        out.append("      }")
+        out.append("      pHandlers = &gattMapHandlers[evt->data.evt_%s.%s];" % (name, field))
+        out.append("      if (pHandlers->%s != NULL) {" % event)
+        out.append("        pHandlers->%s(&evt->data.evt_%s);" % (event, name))
+        out.append("        return true;")
+        out.append("      }")
+        out.append("      break;")
+        out.append("")
+    out.append("    default:")
+    out.append("      break;")
+    out.append("  }")
+    out.append("")
+    out.append("  return false;")
+    out.append("}")
+    out.append("")
+    out.append("/** @} (end addtogroup gatt_map) */")
+    out.append("/** @} (end addtogroup Application) */")
+    with open(os.path.join(out_dir, "gatt_map.c"), "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def write_host(out_dir, attrs, source):
+    kinds = {
+        "service": "GATT_MAP_ATTR_SERVICE",
+        "characteristic": "GATT_MAP_ATTR_CHARACTERISTIC",
+        "value": "GATT_MAP_ATTR_VALUE",
+        "descriptor": "GATT_MAP_ATTR_DESCRIPTOR",
+    }
+    out = [LICENSE.format(brief="GATT attribute table for host builds").rstrip("\n"), ""]
+    out.append("/* This file is generated by tools/gatt_map.py from %s, do not edit. */" % source)
+    out.append("")
+    out.append("#ifdef HOST")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("#include <stddef.h>")
+    out.append("")
+    out.append("/* Own header */")
+    out.append("#include \"gatt_map.h\"")
+    out.append("")
+    out.append("/* Initial values */")
+    for a in attrs:
+        if a.value:
+            out.append("static const uint8_t gattMapValue%d[] = { %s };" % (a.handle, c_bytes(a.value)))
+    out.append("")
+    out.append("const gattMapAttribute_t gattMapAttributes[GATT_MAP_ATTRIBUTE_COUNT] = {")
+    for i, a in enumerate(attrs):
+        sep = "," if i + 1 < len(attrs) else ""
+        value = "gattMapValue%d" % a.handle if a.value else "NULL"
+        max_len = a.max_len if a.kind in ("value", "descriptor") else len(a.value)
+        comment = " /* %s */" % a.name if a.name else ""
+        out.append("  { %d, %s, %d, { %s }, 0x%04x, %d, %s, %d, %s }%s%s"
+                   % (a.handle, kinds[a.kind], len(a.uuid), c_bytes(a.uuid), a.props, max_len,
+                      "true" if a.variable else "false", len(a.value), value, sep, comment))
+    out.append("};")
+    out.append("")
+    out.append("#endif /* HOST */")
+    with open(os.path.join(out_dir, "gatt_map_host.c"), "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("gatt", help="GATT database description (gatt.xml)")
+    parser.add_argument("handlers", help="handler binding file")
+    parser.add_argument("-o", "--output", default=".", help="output directory")
+    args = parser.parse_args()
+
+    attrs = parse_gatt(args.gatt)
+    handlers = parse_handlers(args.handlers, attrs)
+    source = os.path.basename(args.gatt)
+    write_header(args.output, attrs, handlers, source)
+    write_source(args.output, attrs, handlers, source)
+    write_host(args.output, attrs, source)
+
+
+if __name__ == "__main__":
+    main()
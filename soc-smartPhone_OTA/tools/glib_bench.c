@@ -0,0 +1,287 @@
+/*
+ * GLIB raster bench.
+ *
+ * Draws the demo screens into a RAM framebuffer laid out like the
+ * LS013B7DH03 pixel matrix (128 x 128, 2 control bytes per row, inverse
+ * colour) and reports host time per primitive:
+ *
+ *   clear      GLIB_clear()
+ *   pixel      GLIB_drawPixel()
+ *   hline      GLIB_drawLineH(), full and partial width
+ *   vline      GLIB_drawLineV()
+ *   line       GLIB_drawLine(), any slope, partly clipped
+ *   rect       GLIB_drawRect()
+ *   fillrect   GLIB_drawRectFilled()
+ *   circle     GLIB_drawCircle()
+ *   fillcirc   GLIB_drawCircleFilled()
+ *   string     GLIB_drawString(), one line of the narrow 6x8 font
+ *   text       GLIB_drawText(), two lines of the narrow 6x8 atlas, each
+ *              alignment
+ *   screen     the graphWriteString() screen of graphics.c
+ *
+ * as the best of ROUNDS timed rounds, and a checksum of the framebuffer after
+ * each primitive, so the raster path and the DMD_writeColor() path can be
+ * checked to draw the same pixels. A primitive that changes the control bytes
+ * of a row fails the run.
+ *
+ * Build and run both paths from the project directory:
+ *   for p in "" -DDMD_NO_RASTER_1BPP; do
+ *     gcc -O2 -DHOST $p -DHAL_CONFIG=1 -DBGM13S22F512GA=1 -I. \
+ *       -Ihardware/kit/BGM13_BRD4305C/config -Ihardware/kit/common/bsp \
+ *       -Ihardware/kit/common/drivers -Ihardware/kit/common/halconfig \
+ *       -Ihardware/module/config -Iplatform/CMSIS/Include \
+ *       -Iplatform/Device/SiliconLabs/BGM13/Include -Iplatform/emlib/inc \
+ *       -Iplatform/halconfig/inc/hal-config -Iplatform/middleware/glib \
+ *       -Iplatform/middleware/glib/dmd -Iplatform/middleware/glib/glib \
+ *       -o glib_bench tools/glib_bench.c platform/middleware/glib/dmd/display/dmd_display.c \
+ *       $(find platform/middleware/glib/glib -name '*.c') && ./glib_bench
+ *   done
+ *
+ * The file sits on the firmware source path, without HOST it compiles to nothing.
+ */
+
+#ifdef HOST
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "display.h"
+#include "glib.h"
+
+#define WIDTH           128
+#define HEIGHT          128
+#define CONTROL_BYTES   2
+#define STRIDE          (WIDTH + CONTROL_BYTES * 8)
+
+#define RUNS            20000
+#define ROUNDS          9
+
+static uint8_t frame[STRIDE / 8 * HEIGHT];
+static GLIB_Context_t glib;
+
+static double now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* displayls013b7dh03.c, without the hardware */
+static EMSTATUS hostAllocate(DISPLAY_Device_t *device, unsigned int width, unsigned int height,
+                             DISPLAY_PixelMatrix_t *pixelMatrix)
+{
+  unsigned y;
+
+  (void)device;
+  (void)width;
+  (void)height;
+  /* the line address and trailer the driver keeps after each row */
+  for (y = 0; y < HEIGHT; y++) {
+    frame[y * (STRIDE / 8) + WIDTH / 8] = (uint8_t)(y + 1);
+    frame[y * (STRIDE / 8) + WIDTH / 8 + 1] = 0;
+  }
+  *pixelMatrix = frame;
+  return DISPLAY_EMSTATUS_OK;
+}
+
+static EMSTATUS hostFree(DISPLAY_Device_t *device, DISPLAY_PixelMatrix_t pixelMatrix)
+{
+  (void)device;
+  (void)pixelMatrix;
+  return DISPLAY_EMSTATUS_OK;
+}
+
+static EMSTATUS hostDraw(DISPLAY_Device_t *device, DISPLAY_PixelMatrix_t pixelMatrix,
+                         unsigned int startColumn, unsigned int width,
+#ifdef EMWIN_WORKAROUND
+                         unsigned int userStride,
+#endif
+                         unsigned int startRow, unsigned int height)
+{
+  (void)device;
+  (void)pixelMatrix;
+  (void)startColumn;
+  (void)width;
+#ifdef EMWIN_WORKAROUND
+  (void)userStride;
+#endif
+  (void)startRow;
+  (void)height;
+  return DISPLAY_EMSTATUS_OK;
+}
+
+EMSTATUS DISPLAY_Init(void)
+{
+  return DISPLAY_EMSTATUS_OK;
+}
+
+EMSTATUS DISPLAY_DeviceGet(int displayDeviceNo, DISPLAY_Device_t *device)
+{
+  (void)displayDeviceNo;
+  memset(device, 0, sizeof(*device));
+  device->name = "host";
+  device->colourMode = DISPLAY_COLOUR_MODE_MONOCHROME_INVERSE;
+  device->addressMode = DISPLAY_ADDRESSING_BY_ROWS_ONLY;
+  device->geometry.width = WIDTH;
+  device->geometry.height = HEIGHT;
+  device->geometry.stride = STRIDE;
+  device->pPixelMatrixAllocate = hostAllocate;
+  device->pPixelMatrixFree = hostFree;
+  device->pPixelMatrixDraw = hostDraw;
+  return DISPLAY_EMSTATUS_OK;
+}
+
+/* the primitives draw pixels only */
+static bool controlIntact(void)
+{
+  unsigned y;
+
+  for (y = 0; y < HEIGHT; y++) {
+    if ((frame[y * (STRIDE / 8) + WIDTH / 8] != (uint8_t)(y + 1))
+        || (frame[y * (STRIDE / 8) + WIDTH / 8 + 1] != 0)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* FNV-1a of the pixels, without the control bytes */
+static uint32_t checksum(void)
+{
+  uint32_t h = 2166136261UL;
+  unsigned y, x;
+
+  for (y = 0; y < HEIGHT; y++) {
+    for (x = 0; x < WIDTH / 8; x++) {
+      h = (h ^ frame[y * (STRIDE / 8) + x]) * 16777619UL;
+    }
+  }
+  return h;
+}
+
+static unsigned long seed;
+
+static int32_t rnd(int32_t lo, int32_t hi)
+{
+  seed = seed * 1103515245UL + 12345UL;
+  return lo + (int32_t)((seed >> 8) % (unsigned long)(hi - lo + 1));
+}
+
+/* one primitive, coordinates from rnd() reach 16 pixels past the edges */
+static void draw(const char *name, int n)
+{
+  GLIB_Rectangle_t rect;
+  int32_t x = rnd(-16, WIDTH + 15);
+  int32_t y = rnd(-16, HEIGHT + 15);
+
+  glib.foregroundColor = (n & 3) ? Black : White;
+
+  if (!strcmp(name, "clear")) {
+    GLIB_clear(&glib);
+  } else if (!strcmp(name, "pixel")) {
+    GLIB_drawPixel(&glib, x, y);
+  } else if (!strcmp(name, "hline")) {
+    GLIB_drawLineH(&glib, (n & 1) ? 0 : x, y, (n & 1) ? WIDTH - 1 : x + rnd(0, 80));
+  } else if (!strcmp(name, "vline")) {
+    GLIB_drawLineV(&glib, x, y, y + rnd(0, 80));
+  } else if (!strcmp(name, "line")) {
+    GLIB_drawLine(&glib, x, y, rnd(-16, WIDTH + 15), rnd(-16, HEIGHT + 15));
+  } else if (!strcmp(name, "rect") || !strcmp(name, "fillrect")) {
+    rect.xMin = x;
+    rect.yMin = y;
+    rect.xMax = x + rnd(0, 60);
+    rect.yMax = y + rnd(0, 60);
+    if (name[0] == 'r') {
+      GLIB_drawRect(&glib, &rect);
+    } else {
+      GLIB_drawRectFilled(&glib, &rect);
+    }
+  } else if (!strcmp(name, "circle")) {
+    GLIB_drawCircle(&glib, x, y, (uint32_t)rnd(1, 40));
+  } else if (!strcmp(name, "fillcirc")) {
+    GLIB_drawCircleFilled(&glib, x, y, (uint32_t)rnd(1, 40));
+  } else if (!strcmp(name, "string")) {
+    GLIB_drawString(&glib, "Temperature: 23.4 C", 19, x, y, (n & 1) != 0);
+  } else if (!strcmp(name, "text")) {
+    GLIB_drawText(&glib, &GLIB_AtlasNarrow6x8, "Temperature:\n23.4 C", 19, x, y,
+                  (GLIB_Align_t)(n % 3), (n & 1) != 0);
+  } else if (!strcmp(name, "screen")) {
+    /* graphWriteString() with the header and one measurement */
+    static const char *lines[] = {
+      "BLE Health", "Thermometer", "", "Temperature:", " 23.4 C /  74.1 F", "", "Connected"
+    };
+    unsigned i;
+
+    glib.foregroundColor = Black;
+    GLIB_clear(&glib);
+    for (i = 0; i < sizeof(lines) / sizeof(lines[0]); i++) {
+      GLIB_drawText(&glib, &GLIB_AtlasNarrow6x8, lines[i], (uint32_t)strlen(lines[i]), WIDTH / 2,
+                    GLIB_AtlasNarrow6x8.lineSpacing
+                    + (int32_t)i * (GLIB_AtlasNarrow6x8.height + GLIB_AtlasNarrow6x8.lineSpacing),
+                    GLIB_ALIGN_CENTER, false);
+    }
+  }
+}
+
+int main(void)
+{
+  static const char *names[] = {
+    "clear", "pixel", "hline", "vline", "line", "rect", "fillrect", "circle", "fillcirc",
+    "string", "text", "screen"
+  };
+  unsigned i;
+  int n;
+
+  if ((DMD_init(0) != DMD_OK) || (GLIB_contextInit(&glib) != GLIB_OK)) {
+    fprintf(stderr, "GLIB init failed\n");
+    return 1;
+  }
+  glib.backgroundColor = White;
+  GLIB_setFont(&glib, (GLIB_Font_t *)&GLIB_FontNarrow6x8);
+
+#if defined(DMD_RASTER_1BPP)
+  printf("raster path\n");
+#else
+  printf("DMD_writeColor() path\n");
+#endif
+  printf("primitive        ns  checksum\n");
+  for (i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+    double best;
+    unsigned round;
+    uint32_t sum;
+
+    /* same primitives in the same order for the checksum, then timed */
+    seed = 0x2545F491UL;
+    glib.foregroundColor = White;
+    GLIB_clear(&glib);
+    for (n = 0; n < 200; n++) {
+      draw(names[i], n);
+    }
+    sum = checksum();
+
+    /* best of ROUNDS, the host is not otherwise idle */
+    best = 0;
+    for (round = 0; round < ROUNDS; round++) {
+      double t0 = now_ns();
+
+      for (n = 0; n < RUNS; n++) {
+        draw(names[i], n);
+      }
+      t0 = (now_ns() - t0) / RUNS;
+      if ((round == 0) || (t0 < best)) {
+        best = t0;
+      }
+    }
+    printf("%-10s %8.1f  %08lx\n", names[i], best, (unsigned long)sum);
+    if (!controlIntact()) {
+      fprintf(stderr, "%s overwrote the control bytes\n", names[i]);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+#endif /* HOST */
@@ -0,0 +1,31 @@
+/*
+ * Host stand-in for the Gecko bootloader application interface.
+ *
+ * The project takes btl_interface.h from the SDK install. Host builds of
+ * the tools put this directory first on the include path instead: it holds
+ * the declarations the firmware modules under test use, with the SDK
+ * values, and the tool defines the functions.
+ */
+
+#ifndef BTL_INTERFACE_H
+#define BTL_INTERFACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "application_properties.h"
+
+#define BOOTLOADER_OK                           0
+#define BOOTLOADER_ERROR_STORAGE_BASE           0x0400
+#define BOOTLOADER_ERROR_STORAGE_INVALID_SLOT   (BOOTLOADER_ERROR_STORAGE_BASE + 0x1)
+#define BOOTLOADER_ERROR_STORAGE_NO_IMAGE       (BOOTLOADER_ERROR_STORAGE_BASE + 0x9)
+
+typedef void (*BootloaderParserCallback_t)(uint32_t address, uint8_t *data, size_t length,
+                                           void *context);
+
+void bootloader_rebootAndInstall(void);
+
+#include "btl_interface_storage.h"
+
+#endif /* BTL_INTERFACE_H */
@@ -0,0 +1,17 @@
+/*
+ * Host stand-in for the Gecko bootloader storage interface, see
+ * btl_interface.h in this directory.
+ */
+
+#ifndef BTL_INTERFACE_STORAGE_H
+#define BTL_INTERFACE_STORAGE_H
+
+#include "btl_interface.h"
+
+int32_t bootloader_setImageToBootload(int32_t slotId);
+int32_t bootloader_setImagesToBootload(int32_t *slotIds, size_t length);
+int32_t bootloader_verifyImage(uint32_t slotId, BootloaderParserCallback_t callbackFunction);
+int32_t bootloader_getImageInfo(uint32_t slotId, ApplicationData_t *appInfo,
+                                uint32_t *bootloaderVersion);
+
+#endif /* BTL_INTERFACE_STORAGE_H */
@@ -0,0 +1,157 @@
+/*
+ * Heart rate measurement throughput bench.
+ *
+ * Feeds the synthetic beat source of hr_meas.c through the batching of hr.c,
+ * one notification per HR_NOTIFY_MS with the queued RR-Intervals packed up to
+ * ATT_MTU - 3 bytes, and reports per rate and MTU:
+ *
+ *   notify/s   notifications sent per second
+ *   bytes/s    characteristic bytes sent per second
+ *   rr/notify  mean RR-Intervals per notification
+ *   backlog    largest number of RR-Intervals left queued after a notification
+ *   dropped    RR-Intervals lost to the full queue
+ *   encode     host time per hrMeasEncode() call
+ *
+ * Every RR-Interval is checked to arrive once and in order, and the heart
+ * rate of each batch against the generator's mean rate.
+ *
+ * Build and run from the project directory:
+ *   gcc -O2 -DHOST -I. -o hr_bench tools/hr_bench.c hr_meas.c && ./hr_bench [seconds]
+ *
+ * The file sits on the firmware source path, without HOST it compiles to nothing.
+ */
+
+#ifdef HOST
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "hr_meas.h"
+
+/* hr.c settings */
+#define NOTIFY_MS       1000
+#define RR_QUEUE        32
+#define ENERGY_EVERY    10
+#define ENERGY_J        60
+#define VARIABILITY     8
+
+static double now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int run(unsigned bpm, unsigned mtu, unsigned seconds)
+{
+  hrSynth_t synth;
+  uint16_t queue[RR_QUEUE];
+  uint16_t sent[RR_QUEUE];
+  uint8_t buf[256];
+  hrMeas_t meas;
+  unsigned count = 0, backlog = 0, dropped = 0, notifies = 0, rrSent = 0, rrMade = 0;
+  unsigned long bytes = 0;
+  unsigned energyJ = 0;
+  unsigned energyCountdown = 0;
+  unsigned long beatMs = 0;
+  unsigned long tMs;
+  unsigned long expect = 0;
+  uint16_t history[4096];
+  double encodeNs = 0;
+  uint8_t used;
+  uint16_t len;
+  uint16_t rr;
+
+  hrSynthInit(&synth, (uint16_t)bpm, VARIABILITY, 0x2545F491UL);
+  rr = hrSynthNext(&synth);
+  beatMs = (rr * 1000UL + 512) / 1024;
+
+  for (tMs = NOTIFY_MS; tMs <= seconds * 1000UL; tMs += NOTIFY_MS) {
+    /* beats up to this notification */
+    while (beatMs <= tMs) {
+      if (count == RR_QUEUE) {
+        memmove(queue, queue + 1, (RR_QUEUE - 1) * sizeof(queue[0]));
+        count--;
+        dropped++;
+        expect++;
+      }
+      queue[count++] = rr;
+      history[rrMade++ % 4096] = rr;
+      energyJ += ENERGY_J;
+      rr = hrSynthNext(&synth);
+      beatMs += (rr * 1000UL + 512) / 1024;
+    }
+
+    memcpy(sent, queue, count * sizeof(queue[0]));
+    meas.bpm = count ? hrMeasBpm(sent, (uint8_t)count) : 0;
+    meas.flags = 0;
+    meas.energyPresent = (energyCountdown == 0);
+    meas.energy = (uint16_t)(energyJ / 1000);
+    meas.rr = sent;
+    meas.rrCount = (uint8_t)count;
+
+    {
+      double t0 = now_ns();
+      len = hrMeasEncode(buf, (uint16_t)(mtu - 3), &meas, &used);
+      encodeNs += now_ns() - t0;
+    }
+
+    /* decode and check what was sent */
+    {
+      uint8_t flags = buf[0];
+      unsigned p = (flags & HR_MEAS_FLAG_VALUE_16BIT) ? 3 : 2;
+
+      if (flags & HR_MEAS_FLAG_ENERGY_PRESENT) {
+        p += 2;
+      }
+      for (; p + 1 < len; p += 2) {
+        uint16_t v = (uint16_t)(buf[p] | (buf[p + 1] << 8));
+        if (v != history[expect++ % 4096]) {
+          fprintf(stderr, "%u bpm mtu %u: RR-Interval %lu out of order\n", bpm, mtu, expect - 1);
+          return 1;
+        }
+      }
+      if (count && ((meas.bpm + 10U < bpm) || (meas.bpm > bpm + 10))) {
+        fprintf(stderr, "%u bpm mtu %u: batch rate %u\n", bpm, mtu, meas.bpm);
+        return 1;
+      }
+    }
+
+    memmove(queue, queue + used, (count - used) * sizeof(queue[0]));
+    count -= used;
+    rrSent += used;
+    if (count > backlog) {
+      backlog = count;
+    }
+    energyCountdown = meas.energyPresent ? (ENERGY_EVERY - 1) : (energyCountdown - 1);
+    notifies++;
+    bytes += len;
+  }
+
+  printf("%5u %5u %9.2f %9.1f %10.2f %8u %8u %8.1f ns\n", bpm, mtu,
+         notifies / (double)seconds, bytes / (double)seconds, rrSent / (double)notifies, backlog,
+         dropped, encodeNs / notifies);
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  static const unsigned rates[] = { 45, 72, 120, 180, 240, 300 };
+  static const unsigned mtus[] = { 23, 247 };
+  unsigned seconds = (argc > 1) ? (unsigned)atoi(argv[1]) : 3600;
+  unsigned r, m;
+  int err = 0;
+
+  printf("  bpm   mtu  notify/s   bytes/s  rr/notify  backlog  dropped   encode\n");
+  for (m = 0; m < sizeof(mtus) / sizeof(mtus[0]); m++) {
+    for (r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+      err |= run(rates[r], mtus[m], seconds);
+    }
+  }
+  return err;
+}
+
+#endif /* HOST */
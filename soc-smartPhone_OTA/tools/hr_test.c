@@ -0,0 +1,206 @@
+/*
+ * Heart rate measurement encoder test.
+ *
+ * Decodes what hr_meas.c encodes, field by field as the Heart Rate Service
+ * defines the characteristic, and compares it with the measurement:
+ *
+ *   value     8 bit up to 255 bpm, 16 bit above or when asked for, only
+ *             the contact and value format flags are taken from the caller
+ *   energy    present only when asked for, little endian
+ *   rr        as many RR-Intervals as fit in the payload, oldest first,
+ *             never past maxLen, the RR flag only with intervals
+ *   bpm       hrMeasBpm() within half a beat of 60 s over the mean interval
+ *   synth     hrSynthNext() keeps the mean rate and the variation given to
+ *             hrSynthInit(), with the rate clamped to 20 to 300
+ *
+ * tools/hr_bench.c runs the encoder with the batching of hr.c and times it.
+ *
+ * Build and run from the project directory:
+ *   gcc -O2 -DHOST -I. -o hr_test tools/hr_test.c hr_meas.c && ./hr_test
+ *
+ * The file sits on the firmware source path, without HOST it compiles to nothing.
+ */
+
+#ifdef HOST
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "hr_meas.h"
+
+#define RR_MAX          16
+#define PAYLOAD_MAX     64
+
+static unsigned failures;
+
+#define CHECK(cond, ...)            \
+  do {                              \
+    if (!(cond)) {                  \
+      fprintf(stderr, __VA_ARGS__); \
+      fputc('\n', stderr);          \
+      failures++;                   \
+    }                               \
+  } while (0)
+
+/* encode and check one measurement against its decoding */
+static void check(const hrMeas_t *meas, uint16_t maxLen)
+{
+  uint8_t buf[PAYLOAD_MAX + 8];
+  uint8_t used = 0xFF;
+  uint16_t len, p = 1;
+  uint16_t bpm;
+  unsigned header, fit, want, i;
+  uint8_t flags;
+
+  memset(buf, 0xA5, sizeof(buf));
+  len = hrMeasEncode(buf, maxLen, meas, &used);
+  flags = buf[0];
+
+  header = 2 + (((meas->bpm > 0xFF) || (meas->flags & HR_MEAS_FLAG_VALUE_16BIT)) ? 1 : 0)
+           + (meas->energyPresent ? 2 : 0);
+  fit = (maxLen - header) / 2;
+  want = (meas->rrCount < fit) ? meas->rrCount : fit;
+
+  CHECK((flags & (HR_MEAS_FLAG_CONTACT_DETECTED | HR_MEAS_FLAG_CONTACT_SUPPORTED))
+        == (meas->flags & (HR_MEAS_FLAG_CONTACT_DETECTED | HR_MEAS_FLAG_CONTACT_SUPPORTED)),
+        "flags: contact 0x%02x from 0x%02x", flags, meas->flags);
+  CHECK(!(flags & 0xE0), "flags: reserved bits in 0x%02x", flags);
+
+  if (flags & HR_MEAS_FLAG_VALUE_16BIT) {
+    bpm = (uint16_t)(buf[p] | (buf[p + 1] << 8));
+    p += 2;
+    CHECK((meas->bpm > 0xFF) || (meas->flags & HR_MEAS_FLAG_VALUE_16BIT),
+          "value: %u bpm sent as 16 bit", meas->bpm);
+  } else {
+    bpm = buf[p++];
+  }
+  CHECK(bpm == meas->bpm, "value: %u bpm decodes as %u", meas->bpm, bpm);
+
+  CHECK(!(flags & HR_MEAS_FLAG_ENERGY_PRESENT) == !meas->energyPresent,
+        "energy: flag 0x%02x, present %d", flags, meas->energyPresent);
+  if (flags & HR_MEAS_FLAG_ENERGY_PRESENT) {
+    uint16_t energy = (uint16_t)(buf[p] | (buf[p + 1] << 8));
+    p += 2;
+    CHECK(energy == meas->energy, "energy: %u kJ decodes as %u", meas->energy, energy);
+  }
+
+  CHECK(used == want, "rr: %u of %u fit in %u bytes, want %u", used, meas->rrCount, maxLen, want);
+  CHECK(!(flags & HR_MEAS_FLAG_RR_PRESENT) == !used, "rr: flag 0x%02x with %u intervals", flags,
+        used);
+  for (i = 0; (i < used) && (p + 1 < len); i++, p += 2) {
+    uint16_t rr = (uint16_t)(buf[p] | (buf[p + 1] << 8));
+    CHECK(rr == meas->rr[i], "rr: interval %u is %u, want %u", i, rr, meas->rr[i]);
+  }
+  CHECK(p == len, "length: %u bytes, fields end at %u", len, p);
+  CHECK(len <= maxLen, "length: %u bytes in %u", len, maxLen);
+  CHECK(buf[len] == 0xA5, "length: written past %u bytes", len);
+}
+
+static void test_encode(void)
+{
+  static const uint16_t bpms[] = { 0, 1, 72, 255, 256, 300, 0xFFFF };
+  static const uint8_t flagSets[] = {
+    0, HR_MEAS_FLAG_VALUE_16BIT, HR_MEAS_FLAG_CONTACT_DETECTED | HR_MEAS_FLAG_CONTACT_SUPPORTED,
+    /* field flags from the caller are ignored */
+    HR_MEAS_FLAG_ENERGY_PRESENT | HR_MEAS_FLAG_RR_PRESENT | 0xE0
+  };
+  uint16_t rr[RR_MAX];
+  hrMeas_t meas;
+  unsigned b, f, e, count, maxLen, i;
+
+  for (i = 0; i < RR_MAX; i++) {
+    rr[i] = (uint16_t)(0x0301 + i * 0x0111);
+  }
+
+  for (b = 0; b < sizeof(bpms) / sizeof(bpms[0]); b++) {
+    for (f = 0; f < sizeof(flagSets) / sizeof(flagSets[0]); f++) {
+      for (e = 0; e < 2; e++) {
+        for (count = 0; count <= RR_MAX; count++) {
+          /* from the smallest payload that holds the fixed fields, 20 is ATT_MTU 23 */
+          for (maxLen = 5; maxLen <= PAYLOAD_MAX; maxLen++) {
+            meas.bpm = bpms[b];
+            meas.flags = flagSets[f];
+            meas.energyPresent = (e != 0);
+            meas.energy = (uint16_t)(0xFFFF - bpms[b]);
+            meas.rr = rr;
+            meas.rrCount = (uint8_t)count;
+            check(&meas, (uint16_t)maxLen);
+          }
+        }
+      }
+    }
+  }
+}
+
+static void test_bpm(void)
+{
+  unsigned long seed = 0x2545F491UL;
+  uint16_t rr[RR_MAX];
+  unsigned n, count, i;
+
+  CHECK(hrMeasBpm(rr, 0) == 0, "bpm: no intervals");
+  rr[0] = 0;
+  CHECK(hrMeasBpm(rr, 1) == 0, "bpm: zero interval");
+
+  for (n = 0; n < 100000; n++) {
+    unsigned long sum = 0;
+    double exact;
+    uint16_t got;
+
+    count = 1 + n % RR_MAX;
+    for (i = 0; i < count; i++) {
+      seed = seed * 1103515245UL + 12345UL;
+      /* 20 to 300 bpm */
+      rr[i] = (uint16_t)(205 + (seed >> 8) % (3072 - 205 + 1));
+      sum += rr[i];
+    }
+    exact = count * 60.0 * HR_MEAS_RR_PER_S / sum;
+    got = hrMeasBpm(rr, (uint8_t)count);
+    CHECK((got >= exact - 0.5) && (got <= exact + 0.5), "bpm: %u intervals give %u, want %.2f",
+          count, got, exact);
+  }
+}
+
+static void test_synth(void)
+{
+  static const struct {
+    uint16_t bpm;
+    uint16_t want;
+  } rates[] = { { 0, 20 }, { 20, 20 }, { 72, 72 }, { 180, 180 }, { 300, 300 }, { 1000, 300 } };
+  static const uint8_t variabilities[] = { 0, 8, 30 };
+  hrSynth_t synth;
+  unsigned r, v, n;
+
+  for (r = 0; r < sizeof(rates) / sizeof(rates[0]); r++) {
+    for (v = 0; v < sizeof(variabilities) / sizeof(variabilities[0]); v++) {
+      unsigned long sum = 0;
+      double mean = 60.0 * HR_MEAS_RR_PER_S / rates[r].want;
+      double swing = mean * variabilities[v] / 100 + 1;
+
+      hrSynthInit(&synth, rates[r].bpm, variabilities[v], 0x2545F491UL);
+      for (n = 0; n < 10000; n++) {
+        uint16_t rr = hrSynthNext(&synth);
+        CHECK((rr >= mean - swing) && (rr <= mean + swing),
+              "synth: %u bpm %u%% gives %u, want %.0f +- %.0f", rates[r].bpm, variabilities[v], rr,
+              mean, swing);
+        sum += rr;
+      }
+      /* the mean interval is rounded to 1/1024 s, the jitter averages out to about 1% of it */
+      CHECK((sum / 10000.0 >= mean - 1 - swing / 100) && (sum / 10000.0 <= mean + 1 + swing / 100),
+            "synth: %u bpm %u%% mean %.1f, want %.1f", rates[r].bpm, variabilities[v],
+            sum / 10000.0, mean);
+    }
+  }
+}
+
+int main(void)
+{
+  test_encode();
+  test_bpm();
+  test_synth();
+  printf("%u failures\n", failures);
+  return failures != 0;
+}
+
+#endif /* HOST */
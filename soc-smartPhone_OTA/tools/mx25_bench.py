@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+"""MX25 serial flash throughput model.
+
+Runs the command sequences of mx25flash_spi.c and app_storage.c against a
+simulated MX25R8035F and a cycle model of the USART, and compares the
+transfer paths:
+
+  byte     the original driver, USART_SpiTransfer() per byte, each byte
+           waits for transmit complete before the next one is written
+  fifo     TransferBlock() without LDMA, two bytes in flight
+  ldma     TransferBlock() on two LDMA channels
+
+and the ways of waiting for a page program:
+
+  poll     WaitFlashReady(), back to back status reads
+  paced    appStorageWaitReady(), one status read per RTCC tick, issued
+           before the next command so the program of the last page overlaps
+           whatever the caller does until its next access
+
+The flash model decodes the commands and keeps the array contents, every
+run is verified by reading the image back. The timings are a model: the
+SPI clock, the core clock, the per byte software overheads and the flash
+program time are parameters, the defaults are the BRD4305C settings and
+MX25R8035F typical times in high performance mode.
+
+Usage:
+  mx25_bench.py [--size <bytes>] [--chunk <bytes>] [--spi-hz <Hz>]
+                [--core-hz <Hz>] [--tpp-us <us>]
+"""
+
+import argparse
+import random
+
+PAGE = 256
+SECTOR = 4096
+FLASH_SIZE = 0x100000
+
+CMD_READ = 0x03
+CMD_FASTREAD = 0x0B
+CMD_PP = 0x02
+CMD_SE = 0x20
+CMD_WREN = 0x06
+CMD_RDSR = 0x05
+CMD_RDSCUR = 0x2B
+
+# Core cycles of software overhead, estimated from the generated code
+CYCLES_BYTE = 48        # USART_SpiTransfer(): call, TXBL wait, TXC wait, RXDATA read
+CYCLES_FIFO = 14        # TransferBlock() loop iteration, bytes follow back to back
+CYCLES_LDMA_SETUP = 160 # TransferBlockDma() channel setup per 2048 byte transfer
+CYCLES_CS = 12          # GPIO write for chip select
+CYCLES_CALL = 60        # driver function entry, address checks
+
+RTCC_HZ = 32768
+
+
+class Mx25:
+    """MX25R8035F command model."""
+
+    def __init__(self, tpp_us, tse_us):
+        self.mem = bytearray(b"\xff" * FLASH_SIZE)
+        self.tpp_us = tpp_us
+        self.tse_us = tse_us
+        self.busy_until = 0.0
+        self.wel = False
+
+    def transaction(self, now, tx):
+        """Run one chip select low period, returns the bytes clocked out."""
+        cmd = tx[0]
+        rx = bytearray(len(tx))
+        busy = now < self.busy_until
+        if cmd == CMD_RDSR:
+            status = (1 if busy else 0) | (2 if self.wel else 0)
+            for i in range(1, len(tx)):
+                rx[i] = status
+        elif cmd == CMD_RDSCUR:
+            pass
+        elif busy:
+            raise RuntimeError("command 0x%02x while busy" % cmd)
+        elif cmd == CMD_WREN:
+            self.wel = True
+        elif cmd in (CMD_READ, CMD_FASTREAD):
+            addr = int.from_bytes(tx[1:4], "big")
+            start = 4 if cmd == CMD_READ else 5
+            for i in range(start, len(tx)):
+                rx[i] = self.mem[addr + i - start]
+        elif cmd == CMD_PP:
+            assert self.wel, "page program without WREN"
+            addr = int.from_bytes(tx[1:4], "big")
+            base = addr & ~(PAGE - 1)
+            for i, b in enumerate(tx[4:]):
+                a = base + ((addr + i) & (PAGE - 1))
+                self.mem[a] &= b
+            self.busy_until = now + self.tpp_us * 1e-6
+            self.wel = False
+        elif cmd == CMD_SE:
+            assert self.wel, "sector erase without WREN"
+            addr = int.from_bytes(tx[1:4], "big") & ~(SECTOR - 1)
+            self.mem[addr:addr + SECTOR] = b"\xff" * SECTOR
+            self.busy_until = now + self.tse_us * 1e-6
+            self.wel = False
+        return rx
+
+
+class Bus:
+    """USART SPI master with a time base, one of the transfer paths."""
+
+    def __init__(self, flash, path, spi_hz, core_hz):
+        self.flash = flash
+        self.path = path
+        self.byte_s = 8.0 / spi_hz
+        self.cycle_s = 1.0 / core_hz
+        self.now = 0.0
+        self.transactions = 0
+        self.status_reads = 0
+
+    def cycles(self, n):
+        self.now += n * self.cycle_s
+
+    def bytes_time(self, n, bulk):
+        """Time for n bytes. Command bytes always go through SendByte()."""
+        if not bulk or self.path == "byte":
+            per = self.byte_s + CYCLES_BYTE * self.cycle_s
+            return n * per
+        if self.path == "fifo":
+            return n * max(self.byte_s, CYCLES_FIFO * self.cycle_s)
+        setups = (n + 2047) // 2048
+        return setups * CYCLES_LDMA_SETUP * self.cycle_s + n * self.byte_s
+
+    def xfer(self, header, payload=b"", read=0):
+        """Command bytes, then a bulk payload to write or a bulk read."""
+        self.cycles(CYCLES_CS)
+        start = self.now
+        bulk = len(payload) + read
+        self.now += self.bytes_time(len(header), False)
+        self.now += self.bytes_time(bulk, True) if bulk >= 16 else self.bytes_time(bulk, False)
+        tx = bytes(header) + bytes(payload) + b"\xff" * read
+        rx = self.flash.transaction(start, tx)
+        self.cycles(CYCLES_CS)
+        self.transactions += 1
+        return rx[len(header) + len(payload):]
+
+    def busy(self):
+        self.status_reads += 1
+        return self.xfer([CMD_RDSR], read=1)[0] & 1
+
+
+def addr3(a):
+    return [(a >> 16) & 0xff, (a >> 8) & 0xff, a & 0xff]
+
+
+def driver_pp(bus, addr, data, wait):
+    """MX25_PP(): busy check, 4 byte mode check, WREN, program, wait."""
+    bus.cycles(CYCLES_CALL)
+    assert not bus.busy()
+    bus.xfer([CMD_RDSCUR], read=1)
+    bus.xfer([CMD_WREN])
+    bus.xfer([CMD_PP] + addr3(addr), payload=data)
+    if wait == "poll":
+        while bus.busy():
+            pass
+
+
+def paced_wait(bus):
+    """appStorageWaitReady(): one status read per RTCC tick."""
+    tick = 1.0 / RTCC_HZ
+    while bus.busy():
+        bus.now = (int(bus.now / tick) + 1) * tick
+
+
+def driver_fastread(bus, addr, n):
+    bus.cycles(CYCLES_CALL)
+    bus.xfer([CMD_RDSCUR], read=1)
+    return bus.xfer([CMD_FASTREAD] + addr3(addr) + [0xff], read=n)
+
+
+def erase(bus, size):
+    for a in range(0, size, SECTOR):
+        bus.xfer([CMD_WREN])
+        bus.xfer([CMD_SE] + addr3(a))
+        while bus.busy():
+            bus.now = max(bus.now, bus.flash.busy_until)
+
+
+def run(path, wait, image, chunk, args):
+    flash = Mx25(args.tpp_us, 40000)
+    bus = Bus(flash, path, args.spi_hz, args.core_hz)
+    erase(bus, len(image))
+
+    start = bus.now
+    bus.status_reads = 0
+    for off in range(0, len(image), PAGE):
+        if wait == "paced":
+            paced_wait(bus)
+        driver_pp(bus, off, image[off:off + PAGE], wait)
+    if wait == "paced":
+        paced_wait(bus)
+    write_s = bus.now - start
+    write_polls = bus.status_reads
+
+    start = bus.now
+    readback = bytearray()
+    for off in range(0, len(image), chunk):
+        readback += driver_fastread(bus, off, min(chunk, len(image) - off))
+    read_s = bus.now - start
+
+    if bytes(readback) != image:
+        raise RuntimeError("%s/%s: read back mismatch" % (path, wait))
+    return write_s, write_polls, read_s
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--size", type=int, default=245760, help="image size in bytes")
+    parser.add_argument("--chunk", type=int, default=4096, help="read size per call")
+    parser.add_argument("--spi-hz", type=int, default=8000000, help="SPI clock")
+    parser.add_argument("--core-hz", type=int, default=38400000, help="core clock")
+    parser.add_argument("--tpp-us", type=float, default=850, help="page program time")
+    args = parser.parse_args()
+
+    rnd = random.Random(1)
+    image = bytes(rnd.getrandbits(8) for _ in range(args.size))
+    wire_kbs = args.spi_hz / 8 / 1024
+
+    print("%d byte image, %d byte reads, SPI %.1f MHz (%.0f kB/s on the wire), tPP %.0f us"
+          % (args.size, args.chunk, args.spi_hz / 1e6, wire_kbs, args.tpp_us))
+    print("%-6s %-6s %10s %10s %12s %10s %10s"
+          % ("path", "wait", "read ms", "read kB/s", "status reads", "write ms", "write kB/s"))
+    for path, wait in (("byte", "poll"), ("fifo", "poll"), ("ldma", "poll"),
+                       ("fifo", "paced"), ("ldma", "paced")):
+        write_s, polls, read_s = run(path, wait, image, args.chunk, args)
+        print("%-6s %-6s %10.1f %10.1f %12d %10.1f %10.1f"
+              % (path, wait, read_s * 1e3, args.size / 1024 / read_s, polls,
+                 write_s * 1e3, args.size / 1024 / write_s))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,274 @@
+/*
+ * Sensor value library test.
+ *
+ * Checks the fixed-point code of app_sensor.c against double precision and
+ * the C library:
+ *
+ *   c_to_f    appSensorCToF() against rounded C * 9 / 5 + 32
+ *   cal       appSensorCalApply() against rounded raw * gain + offset
+ *   float     appSensorFloat() and appSensorSfloat(), decoded back and
+ *             compared to the value, plus the special values
+ *   format    appSensorFormat() against snprintf("%*.*f")
+ *   stats     appSensorStatsPut() min, max and mean against a scan of the
+ *             window after every sample
+ *
+ * and then times the HTM temperature conversion, once the way htm.c did it
+ * before the library (division and snprintf) and once with the library, as
+ * host time per conversion.
+ *
+ * Build and run from the project directory:
+ *   gcc -O2 -DHOST -I. -o sensor_test tools/sensor_test.c app_sensor.c -lm && ./sensor_test
+ *
+ * The file sits on the firmware source path, without HOST it compiles to nothing.
+ */
+
+#ifdef HOST
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "app_sensor.h"
+
+/* infrastructure.h */
+#define FLT_TO_UINT32(m, e)  (((uint32_t)(m) & 0x00FFFFFFU) | ((uint32_t)(int32_t)(e) << 24))
+
+/* Si7013 range in milli-degrees C */
+#define TEMP_MIN        -47000
+#define TEMP_MAX        125000
+
+#define BENCH_RUNS      1000000
+
+static unsigned failures;
+
+#define CHECK(cond, ...)            \
+  do {                              \
+    if (!(cond)) {                  \
+      fprintf(stderr, __VA_ARGS__); \
+      fputc('\n', stderr);          \
+      failures++;                   \
+    }                               \
+  } while (0)
+
+static double now_ns(void)
+{
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static double decode(uint32_t value, unsigned mantBits, unsigned expBits)
+{
+  int32_t mant = (int32_t)(value & ((1UL << mantBits) - 1));
+  int32_t exp = (int32_t)((value >> mantBits) & ((1UL << expBits) - 1));
+
+  if (mant & (1L << (mantBits - 1))) {
+    mant -= 1L << mantBits;
+  }
+  if (exp & (1L << (expBits - 1))) {
+    exp -= 1L << expBits;
+  }
+  return mant * pow(10, exp);
+}
+
+static void test_c_to_f(void)
+{
+  int32_t c;
+
+  for (c = TEMP_MIN; c <= TEMP_MAX; c++) {
+    int32_t want = (int32_t)floor(c * 9.0 / 5.0 + 32000 + 0.5);
+    int32_t got = appSensorCToF(c);
+    CHECK(got == want, "c_to_f: %d gives %d, want %d", c, got, want);
+  }
+}
+
+static void test_cal(void)
+{
+  static const double gains[] = { 1.0, 0.5, 1.0123, 0.98765, 2.5 };
+  static const int32_t offsets[] = { 0, -250, 1200 };
+  unsigned g, o;
+  int32_t raw;
+
+  for (g = 0; g < sizeof(gains) / sizeof(gains[0]); g++) {
+    for (o = 0; o < sizeof(offsets) / sizeof(offsets[0]); o++) {
+      appSensorCal_t cal = { (int32_t)lround(gains[g] * APP_SENSOR_Q_ONE), offsets[o] };
+      for (raw = TEMP_MIN; raw <= TEMP_MAX; raw += 7) {
+        /* the gain is exact in Q16, only the product is rounded */
+        double want = floor((double)raw * cal.gain / APP_SENSOR_Q_ONE + 0.5) + cal.offset;
+        int32_t got = appSensorCalApply(&cal, raw);
+        CHECK(got == (int32_t)want, "cal: %d * %f + %d gives %d, want %.0f", raw, gains[g],
+              offsets[o], got, want);
+      }
+    }
+  }
+}
+
+static void test_float(void)
+{
+  static const int32_t mants[] = {
+    0, 1, -1, 36600, -47000, 125000, 8388605, -8388605, 8388606, 12345678, -99999999,
+    2047, 2045, 2046, -2045, 123456, 2147483647, -2147483647
+  };
+  static const int8_t exps[] = { -3, -1, 0, 2, 7, 120, 127 };
+  unsigned m, e;
+
+  for (m = 0; m < sizeof(mants) / sizeof(mants[0]); m++) {
+    for (e = 0; e < sizeof(exps) / sizeof(exps[0]); e++) {
+      double value = mants[m] * pow(10, exps[e]);
+      uint32_t f = appSensorFloat(mants[m], exps[e]);
+      uint16_t s = appSensorSfloat(mants[m], exps[e]);
+      double fv = decode(f, 24, 8);
+      double sv = decode(s, 12, 4);
+
+      if ((f & 0xFFFFFF) == (APP_SENSOR_FLOAT_POS_INF & 0xFFFFFF)) {
+        CHECK(value > 0, "float: %d e%d gives +INF", mants[m], exps[e]);
+      } else if ((f & 0xFFFFFF) == (APP_SENSOR_FLOAT_NEG_INF & 0xFFFFFF)) {
+        CHECK(value < 0, "float: %d e%d gives -INF", mants[m], exps[e]);
+      } else {
+        /* at most half a unit of the last kept digit off */
+        CHECK(fabs(fv - value) <= fabs(value) * 5e-7 + 1e-300, "float: %d e%d gives %g",
+              mants[m], exps[e], fv);
+      }
+
+      if (s == APP_SENSOR_SFLOAT_POS_INF) {
+        CHECK(value > 0, "sfloat: %d e%d gives +INF", mants[m], exps[e]);
+      } else if (s == APP_SENSOR_SFLOAT_NEG_INF) {
+        CHECK(value < 0, "sfloat: %d e%d gives -INF", mants[m], exps[e]);
+      } else {
+        CHECK(fabs(sv - value) <= fabs(value) * 2.5e-3 + 1e-300, "sfloat: %d e%d gives %g",
+              mants[m], exps[e], sv);
+      }
+    }
+  }
+
+  /* the encoding htm.c sent before, for every value that fits unchanged */
+  CHECK(appSensorFloat(36600, -3) == FLT_TO_UINT32(36600, -3), "float: 36.600 encoding");
+  CHECK(appSensorFloat(-47000, -3) == FLT_TO_UINT32(-47000, -3), "float: -47.000 encoding");
+  CHECK(appSensorSfloat(2046, 0) == 0x10CD, "sfloat: 2046 is 205e1, got 0x%04x",
+        appSensorSfloat(2046, 0));
+}
+
+static void test_format(void)
+{
+  char got[APP_SENSOR_FORMAT_MAX];
+  char want[64];
+  uint8_t width, decimals;
+  uint8_t len;
+  int32_t v;
+
+  for (decimals = 0; decimals <= 3; decimals++) {
+    for (width = 0; width <= 6; width += 3) {
+      for (v = -130000; v <= 130000; v += 13) {
+        /* %f rounds half to even, the library half away from 0, skip the ties */
+        if ((decimals < 3) && ((labs(v) % 1000) * (decimals == 0 ? 1 : decimals == 1 ? 10 : 100)
+                               % 1000 == 500)) {
+          continue;
+        }
+        snprintf(want, sizeof(want), "%*.*f", width + (decimals ? decimals + 1 : 0), decimals,
+                 v / 1000.0);
+        /* snprintf keeps the sign of a value that rounds to 0 */
+        if (!strncmp(want + strspn(want, " "), "-0", 2) && !strpbrk(want, "123456789")) {
+          char *minus = strchr(want, '-');
+          memmove(want + 1, want, (size_t)(minus - want));
+          want[0] = ' ';
+          if (width == 0) {
+            memmove(want, want + 1, strlen(want));
+          }
+        }
+        len = appSensorFormat(got, v, width, decimals);
+        CHECK(!strcmp(got, want) && (len == strlen(got)),
+              "format: %d width %u decimals %u gives \"%s\", want \"%s\"", v, width, decimals,
+              got, want);
+      }
+    }
+  }
+
+  len = appSensorFormat(got, -2147483647 - 1, 0, 3);
+  CHECK(!strcmp(got, "-2147483.648") && (len < APP_SENSOR_FORMAT_MAX),
+        "format: INT32_MIN gives \"%s\"", got);
+}
+
+static void test_stats(void)
+{
+  appSensorStats_t stats;
+  int32_t window[APP_SENSOR_STATS_WINDOW];
+  unsigned long seed = 0x2545F491UL;
+  unsigned n, i, count;
+
+  appSensorStatsInit(&stats);
+  CHECK(appSensorStatsMean(&stats) == 0, "stats: empty mean");
+
+  for (n = 0; n < 100000; n++) {
+    int64_t sum = 0;
+    int32_t min, max, sample;
+
+    seed = seed * 1103515245UL + 12345UL;
+    /* runs of equal samples, to hit the minimum and maximum leaving the window */
+    sample = (n % 50 < 10) ? 20000 : (int32_t)((seed >> 8) % 80001) - 40000;
+    window[n % APP_SENSOR_STATS_WINDOW] = sample;
+    appSensorStatsPut(&stats, sample);
+
+    count = (n + 1 < APP_SENSOR_STATS_WINDOW) ? (n + 1) : APP_SENSOR_STATS_WINDOW;
+    min = max = window[0];
+    for (i = 0; i < count; i++) {
+      sum += window[i];
+      min = (window[i] < min) ? window[i] : min;
+      max = (window[i] > max) ? window[i] : max;
+    }
+    CHECK((stats.count == count) && (stats.min == min) && (stats.max == max)
+          && (appSensorStatsMean(&stats) == (int32_t)(sum / (int64_t)count)),
+          "stats: sample %u gives %d..%d mean %d, want %d..%d mean %d", n, stats.min, stats.max,
+          appSensorStatsMean(&stats), min, max, (int32_t)(sum / (int64_t)count));
+  }
+}
+
+static void bench(void)
+{
+  char text[40];
+  volatile uint32_t sink = 0;
+  double t0, oldNs, newNs;
+  int32_t tempData, tempDataF;
+  uint8_t len;
+  int i;
+
+  t0 = now_ns();
+  for (i = 0; i < BENCH_RUNS; i++) {
+    tempData = 15000 + (i & 63) * 397;
+    tempDataF = (tempData * 18 + 320000l) / 10l;
+    snprintf(text, sizeof(text), "\nTemperature:\n%3d.%1d C / %3d.%1d F\n",
+             (uint8_t)(tempData / 1000), (uint8_t)((tempData / 100) % 10),
+             (uint8_t)(tempDataF / 1000), (uint8_t)((tempDataF / 100) % 10));
+    sink += FLT_TO_UINT32(tempData, -3) + (uint8_t)text[16];
+  }
+  oldNs = (now_ns() - t0) / BENCH_RUNS;
+
+  t0 = now_ns();
+  for (i = 0; i < BENCH_RUNS; i++) {
+    tempData = 15000 + (i & 63) * 397;
+    tempDataF = appSensorCToF(tempData);
+    len = appSensorFormat(text, tempData, 3, 1);
+    appSensorFormat(&text[len], tempDataF, 3, 1);
+    sink += appSensorFloat(tempData, -3) + (uint8_t)text[4];
+  }
+  newNs = (now_ns() - t0) / BENCH_RUNS;
+
+  printf("htm conversion: %.1f ns before, %.1f ns now\n", oldNs, newNs);
+  (void)sink;
+}
+
+int main(void)
+{
+  test_c_to_f();
+  test_cal();
+  test_float();
+  test_format();
+  test_stats();
+  printf("%u failures\n", failures);
+  bench();
+  return failures != 0;
+}
+
+#endif /* HOST */
@@ -0,0 +1,480 @@
+/*
+ * A/B image slot test.
+ *
+ * Runs app_slots.c against a simulated bootloader, two storage slots that
+ * hold an image version or nothing valid, a list of images to install on
+ * the next reset, and the PS keys in RAM. A reset installs the first image
+ * of the list that verifies, as the Gecko bootloader does, and boots it
+ * through appSlotsInit(). Each scenario walks the state machine:
+ *
+ *   confirm    install over a cable flashed image, trial, confirm, and the
+ *              confirmed slot becomes the fallback of the next download
+ *   timeout    an image that does not confirm in time rolls back
+ *   attempts   an image that resets before confirming rolls back after
+ *              APP_SLOTS_MAX_ATTEMPTS boots
+ *   corrupt    a download that does not verify is never run
+ *   unchanged  the running version installs without a trial
+ *   stuck      a rollback the bootloader does not install keeps the image
+ *              rather than resetting forever
+ *   single     one slot, nothing to roll back to
+ *
+ * checking the slot state, the download slot, the install list, the watchdog
+ * and the confirmation timer after every step.
+ *
+ * Build and run from the project directory:
+ *   gcc -O2 -DHOST -DBGM13S22F512GA=1 -DHAL_CONFIG=1 -Itools/host -I. \
+ *     -Iplatform/bootloader/api -Iplatform/CMSIS/Include \
+ *     -Iplatform/Device/SiliconLabs/BGM13/Include -Iplatform/emlib/inc \
+ *     -Iprotocol/bluetooth/ble_stack/inc/common -Iprotocol/bluetooth/ble_stack/inc/soc \
+ *     -Ihardware/kit/common/drivers -Ihardware/kit/common/halconfig \
+ *     -Ihardware/kit/BGM13_BRD4305C/config -Ihardware/module/config \
+ *     -Iplatform/halconfig/inc/hal-config -o slots_test tools/slots_test.c && ./slots_test
+ *
+ * tools/host holds stand-ins for the bootloader API headers of the SDK.
+ *
+ * The file sits on the firmware source path, without HOST it compiles to nothing.
+ */
+
+#ifdef HOST
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <setjmp.h>
+
+#include "native_gecko.h"
+#include "em_device.h"
+#include "em_cmu.h"
+#include "application_properties.h"
+#include "app.h"
+
+/* the watchdog registers of the image under test */
+static WDOG_TypeDef hostWdog;
+#undef WDOG0
+#define WDOG0 (&hostWdog)
+
+/* quiet, the scenarios report what went wrong */
+#undef printLog
+#define printLog(...)
+#undef syncLog
+#define syncLog()
+
+/* the running image changes with every install */
+static ApplicationProperties_t hostImage(void);
+#define applicationProperties hostImage()
+
+#include "app_slots.c"
+
+#define SLOTS           2
+#define PS_KEYS         0x80
+#define MAX_RESETS      10
+
+static unsigned failures;
+
+#define CHECK(cond, ...)            \
+  do {                              \
+    if (!(cond)) {                  \
+      fprintf(stderr, "%s: ", hostScenario); \
+      fprintf(stderr, __VA_ARGS__); \
+      fputc('\n', stderr);          \
+      failures++;                   \
+    }                               \
+  } while (0)
+
+static const char *hostScenario;
+
+/* storage slots, version 0 does not verify */
+static uint32_t hostSlots[SLOTS];
+static uint32_t hostNumSlots;
+/* images to install on the next reset */
+static int32_t hostList[SLOTS];
+static size_t hostListLen;
+/* version of the running image */
+static uint32_t hostRunning;
+
+/* PS keys from 0x4000 */
+static struct {
+  uint8_t len;
+  uint8_t data[56];
+} hostPs[PS_KEYS];
+
+/* command and response of the stack commands */
+static uint32_t hostCmd[64];
+static uint32_t hostRsp[64];
+void *gecko_cmd_msg_buf = hostCmd;
+void *gecko_rsp_msg_buf = hostRsp;
+
+static jmp_buf hostReset;
+static unsigned hostResets;
+/* what runs after the boot, once */
+static void (*hostEvent)(void);
+
+static ApplicationProperties_t hostImage(void)
+{
+  ApplicationProperties_t properties;
+
+  memset(&properties, 0, sizeof(properties));
+  properties.app.version = hostRunning;
+  return properties;
+}
+
+/***************************************************************************************************
+ * Stack, bootloader and timers
+ **************************************************************************************************/
+
+void sli_bt_cmd_handler_delegate(uint32_t header, gecko_cmd_handler handler, const void *payload)
+{
+  (void)header;
+  handler(payload);
+}
+
+void sli_bt_cmd_flash_ps_load(const void *payload)
+{
+  struct gecko_cmd_packet *cmd = gecko_cmd_msg_buf;
+  struct gecko_cmd_packet *rsp = gecko_rsp_msg_buf;
+  uint16_t key = cmd->data.cmd_flash_ps_load.key;
+
+  (void)payload;
+  if ((key < 0x4000) || (key >= 0x4000 + PS_KEYS) || !hostPs[key - 0x4000].len) {
+    rsp->data.rsp_flash_ps_load.result = bg_err_hardware_ps_key_not_found;
+    rsp->data.rsp_flash_ps_load.value.len = 0;
+    return;
+  }
+  rsp->data.rsp_flash_ps_load.result = bg_err_success;
+  rsp->data.rsp_flash_ps_load.value.len = hostPs[key - 0x4000].len;
+  memcpy(rsp->data.rsp_flash_ps_load.value.data, hostPs[key - 0x4000].data,
+         hostPs[key - 0x4000].len);
+}
+
+void sli_bt_cmd_flash_ps_save(const void *payload)
+{
+  struct gecko_cmd_packet *cmd = gecko_cmd_msg_buf;
+  struct gecko_cmd_packet *rsp = gecko_rsp_msg_buf;
+  uint16_t key = cmd->data.cmd_flash_ps_save.key;
+  uint8_t len = cmd->data.cmd_flash_ps_save.value.len;
+
+  (void)payload;
+  if ((key < 0x4000) || (key >= 0x4000 + PS_KEYS) || (len > sizeof(hostPs[0].data))) {
+    rsp->data.rsp_flash_ps_save.result = bg_err_invalid_param;
+    return;
+  }
+  hostPs[key - 0x4000].len = len;
+  memcpy(hostPs[key - 0x4000].data, cmd->data.cmd_flash_ps_save.value.data, len);
+  rsp->data.rsp_flash_ps_save.result = bg_err_success;
+}
+
+int32_t bootloader_setImageToBootload(int32_t slotId)
+{
+  return bootloader_setImagesToBootload(&slotId, 1);
+}
+
+int32_t bootloader_setImagesToBootload(int32_t *slotIds, size_t length)
+{
+  size_t i;
+
+  if (length > SLOTS) {
+    return BOOTLOADER_ERROR_STORAGE_INVALID_SLOT;
+  }
+  for (i = 0; i < length; i++) {
+    if ((slotIds[i] < 0) || ((uint32_t)slotIds[i] >= hostNumSlots)) {
+      return BOOTLOADER_ERROR_STORAGE_INVALID_SLOT;
+    }
+    hostList[i] = slotIds[i];
+  }
+  hostListLen = length;
+  return BOOTLOADER_OK;
+}
+
+int32_t bootloader_verifyImage(uint32_t slotId, BootloaderParserCallback_t callbackFunction)
+{
+  (void)callbackFunction;
+  return ((slotId < hostNumSlots) && hostSlots[slotId]) ? BOOTLOADER_OK
+         : BOOTLOADER_ERROR_STORAGE_NO_IMAGE;
+}
+
+int32_t bootloader_getImageInfo(uint32_t slotId, ApplicationData_t *appInfo,
+                                uint32_t *bootloaderVersion)
+{
+  if (bootloader_verifyImage(slotId, NULL) != BOOTLOADER_OK) {
+    return BOOTLOADER_ERROR_STORAGE_NO_IMAGE;
+  }
+  memset(appInfo, 0, sizeof(*appInfo));
+  appInfo->version = hostSlots[slotId];
+  *bootloaderVersion = 0;
+  return BOOTLOADER_OK;
+}
+
+void bootloader_rebootAndInstall(void)
+{
+  longjmp(hostReset, 1);
+}
+
+void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable)
+{
+  (void)clock;
+  (void)enable;
+}
+
+void appTimerStart(appTimer_t *timer, uint32_t timeoutMs, uint32_t slackMs, bool periodic,
+                   appTimerCback_t cback, void *arg)
+{
+  (void)timeoutMs;
+  (void)slackMs;
+  (void)periodic;
+  timer->pprev = &timer->next;
+  timer->cback = cback;
+  timer->arg = arg;
+}
+
+void appTimerStop(appTimer_t *timer)
+{
+  timer->pprev = NULL;
+}
+
+bool appTimerIsRunning(const appTimer_t *timer)
+{
+  return timer->pprev != NULL;
+}
+
+/***************************************************************************************************
+ * Simulation
+ **************************************************************************************************/
+
+/* a reset, then event in the booted image */
+static void hostBoot(void (*event)(void))
+{
+  size_t i;
+
+  hostEvent = event;
+  hostResets = 0;
+  if (setjmp(hostReset)) {
+    hostEvent = NULL;
+  }
+  if (++hostResets > MAX_RESETS) {
+    CHECK(0, "resets forever");
+    return;
+  }
+
+  /* the bootloader installs the first image that verifies */
+  for (i = 0; i < hostListLen; i++) {
+    if (hostSlots[hostList[i]]) {
+      hostRunning = hostSlots[hostList[i]];
+      break;
+    }
+  }
+  hostListLen = 0;
+
+  /* RAM and the watchdog start over */
+  memset(&appSlotsRecord, 0, sizeof(appSlotsRecord));
+  memset(&appSlotsTimer, 0, sizeof(appSlotsTimer));
+  memset(&appSlotsWdogTimer, 0, sizeof(appSlotsWdogTimer));
+  memset(&hostWdog, 0, sizeof(hostWdog));
+
+  appSlotsInit(hostNumSlots);
+  if (hostEvent) {
+    hostEvent();
+  }
+}
+
+/* a new device with version 1 flashed by cable */
+static void hostFactory(const char *scenario, uint32_t numSlots)
+{
+  hostScenario = scenario;
+  hostNumSlots = numSlots;
+  memset(hostSlots, 0, sizeof(hostSlots));
+  memset(hostPs, 0, sizeof(hostPs));
+  hostListLen = 0;
+  hostRunning = 1;
+  hostBoot(NULL);
+}
+
+/* OTA download of an image into the download slot, 0 for a corrupt one */
+static int32_t hostDownload(uint32_t version)
+{
+  int32_t slot = appSlotsDownloadSlot();
+
+  if (slot != APP_SLOTS_NONE) {
+    hostSlots[slot] = version;
+  }
+  return slot;
+}
+
+static void hostConfirm(void)
+{
+  appSlotsConfirm();
+}
+
+static void hostTimeout(void)
+{
+  appSlotsTimer.cback(appSlotsTimer.arg);
+}
+
+static void expect(appSlotsState_t state, uint32_t running, int32_t download)
+{
+  bool trial = (state == APP_SLOTS_TRIAL);
+
+  CHECK(appSlotsGetState() == state, "state %d, want %d", appSlotsGetState(), state);
+  CHECK(hostRunning == running, "running version %lu, want %lu", (unsigned long)hostRunning,
+        (unsigned long)running);
+  CHECK(appSlotsDownloadSlot() == download, "download slot %ld, want %ld",
+        (long)appSlotsDownloadSlot(), (long)download);
+  CHECK(appTimerIsRunning(&appSlotsTimer) == trial, "confirmation timer %s",
+        trial ? "stopped" : "running");
+  CHECK(((hostWdog.CTRL & WDOG_CTRL_EN) != 0) == trial, "watchdog %s", trial ? "off" : "on");
+  CHECK(appTimerIsRunning(&appSlotsWdogTimer) == trial, "watchdog feed %s",
+        trial ? "stopped" : "running");
+}
+
+/***************************************************************************************************
+ * Scenarios
+ **************************************************************************************************/
+
+static void test_confirm(void)
+{
+  hostFactory("confirm", SLOTS);
+  expect(APP_SLOTS_IDLE, 1, 0);
+  CHECK(!appSlotsConfirm(), "confirmed an image not on trial");
+
+  CHECK(hostDownload(2) == 0, "download slot");
+  CHECK(appSlotsInstall() == BOOTLOADER_OK, "install");
+  /* a cable flashed image has no copy to fall back to */
+  CHECK((hostListLen == 1) && (hostList[0] == 0), "install list of %u", (unsigned)hostListLen);
+  expect(APP_SLOTS_PENDING, 1, APP_SLOTS_NONE);
+
+  hostBoot(NULL);
+  expect(APP_SLOTS_TRIAL, 2, APP_SLOTS_NONE);
+  CHECK(appSlotsInstall() == BOOTLOADER_ERROR_STORAGE_INVALID_SLOT, "install while on trial");
+  CHECK(appSlotsConfirm(), "confirm");
+  expect(APP_SLOTS_IDLE, 2, 1);
+
+  /* the next download goes to the other slot, with the confirmed one as fallback */
+  CHECK(hostDownload(3) == 1, "second download slot");
+  CHECK(appSlotsInstall() == BOOTLOADER_OK, "second install");
+  CHECK((hostListLen == 2) && (hostList[0] == 1) && (hostList[1] == 0),
+        "second install list of %u", (unsigned)hostListLen);
+  hostBoot(hostConfirm);
+  expect(APP_SLOTS_IDLE, 3, 0);
+
+  /* the state is kept across plain resets */
+  hostBoot(NULL);
+  expect(APP_SLOTS_IDLE, 3, 0);
+}
+
+static void test_timeout(void)
+{
+  hostFactory("timeout", SLOTS);
+  hostDownload(2);
+  appSlotsInstall();
+  hostBoot(hostConfirm);
+  hostDownload(3);
+  appSlotsInstall();
+
+  hostBoot(hostTimeout);
+  expect(APP_SLOTS_IDLE, 2, 1);
+  CHECK(hostSlots[1] == 3, "rejected image gone");
+}
+
+static void test_attempts(void)
+{
+  unsigned boot;
+
+  hostFactory("attempts", SLOTS);
+  hostDownload(2);
+  appSlotsInstall();
+  hostBoot(hostConfirm);
+  hostDownload(3);
+  appSlotsInstall();
+
+  for (boot = 1; boot <= APP_SLOTS_MAX_ATTEMPTS; boot++) {
+    hostBoot(NULL);
+    expect(APP_SLOTS_TRIAL, 3, APP_SLOTS_NONE);
+    CHECK(appSlotsRecord.attempts == boot, "boot %u counted as %u", boot, appSlotsRecord.attempts);
+  }
+  /* one more reset before the confirmation rolls back */
+  hostBoot(NULL);
+  expect(APP_SLOTS_IDLE, 2, 1);
+}
+
+static void test_corrupt(void)
+{
+  hostFactory("corrupt", SLOTS);
+  hostDownload(2);
+  appSlotsInstall();
+  hostBoot(hostConfirm);
+
+  CHECK(hostDownload(0) == 1, "download slot");
+  CHECK(appSlotsInstall() == BOOTLOADER_OK, "install");
+  hostBoot(NULL);
+  expect(APP_SLOTS_IDLE, 2, 1);
+}
+
+static void test_unchanged(void)
+{
+  hostFactory("unchanged", SLOTS);
+  hostDownload(2);
+  appSlotsInstall();
+  hostBoot(hostConfirm);
+
+  CHECK(hostDownload(2) == 1, "download slot");
+  CHECK(appSlotsInstall() == BOOTLOADER_OK, "install");
+  CHECK((hostListLen == 1) && (hostList[0] == 1), "install list of %u", (unsigned)hostListLen);
+  expect(APP_SLOTS_IDLE, 2, 0);
+  hostBoot(NULL);
+  expect(APP_SLOTS_IDLE, 2, 0);
+}
+
+static void test_stuck(void)
+{
+  unsigned boots;
+
+  hostFactory("stuck", SLOTS);
+  hostDownload(2);
+  appSlotsInstall();
+  hostBoot(hostConfirm);
+  hostDownload(3);
+  appSlotsInstall();
+  hostBoot(NULL);
+
+  /* the fallback is lost, the bootloader keeps booting the image on trial and its confirmation
+   * times out on every boot */
+  hostSlots[0] = 0;
+  for (boots = 0; (appSlotsGetState() == APP_SLOTS_TRIAL) && (boots < MAX_RESETS); boots++) {
+    hostBoot(hostTimeout);
+  }
+  expect(APP_SLOTS_IDLE, 3, 0);
+  CHECK(boots <= APP_SLOTS_MAX_ATTEMPTS, "%u timeouts", boots);
+}
+
+static void test_single(void)
+{
+  hostFactory("single", 1);
+  CHECK(hostDownload(2) == 0, "download slot");
+  CHECK(appSlotsInstall() == BOOTLOADER_OK, "install");
+  hostBoot(NULL);
+  expect(APP_SLOTS_TRIAL, 2, APP_SLOTS_NONE);
+
+  /* the download replaced the only copy, the image stays */
+  hostTimeout();
+  expect(APP_SLOTS_IDLE, 2, 0);
+
+  hostDownload(3);
+  appSlotsInstall();
+  hostBoot(hostConfirm);
+  expect(APP_SLOTS_IDLE, 3, 0);
+  CHECK(appSlotsRecord.confirmedSlot == APP_SLOTS_NONE, "confirmed copy in the only slot");
+}
+
+int main(void)
+{
+  test_confirm();
+  test_timeout();
+  test_attempts();
+  test_corrupt();
+  test_unchanged();
+  test_stuck();
+  test_single();
+  printf("%u failures\n", failures);
+  return failures != 0;
+}
+
+#endif /* HOST */
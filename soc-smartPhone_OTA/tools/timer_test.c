@@ -0,0 +1,317 @@
+/*
+ * Application timer wheel test.
+ *
+ * Runs app_timer.c on a simulated RTCC and stack soft timer. The stack timer
+ * fires at the time it was armed for plus a random latency, then the test
+ * calls appTimerProcess() as the event handler in app.c does. A model keeps
+ * the expiry of every timer in RTCC ticks:
+ *
+ *   random    64 timers started, restarted and stopped at random, one-shot
+ *             and periodic, from 0 ms to 30 hours, with and without slack,
+ *             some of them from inside callbacks. Every callback comes
+ *             within [expiry, expiry + slack] plus two wheel ticks and the
+ *             latency, periodic timers do not drift, stopped timers never
+ *             fire, appTimerIsRunning() agrees with the model and the stack
+ *             timer is stopped only when no timer runs
+ *   wrap      the same with the RTCC count and the wheel time about to wrap
+ *   coalesce  16 staggered 1 s timers with 200 ms slack need fewer than half
+ *             the wakeups of the same timers without slack
+ *
+ * Build and run from the project directory:
+ *   gcc -O2 -DHOST -DBGM13S22F512GA=1 -I. -Iplatform/CMSIS/Include \
+ *     -Iplatform/Device/SiliconLabs/BGM13/Include -Iplatform/emlib/inc \
+ *     -Iprotocol/bluetooth/ble_stack/inc/common -Iprotocol/bluetooth/ble_stack/inc/soc \
+ *     -o timer_test tools/timer_test.c && ./timer_test
+ *
+ * The file sits on the firmware source path, without HOST it compiles to nothing.
+ */
+
+#ifdef HOST
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "native_gecko.h"
+#include "em_device.h"
+
+/* the counter app_timer.c reads */
+static RTCC_TypeDef hostRtcc;
+#undef RTCC
+#define RTCC (&hostRtcc)
+
+#include "app_timer.c"
+
+#define TIMERS          64
+#define STEPS           200000
+#define LATENCY         100
+/* one wheel tick in RTCC ticks */
+#define TICK            (1UL << APP_TIMER_TICK_SHIFT)
+
+static unsigned failures;
+
+#define CHECK(cond, ...)            \
+  do {                              \
+    if (!(cond)) {                  \
+      fprintf(stderr, "%s: ", hostScenario); \
+      fprintf(stderr, __VA_ARGS__); \
+      fputc('\n', stderr);          \
+      failures++;                   \
+    }                               \
+  } while (0)
+
+static const char *hostScenario;
+
+/* command and response of the stack commands */
+static uint32_t hostCmd[64];
+static uint32_t hostRsp[64];
+void *gecko_cmd_msg_buf = hostCmd;
+void *gecko_rsp_msg_buf = hostRsp;
+
+/* RTCC ticks since the start of the scenario, the count is this plus hostRtccStart */
+static uint64_t hostTime;
+static uint32_t hostRtccStart;
+/* RTCC ticks since the start when appTimerInit() ran */
+static uint64_t hostInit;
+/* the stack timer */
+static bool hostArmed;
+static uint64_t hostFireAt;
+static unsigned long hostWakeups;
+
+static unsigned long seed;
+
+static uint32_t rnd(uint32_t n)
+{
+  seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+  return (uint32_t)((seed >> 33) % n);
+}
+
+static struct model {
+  appTimer_t timer;
+  bool running;
+  bool periodic;
+  uint64_t expiry;        /* RTCC ticks since the start */
+  uint64_t period;
+  uint64_t slack;
+  unsigned long fired;
+} models[TIMERS];
+
+static unsigned long callbacks;
+/* callbacks start and stop other timers */
+static bool meddle;
+
+/***************************************************************************************************
+ * Stack and RTCC
+ **************************************************************************************************/
+
+void sli_bt_cmd_handler_delegate(uint32_t header, gecko_cmd_handler handler, const void *payload)
+{
+  (void)header;
+  handler(payload);
+}
+
+void sli_bt_cmd_hardware_set_soft_timer(const void *payload)
+{
+  struct gecko_cmd_packet *cmd = gecko_cmd_msg_buf;
+
+  (void)payload;
+  CHECK(cmd->data.cmd_hardware_set_soft_timer.handle == APP_TIMER_HANDLE, "stack timer handle %u",
+        cmd->data.cmd_hardware_set_soft_timer.handle);
+  CHECK(cmd->data.cmd_hardware_set_soft_timer.single_shot, "stack timer repeats");
+  hostArmed = (cmd->data.cmd_hardware_set_soft_timer.time != 0);
+  hostFireAt = hostTime + cmd->data.cmd_hardware_set_soft_timer.time;
+}
+
+static void hostSetTime(uint64_t time)
+{
+  hostTime = time;
+  hostRtcc.CNT = (uint32_t)(hostRtccStart + time);
+}
+
+/* start of the wheel tick a time falls in */
+static uint64_t hostWheelFloor(uint64_t time)
+{
+  return hostInit + (time - hostInit) / TICK * TICK;
+}
+
+static void hostReset(const char *scenario, uint32_t rtccStart, uint32_t wheelStart)
+{
+  hostScenario = scenario;
+  hostRtccStart = rtccStart;
+  hostArmed = false;
+  hostWakeups = 0;
+  callbacks = 0;
+  memset(models, 0, sizeof(models));
+  memset(appTimerWheel, 0, sizeof(appTimerWheel));
+  memset(appTimerOccupied, 0, sizeof(appTimerOccupied));
+
+  hostSetTime(rnd(TICK));
+  hostInit = hostTime;
+  appTimerInit();
+  appTimerTime = wheelStart;
+  appTimerClock = wheelStart;
+}
+
+/***************************************************************************************************
+ * Model
+ **************************************************************************************************/
+
+static void cback(void *arg);
+
+static void start(struct model *m, uint32_t timeoutMs, uint32_t slackMs, bool periodic)
+{
+  m->running = true;
+  m->periodic = periodic;
+  m->expiry = hostWheelFloor(hostTime) + (uint64_t)APP_TIMER_MS_2_WHEELTICK(timeoutMs) * TICK;
+  m->period = (uint64_t)APP_TIMER_MS_2_WHEELTICK(timeoutMs) * TICK;
+  m->slack = (uint64_t)APP_TIMER_MS_2_WHEELTICK(slackMs) * TICK;
+  appTimerStart(&m->timer, timeoutMs, slackMs, periodic, cback, m);
+}
+
+static void stop(struct model *m)
+{
+  m->running = false;
+  appTimerStop(&m->timer);
+}
+
+/* a timeout from 0 ms to 30 hours, mostly short, and a slack below half of it */
+static void startRandom(struct model *m)
+{
+  static const uint32_t ranges[] = { 1, 20, 1000, 60000, 3600000, 108000000 };
+  uint32_t timeoutMs = rnd(ranges[rnd(sizeof(ranges) / sizeof(ranges[0]))] + 1);
+  bool periodic = (rnd(3) == 0) && (timeoutMs >= 10);
+  uint32_t slackMs = rnd(2) ? 0 : rnd(timeoutMs / 2 + 1);
+
+  start(m, timeoutMs, slackMs, periodic);
+}
+
+static void cback(void *arg)
+{
+  struct model *m = arg;
+  unsigned i = (unsigned)(m - models);
+
+  callbacks++;
+  m->fired++;
+  CHECK(m->running, "timer %u fired while stopped", i);
+  CHECK(hostTime >= m->expiry, "timer %u fired %llu ticks early", i,
+        (unsigned long long)(m->expiry - hostTime));
+  CHECK(hostTime <= m->expiry + m->slack + 2 * TICK + LATENCY, "timer %u fired %llu ticks late", i,
+        (unsigned long long)(hostTime - m->expiry - m->slack));
+  CHECK(!appTimerIsRunning(&m->timer) == !m->periodic, "timer %u %s after its callback", i,
+        m->periodic ? "stopped" : "running");
+
+  if (m->periodic) {
+    m->expiry += m->period;
+  } else {
+    m->running = false;
+  }
+
+  /* callbacks may start and stop any timer, also one still due in this round */
+  if (meddle && (rnd(8) == 0)) {
+    struct model *other = &models[rnd(TIMERS)];
+
+    if (rnd(2)) {
+      stop(other);
+    } else {
+      startRandom(other);
+    }
+  }
+}
+
+/* fire the stack timer, late by up to LATENCY */
+static void hostFire(void)
+{
+  hostSetTime(hostFireAt + rnd(LATENCY + 1));
+  hostArmed = false;
+  hostWakeups++;
+  appTimerProcess();
+}
+
+static void checkRunning(void)
+{
+  bool any = false;
+  unsigned i;
+
+  for (i = 0; i < TIMERS; i++) {
+    CHECK(appTimerIsRunning(&models[i].timer) == models[i].running, "timer %u %s", i,
+          models[i].running ? "not running" : "running");
+    /* a timer past its deadline by more than the latency was missed */
+    CHECK(!models[i].running || (hostTime <= models[i].expiry + models[i].slack + 2 * TICK + LATENCY),
+          "timer %u missed", i);
+    any |= models[i].running;
+  }
+  CHECK(hostArmed || !any, "stack timer stopped with timers running");
+}
+
+/***************************************************************************************************
+ * Scenarios
+ **************************************************************************************************/
+
+static void run(const char *scenario, uint32_t rtccStart, uint32_t wheelStart)
+{
+  unsigned long step;
+
+  hostReset(scenario, rtccStart, wheelStart);
+  meddle = true;
+  for (step = 0; step < STEPS; step++) {
+    struct model *m = &models[rnd(TIMERS)];
+
+    switch (rnd(4)) {
+      case 0:
+        startRandom(m);
+        break;
+
+      case 1:
+        if (rnd(4) == 0) {
+          stop(m);
+        }
+        break;
+
+      default:
+        if (hostArmed) {
+          hostFire();
+        } else {
+          hostSetTime(hostTime + rnd(100000));
+        }
+        break;
+    }
+    checkRunning();
+  }
+}
+
+static unsigned long coalesce(uint32_t slackMs)
+{
+  unsigned i;
+
+  hostReset("coalesce", 0, 0);
+  meddle = false;
+  for (i = 0; i < 16; i++) {
+    hostSetTime(hostTime + 60 * 33);
+    start(&models[i], 1000, slackMs, true);
+  }
+  while (hostTime < 101 * 32768UL) {
+    hostFire();
+    checkRunning();
+  }
+  CHECK(callbacks >= 16 * 99, "%lu callbacks in 100 s", callbacks);
+  return hostWakeups;
+}
+
+int main(void)
+{
+  unsigned long tight, loose;
+
+  seed = 0x2545F4914F6CDD1DULL;
+  run("random", 0, 0);
+  run("wrap", 0xFFFFFFFFUL - 300 * 32768UL, 0xFFFFFFFFUL - 60000);
+
+  tight = coalesce(0);
+  loose = coalesce(200);
+  hostScenario = "coalesce";
+  CHECK(loose * 2 < tight, "%lu wakeups with slack, %lu without", loose, tight);
+
+  printf("%u failures\n", failures);
+  return failures != 0;
+}
+
+#endif /* HOST */
@@ -39,6 +39,7 @@
 /* Libraries containing default Gecko configuration values */
 #include "em_emu.h"
 #include "em_cmu.h"
+#include "em_core.h"
 
 /* Device initialization header */
 #include "hal-config.h"
@@ -155,8 +156,23 @@ int main(void)
     /* Event pointer for handling events */
     struct gecko_cmd_packet* evt;
 
-    /* Check for stack event. */
-    evt = gecko_wait_event();
+    /* Check for stack event, without blocking. */
+    evt = gecko_peek_event();
+
+    /* No event pending, sleep until the stack needs to run again. Interrupts are masked between
+     * the poll and the sleep, so an interrupt that arrives in between still wakes the core up. */
+    if (NULL == evt) {
+      CORE_DECLARE_IRQ_STATE;
+      uint32_t sleepMs;
+
+      CORE_ENTER_ATOMIC();
+      sleepMs = gecko_can_sleep_ms();
+      if (sleepMs) {
+        gecko_sleep_for_ms(sleepMs);
+      }
+      CORE_EXIT_ATOMIC();
+      continue;
+    }
 
     /* Handle events */
     switch (BGLIB_MSG_ID(evt->header)) {